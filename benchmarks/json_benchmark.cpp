@@ -0,0 +1,84 @@
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include <grafkit/descriptors/image_desc.h>
+#include <grafkit/descriptors/mesh_desc.h>
+
+#include "json/json_registry.h"
+
+using Grafkit::Serialization::JsonSerializerRegistry;
+
+namespace {
+	constexpr int ITERATION_COUNT = 10;
+
+	std::string MakeImageJson(const uint32_t width, const uint32_t height)
+	{
+		std::string text = "{\"size\": {\"x\": " + std::to_string(width) + ", \"y\": " + std::to_string(height)
+			+ ", \"z\": 1}, \"channels\": 4, \"image\": [";
+		for (uint32_t i = 0; i < width * height * 4; ++i) {
+			text += (i ? "," : "") + std::to_string(i % 256);
+		}
+		return text + "]}";
+	}
+
+	std::string MakeMeshJson(const uint32_t vertexCount)
+	{
+		std::string positions;
+		std::string indices;
+		for (uint32_t i = 0; i < vertexCount; ++i) {
+			positions += (i ? "," : "") + std::string("{\"x\": ") + std::to_string(i * 0.5f)
+				+ ", \"y\": " + std::to_string(i * 0.25f) + ", \"z\": " + std::to_string(i * 0.125f) + "}";
+			indices += (i ? "," : "") + std::to_string(i);
+		}
+		return R"({"name": "benchmark", "materials": {"default": 0}, "primitives": [{"positions": [)" + positions
+			+ "], \"normals\": [" + positions + "], \"indices\": [" + indices + "]}]}";
+	}
+
+	// Best of the iterations, in MB/s
+	double Measure(const std::string& text, const std::function<void()>& func)
+	{
+		double best = 0.0;
+		for (int i = 0; i < ITERATION_COUNT; ++i) {
+			const auto start = std::chrono::steady_clock::now();
+			func();
+			const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+			best = std::max(best, static_cast<double>(text.size()) / elapsed.count() / (1024.0 * 1024.0));
+		}
+		return best;
+	}
+
+	template <typename T> void Compare(const char* name, const std::string& text)
+	{
+		auto& registry = JsonSerializerRegistry::Instance();
+		const std::span<const uint8_t> data(reinterpret_cast<const uint8_t*>(text.data()), text.size());
+
+		const double domThroughput = Measure(text, [&]() {
+			T object {};
+			registry.Deserialize(nlohmann::json::parse(data.begin(), data.end()), object);
+		});
+		const double saxThroughput = Measure(text, [&]() {
+			T object {};
+			registry.Deserialize(data, typeid(T), &object);
+		});
+
+		std::printf("%-8s %8.2f MB  DOM %8.2f MB/s  SAX %8.2f MB/s  %5.2fx\n",
+			name,
+			static_cast<double>(text.size()) / (1024.0 * 1024.0),
+			domThroughput,
+			saxThroughput,
+			saxThroughput / domThroughput);
+	}
+} // namespace
+
+int main()
+{
+	Compare<Grafkit::Resource::ImageDesc>("image", MakeImageJson(1024, 1024));
+	Compare<Grafkit::Resource::MeshDesc>("mesh", MakeMeshJson(200000));
+	return 0;
+}
@@ -0,0 +1,141 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <grafkit/utils/concurrent_map.hpp>
+
+namespace {
+	constexpr int ITERATION_COUNT = 5;
+	constexpr int KEY_COUNT = 4096;
+	constexpr int LOOKUPS_PER_THREAD = 1 << 20;
+	// One write in this many operations, resources are looked up far more often than stored
+	constexpr int WRITE_INTERVAL = 1000;
+
+	using Value = std::shared_ptr<int>;
+
+	// The registry before it was sharded, a single map behind a single lock
+	class LockedMap {
+	public:
+		Value Find(const std::string& key) const
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			const auto it = m_map.find(key);
+			return it != m_map.end() ? it->second : nullptr;
+		}
+
+		void InsertOrAssign(const std::string& key, Value value)
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_map[key] = std::move(value);
+		}
+
+	private:
+		mutable std::mutex m_mutex;
+		std::unordered_map<std::string, Value> m_map;
+	};
+
+	class SharedLockedMap {
+	public:
+		Value Find(const std::string& key) const
+		{
+			std::shared_lock<std::shared_mutex> lock(m_mutex);
+			const auto it = m_map.find(key);
+			return it != m_map.end() ? it->second : nullptr;
+		}
+
+		void InsertOrAssign(const std::string& key, Value value)
+		{
+			std::unique_lock<std::shared_mutex> lock(m_mutex);
+			m_map[key] = std::move(value);
+		}
+
+	private:
+		mutable std::shared_mutex m_mutex;
+		std::unordered_map<std::string, Value> m_map;
+	};
+
+	std::vector<std::string> MakeKeys()
+	{
+		std::vector<std::string> keys;
+		for (int i = 0; i < KEY_COUNT; ++i) {
+			keys.push_back("assets/textures/texture" + std::to_string(i) + ".png");
+		}
+		return keys;
+	}
+
+	// Best of the iterations, in million operations per second
+	double Measure(const size_t threadCount, const std::function<void(size_t)>& func)
+	{
+		double best = 0.0;
+		for (int i = 0; i < ITERATION_COUNT; ++i) {
+			const auto start = std::chrono::steady_clock::now();
+			std::vector<std::thread> threads;
+			for (size_t thread = 0; thread < threadCount; ++thread) {
+				threads.emplace_back(func, thread);
+			}
+			for (auto& thread : threads) {
+				thread.join();
+			}
+			const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+			best = std::max(best, static_cast<double>(threadCount) * LOOKUPS_PER_THREAD / elapsed.count() / 1e6);
+		}
+		return best;
+	}
+
+	template <typename MapT> double Run(MapT& map, const std::vector<std::string>& keys, const size_t threadCount)
+	{
+		for (const auto& key : keys) {
+			map.InsertOrAssign(key, std::make_shared<int>(0));
+		}
+
+		std::atomic<size_t> found = 0;
+		const double throughput = Measure(threadCount, [&](const size_t thread) {
+			size_t localFound = 0;
+			size_t index = thread * 7919;
+			for (int i = 0; i < LOOKUPS_PER_THREAD; ++i) {
+				index = (index + 104729) % keys.size();
+				if (i % WRITE_INTERVAL == 0) {
+					map.InsertOrAssign(keys[index], std::make_shared<int>(i));
+				} else if (map.Find(keys[index]) != nullptr) {
+					++localFound;
+				}
+			}
+			found += localFound;
+		});
+
+		// Keeps the lookups from being optimized away
+		if (found.load() == 0) {
+			std::printf("nothing found\n");
+		}
+		return throughput;
+	}
+} // namespace
+
+int main()
+{
+	const auto keys = MakeKeys();
+	const size_t maxThreadCount = std::max(1u, std::thread::hardware_concurrency());
+
+	std::printf("%-8s %14s %14s %14s\n", "threads", "mutex", "shared_mutex", "sharded");
+	for (size_t threadCount = 1; threadCount <= maxThreadCount; threadCount *= 2) {
+		LockedMap locked;
+		SharedLockedMap sharedLocked;
+		Grafkit::Utils::ConcurrentMap<std::string, int> sharded;
+
+		std::printf("%-8zu %9.2f Mop/s %9.2f Mop/s %9.2f Mop/s\n",
+			threadCount,
+			Run(locked, keys, threadCount),
+			Run(sharedLocked, keys, threadCount),
+			Run(sharded, keys, threadCount));
+	}
+	return 0;
+}
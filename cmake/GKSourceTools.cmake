@@ -186,7 +186,7 @@ function(spirv_compile_shaders)
 		get_filename_component(FILE_NAME ${SOURCE} NAME)
 
 		set(SPIRV "${ARGS_SHADER_BINARY_DIR}/${FILE_NAME}.spv")
-		set(SPIRV_COMMAND ${Vulkan_GLSLC_EXECUTABLE} ${SOURCE} -o ${SPIRV})
+		set(SPIRV_COMMAND ${Vulkan_GLSLC_EXECUTABLE} -I ${CMAKE_SOURCE_DIR}/include ${SOURCE} -o ${SPIRV})
 
 		message(STATUS "Compiling ${GLSL} to ${SPIRV}")
 		if (NOT EXISTS ${SPIRV} OR ${SOURCE} IS_NEWER_THAN ${SPIRV})
@@ -235,3 +235,49 @@ function(spirv_compile_shaders)
 	set(${ARGS_GENERATED_FILES_ARG} "${SPIRV_GENERATED_SOURCE_FILES}" PARENT_SCOPE)
 
 endfunction()
+
+# Builds an asset pack from the contents of a directory
+function(pack_assets_from_directory)
+	cmake_parse_arguments(
+		ARGS # prefix
+		"NO_COMPRESSION" # flags
+		"SOURCE_DIR;OUTPUT;TARGET;BLOCK_SIZE" # single-values
+		"" # multi-values
+		${ARGN}
+	)
+
+	if (NOT ARGS_SOURCE_DIR)
+		message(FATAL_ERROR "You must provide a source directory")
+	endif ()
+
+	if (NOT ARGS_OUTPUT)
+		message(FATAL_ERROR "You must provide an output file")
+	endif ()
+
+	if (NOT ARGS_TARGET)
+		message(FATAL_ERROR "You must provide a target name")
+	endif ()
+
+	file(GLOB_RECURSE PACK_SOURCE_FILES ${ARGS_SOURCE_DIR}/*)
+
+	set(PACK_OPTIONS "")
+	if (ARGS_NO_COMPRESSION)
+		list(APPEND PACK_OPTIONS --no-compression)
+	endif()
+	if (ARGS_BLOCK_SIZE)
+		list(APPEND PACK_OPTIONS --block-size ${ARGS_BLOCK_SIZE})
+	endif()
+
+	set(PACK_COMMAND ${PYTHON_VENV_EXECUTABLE} -m grafkit_tools.packer --input-dir ${ARGS_SOURCE_DIR} --output ${ARGS_OUTPUT} ${PACK_OPTIONS})
+
+	add_custom_command(
+		OUTPUT ${ARGS_OUTPUT}
+		COMMAND ${PACK_COMMAND}
+		DEPENDS ${PACK_SOURCE_FILES}
+		COMMENT "Packing ${ARGS_SOURCE_DIR} to ${ARGS_OUTPUT}"
+		VERBATIM
+	)
+
+	add_custom_target(${ARGS_TARGET} DEPENDS ${ARGS_OUTPUT})
+
+endfunction()
@@ -133,6 +133,15 @@ namespace Grafkit::Core
 	class DescriptorPool;
 	using DescriptorPoolRef = RefWrapper<DescriptorPool>;
 
+	class UploadManager; // Staging ring + transfer queue
+	using UploadManagerRef = RefWrapper<UploadManager>;
+
+	class GeometryArena; // Vertex and index buffers shared by the meshes
+	using GeometryArenaRef = RefWrapper<GeometryArena>;
+
+	class UniformAllocator; // Per frame uniforms behind dynamic offsets
+	using UniformAllocatorRef = RefWrapper<UniformAllocator>;
+
 	class Image;
 	using ImagePtr = std::shared_ptr<Image>;
 
@@ -1,7 +1,10 @@
 #ifndef GRAFKIT_CORE_BUFFER_H
 #define GRAFKIT_CORE_BUFFER_H
 
+#include <cstdint>
+#include <functional>
 #include <grafkit/common.h>
+#include <span>
 #include <vector>
 #include <vk_mem_alloc.h>
 
@@ -12,6 +15,14 @@ namespace Grafkit::Core {
 		VmaAllocation allocation = VK_NULL_HANDLE;
 		VmaAllocationInfo allocationInfo {};
 
+		// Host visible buffers stay mapped for their whole life
+		uint8_t* mappedData = nullptr;
+		bool isCoherent = false;
+
+		// Written since the last flush, empty when begin is past end
+		size_t dirtyBegin = SIZE_MAX;
+		size_t dirtyEnd = 0;
+
 		void Destroy(const DeviceRef& device);
 
 		static Buffer CreateBuffer(const DeviceRef& device,
@@ -19,12 +30,24 @@ namespace Grafkit::Core {
 			const VkBufferUsageFlags usage,
 			const VmaMemoryUsage memoryUsage);
 
+		// Copies to the start of the buffer and flushes it
 		void Update(const DeviceRef& device, const void* data, const size_t size);
+
+		// Copies to the mapped memory only; the range is flushed on the next Flush, or queued on the device
+		void Update(const void* data, const size_t offset, const size_t size);
+
+		// For ranges written through the mapped memory directly
+		void MarkDirty(const size_t offset, const size_t size);
+
+		// Flushes the ranges written since the last flush, does nothing on coherent memory
+		void Flush(const DeviceRef& device);
+
+		// Hands the first size bytes to the writer to fill in place, and flushes them once it returns
+		void Write(const DeviceRef& device, const size_t size, const std::function<void(std::span<uint8_t>)>& writer);
 	};
 
 	struct GKAPI RingBuffer {
 		std::vector<Buffer> buffers;
-		std::vector<void*> mappedData;
 
 		[[nodiscard]] const Buffer& GetBuffer(const uint32_t frameIndex) const { return buffers[frameIndex]; }
 
@@ -35,29 +58,13 @@ namespace Grafkit::Core {
 			const VkBufferUsageFlags usage,
 			const VmaMemoryUsage memoryUsage);
 
+		// Copies into the buffer of the frame, flushed along with the other buffers of the frame before its submit
 		void Update(const DeviceRef& device, const void* data, const size_t size, const uint32_t frameIndex);
-	};
-
-	template <class Type> struct GKAPI UniformBuffer {
-		RingBuffer buffer {};
-		Type data {};
-
-		void Destroy(const DeviceRef& device) { buffer.Destroy(device); }
-
-		static UniformBuffer<Type> CreateBuffer(const DeviceRef& device)
-		{
-			UniformBuffer<Type> uniformBuffer = {};
-			uniformBuffer.buffer = RingBuffer::CreateBuffer(
-				device, sizeof(Type), VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, VMA_MEMORY_USAGE_CPU_TO_GPU);
-			return uniformBuffer;
-		}
-
-		void Update(const DeviceRef& device, const uint32_t frameIndex)
-		{
-			buffer.Update(device, reinterpret_cast<void*>(&data), sizeof(Type), frameIndex);
-		}
-
-		VkBuffer GetBuffer(const uint32_t frameIndex) const { return buffer.GetBuffer(frameIndex).buffer; }
+		void Update(const DeviceRef& device,
+			const void* data,
+			const size_t offset,
+			const size_t size,
+			const uint32_t frameIndex);
 	};
 
 } // namespace Grafkit::Core
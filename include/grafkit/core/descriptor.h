@@ -4,6 +4,7 @@
 #include <grafkit/common.h>
 #include <grafkit/core/buffer.h>
 #include <optional>
+#include <span>
 #include <vector>
 
 namespace Grafkit::Core
@@ -23,12 +24,21 @@ namespace Grafkit::Core
 			const VkPipelineLayout &pipelineLayout,
 			const uint32_t frame) const noexcept;
 
+		// Dynamic offsets go to the UNIFORM_BUFFER_DYNAMIC bindings of the set, in binding order
+		void Bind(const Core::CommandBufferRef &commandBuffer,
+			const VkPipelineLayout &pipelineLayout,
+			const uint32_t frame,
+			std::span<const uint32_t> dynamicOffsets) const noexcept;
+
 		void Update(const Buffer &buffer,
 			const uint32_t binding,
 			const std::optional<uint32_t> frame = std::nullopt) noexcept;
 
 		void Update(const RingBuffer &buffer, const uint32_t binding) noexcept;
 
+		// Points a UNIFORM_BUFFER_DYNAMIC binding at the uniform allocator, for uniforms up to range bytes
+		void Update(const UniformAllocator &allocator, const uint32_t binding, const VkDeviceSize range) noexcept;
+
 		void Update(const ImagePtr &image,
 			const VkSampler &sampler,
 			const uint32_t binding,
@@ -58,7 +68,8 @@ namespace Grafkit::Core
 	private:
 		void Update(const VkDescriptorBufferInfo &bufferInfo,
 			const uint32_t binding,
-			const std::optional<uint32_t> frame = std::nullopt) noexcept;
+			const std::optional<uint32_t> frame = std::nullopt,
+			const VkDescriptorType descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER) noexcept;
 
 		void Update(const VkDescriptorImageInfo &imageInfo,
 			const uint32_t binding,
@@ -2,10 +2,12 @@
 #define GRAFKIT_CORE_DESCRIPTOR_POOL_H
 
 #include <grafkit/common.h>
+#include <mutex>
 #include <vector>
 
 namespace Grafkit::Core
 {
+	// Allocations are synchronized, resources can be built on multiple threads
 	class GKAPI DescriptorPool
 	{
 	public:
@@ -35,6 +37,8 @@ namespace Grafkit::Core
 
 		uint32_t m_maxSets;
 
+		std::mutex m_mutex;
+
 		[[nodiscard]] VkDescriptorPool CreatePool();
 		[[nodiscard]] VkDescriptorPool GetPool();
 	};
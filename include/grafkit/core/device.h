@@ -2,12 +2,17 @@
 #define GRAFKIT_CORE_DEVICE_H
 
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <vector>
 
 #include <grafkit/common.h>
+#include <grafkit/core/buffer.h>
 #include <grafkit/core/descriptor_pool.h>
+#include <grafkit/core/geometry_arena.h>
 #include <grafkit/core/instance.h>
+#include <grafkit/core/uniform_allocator.h>
+#include <grafkit/core/upload_manager.h>
 #include <grafkit/core/window.h>
 
 #include <vk_mem_alloc.h>
@@ -15,11 +20,15 @@
 namespace Grafkit::Core
 {
 	using DescriptorPoolPtr = std::unique_ptr<DescriptorPool>;
+	using UploadManagerPtr = std::unique_ptr<UploadManager>;
+	using GeometryArenaPtr = std::unique_ptr<GeometryArena>;
+	using UniformAllocatorPtr = std::unique_ptr<UniformAllocator>;
 
 	struct QueueFamilyIndices
 	{
 		std::optional<uint32_t> graphicsFamily;
 		std::optional<uint32_t> presentFamily;
+		std::optional<uint32_t> transferFamily; // Only when there is one without graphics
 
 		bool IsComplete() const
 		{
@@ -41,9 +50,16 @@ namespace Grafkit::Core
 		~Device();
 
 		void WaitIdle() const;
+
+		// The command pool and the graphics queue stay locked from Begin until End, so builders can record
+		// single time commands from worker threads
 		[[nodiscard]] VkCommandBuffer BeginSingleTimeCommands() const;
 		void EndSingleTimeCommands(const VkCommandBuffer &commandBuffer) const;
 
+		// Queues are shared between threads, submissions to any of them are serialized
+		void Submit(const VkQueue &queue, const VkSubmitInfo &submitInfo, VkFence fence) const;
+		[[nodiscard]] VkResult Present(const VkPresentInfoKHR &presentInfo) const;
+
 		[[nodiscard]] const VkDevice &operator*() const
 		{
 			return m_device;
@@ -70,6 +86,12 @@ namespace Grafkit::Core
 			return m_presentQueue;
 		}
 
+		// The graphics queue when the device has no dedicated transfer queue family
+		[[nodiscard]] const VkQueue &GetVkTransferQueue() const
+		{
+			return m_transferQueue;
+		}
+
 		[[nodiscard]] const VkCommandPool &GetVkCommandPool() const
 		{
 			return m_commandPool;
@@ -81,6 +103,9 @@ namespace Grafkit::Core
 		}
 
 		[[nodiscard]] DescriptorPoolRef GetDescriptorPool() const;
+		[[nodiscard]] UploadManagerRef GetUploadManager() const;
+		[[nodiscard]] GeometryArenaRef GetGeometryArena() const;
+		[[nodiscard]] UniformAllocatorRef GetUniformAllocator() const;
 
 		// TODO: This is not quite neccessary - Only used during initialization
 		[[nodiscard]] QueueFamilyIndices GetQueueFamilies() const;	  // TODO -> SwapChain
@@ -104,11 +129,18 @@ namespace Grafkit::Core
 
 		[[nodiscard]] uint32_t GetMaxConcurrentFrames() const;
 
+		// Buffers written during the frame are flushed together with a single call, before the frame is submitted
+		// Queuing takes over the dirty range of the buffer, so the buffer itself may be moved or copied afterwards
+		void QueueFlush(Buffer &buffer);
+		void CancelFlush(const Buffer &buffer);
+		void FlushQueued();
+
 	private:
 		void PickPhysicalDevice();
 		void CreateLogicalDevice();
 		void CreateGraphicsQueue();
 		void CreatePresentQueue();
+		void CreateTransferQueue();
 		void CreateCommandPool();
 		void InitializeAllocator();
 
@@ -131,12 +163,28 @@ namespace Grafkit::Core
 
 		VkQueue m_graphicsQueue = VK_NULL_HANDLE;
 		VkQueue m_presentQueue = VK_NULL_HANDLE;
+		VkQueue m_transferQueue = VK_NULL_HANDLE;
+		mutable std::mutex m_queueMutex;
 
 		VkCommandPool m_commandPool = VK_NULL_HANDLE;
+		mutable std::recursive_mutex m_singleTimeCommandMutex;
 		DescriptorPoolPtr m_descriptorPool = VK_NULL_HANDLE;
+		UploadManagerPtr m_uploadManager = nullptr;
+		GeometryArenaPtr m_geometryArena = nullptr;
+		UniformAllocatorPtr m_uniformAllocator = nullptr;
 
 		VmaAllocator m_allocator = VK_NULL_HANDLE;
 
+		struct QueuedFlush
+		{
+			VmaAllocation allocation;
+			VkDeviceSize begin;
+			VkDeviceSize end;
+		};
+
+		std::mutex m_flushMutex;
+		std::vector<QueuedFlush> m_queuedFlushes;
+
 		// Cache for expensive queries
 		// TOOD: Move to a separate class/struct if needed
 		mutable std::optional<QueueFamilyIndices> m_queueFamilyIndices = std::nullopt;
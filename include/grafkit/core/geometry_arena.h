@@ -0,0 +1,110 @@
+#ifndef GRAFKIT_CORE_GEOMETRY_ARENA_H
+#define GRAFKIT_CORE_GEOMETRY_ARENA_H
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include <grafkit/common.h>
+#include <grafkit/core/buffer.h>
+#include <grafkit/core/geometry_layout.h>
+
+namespace Grafkit::Core
+{
+	// Where the geometry of a mesh is, in bytes from the start of the buffer
+	struct GeometryRange
+	{
+		VkBuffer buffer = VK_NULL_HANDLE;
+		VkDeviceSize vertexOffset = 0; // A multiple of the vertex stride
+		VkDeviceSize indexOffset = 0;  // A multiple of GEOMETRY_INDEX_ALIGNMENT, for both index types
+		uint64_t generation = 0;	   // Of the arena the offsets are valid in
+	};
+
+	/**
+	 * @brief Vertex and index data of every mesh, suballocated from a few large device local buffers
+	 * Each allocation holds the vertices of a mesh followed by its indices, in the same buffer, so draws of meshes in
+	 * the same block only differ in their first vertex and index. Blocks are managed by TLSF allocators of VMA; a new
+	 * one is added when none of them has room. Blocks left empty are released once the frames in flight that could
+	 * have drawn from them are done.
+	 * Ranges move when the arena is defragmented, which bumps its generation.
+	 */
+	class GKAPI GeometryArena
+	{
+	public:
+		using Handle = uint32_t;
+
+		static constexpr Handle INVALID_HANDLE = ~Handle{0};
+		static constexpr VkDeviceSize DEFAULT_BLOCK_SIZE = VkDeviceSize{64} << 20;
+
+		explicit GeometryArena(const DeviceRef &device, VkDeviceSize blockSize = DEFAULT_BLOCK_SIZE);
+		~GeometryArena();
+
+		GeometryArena(const GeometryArena &) = delete;
+		GeometryArena &operator=(const GeometryArena &) = delete;
+		GeometryArena(GeometryArena &&) = delete;
+		GeometryArena &operator=(GeometryArena &&) = delete;
+
+		[[nodiscard]] Handle Allocate(VkDeviceSize vertexSize, VkDeviceSize vertexStride, VkDeviceSize indexSize);
+		void Free(Handle handle);
+
+		[[nodiscard]] GeometryRange GetRange(Handle handle) const;
+
+		// Releases the blocks emptied as many frames ago as there are frames in flight; once a frame, after its fence
+		void BeginFrame();
+
+		/**
+		 * @brief Packs the live geometry into a single block and releases the others
+		 * Waits for the pending uploads and for the graphics queue to go idle, so no submitted frame reads the old
+		 * blocks by the time they are destroyed. Meshes must not be built meanwhile.
+		 */
+		void Defragment();
+
+		[[nodiscard]] uint64_t GetGeneration() const
+		{
+			return m_generation.load(std::memory_order_acquire);
+		}
+
+		[[nodiscard]] size_t GetBlockCount() const;
+
+	private:
+		// Released blocks keep their slot with a null allocator, entries refer to blocks by index
+		struct Block
+		{
+			Buffer buffer{};
+			VmaVirtualBlock allocator = VK_NULL_HANDLE;
+			uint32_t allocationCount = 0;
+			uint64_t emptySince = 0; // Frame the last allocation was freed in
+		};
+
+		struct Entry
+		{
+			uint32_t block = 0;
+			VmaVirtualAllocation allocation = VK_NULL_HANDLE;
+			VkDeviceSize vertexOffset = 0;
+			VkDeviceSize vertexSize = 0;
+			VkDeviceSize vertexStride = 0;
+			VkDeviceSize indexOffset = 0;
+			VkDeviceSize indexSize = 0;
+		};
+
+		[[nodiscard]] Block CreateBlock(VkDeviceSize size) const;
+		void DestroyBlock(Block &block) const;
+
+		// Places the entry in the block, its vertex and index offsets are laid out from where it landed
+		[[nodiscard]] bool Place(Block &block, Entry &entry) const;
+
+		const DeviceRef m_device;
+		const VkDeviceSize m_blockSize;
+
+		std::vector<Block> m_blocks;
+		std::vector<Entry> m_entries;
+		std::vector<Handle> m_freeHandles;
+		std::atomic<uint64_t> m_generation = 1;
+		uint64_t m_frameIndex = 0;
+
+		mutable std::mutex m_mutex;
+	};
+
+} // namespace Grafkit::Core
+
+#endif // GRAFKIT_CORE_GEOMETRY_ARENA_H
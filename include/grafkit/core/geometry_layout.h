@@ -0,0 +1,46 @@
+#ifndef GRAFKIT_CORE_GEOMETRY_LAYOUT_H
+#define GRAFKIT_CORE_GEOMETRY_LAYOUT_H
+
+#include <optional>
+
+#include <grafkit/common.h>
+
+#include <vk_mem_alloc.h>
+
+namespace Grafkit::Core
+{
+	// Index data starts on a multiple of this, which suits both 16 and 32 bit indices
+	constexpr VkDeviceSize GEOMETRY_INDEX_ALIGNMENT = 4;
+
+	// Where the vertices and the indices of a mesh are, in bytes from the start of the block
+	struct GeometryLayout
+	{
+		VkDeviceSize vertexOffset = 0; // A multiple of the vertex stride
+		VkDeviceSize indexOffset = 0;  // A multiple of GEOMETRY_INDEX_ALIGNMENT
+	};
+
+	// Room for the data along with the padding in front of the vertices and the indices, wherever it lands
+	[[nodiscard]] GKAPI VkDeviceSize GetGeometryAllocationSize(VkDeviceSize vertexSize,
+		VkDeviceSize vertexStride,
+		VkDeviceSize indexSize);
+
+	// Lays out the vertices from where the allocation landed, the indices follow them
+	[[nodiscard]] GKAPI GeometryLayout GetGeometryLayout(VkDeviceSize offset,
+		VkDeviceSize vertexSize,
+		VkDeviceSize vertexStride);
+
+	/**
+	 * @brief Allocates the geometry of a mesh from a virtual block and lays it out within the allocation
+	 * Vertex strides of packed formats are not powers of two, so the allocation is aligned for the indices only and
+	 * padded for the vertices instead.
+	 * @return Nothing when the block has no room, the allocation is left null then
+	 */
+	[[nodiscard]] GKAPI std::optional<GeometryLayout> AllocateGeometry(VmaVirtualBlock block,
+		VkDeviceSize vertexSize,
+		VkDeviceSize vertexStride,
+		VkDeviceSize indexSize,
+		VmaVirtualAllocation &allocation);
+
+} // namespace Grafkit::Core
+
+#endif // GRAFKIT_CORE_GEOMETRY_LAYOUT_H
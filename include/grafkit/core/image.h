@@ -35,6 +35,14 @@ namespace Grafkit::Core
 			return m_layout;
 		}
 
+		// Readiness token of the data the image was created with, zero when there was nothing to upload
+		[[nodiscard]] inline uint64_t GetUploadTicket() const
+		{
+			return m_uploadTicket;
+		}
+
+		[[nodiscard]] bool IsReady() const;
+
 		// MARK: Factory methods
 		static ImagePtr CreateImage(const DeviceRef &device,
 			const VkExtent3D size,
@@ -44,10 +52,11 @@ namespace Grafkit::Core
 			const VkImageUsageFlags usage = VK_IMAGE_USAGE_SAMPLED_BIT,
 			const VkImageLayout layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
 
+		// The data is staged and copied with the next upload batch, the image is usable once it is ready
 		static ImagePtr CreateImage(const DeviceRef &device,
 			const void *data,
 			const VkExtent3D size,
-			const uint32_t channels,
+			const uint32_t bytesPerPixel,
 			const VkFormat format,
 			const VkImageType type,
 			const bool mipmapped = false,
@@ -63,6 +72,7 @@ namespace Grafkit::Core
 		VkImage m_image = VK_NULL_HANDLE;
 		VkImageView m_imageView = VK_NULL_HANDLE;
 		VkImageLayout m_layout = VK_IMAGE_LAYOUT_UNDEFINED;
+		uint64_t m_uploadTicket = 0;
 
 		static void TransitionImageLayout(VkCommandBuffer &command,
 			const VkImage &image,
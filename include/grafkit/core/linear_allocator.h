@@ -0,0 +1,59 @@
+#ifndef GRAFKIT_CORE_LINEAR_ALLOCATOR_H
+#define GRAFKIT_CORE_LINEAR_ALLOCATOR_H
+
+#include <atomic>
+#include <optional>
+
+#include <grafkit/common.h>
+
+namespace Grafkit::Core
+{
+	/**
+	 * @brief Bumps offsets within a range of fixed size, from any thread, until reset
+	 * Offsets are aligned to a power of two. An allocation that does not fit fails, and so does every one after it
+	 * until the next reset.
+	 */
+	class GKAPI LinearAllocator
+	{
+	public:
+		LinearAllocator(VkDeviceSize size, VkDeviceSize alignment);
+
+		LinearAllocator(const LinearAllocator &) = delete;
+		LinearAllocator &operator=(const LinearAllocator &) = delete;
+		LinearAllocator(LinearAllocator &&) = delete;
+		LinearAllocator &operator=(LinearAllocator &&) = delete;
+
+		// Nothing may use the previous offsets anymore
+		void Reset();
+
+		// Nothing when the range has no room left
+		[[nodiscard]] std::optional<VkDeviceSize> Allocate(VkDeviceSize size);
+
+		// From the start of the range to the end of the last allocation, padding included
+		[[nodiscard]] VkDeviceSize GetUsedSize() const;
+
+		[[nodiscard]] VkDeviceSize GetSize() const
+		{
+			return m_size;
+		}
+
+		[[nodiscard]] VkDeviceSize GetAlignment() const
+		{
+			return m_alignment;
+		}
+
+		[[nodiscard]] static constexpr VkDeviceSize AlignUp(const VkDeviceSize value, const VkDeviceSize alignment)
+		{
+			return (value + alignment - 1) & ~(alignment - 1);
+		}
+
+	private:
+		const VkDeviceSize m_size;
+		const VkDeviceSize m_alignment;
+
+		std::atomic<VkDeviceSize> m_head = 0;
+	};
+
+} // namespace Grafkit::Core
+
+#endif // GRAFKIT_CORE_LINEAR_ALLOCATOR_H
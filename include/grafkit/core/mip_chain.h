@@ -0,0 +1,47 @@
+#ifndef GRAFKIT_CORE_MIP_CHAIN_H
+#define GRAFKIT_CORE_MIP_CHAIN_H
+
+#include <span>
+#include <vector>
+
+#include <grafkit/common.h>
+
+namespace Grafkit::Core
+{
+	// Levels are laid out one after another, each starting on this alignment for the buffer to image copies
+	constexpr size_t MIP_LEVEL_ALIGNMENT = 16;
+
+	struct MipLevel
+	{
+		VkExtent3D extent = {0, 0, 0};
+		size_t offset = 0;
+		size_t size = 0;
+	};
+
+	enum class MipChannelType
+	{
+		Unorm8,
+		Float32,
+	};
+
+	[[nodiscard]] GKAPI uint32_t GetMipLevelCount(VkExtent3D extent);
+
+	// Every level halves the extent of the previous one, down to one texel
+	[[nodiscard]] GKAPI std::vector<MipLevel> GetMipChainLayout(VkExtent3D extent,
+		uint32_t levelCount,
+		size_t pixelSize);
+	[[nodiscard]] GKAPI size_t GetMipChainSize(VkExtent3D extent, uint32_t levelCount, size_t pixelSize);
+
+	/**
+	 * @brief Fills every level after the first one with a box filter of the level before it
+	 * The data is in the layout of GetMipChainLayout, with the first level already in place. Odd texels at the edge of
+	 * a level are folded into the last texel of the next one.
+	 */
+	GKAPI void GenerateMipChain(std::span<uint8_t> data,
+		std::span<const MipLevel> levels,
+		uint32_t channels,
+		MipChannelType type);
+
+} // namespace Grafkit::Core
+
+#endif // GRAFKIT_CORE_MIP_CHAIN_H
@@ -0,0 +1,72 @@
+#ifndef GRAFKIT_CORE_UNIFORM_ALLOCATOR_H
+#define GRAFKIT_CORE_UNIFORM_ALLOCATOR_H
+
+#include <cstring>
+#include <span>
+
+#include <grafkit/common.h>
+#include <grafkit/core/buffer.h>
+#include <grafkit/core/linear_allocator.h>
+
+namespace Grafkit::Core
+{
+	// Where a uniform of the frame is; the offset goes to the dynamic offsets when its descriptor set is bound
+	struct UniformAllocation
+	{
+		VkBuffer buffer = VK_NULL_HANDLE;
+		uint32_t offset = 0;
+		std::span<uint8_t> data{};
+	};
+
+	/**
+	 * @brief Bump allocator for the uniforms of a frame, over one mapped buffer split between the frames in flight
+	 * Every allocation of a frame shares the buffer, so a single UNIFORM_BUFFER_DYNAMIC descriptor covers all of them.
+	 * Allocations of a frame are valid from BeginFrame until the fence of the frame signals again; they are made from
+	 * any thread between BeginFrame and EndFrame.
+	 */
+	class GKAPI UniformAllocator
+	{
+	public:
+		static constexpr VkDeviceSize DEFAULT_FRAME_SIZE = VkDeviceSize{1} << 20;
+
+		explicit UniformAllocator(const DeviceRef &device, VkDeviceSize frameSize = DEFAULT_FRAME_SIZE);
+		~UniformAllocator();
+
+		UniformAllocator(const UniformAllocator &) = delete;
+		UniformAllocator &operator=(const UniformAllocator &) = delete;
+		UniformAllocator(UniformAllocator &&) = delete;
+		UniformAllocator &operator=(UniformAllocator &&) = delete;
+
+		// Rewinds the part of the frame; its fence has to be signaled, nothing may read the previous uniforms there
+		void BeginFrame(uint32_t frameIndex);
+
+		// Queues what the frame has written for the flush of the device, before its command buffer is submitted
+		void EndFrame();
+
+		[[nodiscard]] UniformAllocation Allocate(VkDeviceSize size);
+
+		template <class Type> [[nodiscard]] UniformAllocation Push(const Type &value)
+		{
+			const UniformAllocation allocation = Allocate(sizeof(Type));
+			std::memcpy(allocation.data.data(), &value, sizeof(Type));
+			return allocation;
+		}
+
+		[[nodiscard]] VkBuffer GetBuffer() const
+		{
+			return m_buffer.buffer;
+		}
+
+	private:
+		const DeviceRef m_device;
+		const VkDeviceSize m_alignment;
+		const VkDeviceSize m_frameSize;
+
+		Buffer m_buffer{};
+		VkDeviceSize m_frameOffset = 0;
+		LinearAllocator m_frame;
+	};
+
+} // namespace Grafkit::Core
+
+#endif // GRAFKIT_CORE_UNIFORM_ALLOCATOR_H
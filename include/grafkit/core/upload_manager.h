@@ -0,0 +1,177 @@
+#ifndef GRAFKIT_CORE_UPLOAD_MANAGER_H
+#define GRAFKIT_CORE_UPLOAD_MANAGER_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <span>
+#include <vector>
+
+#include <grafkit/common.h>
+#include <grafkit/core/buffer.h>
+
+namespace Grafkit::Core
+{
+	// A range of a device local buffer to fill, and how it is read once it is there
+	struct UploadRegion
+	{
+		VkBuffer destination = VK_NULL_HANDLE;
+		VkDeviceSize offset = 0;
+		VkDeviceSize size = 0;
+		VkPipelineStageFlags dstStageMask = VK_PIPELINE_STAGE_VERTEX_INPUT_BIT;
+		VkAccessFlags dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT;
+	};
+
+	/**
+	 * @brief An image filled from its first few mip levels, every level of it ends up in the given layout
+	 * The staged levels follow the layout of GetMipChainLayout. Levels after them are blitted from the one before, so
+	 * the format has to support linear filtered blits when there are any.
+	 */
+	struct ImageUploadRegion
+	{
+		VkImage image = VK_NULL_HANDLE;
+		VkExtent3D extent = {0, 0, 0};
+		VkDeviceSize size = 0; // Of the first level
+		uint32_t mipLevels = 1;
+		uint32_t stagedLevels = 1;
+		VkImageAspectFlags aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		VkImageLayout layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+		VkPipelineStageFlags dstStageMask = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+		VkAccessFlags dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+	};
+
+	/**
+	 * @brief Copies data into device local buffers and images through a persistently mapped staging ring
+	 * Uploads are collected until Flush, which records all of them into a single command buffer. Where the device has
+	 * a dedicated transfer queue family the copies run there, and the resources are released to the graphics family
+	 * then acquired by a second submission on the graphics queue. Uploads larger than the ring get a staging buffer of
+	 * their own for the batch.
+	 * Batches signal their ticket on a timeline semaphore. Tickets are the readiness tokens of the uploaded resources:
+	 * staging space is reclaimed once the semaphore reaches the ticket of its batch, and callers poll or wait on them
+	 * instead of stalling the queue for every upload.
+	 * Uploads are synchronized, resources can be built on multiple threads.
+	 */
+	class GKAPI UploadManager
+	{
+	public:
+		// One staging range per region, in the same order
+		using Writer = std::function<void(std::span<const std::span<uint8_t>> staging)>;
+
+		static constexpr VkDeviceSize DEFAULT_STAGING_SIZE = VkDeviceSize{32} << 20;
+
+		explicit UploadManager(const DeviceRef &device, VkDeviceSize stagingSize = DEFAULT_STAGING_SIZE);
+		~UploadManager();
+
+		UploadManager(const UploadManager &) = delete;
+		UploadManager &operator=(const UploadManager &) = delete;
+		UploadManager(UploadManager &&) = delete;
+		UploadManager &operator=(UploadManager &&) = delete;
+
+		// Stages the regions for the writer to fill in place; returns the ticket of the batch they are copied in
+		uint64_t Upload(std::span<const UploadRegion> regions, const Writer &writer);
+		uint64_t Upload(const UploadRegion &region, const void *data);
+
+		// The writer fills every staged level in place
+		uint64_t Upload(const ImageUploadRegion &region, const std::function<void(std::span<uint8_t>)> &writer);
+		// The data holds every staged level, they are zero filled when there is none
+		uint64_t Upload(const ImageUploadRegion &region, const void *data);
+
+		// Submits the pending uploads as one batch; work submitted to the graphics queue afterwards sees their data
+		uint64_t Flush();
+
+		[[nodiscard]] bool IsComplete(uint64_t ticket);
+
+		// Flushes first when the ticket is still pending; returns right away for uploads dropped by a failed flush
+		void Wait(uint64_t ticket);
+
+	private:
+		struct Copy
+		{
+			VkBuffer source = VK_NULL_HANDLE;
+			VkBuffer destination = VK_NULL_HANDLE;
+			VkBufferCopy region{};
+			VkPipelineStageFlags dstStageMask = 0;
+			VkAccessFlags dstAccessMask = 0;
+		};
+
+		struct ImageCopy
+		{
+			VkBuffer source = VK_NULL_HANDLE;
+			VkDeviceSize sourceOffset = 0;
+			ImageUploadRegion target{};
+		};
+
+		struct Batch
+		{
+			uint64_t ticket = 0;
+			VkDeviceSize stagingEnd = 0; // The ring is free up to here once the batch is done
+			std::vector<Buffer> dedicatedStaging;
+			VkCommandBuffer transferCommands = VK_NULL_HANDLE;
+			VkCommandBuffer acquireCommands = VK_NULL_HANDLE;
+			VkSemaphore released = VK_NULL_HANDLE;
+		};
+
+		// Returns the buffer and offset the data was written to, with the lock held again
+		[[nodiscard]] VkBuffer Stage(VkDeviceSize size,
+			const std::function<void(std::span<uint8_t>)> &write,
+			VkDeviceSize &offset,
+			std::unique_lock<std::mutex> &lock);
+		[[nodiscard]] VkDeviceSize Reserve(VkDeviceSize size, std::unique_lock<std::mutex> &lock);
+
+		uint64_t FlushLocked(std::unique_lock<std::mutex> &lock);
+		void Record(Batch &batch);
+		// Blits the levels that were not staged, then moves every level to the final layout; on the graphics queue
+		void RecordMipChains(VkCommandBuffer commandBuffer) const;
+		static void RecordMipChain(VkCommandBuffer commandBuffer, const ImageUploadRegion &region);
+		// Signals the ticket on the timeline once the commands are done
+		void SubmitBatch(const VkQueue &queue,
+			VkCommandBuffer commandBuffer,
+			uint64_t ticket,
+			VkSemaphore waitSemaphore = VK_NULL_HANDLE,
+			VkPipelineStageFlags waitStageMask = 0) const;
+
+		[[nodiscard]] VkCommandBuffer BeginCommands(VkCommandPool pool) const;
+		[[nodiscard]] VkSemaphore AcquireSemaphore();
+
+		void Collect();
+		void WaitOldest();
+		void Retire(Batch &batch);
+		void Release(Batch &batch);
+
+		[[nodiscard]] bool HasTransferQueue() const
+		{
+			return m_transferFamily != m_graphicsFamily;
+		}
+
+		const DeviceRef m_device;
+
+		uint32_t m_graphicsFamily = 0;
+		uint32_t m_transferFamily = 0;
+		VkCommandPool m_graphicsPool = VK_NULL_HANDLE;
+		VkCommandPool m_transferPool = VK_NULL_HANDLE;
+
+		Buffer m_staging{};
+		uint8_t *m_stagingData = nullptr;
+		VkDeviceSize m_stagingSize = 0;
+		VkDeviceSize m_head = 0; // Next free byte
+		VkDeviceSize m_tail = 0; // First byte still in use, equal to the head when the ring is empty
+
+		std::vector<Copy> m_copies;
+		std::vector<ImageCopy> m_imageCopies;
+		std::vector<Buffer> m_dedicatedStaging;
+		size_t m_writerCount = 0; // Uploads writing their staging range outside of the lock
+		uint64_t m_nextTicket = 1;
+		uint64_t m_completedTicket = 0;
+
+		std::deque<Batch> m_batches;
+		VkSemaphore m_timeline = VK_NULL_HANDLE; // Counts the completed tickets
+		std::vector<VkSemaphore> m_freeSemaphores;
+
+		std::mutex m_mutex;
+		std::condition_variable m_writersDone;
+	};
+
+} // namespace Grafkit::Core
+
+#endif // GRAFKIT_CORE_UPLOAD_MANAGER_H
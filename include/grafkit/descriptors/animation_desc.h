@@ -4,7 +4,7 @@
  *
  * This file has been automatically generated and should not be modified.
  *
- * Generated on: 2025-03-26 12:50:23
+ * Generated on: 2026-10-19 10:11:57
  * Source file:
  */
 
@@ -14,10 +14,72 @@
 #include <grafkit/common.h>
 #include <map>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 /* animation_desc */
 namespace Grafkit::Resource
 {
+	enum class KeyInterpolation
+	{
+		Step = 0,
+		Linear = 1,
+		Smooth = 2,
+		CubicSpline = 3,
+	};
+
+	struct AnimationKeyDesc
+	{
+		float time;
+		KeyInterpolation interpolation = KeyInterpolation::Linear;
+		glm::vec4 value;
+	};
+
+	struct AnimationChannelDesc
+	{
+		uint32_t id;
+		uint32_t target;
+		std::vector<AnimationKeyDesc> keys;
+	};
+
+	struct AnimationClipDesc
+	{
+		std::string name;
+		float duration;
+		bool isLooping = false;
+		std::vector<AnimationChannelDesc> channels;
+	};
+
+	struct alignas(16) AnimationClipHeader
+	{
+		uint32_t magic;
+		uint32_t version;
+		uint32_t channelCount;
+		uint32_t keyCount; // Padded key count of the key streams
+		float duration;
+		uint32_t flags;
+		uint32_t nameOffset;
+		uint32_t nameLength;
+		uint64_t channelTableOffset;
+		uint64_t timeStreamOffset;
+		uint64_t valueStreamOffset;
+		uint64_t interpolationStreamOffset;
+	};
+	static_assert(std::is_standard_layout_v<AnimationClipHeader> && std::is_trivially_copyable_v<AnimationClipHeader>,
+		"AnimationClipHeader is read in place from mapped memory");
+	static_assert(sizeof(AnimationClipHeader) == 64, "AnimationClipHeader binary layout has changed");
+
+	struct alignas(16) AnimationChannelEntry
+	{
+		uint32_t id;
+		uint32_t target;
+		uint32_t firstKey; // Index into the key streams, multiple of the SIMD width
+		uint32_t keyCount;
+	};
+	static_assert(std::is_standard_layout_v<AnimationChannelEntry> &&
+					  std::is_trivially_copyable_v<AnimationChannelEntry>,
+		"AnimationChannelEntry is read in place from mapped memory");
+	static_assert(sizeof(AnimationChannelEntry) == 16, "AnimationChannelEntry binary layout has changed");
+
 } // namespace Grafkit::Resource
 #endif // __ANIMATION_DESC_GENERATED_H__
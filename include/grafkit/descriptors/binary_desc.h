@@ -0,0 +1,33 @@
+/**
+ * @file binary_desc.h
+ * @brief binary_desc descriptor
+ *
+ * This file has been automatically generated and should not be modified.
+ *
+ * Generated on: 2026-10-19 18:20:31
+ * Source file:
+ */
+
+#ifndef __BINARY_DESC_GENERATED_H__
+#define __BINARY_DESC_GENERATED_H__
+
+#include <grafkit/common.h>
+#include <type_traits>
+
+/* binary_desc */
+namespace Grafkit::Asset
+{
+	struct alignas(16) BinaryAssetHeader
+	{
+		uint32_t magic;
+		uint32_t version;
+		uint64_t schemaHash; // Hash of the type and its fields, changes with the descriptor
+		uint64_t payloadSize;
+		uint64_t reserved;
+	};
+	static_assert(std::is_standard_layout_v<BinaryAssetHeader> && std::is_trivially_copyable_v<BinaryAssetHeader>,
+		"BinaryAssetHeader is read in place from mapped memory");
+	static_assert(sizeof(BinaryAssetHeader) == 32, "BinaryAssetHeader binary layout has changed");
+
+} // namespace Grafkit::Asset
+#endif // __BINARY_DESC_GENERATED_H__
@@ -0,0 +1,76 @@
+/**
+ * @file cook_desc.h
+ * @brief cook_desc descriptor
+ *
+ * This file has been automatically generated and should not be modified.
+ *
+ * Generated on: 2026-10-19 16:02:14
+ * Source file:
+ */
+
+#ifndef __COOK_DESC_GENERATED_H__
+#define __COOK_DESC_GENERATED_H__
+
+#include <grafkit/common.h>
+#include <type_traits>
+
+/* cook_desc */
+namespace Grafkit::Resource
+{
+	struct alignas(16) CookCacheHeader
+	{
+		uint32_t magic;
+		uint32_t version;
+		uint64_t key; // Hash of the source asset and the builder
+		uint64_t dataSize;
+		uint64_t dataHash;
+	};
+	static_assert(std::is_standard_layout_v<CookCacheHeader> && std::is_trivially_copyable_v<CookCacheHeader>,
+		"CookCacheHeader is read in place from mapped memory");
+	static_assert(sizeof(CookCacheHeader) == 32, "CookCacheHeader binary layout has changed");
+
+	struct alignas(16) CookedImageHeader
+	{
+		uint32_t width;
+		uint32_t height;
+		uint32_t depth;
+		uint32_t channels;
+		uint32_t format;
+		uint32_t flags;
+		uint64_t pixelSize;
+	};
+	static_assert(std::is_standard_layout_v<CookedImageHeader> && std::is_trivially_copyable_v<CookedImageHeader>,
+		"CookedImageHeader is read in place from mapped memory");
+	static_assert(sizeof(CookedImageHeader) == 32, "CookedImageHeader binary layout has changed");
+
+	struct alignas(16) CookedMeshHeader
+	{
+		uint32_t primitiveCount;
+		uint32_t vertexCount;
+		uint32_t indexSize; // Bytes, 16 and 32 bit indices mixed
+		uint32_t materialCount;
+		uint32_t meshletCount;
+		uint32_t reserved;
+		uint64_t vertexOffset;
+		uint64_t indexOffset;
+		uint64_t meshletOffset;
+		uint64_t materialOffset;
+		uint64_t nameOffset;
+	};
+	static_assert(std::is_standard_layout_v<CookedMeshHeader> && std::is_trivially_copyable_v<CookedMeshHeader>,
+		"CookedMeshHeader is read in place from mapped memory");
+	static_assert(sizeof(CookedMeshHeader) == 64, "CookedMeshHeader binary layout has changed");
+
+	struct alignas(16) CookedMaterialEntry
+	{
+		uint32_t index;
+		uint32_t nameOffset; // Relative to the name table
+		uint32_t nameLength;
+		uint32_t reserved;
+	};
+	static_assert(std::is_standard_layout_v<CookedMaterialEntry> && std::is_trivially_copyable_v<CookedMaterialEntry>,
+		"CookedMaterialEntry is read in place from mapped memory");
+	static_assert(sizeof(CookedMaterialEntry) == 16, "CookedMaterialEntry binary layout has changed");
+
+} // namespace Grafkit::Resource
+#endif // __COOK_DESC_GENERATED_H__
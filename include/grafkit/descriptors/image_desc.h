@@ -4,7 +4,7 @@
  *
  * This file has been automatically generated and should not be modified.
  *
- * Generated on: 2025-03-26 12:50:23
+ * Generated on: 2026-10-19 19:02:47
  * Source file:
  */
 
@@ -24,6 +24,7 @@ namespace Grafkit::Resource
 		RGB = 1,
 		RGBA = 2,
 		Grayscale = 3,
+		RGBAFloat = 4, // 32 bit float per channel, HDR images
 	};
 
 	struct ImageDesc
@@ -44,6 +44,13 @@ namespace Grafkit::Resource
 		MeshType type;
 	};
 
+	struct PrimitiveLodDesc
+	{
+		uint32_t indexOffset;
+		uint32_t indexCount;
+		float error; // Relative to the extent of the primitive
+	};
+
 	struct PrimitiveDescV2
 	{
 		uint32_t indexOffset;
@@ -51,6 +58,7 @@ namespace Grafkit::Resource
 		uint32_t vertexOffset;
 		uint32_t vertexCount;
 		uint32_t materialIndex;
+		std::vector<PrimitiveLodDesc> lods; // Coarser index buffers over the same vertices
 	};
 
 	struct MeshDescV2
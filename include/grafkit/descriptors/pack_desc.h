@@ -0,0 +1,51 @@
+/**
+ * @file pack_desc.h
+ * @brief pack_desc descriptor
+ *
+ * This file has been automatically generated and should not be modified.
+ *
+ * Generated on: 2026-10-19 15:26:37
+ * Source file:
+ */
+
+#ifndef __PACK_DESC_GENERATED_H__
+#define __PACK_DESC_GENERATED_H__
+
+#include <grafkit/common.h>
+#include <type_traits>
+
+/* pack_desc */
+namespace Grafkit::Asset
+{
+	struct alignas(16) PackHeader
+	{
+		uint32_t magic;
+		uint32_t version;
+		uint32_t entryCount;
+		uint32_t blockSize; // Uncompressed size of a compressed block
+		uint64_t entryTableOffset;
+		uint64_t blockTableOffset;
+		uint64_t stringTableOffset;
+		uint64_t stringTableSize;
+	};
+	static_assert(std::is_standard_layout_v<PackHeader> && std::is_trivially_copyable_v<PackHeader>,
+		"PackHeader is read in place from mapped memory");
+	static_assert(sizeof(PackHeader) == 48, "PackHeader binary layout has changed");
+
+	struct alignas(16) PackEntry
+	{
+		uint64_t nameHash; // FNV-1a of the normalized name
+		uint64_t dataOffset;
+		uint64_t size; // Uncompressed size
+		uint64_t storedSize;
+		uint32_t nameOffset;
+		uint32_t nameLength;
+		uint32_t firstBlock; // Index into the block table of compressed entries
+		uint32_t flags;
+	};
+	static_assert(std::is_standard_layout_v<PackEntry> && std::is_trivially_copyable_v<PackEntry>,
+		"PackEntry is read in place from mapped memory");
+	static_assert(sizeof(PackEntry) == 48, "PackEntry binary layout has changed");
+
+} // namespace Grafkit::Asset
+#endif // __PACK_DESC_GENERATED_H__
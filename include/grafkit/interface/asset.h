@@ -3,8 +3,8 @@
 
 #include <grafkit/common.h>
 
-#include <any>
 #include <functional>
+#include <span>
 #include <string>
 #include <typeindex>
 
@@ -20,25 +20,68 @@ namespace Grafkit::Asset {
 	using AssetLoaderPtr = std::unique_ptr<IAssetLoader>;
 	using AssetLoaderRef = Grafkit::RefWrapper<IAssetLoader>;
 
+	/**
+	 * @brief Read-only bytes of an asset
+	 * The owner keeps the storage (buffer or file mapping) alive as long as it is referenced.
+	 */
+	class GKAPI IAssetData {
+	public:
+		virtual ~IAssetData() = default;
+		[[nodiscard]] virtual std::span<const uint8_t> GetData() const = 0;
+	};
+
+	using AssetDataPtr = std::shared_ptr<const IAssetData>;
+
+	class GKAPI BufferAssetData final : public IAssetData {
+	public:
+		explicit BufferAssetData(std::vector<uint8_t> data)
+			: m_data(std::move(data))
+		{
+		}
+
+		[[nodiscard]] std::span<const uint8_t> GetData() const override { return m_data; }
+
+	private:
+		const std::vector<uint8_t> m_data;
+	};
+
 	class GKAPI IAssetSource {
 	public:
 		virtual ~IAssetSource() = default;
 		virtual void ReadData(const std::string& assetName, std::vector<uint8_t>& data) const = 0;
+
+		// Sources able to map their storage override this to avoid copying
+		[[nodiscard]] virtual AssetDataPtr OpenData(const std::string& assetName) const
+		{
+			std::vector<uint8_t> data;
+			ReadData(assetName, data);
+			return std::make_shared<BufferAssetData>(std::move(data));
+		}
 	};
 
 	class GKAPI ISerializedAsset {
 	public:
 		virtual ~ISerializedAsset() = default;
 
-		virtual void Deserialize(const std::type_index& assetType, std::any& object) = 0;
+		// Deserializes in place, object has to point to an instance of assetType
+		virtual void Deserialize(const std::type_index& assetType, void* object) = 0;
 
-		virtual void ReadData(std::vector<uint8_t>& data) const = 0;
+		// Raw bytes of the asset, valid as long as the asset is alive
+		[[nodiscard]] virtual std::span<const uint8_t> GetData() const = 0;
+
+		virtual void ReadData(std::vector<uint8_t>& data) const
+		{
+			const std::span<const uint8_t> source = GetData();
+			data.insert(data.end(), source.begin(), source.end());
+		}
+
+		template <class T> void DeserializeInto(T& object) { Deserialize(typeid(T), &object); }
 
 		template <class T> T DeserializeAs()
 		{
-			std::any object = T();
-			Deserialize(typeid(T), object);
-			return std::any_cast<T>(object);
+			T object {};
+			DeserializeInto(object);
+			return object;
 		}
 	};
 
@@ -67,9 +110,7 @@ namespace Grafkit::Asset {
 
 		[[nodiscard]] SerializedAssetPtr Load(const std::string& assetName) const override
 		{
-			std::vector<uint8_t> data;
-			AssetSourceT::ReadData(assetName, data);
-			return std::make_shared<SerializedAssetT>(std::move(data));
+			return std::make_shared<SerializedAssetT>(AssetSourceT::OpenData(assetName));
 		}
 	};
 
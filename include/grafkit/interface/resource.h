@@ -2,11 +2,26 @@
 #define GRAFKIT_BUILDER_H
 
 #include <grafkit/common.h>
+#include <grafkit/core/log.h>
+#include <grafkit/interface/asset.h>
+#include <grafkit/resource/cook_cache.h>
+#include <grafkit/utils/concurrent_map.hpp>
 
+#include <atomic>
+#include <deque>
+#include <exception>
 #include <fstream>
 #include <functional>
+#include <future>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <span>
 #include <string>
+#include <thread>
 #include <typeindex>
+#include <unordered_set>
+#include <vector>
 
 namespace Grafkit::Asset
 {
@@ -14,12 +29,48 @@ namespace Grafkit::Asset
 	using IAssetLoaderRef = Grafkit::RefWrapper<IAssetLoader>;
 } // namespace Grafkit::Asset
 
+namespace Grafkit::Utils
+{
+	class ThreadPool;
+} // namespace Grafkit::Utils
+
 namespace Grafkit::Resource
 {
 	class ResourceManager;
 	using ResourceManagerPtr = std::unique_ptr<ResourceManager>;
 	using ResourceManagerRef = Grafkit::RefWrapper<ResourceManager>;
 
+	// A resource as it is stored in the resource manager
+	struct ResourceId
+	{
+		std::type_index type;
+		std::string name;
+
+		bool operator==(const ResourceId &other) const = default;
+	};
+
+	struct ResourceIdHash
+	{
+		size_t operator()(const ResourceId &id) const
+		{
+			return std::hash<std::type_index>{}(id.type) ^ (std::hash<std::string>{}(id.name) * 31);
+		}
+	};
+
+	// Memory held by a resource, builders report it so the resource manager can keep to its budgets
+	struct ResourceUsage
+	{
+		size_t cpuBytes = 0;
+		size_t gpuBytes = 0;
+	};
+
+	// No limits by default
+	struct MemoryBudget
+	{
+		size_t cpuBytes = std::numeric_limits<size_t>::max();
+		size_t gpuBytes = std::numeric_limits<size_t>::max();
+	};
+
 	// MARK: Resource Loader Interface
 	class GKAPI IResourceLoader
 	{
@@ -33,9 +84,38 @@ namespace Grafkit::Resource
 		[[nodiscard]] virtual bool ResolveDependencies(const RefWrapper<ResourceManager> &resources) = 0;
 		virtual void Build(const Core::DeviceRef &device) = 0;
 
+		// Resources ResolveDependencies is going to look up by name, the BuildScheduler orders builds by them
+		[[nodiscard]] virtual std::vector<ResourceId> GetDependencies() const
+		{
+			return {};
+		}
+
+		// Memory the built resource holds on to, called after Build
+		[[nodiscard]] virtual ResourceUsage GetUsage() const
+		{
+			return {};
+		}
+
 		[[nodiscard]] virtual std::shared_ptr<void> GetResource() const = 0;
 	};
 
+	using IResourceLoaderPtr = std::shared_ptr<IResourceLoader>;
+
+	/**
+	 * @brief Builders doing expensive CPU side work implement it to have their result kept in a CookCache
+	 * Both are called from a worker thread, before ResolveDependencies and Build.
+	 */
+	class GKAPI ICookable
+	{
+	public:
+		virtual ~ICookable() = default;
+
+		// Does the CPU side work of Build and returns its result in a self contained binary form
+		[[nodiscard]] virtual std::vector<uint8_t> Cook() = 0;
+		// Restores the state of the builder from Cook()'s result instead of the descriptor
+		virtual void LoadCooked(std::span<const uint8_t> data) = 0;
+	};
+
 	template <class DescriptorT, class ResourceT>
 	class GKAPI ResourceBuilder : public IResourceLoader
 	{
@@ -50,6 +130,11 @@ namespace Grafkit::Resource
 		{
 		}
 
+		explicit ResourceBuilder(DescriptorType &&desc)
+			: m_descriptor(std::move(desc))
+		{
+		}
+
 		[[nodiscard]] ResourcePtr BuildResource(const Core::DeviceRef &device,
 			const RefWrapper<ResourceManager> &resources)
 		{
@@ -92,6 +177,10 @@ namespace Grafkit::Resource
 	{
 	public:
 		using LoaderFunc = std::function<bool(std::shared_ptr<void> &, const std::string &, ResourceManager &)>;
+		// Creates a builder from an asset; runs on a worker thread, must not touch the device
+		// The cache is optional, it is null when the resource manager has none
+		using BuilderFunc =
+			std::function<IResourceLoaderPtr(const Asset::IAssetLoader &, const std::string &, const CookCache *)>;
 
 		static ResourceLoaderRegistry &Instance()
 		{
@@ -106,18 +195,88 @@ namespace Grafkit::Resource
 		}
 		LoaderFunc GetLoader(std::type_index type) const;
 
+		// Registers a builder for its resource type; the asset is deserialized into the builder's descriptor
+		// Cookable builders skip deserialization when the cache has an up to date entry of the asset
+		// Registration is not synchronized, register everything before loading
+		template <typename BuilderT>
+		void RegisterBuilder()
+		{
+			m_builders[typeid(typename BuilderT::ResourceType)] =
+				[](const Asset::IAssetLoader &loader, const std::string &name, const CookCache *cache)
+				-> IResourceLoaderPtr
+			{
+				const Asset::SerializedAssetPtr asset = loader.Load(name);
+				if constexpr (std::is_base_of_v<ICookable, BuilderT>)
+				{
+					if (cache != nullptr)
+					{
+						return LoadCookedBuilder<BuilderT>(*cache, name, *asset);
+					}
+				}
+
+				typename BuilderT::DescriptorType descriptor{};
+				asset->DeserializeInto(descriptor);
+				return std::make_shared<BuilderT>(std::move(descriptor));
+			};
+		}
+		BuilderFunc GetBuilder(std::type_index type) const;
+
 	private:
 		ResourceLoaderRegistry() = default;
+
+		template <typename BuilderT>
+		static IResourceLoaderPtr LoadCookedBuilder(const CookCache &cache,
+			const std::string &name,
+			Asset::ISerializedAsset &asset)
+		{
+			// Builder type and asset name are part of the key, so entries of different builders never mix up
+			const uint64_t key = CookCache::Hash(
+				asset.GetData(), CookCache::Hash(name, CookCache::Hash(std::string_view(typeid(BuilderT).name()))));
+
+			if (const auto cooked = cache.Load(name, key); cooked.has_value())
+			{
+				auto builder = std::make_shared<BuilderT>(typename BuilderT::DescriptorType{});
+				builder->LoadCooked(*cooked);
+				return builder;
+			}
+
+			typename BuilderT::DescriptorType descriptor{};
+			asset.DeserializeInto(descriptor);
+			auto builder = std::make_shared<BuilderT>(std::move(descriptor));
+
+			// The cache only saves time on the next start, a load does not fail because it could not be written
+			try
+			{
+				cache.Store(name, key, builder->Cook());
+			}
+			catch (const std::exception &e)
+			{
+				Core::Log::Instance().Warning("Failed to store cooked asset %s: %s", name.c_str(), e.what());
+			}
+			return builder;
+		}
+
 		std::unordered_map<std::type_index, LoaderFunc> m_loaders;
+		std::unordered_map<std::type_index, BuilderFunc> m_builders;
 	};
 
+	template <typename T>
+	using ResourceFuture = std::shared_future<std::shared_ptr<T>>;
+
+	template <typename T>
+	using ResourceCallback = std::function<void(const std::shared_ptr<T> &)>;
+
 	class ResourceManager
 	{
 	public:
-		explicit ResourceManager(const Asset::IAssetLoaderRef loader)
-			: m_loader(loader)
-		{
-		}
+		// Zero worker count picks one per hardware thread
+		explicit ResourceManager(const Asset::IAssetLoaderRef loader, size_t workerCount = 0);
+		~ResourceManager();
+
+		ResourceManager(const ResourceManager &) = delete;
+		ResourceManager &operator=(const ResourceManager &) = delete;
+		ResourceManager(ResourceManager &&) = delete;
+		ResourceManager &operator=(ResourceManager &&) = delete;
 
 		// Template method to load different types of assets
 		template <typename T>
@@ -127,31 +286,210 @@ namespace Grafkit::Resource
 			ResourceLoaderRegistry::LoaderFunc loader = ResourceLoaderRegistry::Instance().GetLoader(typeid(T));
 			if (loader && loader(asset, filename, *this))
 			{
-				m_resources[typeid(T)][filename] = asset;
+				Store(typeid(T), filename, asset, {}, false);
 				return std::static_pointer_cast<T>(asset);
 			}
 			return nullptr;
 		}
 
-		// Template method to get different types of assets
+		/**
+		 * @brief Loads a resource in the background
+		 *
+		 * Reading and deserializing the asset runs on a worker thread. Building the resource happens in Update()
+		 * once its dependencies are available, the callback is invoked from there as well. On failure the future
+		 * holds the exception and the callback receives nullptr.
+		 * LoadAsync and Update are expected to be called from the same thread.
+		 */
 		template <typename T>
-		std::shared_ptr<T> Get(const std::string &name) const
+		ResourceFuture<T> LoadAsync(const std::string &name, ResourceCallback<T> callback = {})
 		{
-			auto typeAssets = m_resources.find(typeid(T));
-			if (typeAssets != m_resources.end())
+			auto promise = std::make_shared<std::promise<std::shared_ptr<T>>>();
+			ResourceFuture<T> future = promise->get_future().share();
+
+			auto completion = [promise, callback = std::move(callback)](
+								  const std::shared_ptr<void> &resource, std::exception_ptr error)
 			{
-				auto it = typeAssets->second.find(name);
-				if (it != typeAssets->second.end())
+				const std::shared_ptr<T> typedResource = error ? nullptr : std::static_pointer_cast<T>(resource);
+				if (error)
 				{
-					return std::static_pointer_cast<T>(it->second);
+					promise->set_exception(error);
 				}
-			}
-			return nullptr;
+				else
+				{
+					promise->set_value(typedResource);
+				}
+				if (callback)
+				{
+					callback(typedResource);
+				}
+			};
+
+			EnqueueLoad(typeid(T), name, std::move(completion));
+			return future;
+		}
+
+		/**
+		 * @brief Builds resources loaded by LoadAsync and fires their callbacks
+		 * Call it once per frame from the thread that owns the device.
+		 */
+		void Update(const Core::DeviceRef &device);
+
+		[[nodiscard]] size_t GetPendingCount() const { return m_pendingCount.load(); }
+
+		// Cooked results of cookable builders are kept here between runs; set it before loading anything
+		void SetCookCache(CookCachePtr cache) { m_cookCache = std::move(cache); }
+
+		// Stores a resource built outside of the manager, so builders can refer to it by name; it is never evicted
+		template <typename T>
+		void Add(const std::string &name, std::shared_ptr<T> resource, const ResourceUsage &usage = {})
+		{
+			Add(typeid(T), name, std::move(resource), usage);
+		}
+
+		void Add(const std::type_index type,
+			const std::string &name,
+			std::shared_ptr<void> resource,
+			const ResourceUsage &usage = {})
+		{
+			Store(type, name, std::move(resource), usage, false);
+		}
+
+		// Safe to call from any thread
+		[[nodiscard]] bool Contains(const ResourceId &id) const { return m_resources.Find(id) != nullptr; }
+
+		// Template method to get different types of assets
+		// An evicted resource is loaded again in the background, it is available after an Update() or two
+		// Safe to call from any thread, builders may look up their dependencies from workers
+		template <typename T>
+		std::shared_ptr<T> Get(const std::string &name)
+		{
+			return std::static_pointer_cast<T>(Get(typeid(T), name));
+		}
+
+		std::shared_ptr<void> Get(std::type_index type, const std::string &name);
+
+		/**
+		 * @brief Limits the memory resources may use, globally or per resource type
+		 *
+		 * Update() evicts resources once a budget is exceeded, least recently used first. Only resources loaded by
+		 * LoadAsync that nothing else refers to are evicted; asking for them again reloads them.
+		 */
+		void SetMemoryBudget(const MemoryBudget &budget) { m_budget = budget; }
+
+		template <typename T>
+		void SetMemoryBudget(const MemoryBudget &budget)
+		{
+			m_typeBudgets[typeid(T)] = budget;
+		}
+
+		[[nodiscard]] ResourceUsage GetMemoryUsage() const { return m_usage; }
+
+		template <typename T>
+		[[nodiscard]] ResourceUsage GetMemoryUsage() const
+		{
+			const auto it = m_typeUsages.find(typeid(T));
+			return it != m_typeUsages.end() ? it->second : ResourceUsage{};
 		}
 
+		// Evicts until every budget is met or nothing is left to evict
+		void EnforceBudgets();
+
+		using ReloadCallback = std::function<void(const ResourceId &, const std::shared_ptr<void> &)>;
+
+		/**
+		 * @brief Rebuilds the resources loaded from an asset along with everything depending on them
+		 *
+		 * Assets are read and deserialized on the workers again. Once every builder is ready, Update() builds the new
+		 * resources against each other and swaps all of them in at once; if any of them fails the old ones stay.
+		 * Replaced resources are kept alive until the frames in flight are done with them. Reload callbacks receive
+		 * the new resources, to replace the ones held elsewhere.
+		 */
+		void Reload(const std::string &name);
+
+		void AddReloadCallback(ReloadCallback callback) { m_reloadCallbacks.push_back(std::move(callback)); }
+
+		// Replaced resources are released this many Update() calls later
+		void SetFramesInFlight(const uint32_t frameCount) { m_framesInFlight = frameCount; }
+
 	private:
+		using CompletionFunc = std::function<void(const std::shared_ptr<void> &, std::exception_ptr)>;
+
+		struct ReloadBatch;
+
+		struct LoadJob
+		{
+			std::type_index type;
+			std::string name;
+			CompletionFunc completion;
+			IResourceLoaderPtr builder;
+			std::shared_ptr<void> resource;
+			std::exception_ptr error;
+			// Taken before resolving them, builders stop reporting what they have already resolved
+			std::vector<ResourceId> dependencies;
+			ReloadBatch *batch;
+		};
+		using LoadJobPtr = std::shared_ptr<LoadJob>;
+
+		struct ReloadBatch
+		{
+			std::vector<LoadJobPtr> jobs;
+			size_t preparedCount = 0;
+		};
+
+		// Replaced as a whole on store, only lastUsed changes afterwards
+		struct ResourceEntry
+		{
+			std::shared_ptr<void> resource;
+			ResourceUsage usage;
+			std::atomic<uint64_t> lastUsed = 0;
+			// Loaded through a builder, so it can be evicted and reloaded
+			bool isReloadable = false;
+			std::vector<ResourceId> dependencies;
+		};
+
+		void EnqueueLoad(std::type_index type, const std::string &name, CompletionFunc completion);
+		// Creates the builder of the job on a worker
+		void Prepare(const LoadJobPtr &job);
+		void CompleteLoad(const LoadJobPtr &job);
+		void ApplyReload(ReloadBatch &batch, const Core::DeviceRef &device);
+
+		void Store(std::type_index type,
+			const std::string &name,
+			std::shared_ptr<void> resource,
+			const ResourceUsage &usage,
+			bool isReloadable,
+			std::vector<ResourceId> dependencies = {});
+		// Evicts resources of the given type, or of any type without one, until the usage fits the budget
+		void Evict(const std::optional<std::type_index> &type, const MemoryBudget &budget);
+
 		const Asset::IAssetLoaderRef m_loader;
-		std::unordered_map<std::type_index, std::unordered_map<std::string, std::shared_ptr<void>>> m_resources;
+		CookCachePtr m_cookCache;
+		Utils::ConcurrentMap<ResourceId, ResourceEntry, ResourceIdHash> m_resources;
+		std::mutex m_evictedMutex;
+		std::unordered_map<std::type_index, std::unordered_set<std::string>> m_evicted;
+		std::atomic<uint64_t> m_useCounter = 0;
+
+		MemoryBudget m_budget;
+		std::unordered_map<std::type_index, MemoryBudget> m_typeBudgets;
+		ResourceUsage m_usage;
+		std::unordered_map<std::type_index, ResourceUsage> m_typeUsages;
+
+		std::deque<std::unique_ptr<ReloadBatch>> m_reloads;
+		// Results of the reload being applied, Get() prefers them so dependents are built against the new versions
+		// Only the thread applying the reload sees them, others keep getting the current ones until the swap
+		std::unordered_map<std::type_index, std::unordered_map<std::string, std::shared_ptr<void>>> m_staging;
+		std::atomic<std::thread::id> m_stagingThread;
+		std::deque<std::pair<uint64_t, std::shared_ptr<void>>> m_retired;
+		std::vector<ReloadCallback> m_reloadCallbacks;
+		uint64_t m_frameIndex = 0;
+		uint32_t m_framesInFlight = 2;
+
+		std::mutex m_preparedMutex;
+		std::deque<LoadJobPtr> m_prepared; // Deserialized on a worker, waiting to be built
+		std::deque<LoadJobPtr> m_waiting;  // Waiting for dependencies, touched from Update() only
+		std::atomic<size_t> m_pendingCount = 0;
+
+		std::unique_ptr<Utils::ThreadPool> m_workers;
 	};
 
 	// Mixins
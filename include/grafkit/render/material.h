@@ -78,12 +78,13 @@ namespace Grafkit
 						},
 					},
 				},
+				// The camera is pushed to the uniform allocator every frame, bound at its dynamic offset
 				{
 					CAMERA_VIEW_SET,
 					{
 						{
 							MODEL_VIEW_BINDING,
-							VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+							VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
 							VK_SHADER_STAGE_VERTEX_BIT,
 						},
 					},
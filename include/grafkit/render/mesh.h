@@ -3,13 +3,17 @@
 
 #include <grafkit/common.h>
 
+#include <functional>
 #include <memory>
+#include <span>
 #include <tuple>
 #include <unordered_map>
 #include <vector>
 
 #include "grafkit/core/buffer.h"
+#include "grafkit/core/geometry_arena.h"
 #include "grafkit/render/mesh.h"
+#include "grafkit/render/meshlet.h"
 
 namespace Grafkit
 {
@@ -22,6 +26,7 @@ namespace Grafkit
 	GKAPI struct ModelView
 	{
 		alignas(16) glm::mat4 model;
+		alignas(16) glm::mat4 positionTransform; // Packed positions to model space, identity for float vertices
 	};
 
 	GKAPI struct Vertex
@@ -75,26 +80,41 @@ namespace Grafkit
 		}
 	};
 
+	// Layout of the vertex buffer of a mesh, see grafkit/render/vertex_packing.h
+	enum class VertexFormat : uint32_t
+	{
+		Float = 0,	 // Vertex
+		Snorm16 = 1, // CompactVertex, positions normalized to the bounds of the mesh
+		Half = 2,	 // HalfVertex, positions relative to the center of the mesh
+	};
+
 	GKAPI struct Primitive
 	{
 		uint32_t id = 0;
-		uint32_t firstIndex = 0;
+		uint32_t firstIndex = 0; // In elements of the index type
 		uint32_t indexCount = 0;
 		uint32_t vertexOffset = 0;
 		uint32_t vertexCount = 0;
 		uint32_t materialId = 0;
+		VkIndexType indexType = VK_INDEX_TYPE_UINT32; // 16 bit when the primitive has few enough vertices
+		uint32_t firstMeshlet = 0;
+		uint32_t meshletCount = 0; // None when the primitive was not clustered
 	};
 
 	GKAPI class Mesh
 	{
 	public:
 		// friend class Scenegraph;
+		// Takes over the geometry, it is freed along with the mesh
 		Mesh(const Core::DeviceRef &device,
 			uint32_t id,
-			const Core::Buffer &vertexBuffer,
-			const Core::Buffer &indexBuffer,
+			Core::GeometryArena::Handle geometry,
 			std::vector<Primitive> primitives,
-			std::unordered_map<uint32_t, MaterialPtr> materials);
+			std::unordered_map<uint32_t, MaterialPtr> materials,
+			VertexFormat vertexFormat = VertexFormat::Float,
+			const glm::mat4 &positionTransform = glm::mat4(1.0f),
+			std::vector<Meshlet> meshlets = {},
+			uint64_t uploadTicket = 0);
 
 		virtual ~Mesh();
 
@@ -105,14 +125,28 @@ namespace Grafkit
 			return m_primitives;
 		}
 
-		[[nodiscard]] inline const Core::Buffer GetVertexBuffer() const noexcept
+		/**
+		 * @brief Where the vertices and indices are in the geometry arena of the device
+		 * Primitives are relative to these: the first vertex of one is at vertexOffset / stride + its vertex offset,
+		 * its first index at indexOffset / index size + its first index. They move when the arena is defragmented.
+		 */
+		[[nodiscard]] Core::GeometryRange GetGeometry() const;
+
+		[[nodiscard]] inline VertexFormat GetVertexFormat() const noexcept
+		{
+			return m_vertexFormat;
+		}
+
+		// Maps the positions of the vertex buffer to model space, identity unless they are quantized
+		[[nodiscard]] inline const glm::mat4 &GetPositionTransform() const noexcept
 		{
-			return m_vertexBuffer;
+			return m_positionTransform;
 		}
 
-		[[nodiscard]] inline const Core::Buffer GetIndexBuffer() const noexcept
+		// Meshlets of a primitive, in the order they are in the index buffer
+		[[nodiscard]] inline std::span<const Meshlet> GetMeshlets(const Primitive &primitive) const noexcept
 		{
-			return m_indexBuffer;
+			return std::span<const Meshlet>(m_meshlets).subspan(primitive.firstMeshlet, primitive.meshletCount);
 		}
 
 		[[nodiscard]] inline const MaterialPtr GetMaterial(const uint32_t materalId) const noexcept
@@ -126,14 +160,42 @@ namespace Grafkit
 			std::vector<Primitive> primitives,
 			std::unordered_map<uint32_t, MaterialPtr> materials = {});
 
+		// Takes buffers already in their final layout; indices are mixed 16 and 32 bit as the primitives say
+		static MeshPtr Create(const Core::DeviceRef &device,
+			std::span<const uint8_t> vertexData,
+			std::span<const uint8_t> indexData,
+			std::vector<Primitive> primitives,
+			std::unordered_map<uint32_t, MaterialPtr> materials = {},
+			VertexFormat vertexFormat = VertexFormat::Float,
+			const glm::mat4 &positionTransform = glm::mat4(1.0f),
+			std::vector<Meshlet> meshlets = {});
+
+		using DataWriter = std::function<void(std::span<uint8_t> vertexData, std::span<uint8_t> indexData)>;
+
+		// Geometry of the given sizes in the arena; the writer fills its staging in the final layout, which is
+		// copied over with the next batch of uploads
+		static MeshPtr Create(const Core::DeviceRef &device,
+			size_t vertexDataSize,
+			size_t indexDataSize,
+			const DataWriter &writer,
+			std::vector<Primitive> primitives,
+			std::unordered_map<uint32_t, MaterialPtr> materials = {},
+			VertexFormat vertexFormat = VertexFormat::Float,
+			const glm::mat4 &positionTransform = glm::mat4(1.0f),
+			std::vector<Meshlet> meshlets = {});
+
 	private:
 		const Core::DeviceRef m_device;
 		uint32_t m_id = 0;
-		Core::Buffer m_vertexBuffer{};
-		Core::Buffer m_indexBuffer{};
+		Core::GeometryArena::Handle m_geometry = Core::GeometryArena::INVALID_HANDLE;
 
 		std::vector<Primitive> m_primitives = {};
 		std::unordered_map<uint32_t, MaterialPtr> m_materials = {};
+
+		VertexFormat m_vertexFormat = VertexFormat::Float;
+		glm::mat4 m_positionTransform = glm::mat4(1.0f);
+		std::vector<Meshlet> m_meshlets = {};
+		uint64_t m_uploadTicket = 0; // Of the copies filling the geometry, see Core::UploadManager
 	};
 
 	GKAPI class FullScreenQuad
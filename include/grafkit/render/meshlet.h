@@ -0,0 +1,102 @@
+#ifndef GRAFKIT_MESHLET_H
+#define GRAFKIT_MESHLET_H
+
+#include <array>
+#include <span>
+#include <vector>
+
+#include <grafkit/common.h>
+
+namespace Grafkit
+{
+	struct Primitive;
+
+	/**
+	 * @brief Cluster of adjacent triangles of a primitive, with the bounds to cull it by
+	 *
+	 * Triangles of a clustered primitive are stored meshlet by meshlet in the index buffer, so a meshlet is a
+	 * contiguous range of it. The same limits fit a task / mesh shader workgroup.
+	 */
+	struct Meshlet
+	{
+		static constexpr uint32_t MAX_VERTICES = 64;
+		static constexpr uint32_t MAX_TRIANGLES = 124;
+
+		uint32_t vertexOffset = 0;	 // Into the vertex list of the clustering, see MeshletData
+		uint32_t triangleOffset = 0; // Within the primitive, three times of it is the first index of the meshlet
+		uint32_t vertexCount = 0;
+		uint32_t triangleCount = 0;
+
+		// Bounding sphere, in the space of the vertices
+		glm::vec3 center = glm::vec3(0.0f);
+		float radius = 0.0f;
+
+		// Normal cone; the sine of its half angle, 1 when the triangles face too many ways to ever be culled
+		glm::vec3 coneAxis = glm::vec3(0.0f, 0.0f, 1.0f);
+		float coneCutoff = 1.0f;
+	};
+
+	// Contiguous part of the index buffer to draw
+	struct DrawRange
+	{
+		uint32_t firstIndex = 0;
+		uint32_t indexCount = 0;
+	};
+
+	struct MeshletCullStats
+	{
+		size_t meshletCount = 0;
+		size_t frustumCulled = 0;
+		size_t backfaceCulled = 0;
+	};
+
+	/**
+	 * @brief Drops meshlets outside of the view frustum, or having all of their triangles facing away
+	 * The view is set in the space of the vertices, so meshlets of a mesh are tested without transforming them.
+	 */
+	class GKAPI MeshletCuller
+	{
+	public:
+		/**
+		 * @brief Sets the view to test against
+		 * @param modelViewProjection Takes the vertices of the mesh to clip space, with a [-1, 1] depth range
+		 * @param cameraPosition In the space of the vertices, that is with the inverse model matrix applied
+		 */
+		void SetView(const glm::mat4 &modelViewProjection, const glm::vec3 &cameraPosition);
+
+		// Set it off for two sided materials
+		void SetBackfaceCulling(const bool isEnabled)
+		{
+			m_isBackfaceCulling = isEnabled;
+		}
+
+		[[nodiscard]] bool IsInFrustum(const Meshlet &meshlet) const;
+		[[nodiscard]] bool IsBackfacing(const Meshlet &meshlet) const;
+
+		/**
+		 * @brief Appends the index ranges of the visible meshlets of a primitive, neighbouring ones merged
+		 * Primitives without meshlets are appended whole.
+		 */
+		void Cull(const Primitive &primitive, std::span<const Meshlet> meshlets, std::vector<DrawRange> &ranges);
+
+		[[nodiscard]] const MeshletCullStats &GetStats() const
+		{
+			return m_stats;
+		}
+
+		void ResetStats()
+		{
+			m_stats = {};
+		}
+
+	private:
+		// Left, right, bottom, top, near, far; normals point inwards
+		std::array<glm::vec4, 6> m_planes{};
+		glm::vec3 m_cameraPosition = glm::vec3(0.0f);
+		bool m_isBackfaceCulling = true;
+		MeshletCullStats m_stats{};
+	};
+
+} // namespace Grafkit
+
+#endif // GRAFKIT_MESHLET_H
@@ -44,6 +44,8 @@ namespace Grafkit
 		NodePtr CreateNode(const MeshPtr &mesh, const NodePtr &parent = nullptr); // TODO: Add bone
 
 		void AddDescriptorSet(const uint32_t set, const Core::DescriptorSetPtr &descriptorSet);
+		// For the dynamic bindings of a set, in binding order; they change every frame along with the uniforms
+		void SetDynamicOffsets(const uint32_t set, std::vector<uint32_t> offsets);
 
 		void Update(const Grafkit::TimeInfo &deltaTime);
 		void
@@ -53,13 +55,15 @@ namespace Grafkit
 		struct DrawCommand
 		{
 			std::vector<Core::DescriptorSetPtr> descriptorSets{};
-			VkBuffer vertexBuffer = VK_NULL_HANDLE;
-			VkBuffer indexBuffer = VK_NULL_HANDLE;
-			uint32_t firstIndex = 0;
+			VkBuffer geometryBuffer = VK_NULL_HANDLE; // Holds both the vertices and the indices
+			VkIndexType indexType = VK_INDEX_TYPE_UINT32;
+			uint32_t firstIndex = 0; // From the start of the buffer, as is the vertex offset
 			uint32_t indexCount = 0;
 			uint32_t vertexOffset = 0;
 			uint32_t instanceCount = 0;
 			NodePtr node = nullptr;
+			// Dequantizes packed positions, pushed next to the model matrix on draw
+			glm::mat4 positionTransform = glm::mat4(1.0f);
 		};
 
 		void UpdateRenderGraph();
@@ -71,8 +75,10 @@ namespace Grafkit
 		std::vector<std::pair<RenderStagePtr, std::vector<DrawCommand>>> m_commandList;
 
 		std::map<uint32_t, Core::DescriptorSetPtr> m_descriptorSets;
+		std::map<uint32_t, std::vector<uint32_t>> m_dynamicOffsets;
 
 		bool m_isDirty = true;
+		uint64_t m_geometryGeneration = 0; // Of the arena the draw commands were built in
 	};
 
 } // namespace Grafkit
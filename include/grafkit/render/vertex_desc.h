@@ -0,0 +1,79 @@
+/**
+ * @file vertex_desc.h
+ * @brief vertex_desc descriptor
+ *
+ * This file has been automatically generated and should not be modified.
+ *
+ * Generated on: 2026-10-19 11:27:20
+ * Source file:
+ */
+
+#ifndef __VERTEX_DESC_GENERATED_H__
+#define __VERTEX_DESC_GENERATED_H__
+
+#include <array>
+#include <cstddef>
+#include <grafkit/common.h>
+#include <type_traits>
+
+/* vertex_desc */
+namespace Grafkit
+{
+	struct CompactVertex
+	{
+		std::array<int16_t, 4> position; // w is padding
+		std::array<uint8_t, 4> color;
+		std::array<uint16_t, 2> uv;
+		std::array<int16_t, 2> normal;	// Octahedral
+		std::array<int16_t, 2> tangent; // Octahedral
+
+		static inline Core::VertexDescription GetVertexDescription(const uint32_t inputBinding = 0,
+			const uint32_t vertexBinding = 0)
+		{
+			return {
+				.bindings = {{inputBinding, sizeof(CompactVertex), VK_VERTEX_INPUT_RATE_VERTEX}},
+				.attributes =
+					{
+						{0, vertexBinding, VK_FORMAT_R16G16B16A16_SNORM, offsetof(CompactVertex, position)},
+						{1, vertexBinding, VK_FORMAT_R8G8B8A8_UNORM, offsetof(CompactVertex, color)},
+						{2, vertexBinding, VK_FORMAT_R16G16_UNORM, offsetof(CompactVertex, uv)},
+						{3, vertexBinding, VK_FORMAT_R16G16_SNORM, offsetof(CompactVertex, normal)},
+						{4, vertexBinding, VK_FORMAT_R16G16_SNORM, offsetof(CompactVertex, tangent)},
+					},
+			};
+		}
+	};
+	static_assert(std::is_standard_layout_v<CompactVertex> && std::is_trivially_copyable_v<CompactVertex>,
+		"CompactVertex is read in place from mapped memory");
+	static_assert(sizeof(CompactVertex) == 24, "CompactVertex binary layout has changed");
+
+	struct HalfVertex
+	{
+		std::array<uint16_t, 4> position; // w is padding
+		std::array<uint8_t, 4> color;
+		std::array<uint16_t, 2> uv;
+		std::array<int16_t, 2> normal;	// Octahedral
+		std::array<int16_t, 2> tangent; // Octahedral
+
+		static inline Core::VertexDescription GetVertexDescription(const uint32_t inputBinding = 0,
+			const uint32_t vertexBinding = 0)
+		{
+			return {
+				.bindings = {{inputBinding, sizeof(HalfVertex), VK_VERTEX_INPUT_RATE_VERTEX}},
+				.attributes =
+					{
+						{0, vertexBinding, VK_FORMAT_R16G16B16A16_SFLOAT, offsetof(HalfVertex, position)},
+						{1, vertexBinding, VK_FORMAT_R8G8B8A8_UNORM, offsetof(HalfVertex, color)},
+						{2, vertexBinding, VK_FORMAT_R16G16_UNORM, offsetof(HalfVertex, uv)},
+						{3, vertexBinding, VK_FORMAT_R16G16_SNORM, offsetof(HalfVertex, normal)},
+						{4, vertexBinding, VK_FORMAT_R16G16_SNORM, offsetof(HalfVertex, tangent)},
+					},
+			};
+		}
+	};
+	static_assert(std::is_standard_layout_v<HalfVertex> && std::is_trivially_copyable_v<HalfVertex>,
+		"HalfVertex is read in place from mapped memory");
+	static_assert(sizeof(HalfVertex) == 24, "HalfVertex binary layout has changed");
+
+} // namespace Grafkit
+#endif // __VERTEX_DESC_GENERATED_H__
@@ -0,0 +1,68 @@
+#ifndef GRAFKIT_VERTEX_PACKING_H
+#define GRAFKIT_VERTEX_PACKING_H
+
+#include <array>
+#include <span>
+#include <vector>
+
+#include <grafkit/common.h>
+#include <grafkit/render/mesh.h>
+#include <grafkit/render/vertex_desc.h>
+
+namespace Grafkit
+{
+	[[nodiscard]] GKAPI uint32_t GetVertexStride(VertexFormat format);
+	[[nodiscard]] GKAPI uint32_t GetIndexSize(VkIndexType indexType);
+	[[nodiscard]] GKAPI Core::VertexDescription GetVertexDescription(VertexFormat format,
+		uint32_t inputBinding = 0,
+		uint32_t vertexBinding = 0);
+
+	// Axis aligned box of the positions, extent is the half size
+	struct PositionBounds
+	{
+		glm::vec3 center = glm::vec3(0.0f);
+		glm::vec3 extent = glm::vec3(1.0f);
+	};
+
+	[[nodiscard]] GKAPI PositionBounds CalculateBounds(std::span<const Vertex> vertices);
+	// Bounds of several vertex ranges together
+	[[nodiscard]] GKAPI PositionBounds CalculateBounds(std::span<const std::span<const Vertex>> ranges);
+
+	/**
+	 * @brief Maps the packed positions back to model space, to be applied before the model matrix
+	 * Snorm16 positions are normalized to the bounds, half-float ones are relative to their center.
+	 */
+	[[nodiscard]] GKAPI glm::mat4 GetPositionTransform(VertexFormat format, const PositionBounds &bounds);
+
+	/**
+	 * @brief Packs vertices into the layout of the format, as the bytes of a vertex buffer
+	 * UVs are clamped to [0, 1]. Vertex has no tangent, packed layouts get one perpendicular to the normal.
+	 */
+	[[nodiscard]] GKAPI std::vector<uint8_t> PackVertices(std::span<const Vertex> vertices,
+		VertexFormat format,
+		const PositionBounds &bounds);
+
+	// Packs into memory of the caller, such as a mapped buffer; it has to hold a stride for every vertex
+	GKAPI void PackVertices(std::span<const Vertex> vertices,
+		VertexFormat format,
+		const PositionBounds &bounds,
+		std::span<uint8_t> destination);
+
+	// Scalar encodings of the packed layouts, they match what the vertex input of the GPU decodes
+	namespace VertexPacking
+	{
+		[[nodiscard]] GKAPI int16_t PackSnorm16(float value);
+		[[nodiscard]] GKAPI uint16_t PackUnorm16(float value);
+		[[nodiscard]] GKAPI uint8_t PackUnorm8(float value);
+
+		[[nodiscard]] GKAPI uint16_t PackHalf(float value);
+		[[nodiscard]] GKAPI float UnpackHalf(uint16_t value);
+
+		// Unit vectors folded onto an octahedron, see grafkit/shaders/vertex_decode.glsl for decoding on the GPU
+		[[nodiscard]] GKAPI std::array<int16_t, 2> PackOctahedral(const glm::vec3 &direction);
+		[[nodiscard]] GKAPI glm::vec3 UnpackOctahedral(const std::array<int16_t, 2> &packed);
+	} // namespace VertexPacking
+
+} // namespace Grafkit
+
+#endif // GRAFKIT_VERTEX_PACKING_H
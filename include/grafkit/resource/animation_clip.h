@@ -0,0 +1,72 @@
+#ifndef GRAFKIT_ANIMATION_CLIP_H
+#define GRAFKIT_ANIMATION_CLIP_H
+
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include <grafkit/common.h>
+#include <grafkit/descriptors/animation_desc.h>
+
+namespace Grafkit::Resource
+{
+	constexpr uint32_t ANIMATION_CLIP_MAGIC = 0x43414B47; // 'GKAC'
+	constexpr uint32_t ANIMATION_CLIP_VERSION = 1;
+
+	// Keys of each channel are padded to a multiple of this by repeating the last key,
+	// so a channel can always be scanned in full SIMD lanes
+	constexpr uint32_t ANIMATION_CLIP_KEY_ALIGNMENT = 4;
+	constexpr uint64_t ANIMATION_CLIP_STREAM_ALIGNMENT = 64;
+
+	constexpr uint32_t ANIMATION_CLIP_FLAG_LOOPING = 1u << 0;
+
+	/**
+	 * @brief Read-only view over a cooked animation clip
+	 *
+	 * The clip is stored as structure of arrays: key times, values and interpolations are separate
+	 * streams, each aligned to a cache line. The view does not copy anything; the underlying memory
+	 * (typically a mapped file) has to outlive it.
+	 */
+	class GKAPI AnimationClipView
+	{
+	public:
+		AnimationClipView() = default;
+		explicit AnimationClipView(std::span<const uint8_t> data);
+
+		[[nodiscard]] const AnimationClipHeader &GetHeader() const { return *m_header; }
+		[[nodiscard]] std::string_view GetName() const;
+		[[nodiscard]] float GetDuration() const { return m_header->duration; }
+		[[nodiscard]] bool IsLooping() const { return (m_header->flags & ANIMATION_CLIP_FLAG_LOOPING) != 0; }
+
+		[[nodiscard]] std::span<const AnimationChannelEntry> GetChannels() const;
+
+		// Padded key streams of a channel; the size is a multiple of ANIMATION_CLIP_KEY_ALIGNMENT
+		[[nodiscard]] std::span<const float> GetKeyTimes(const AnimationChannelEntry &channel) const;
+		[[nodiscard]] std::span<const glm::vec4> GetKeyValues(const AnimationChannelEntry &channel) const;
+		[[nodiscard]] std::span<const KeyInterpolation> GetKeyInterpolations(
+			const AnimationChannelEntry &channel) const;
+
+		// Index of the last key at or before the given time
+		[[nodiscard]] size_t FindKey(const AnimationChannelEntry &channel, float time) const;
+		[[nodiscard]] glm::vec4 Sample(const AnimationChannelEntry &channel, float time) const;
+
+		[[nodiscard]] bool IsValid() const { return m_header != nullptr; }
+
+	private:
+		template <typename T> [[nodiscard]] const T *StreamAt(uint64_t offset) const
+		{
+			return reinterpret_cast<const T *>(m_data.data() + offset);
+		}
+
+		std::span<const uint8_t> m_data;
+		const AnimationClipHeader *m_header = nullptr;
+	};
+
+	/**
+	 * @brief Cooks an authored clip into the binary layout read by AnimationClipView
+	 */
+	[[nodiscard]] GKAPI std::vector<uint8_t> CookAnimationClip(const AnimationClipDesc &desc);
+
+} // namespace Grafkit::Resource
+
+#endif // GRAFKIT_ANIMATION_CLIP_H
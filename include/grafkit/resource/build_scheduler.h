@@ -0,0 +1,94 @@
+#ifndef GRAFKIT_BUILD_SCHEDULER_H
+#define GRAFKIT_BUILD_SCHEDULER_H
+
+#include <map>
+#include <memory>
+#include <string>
+#include <typeindex>
+#include <utility>
+#include <vector>
+
+#include <grafkit/common.h>
+#include <grafkit/interface/resource.h>
+
+namespace Grafkit::Utils
+{
+	class ThreadPool;
+} // namespace Grafkit::Utils
+
+namespace Grafkit::Resource
+{
+	/**
+	 * @brief Builds a set of named loaders in the order of their dependencies
+	 *
+	 * The dependency graph is derived from IResourceLoader::GetDependencies. A dependency is either built by another
+	 * loader of the set or already stored in the resource manager; anything else, and every cycle, is reported before
+	 * a single loader is built.
+	 * Loaders whose dependencies are done build in parallel on worker threads. Resolving dependencies and storing the
+	 * results in the resource manager happens on the thread calling Build.
+	 */
+	class GKAPI BuildScheduler
+	{
+	public:
+		// Zero worker count picks one per hardware thread
+		explicit BuildScheduler(const ResourceManagerRef &resources, size_t workerCount = 0);
+		~BuildScheduler();
+
+		BuildScheduler(const BuildScheduler &) = delete;
+		BuildScheduler &operator=(const BuildScheduler &) = delete;
+		BuildScheduler(BuildScheduler &&) = delete;
+		BuildScheduler &operator=(BuildScheduler &&) = delete;
+
+		// The result is stored in the resource manager under the builder's resource type and the given name
+		template <typename BuilderT>
+		BuildScheduler &Add(const std::string &name, std::shared_ptr<BuilderT> builder)
+		{
+			return Add(typeid(typename BuilderT::ResourceType), name, std::move(builder));
+		}
+
+		BuildScheduler &Add(std::type_index type, const std::string &name, IResourceLoaderPtr loader);
+
+		// Describes every missing dependency and cycle, empty when the loaders can be built
+		[[nodiscard]] std::vector<std::string> Validate() const;
+
+		/**
+		 * @brief Builds every loader added, then forgets about them
+		 * Throws without building anything when Validate() reports a problem. When a build fails no further builds
+		 * are started, the error is rethrown once the ones in flight have finished.
+		 */
+		void Build(const Core::DeviceRef &device);
+
+		[[nodiscard]] size_t GetLoaderCount() const { return m_nodes.size(); }
+
+	private:
+		struct Node
+		{
+			ResourceId id;
+			IResourceLoaderPtr loader;
+		};
+
+		struct Graph
+		{
+			std::vector<std::vector<size_t>> dependencies;
+			std::vector<std::vector<size_t>> dependents;
+		};
+
+		// Links the nodes by their dependencies, problems found are appended to errors
+		[[nodiscard]] Graph MakeGraph(std::vector<std::string> &errors) const;
+
+		void FindCycles(const Graph &graph,
+			size_t index,
+			std::vector<uint8_t> &states,
+			std::vector<size_t> &path,
+			std::vector<std::string> &errors) const;
+
+		const ResourceManagerRef m_resources;
+		std::vector<Node> m_nodes;
+		std::map<std::pair<std::type_index, std::string>, size_t> m_nodeIndices;
+
+		std::unique_ptr<Utils::ThreadPool> m_workers;
+	};
+
+} // namespace Grafkit::Resource
+
+#endif // GRAFKIT_BUILD_SCHEDULER_H
@@ -0,0 +1,58 @@
+#ifndef GRAFKIT_COOK_CACHE_H
+#define GRAFKIT_COOK_CACHE_H
+
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include <grafkit/common.h>
+#include <grafkit/descriptors/cook_desc.h>
+
+namespace Grafkit::Resource
+{
+	constexpr uint32_t COOK_CACHE_MAGIC = 0x43434B47; // 'GKCC'
+	// Bump it when the cooked layout of any builder changes, it invalidates every entry
+	constexpr uint32_t COOK_CACHE_VERSION = 3;
+
+	/**
+	 * @brief Persistent on-disk cache of cooked resources
+	 *
+	 * Every asset has one entry, stored under the hash of its name. An entry is only used when its key matches,
+	 * the key is a hash of the source asset and the builder cooking it, so editing the source invalidates
+	 * it automatically. Stale and corrupt entries are treated as misses and get overwritten on the next store.
+	 * Loading and storing distinct names is safe from multiple threads.
+	 */
+	class GKAPI CookCache
+	{
+	public:
+		explicit CookCache(std::filesystem::path directory);
+
+		CookCache(const CookCache &) = delete;
+		CookCache &operator=(const CookCache &) = delete;
+		CookCache(CookCache &&) = delete;
+		CookCache &operator=(CookCache &&) = delete;
+
+		// FNV-1a, chain calls through the seed to combine hashes
+		[[nodiscard]] static uint64_t Hash(std::span<const uint8_t> data, uint64_t seed = 0xCBF29CE484222325ull);
+		[[nodiscard]] static uint64_t Hash(std::string_view text, uint64_t seed = 0xCBF29CE484222325ull);
+
+		[[nodiscard]] std::optional<std::vector<uint8_t>> Load(std::string_view name, uint64_t key) const;
+		void Store(std::string_view name, uint64_t key, std::span<const uint8_t> data) const;
+
+		// Drops the entry of an asset, if there is any
+		void Invalidate(std::string_view name) const;
+
+		[[nodiscard]] std::filesystem::path GetPath(std::string_view name) const;
+		[[nodiscard]] const std::filesystem::path &GetDirectory() const { return m_directory; }
+
+	private:
+		std::filesystem::path m_directory;
+	};
+
+	using CookCachePtr = std::shared_ptr<CookCache>;
+
+} // namespace Grafkit::Resource
+
+#endif // GRAFKIT_COOK_CACHE_H
@@ -11,13 +11,22 @@
 
 namespace Grafkit::Resource
 {
+	constexpr uint32_t COOKED_IMAGE_FLAG_MIPMAP = 1u << 0;
 
-	class ImageBuilder : public ResourceBuilder<ImageDesc, Core::Image>
+	class ImageBuilder : public ResourceBuilder<ImageDesc, Core::Image>, public ICookable
 	{
 	public:
 		explicit ImageBuilder(const ImageDesc &desc)
 			: ResourceBuilder<ImageDesc, Core::Image>(desc)
 		{
+			ExpandToRgba();
+		}
+
+		// Takes over the pixel data without copying it
+		explicit ImageBuilder(ImageDesc &&desc)
+			: ResourceBuilder<ImageDesc, Core::Image>(std::move(desc))
+		{
+			ExpandToRgba();
 		}
 
 		ImageBuilder(const ImageBuilder &) = delete;
@@ -31,6 +40,14 @@ namespace Grafkit::Resource
 		}
 
 		void Build(const Core::DeviceRef &device) override;
+		[[nodiscard]] ResourceUsage GetUsage() const override;
+
+		[[nodiscard]] std::vector<uint8_t> Cook() override;
+		void LoadCooked(std::span<const uint8_t> data) override;
+
+	private:
+		// RGB has no widely supported Vulkan format, it is expanded in place while still on the loader thread
+		void ExpandToRgba();
 	};
 
 	class SolidImageBuilder : public ResourceBuilder<SolidImageDesc, Core::Image>
@@ -52,9 +69,10 @@ namespace Grafkit::Resource
 		}
 
 		void Build(const Core::DeviceRef &device) override;
+		[[nodiscard]] ResourceUsage GetUsage() const override;
 	};
 
-	class CheckerImageBuilder : public ResourceBuilder<CheckerImageDesc, Core::Image>
+	class CheckerImageBuilder : public ResourceBuilder<CheckerImageDesc, Core::Image>, public ICookable
 	{
 	public:
 		explicit CheckerImageBuilder(const DescriptorType &desc)
@@ -73,6 +91,16 @@ namespace Grafkit::Resource
 		}
 
 		void Build(const Core::DeviceRef &device) override;
+		[[nodiscard]] ResourceUsage GetUsage() const override;
+
+		// The generated pixels are cooked, warm starts skip generating them
+		[[nodiscard]] std::vector<uint8_t> Cook() override;
+		void LoadCooked(std::span<const uint8_t> data) override;
+
+	private:
+		void GenerateBitmap();
+
+		std::vector<uint8_t> m_bitmap;
 	};
 
 } // namespace Grafkit::Resource
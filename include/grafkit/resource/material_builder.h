@@ -32,6 +32,7 @@ namespace Grafkit::Resource
 
 		[[nodiscard]] bool ResolveDependencies(const RefWrapper<ResourceManager> &resources) final;
 		void Build(const Core::DeviceRef &device) final;
+		[[nodiscard]] std::vector<ResourceId> GetDependencies() const final;
 
 	private:
 		RenderStagePtr m_renderStage;
@@ -0,0 +1,112 @@
+#ifndef GRAFKIT_MESH_OPTIMIZER_H
+#define GRAFKIT_MESH_OPTIMIZER_H
+
+#include <span>
+#include <vector>
+
+#include <grafkit/common.h>
+
+namespace Grafkit::Resource
+{
+	struct MeshDescV2;
+
+	struct MeshOptimizeOptions
+	{
+		// Reorders triangles for post-transform cache hits (Tipsify)
+		bool vertexCache = true;
+		// Sorts clusters of the cache optimized order to draw outward facing ones first
+		bool overdraw = true;
+		// Reorders vertices in the order the indices first refer to them
+		bool vertexFetch = true;
+
+		// FIFO entries the cache optimization and the statistics assume
+		uint32_t cacheSize = 16;
+		// Cache efficiency traded for overdraw, a cluster is split while its ACMR stays within this ratio
+		float overdrawThreshold = 1.05f;
+	};
+
+	// Average cache miss ratio, post-transform cache misses per triangle; 0.5 is the best a grid can get, 3 the worst
+	struct MeshOptimizeStats
+	{
+		size_t triangleCount = 0;
+		float acmrBefore = 0.0f;
+		float acmrAfter = 0.0f;
+
+		// Accumulates the stats of another primitive, weighted by triangle count
+		void Add(const MeshOptimizeStats &other);
+	};
+
+	/**
+	 * @brief Triangle list optimizations, in the spirit of Sander et al.: Fast Triangle Reordering for Vertex Locality
+	 * and Reduced Overdraw
+	 *
+	 * Indices are relative to the vertices of the primitive. None of them change what is drawn, only the order of
+	 * triangles and vertices.
+	 */
+	namespace MeshOptimizer
+	{
+		// Simulates a FIFO post-transform cache of the given size
+		[[nodiscard]] GKAPI float CalculateAcmr(std::span<const uint32_t> indices,
+			uint32_t vertexCount,
+			uint32_t cacheSize = 16);
+
+		[[nodiscard]] GKAPI std::vector<uint32_t> OptimizeVertexCache(std::span<const uint32_t> indices,
+			uint32_t vertexCount,
+			uint32_t cacheSize = 16);
+
+		// Expects cache optimized indices, splits them into clusters and sorts those from the outside in
+		[[nodiscard]] GKAPI std::vector<uint32_t> OptimizeOverdraw(std::span<const uint32_t> indices,
+			std::span<const glm::vec3> positions,
+			uint32_t cacheSize = 16,
+			float threshold = 1.05f);
+
+		// Renumbers the indices in place and returns the new place of every vertex; unreferenced ones go last
+		[[nodiscard]] GKAPI std::vector<uint32_t> OptimizeVertexFetch(std::span<uint32_t> indices,
+			uint32_t vertexCount);
+
+		template <typename T>
+		void RemapVertices(std::vector<T> &vertices, std::span<const uint32_t> remap)
+		{
+			std::vector<T> remapped(vertices.size());
+			for (size_t i = 0; i < vertices.size(); ++i)
+			{
+				remapped[remap[i]] = std::move(vertices[i]);
+			}
+			vertices = std::move(remapped);
+		}
+
+		// Runs the enabled passes on the triangle list of the positions, returns the remap of the vertices
+		GKAPI std::vector<uint32_t> OptimizeIndices(std::vector<uint32_t> &indices,
+			std::span<const glm::vec3> positions,
+			const MeshOptimizeOptions &options,
+			MeshOptimizeStats &stats);
+
+		// Vertices need a glm::vec3 position member
+		template <typename VertexT>
+		MeshOptimizeStats Optimize(std::vector<VertexT> &vertices,
+			std::vector<uint32_t> &indices,
+			const MeshOptimizeOptions &options = {})
+		{
+			std::vector<glm::vec3> positions(vertices.size());
+			for (size_t i = 0; i < vertices.size(); ++i)
+			{
+				positions[i] = vertices[i].position;
+			}
+
+			MeshOptimizeStats stats{};
+			const std::vector<uint32_t> remap = OptimizeIndices(indices, positions, options, stats);
+			if (!remap.empty())
+			{
+				RemapVertices(vertices, remap);
+			}
+			return stats;
+		}
+
+		// Optimizes each primitive within its own range of the shared streams; its levels of detail follow the
+		// vertex remap and have their triangles reordered, statistics only count the full detail ones
+		GKAPI MeshOptimizeStats Optimize(MeshDescV2 &mesh, const MeshOptimizeOptions &options = {});
+	} // namespace MeshOptimizer
+
+} // namespace Grafkit::Resource
+
+#endif // GRAFKIT_MESH_OPTIMIZER_H
@@ -0,0 +1,60 @@
+#ifndef GRAFKIT_MESH_SIMPLIFIER_H
+#define GRAFKIT_MESH_SIMPLIFIER_H
+
+#include <span>
+#include <vector>
+
+#include <grafkit/common.h>
+
+namespace Grafkit::Utils
+{
+	class ThreadPool;
+}
+
+namespace Grafkit::Resource
+{
+	struct MeshDescV2;
+
+	struct MeshLodOptions
+	{
+		// Triangle count of each level relative to the full detail primitive, coarsest last
+		std::vector<float> ratios = {0.5f, 0.25f, 0.125f};
+		// Largest distance a vertex may move, relative to the extent of the primitive; levels stop short at it
+		float maxError = 0.01f;
+		// A level keeping more than this of the previous one is dropped along with the rest of the chain
+		float minReduction = 0.9f;
+	};
+
+	/**
+	 * @brief Quadric error edge collapse simplification, after Garland and Heckbert: Surface Simplification Using
+	 * Quadric Error Metrics
+	 *
+	 * Vertices only collapse onto other vertices, so every level indexes the vertices of the full detail one.
+	 * Borders only collapse along themselves. Vertices split for differing attributes at the same position (UV or
+	 * normal seams) collapse along the seam together with their twin on the other side, or not at all.
+	 * Indices are relative to the vertices of the primitive.
+	 */
+	namespace MeshSimplifier
+	{
+		/**
+		 * @brief Collapses edges, cheapest first, until the index count reaches the target or the error the limit
+		 * @param maxError Largest distance a vertex may move off the planes of the triangles collapsed into it,
+		 * relative to the extent of the positions
+		 * @param resultError Set to the largest error of the collapses made, relative as well
+		 */
+		[[nodiscard]] GKAPI std::vector<uint32_t> Simplify(std::span<const uint32_t> indices,
+			std::span<const glm::vec3> positions,
+			size_t targetIndexCount,
+			float maxError,
+			float *resultError = nullptr);
+
+		// Appends the levels of each primitive to the indices of the mesh; indices of previous levels are removed
+		GKAPI void GenerateLods(MeshDescV2 &mesh, const MeshLodOptions &options = {});
+
+		// Meshes are simplified concurrently, one task each; rethrows the first error once all of them are done
+		GKAPI void GenerateLods(std::span<MeshDescV2> meshes, const MeshLodOptions &options, Utils::ThreadPool &pool);
+	} // namespace MeshSimplifier
+
+} // namespace Grafkit::Resource
+
+#endif // GRAFKIT_MESH_SIMPLIFIER_H
@@ -0,0 +1,64 @@
+#ifndef GRAFKIT_MESHLET_BUILDER_H
+#define GRAFKIT_MESHLET_BUILDER_H
+
+#include <span>
+#include <vector>
+
+#include <grafkit/common.h>
+#include <grafkit/render/meshlet.h>
+
+namespace Grafkit::Resource
+{
+	struct MeshletOptions
+	{
+		uint32_t maxVertices = Meshlet::MAX_VERTICES;
+		uint32_t maxTriangles = Meshlet::MAX_TRIANGLES;
+	};
+
+	/**
+	 * @brief Clustering of a triangle list, in the layout a mesh shader reads it
+	 * Meshlets index their vertices, the vertices index the primitive; triangles are three bytes of meshlet local
+	 * vertex indices.
+	 */
+	struct MeshletData
+	{
+		std::vector<Meshlet> meshlets;
+		std::vector<uint32_t> vertices;
+		std::vector<uint8_t> triangles;
+	};
+
+	namespace MeshletBuilder
+	{
+		/**
+		 * @brief Greedily grows meshlets from triangles sharing the most vertices with them
+		 * Triangles are taken in the order of the indices when nothing adjacent is left, cache optimized indices
+		 * give tighter clusters.
+		 */
+		[[nodiscard]] GKAPI MeshletData Build(std::span<const uint32_t> indices,
+			std::span<const glm::vec3> positions,
+			const MeshletOptions &options = {});
+
+		// Triangle list of the meshlets one after another, indices relative to the primitive
+		[[nodiscard]] GKAPI std::vector<uint32_t> BuildIndices(const MeshletData &data);
+
+		// Bounding sphere and normal cone of a meshlet from its triangles
+		GKAPI void CalculateBounds(Meshlet &meshlet, const MeshletData &data, std::span<const glm::vec3> positions);
+
+		// Vertices need a glm::vec3 position member
+		template <typename VertexT>
+		MeshletData Build(const std::vector<VertexT> &vertices,
+			std::span<const uint32_t> indices,
+			const MeshletOptions &options = {})
+		{
+			std::vector<glm::vec3> positions(vertices.size());
+			for (size_t i = 0; i < vertices.size(); ++i)
+			{
+				positions[i] = vertices[i].position;
+			}
+			return Build(indices, positions, options);
+		}
+	} // namespace MeshletBuilder
+
+} // namespace Grafkit::Resource
+
+#endif // GRAFKIT_MESHLET_BUILDER_H
@@ -1,63 +1,172 @@
 #ifndef GRAFKIT_SCENEGRAPH_BUILDER_H
 #define GRAFKIT_SCENEGRAPH_BUILDER_H
 
+#include <optional>
 #include <unordered_map>
 
+#include <glm/gtc/quaternion.hpp>
 #include <grafkit/common.h>
 #include <grafkit/interface/resource.h>
 #include <grafkit/render/material.h>
 #include <grafkit/render/mesh.h>
+#include <grafkit/render/vertex_packing.h>
+#include <grafkit/resource/mesh_optimizer.h>
+#include <grafkit/resource/meshlet_builder.h>
 
 namespace Grafkit::Resource
 {
 
-	struct PrimitiveDesc
+	// Named apart from the serialized descriptors in mesh_desc.h, so both can be used in one place
+	struct MeshBuilderPrimitiveDesc
 	{
 		std::vector<Vertex> vertices;
 		std::vector<uint32_t> indices;
 		uint32_t materialIndex;
 	};
 
-	struct MeshDesc
+	struct MeshBuilderDesc
 	{
-		std::vector<PrimitiveDesc> primitives;
+		std::vector<MeshBuilderPrimitiveDesc> primitives;
 		std::unordered_map<uint32_t, std::string> materials;
 	};
 
-	class MeshBuilder : public ResourceBuilder<MeshDesc, Grafkit::Mesh>
+	class MeshBuilder : public ResourceBuilder<MeshBuilderDesc, Grafkit::Mesh>, public ICookable
 	{
 	public:
-		explicit MeshBuilder(const MeshDesc &desc = {})
+		explicit MeshBuilder(const MeshBuilderDesc &desc = {})
 			: ResourceBuilder(desc)
 		{
 		}
 
-		MeshBuilder &AddPrimitive(const PrimitiveDesc &primitive)
+		explicit MeshBuilder(MeshBuilderDesc &&desc)
+			: ResourceBuilder(std::move(desc))
 		{
-			m_descriptor.primitives.push_back(primitive);
+		}
+
+		// Overloads taking rvalues keep the vectors of the caller, Build copies them straight to the GPU
+		MeshBuilder &AddPrimitive(const MeshBuilderPrimitiveDesc &primitive)
+		{
+			return AddPrimitive(MeshBuilderPrimitiveDesc(primitive));
+		}
+
+		MeshBuilder &AddPrimitive(MeshBuilderPrimitiveDesc &&primitive)
+		{
+			m_descriptor.primitives.push_back(std::move(primitive));
+			Invalidate();
 			return *this;
 		}
 
 		MeshBuilder &AddPrimitive(const std::vector<Vertex> &vertices,
 			const std::vector<uint32_t> &indices,
+			const uint32_t materialIndex)
+		{
+			return AddPrimitive(std::vector<Vertex>(vertices), std::vector<uint32_t>(indices), materialIndex);
+		}
+
+		MeshBuilder &AddPrimitive(std::vector<Vertex> &&vertices,
+			std::vector<uint32_t> &&indices,
 			const uint32_t materialIndex);
 
 		MeshBuilder &AddPrimitive(const std::vector<Vertex> &vertices,
 			const std::vector<uint32_t> &indices,
+			const MaterialPtr &material)
+		{
+			return AddPrimitive(std::vector<Vertex>(vertices), std::vector<uint32_t>(indices), material);
+		}
+
+		MeshBuilder &AddPrimitive(std::vector<Vertex> &&vertices,
+			std::vector<uint32_t> &&indices,
 			const MaterialPtr &material);
 
 		MeshBuilder &AddMaterial(const uint32_t index, const MaterialPtr &material);
 
+		// Reorders each primitive for the vertex cache, overdraw and vertex fetch when merging, before Cook or Build
+		MeshBuilder &Optimize(const MeshOptimizeOptions &options = {})
+		{
+			m_optimizeOptions = options;
+			Invalidate();
+			return *this;
+		}
+
+		// Splits each primitive into meshlets when merging, after the optimization; their triangles are reordered
+		MeshBuilder &BuildMeshlets(const MeshletOptions &options = {})
+		{
+			m_meshletOptions = options;
+			Invalidate();
+			return *this;
+		}
+
+		// Packs the vertex buffer into a compact layout on Build; cooked meshes keep full precision
+		MeshBuilder &SetVertexFormat(const VertexFormat format)
+		{
+			m_vertexFormat = format;
+			return *this;
+		}
+
+		// ACMR of the merged primitives, before and after the optimization
+		[[nodiscard]] const MeshOptimizeStats &GetOptimizeStats() const
+		{
+			return m_optimizeStats;
+		}
+
 		[[nodiscard]] bool ResolveDependencies(const RefWrapper<ResourceManager> &resources) final;
 		void Build(const Core::DeviceRef &device) final;
+		[[nodiscard]] std::vector<ResourceId> GetDependencies() const final;
+		[[nodiscard]] ResourceUsage GetUsage() const final;
+
+		// Cooks the merged vertex and index buffers along with the material names
+		[[nodiscard]] std::vector<uint8_t> Cook() override;
+		void LoadCooked(std::span<const uint8_t> data) override;
 
 	private:
+		/**
+		 * @brief Lays out the primitives in a single vertex and index buffer, 16 bit indices where they fit
+		 * Sizes everything up front without copying; only primitives reordered by the optimization or the
+		 * clustering are held on to, the rest are read from the descriptor when written.
+		 */
+		void Prepare();
+
+		// Writes the prepared primitives in the layout of the buffers, the destinations are sized by Prepare
+		void WritePrimitives(std::span<uint8_t> vertexData,
+			std::span<uint8_t> indexData,
+			VertexFormat vertexFormat,
+			const PositionBounds &bounds) const;
+
+		// Copies the prepared primitives into the merged buffers at full precision, for cooking
+		void Merge();
+
+		void Invalidate()
+		{
+			m_isPrepared = false;
+			m_isMerged = false;
+		}
+
 		std::unordered_map<uint32_t, MaterialPtr> m_materials;
+		std::optional<MeshOptimizeOptions> m_optimizeOptions;
+		MeshOptimizeStats m_optimizeStats{};
+		std::optional<MeshletOptions> m_meshletOptions;
+		VertexFormat m_vertexFormat = VertexFormat::Float;
+
+		std::vector<Grafkit::Primitive> m_primitives;
+		std::vector<Grafkit::Meshlet> m_meshlets;
+		// Primitives of the descriptor after reordering, empty when neither pass is enabled
+		std::vector<MeshBuilderPrimitiveDesc> m_reordered;
+		size_t m_vertexCount = 0;
+		size_t m_indexDataSize = 0;
+		bool m_isPrepared = false;
+
+		std::vector<Grafkit::Vertex> m_vertices;
+		// Indices relative to the vertex offset of their primitive, mixed uint16 and uint32 regions
+		std::vector<uint8_t> m_indexData;
+		bool m_isMerged = false;
 	};
 
 	struct NodeDesc
 	{
 		std::string name;
+		glm::vec3 translation = glm::vec3(0.0f);
+		glm::quat rotation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+		glm::vec3 scale = glm::vec3(1.0f);
 		std::vector<uint32_t> meshIndices;
 		std::vector<NodeDesc> children;
 	};
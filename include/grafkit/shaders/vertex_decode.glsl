@@ -0,0 +1,28 @@
+#ifndef GRAFKIT_VERTEX_DECODE_GLSL
+#define GRAFKIT_VERTEX_DECODE_GLSL
+
+// Decoders of the compact vertex layouts, see grafkit/render/vertex_desc.h and grafkit/render/vertex_packing.h
+// The vertex input already turns snorm / unorm / half attributes into floats, what is left is unfolding directions.
+
+vec2 OctSignNotZero(vec2 v)
+{
+	return vec2(v.x >= 0.0 ? 1.0 : -1.0, v.y >= 0.0 ? 1.0 : -1.0);
+}
+
+// Unit vector from its octahedral encoding, in [-1, 1]^2
+vec3 OctDecode(vec2 e)
+{
+	vec3 v = vec3(e.xy, 1.0 - abs(e.x) - abs(e.y));
+	float fold = max(-v.z, 0.0);
+	v.xy -= OctSignNotZero(v.xy) * fold;
+	return normalize(v);
+}
+
+// Packed positions are mapped back to model space by the position transform of the mesh, which the renderer pushes
+// after the model matrix. It scales the axes unevenly, so it is applied to positions only.
+vec3 DecodePosition(vec4 packedPosition, mat4 positionTransform)
+{
+	return (positionTransform * vec4(packedPosition.xyz, 1.0)).xyz;
+}
+
+#endif // GRAFKIT_VERTEX_DECODE_GLSL
@@ -0,0 +1,139 @@
+#ifndef GRAFKIT_UTILS_CONCURRENT_MAP_HPP
+#define GRAFKIT_UTILS_CONCURRENT_MAP_HPP
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace Grafkit::Utils
+{
+	/**
+	 * @brief Hash map that can be read and written from any thread
+	 *
+	 * Keys are spread over shards by their hash, each with a table behind its own shared mutex. Readers share the lock
+	 * of a shard, so they only wait for a writer of the same shard, and writers of different shards do not wait for
+	 * each other. Values are held by pointer; one found stays valid after it is replaced or erased.
+	 */
+	template <typename KeyT, typename ValueT, typename HashT = std::hash<KeyT>, size_t ShardCount = 64>
+	class ConcurrentMap
+	{
+		static_assert((ShardCount & (ShardCount - 1)) == 0, "Shard count has to be a power of two");
+
+	public:
+		using ValuePtr = std::shared_ptr<ValueT>;
+
+		ConcurrentMap() = default;
+
+		ConcurrentMap(const ConcurrentMap &) = delete;
+		ConcurrentMap &operator=(const ConcurrentMap &) = delete;
+		ConcurrentMap(ConcurrentMap &&) = delete;
+		ConcurrentMap &operator=(ConcurrentMap &&) = delete;
+
+		// Null when the key is not present
+		[[nodiscard]] ValuePtr Find(const KeyT &key) const
+		{
+			const Shard &shard = GetShard(key);
+			std::shared_lock<std::shared_mutex> lock(shard.mutex);
+			const auto it = shard.table.find(key);
+			return it != shard.table.end() ? it->second : nullptr;
+		}
+
+		// Returns the value replaced, if any
+		ValuePtr InsertOrAssign(const KeyT &key, ValuePtr value)
+		{
+			ValuePtr previous;
+			Modify(key,
+				[&](Table &table)
+				{
+					ValuePtr &slot = table[key];
+					previous = std::exchange(slot, std::move(value));
+				});
+			return previous;
+		}
+
+		// Returns the value removed, if any
+		ValuePtr Erase(const KeyT &key)
+		{
+			ValuePtr previous;
+			Modify(key,
+				[&](Table &table)
+				{
+					if (const auto it = table.find(key); it != table.end())
+					{
+						previous = std::move(it->second);
+						table.erase(it);
+					}
+				});
+			return previous;
+		}
+
+		// Visits the shards one at a time, holding the lock of each; func must not write the map
+		template <typename FuncT>
+		void ForEach(FuncT &&func) const
+		{
+			for (const Shard &shard : m_shards)
+			{
+				std::shared_lock<std::shared_mutex> lock(shard.mutex);
+				for (const auto &[key, value] : shard.table)
+				{
+					func(key, value);
+				}
+			}
+		}
+
+		[[nodiscard]] size_t Size() const
+		{
+			size_t size = 0;
+			for (const Shard &shard : m_shards)
+			{
+				std::shared_lock<std::shared_mutex> lock(shard.mutex);
+				size += shard.table.size();
+			}
+			return size;
+		}
+
+		void Clear()
+		{
+			for (Shard &shard : m_shards)
+			{
+				std::unique_lock<std::shared_mutex> lock(shard.mutex);
+				shard.table.clear();
+			}
+		}
+
+	private:
+		using Table = std::unordered_map<KeyT, ValuePtr, HashT>;
+
+		// Own cache line each, locking a shard does not slow down the neighbouring ones
+		struct alignas(64) Shard
+		{
+			mutable std::shared_mutex mutex;
+			Table table;
+		};
+
+		template <typename FuncT>
+		void Modify(const KeyT &key, FuncT &&func)
+		{
+			Shard &shard = GetShard(key);
+			std::unique_lock<std::shared_mutex> lock(shard.mutex);
+			func(shard.table);
+		}
+
+		[[nodiscard]] Shard &GetShard(const KeyT &key) const
+		{
+			// The tables bucket by the low bits of the hash, the shard is picked by the high bits of a mixed one
+			const uint64_t hash = static_cast<uint64_t>(HashT{}(key)) * 0x9e3779b97f4a7c15ull;
+			return m_shards[static_cast<size_t>(hash >> 32) & (ShardCount - 1)];
+		}
+
+		mutable std::array<Shard, ShardCount> m_shards;
+	};
+
+} // namespace Grafkit::Utils
+
+#endif // GRAFKIT_UTILS_CONCURRENT_MAP_HPP
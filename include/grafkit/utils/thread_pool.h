@@ -0,0 +1,64 @@
+#ifndef GRAFKIT_UTILS_THREAD_POOL_H
+#define GRAFKIT_UTILS_THREAD_POOL_H
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <grafkit/common.h>
+
+namespace Grafkit::Utils
+{
+	/**
+	 * @brief Fixed size pool of worker threads executing tasks in submission order
+	 */
+	class GKAPI ThreadPool
+	{
+	public:
+		// Zero picks one worker per hardware thread, leaving one for the main loop
+		explicit ThreadPool(size_t threadCount = 0);
+		~ThreadPool();
+
+		ThreadPool(const ThreadPool &) = delete;
+		ThreadPool &operator=(const ThreadPool &) = delete;
+		ThreadPool(ThreadPool &&) = delete;
+		ThreadPool &operator=(ThreadPool &&) = delete;
+
+		void Enqueue(std::function<void()> task);
+
+		template <typename FuncT>
+		[[nodiscard]] std::future<std::invoke_result_t<FuncT>> Submit(FuncT &&func)
+		{
+			using ResultType = std::invoke_result_t<FuncT>;
+			auto task = std::make_shared<std::packaged_task<ResultType()>>(std::forward<FuncT>(func));
+			std::future<ResultType> future = task->get_future();
+			Enqueue([task]() { (*task)(); });
+			return future;
+		}
+
+		// Blocks until every queued task has finished
+		void WaitIdle();
+
+		[[nodiscard]] size_t GetThreadCount() const { return m_threads.size(); }
+
+	private:
+		void WorkerLoop();
+
+		std::vector<std::thread> m_threads;
+		std::queue<std::function<void()>> m_tasks;
+
+		std::mutex m_mutex;
+		std::condition_variable m_taskAvailable;
+		std::condition_variable m_idle;
+		size_t m_activeTasks = 0;
+		bool m_stopping = false;
+	};
+
+} // namespace Grafkit::Utils
+
+#endif // GRAFKIT_UTILS_THREAD_POOL_H
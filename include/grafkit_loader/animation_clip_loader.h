@@ -0,0 +1,32 @@
+#ifndef ASSET_ANIMATION_CLIP_LOADER_H
+#define ASSET_ANIMATION_CLIP_LOADER_H
+
+#include <filesystem>
+
+#include <grafkit/common.h>
+#include <grafkit/resource/animation_clip.h>
+#include <grafkit_loader/mapped_file.h>
+
+namespace Grafkit::Asset {
+
+	/**
+	 * @brief Cooked animation clip read in place from a mapped file
+	 */
+	class GKAPI MappedAnimationClip {
+	public:
+		explicit MappedAnimationClip(const std::filesystem::path& path);
+
+		[[nodiscard]] const Resource::AnimationClipView& GetClip() const { return m_clip; }
+
+	private:
+		MappedFile m_file;
+		Resource::AnimationClipView m_clip;
+	};
+
+	using MappedAnimationClipPtr = std::shared_ptr<MappedAnimationClip>;
+
+	GKAPI void WriteAnimationClip(const std::filesystem::path& path, const Resource::AnimationClipDesc& desc);
+
+} // namespace Grafkit::Asset
+
+#endif // ASSET_ANIMATION_CLIP_LOADER_H
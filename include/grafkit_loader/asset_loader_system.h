@@ -3,8 +3,11 @@
 
 #include <grafkit/common.h>
 
+#include <grafkit_loader/binary_adapter.h>
 #include <grafkit_loader/file_loader.h>
+#include <grafkit_loader/image_asset.h>
 #include <grafkit_loader/json_adapter.h>
+#include <grafkit_loader/pack_source.h>
 
 namespace Grafkit::Asset {
 	class GKAPI JsonAssetLoader final : virtual public AssetLoader<FileAssetSource, JsonAsset> {
@@ -15,6 +18,47 @@ namespace Grafkit::Asset {
 
 		~JsonAssetLoader() override = default;
 	};
+
+	class GKAPI PackJsonAssetLoader final : virtual public AssetLoader<PackAssetSource, JsonAsset> {
+	public:
+		explicit PackJsonAssetLoader(const std::filesystem::path& packPath) { Mount(packPath); }
+		PackJsonAssetLoader(const PackJsonAssetLoader&) = delete; // Delete copy constructor
+		PackJsonAssetLoader& operator=(const PackJsonAssetLoader&) = delete; // Delete copy assignment operator
+
+		~PackJsonAssetLoader() override = default;
+
+		using PackAssetSource::Mount;
+	};
+
+	class GKAPI BinaryAssetLoader final : virtual public AssetLoader<FileAssetSource, BinaryAsset> {
+	public:
+		BinaryAssetLoader() = default;
+		BinaryAssetLoader(const BinaryAssetLoader&) = delete; // Delete copy constructor
+		BinaryAssetLoader& operator=(const BinaryAssetLoader&) = delete; // Delete copy assignment operator
+
+		~BinaryAssetLoader() override = default;
+	};
+
+	class GKAPI PackBinaryAssetLoader final : virtual public AssetLoader<PackAssetSource, BinaryAsset> {
+	public:
+		explicit PackBinaryAssetLoader(const std::filesystem::path& packPath) { Mount(packPath); }
+		PackBinaryAssetLoader(const PackBinaryAssetLoader&) = delete; // Delete copy constructor
+		PackBinaryAssetLoader& operator=(const PackBinaryAssetLoader&) = delete; // Delete copy assignment operator
+
+		~PackBinaryAssetLoader() override = default;
+
+		using PackAssetSource::Mount;
+	};
+
+	// Reads image files directly, see ImageAsset
+	class GKAPI ImageAssetLoader final : virtual public AssetLoader<FileAssetSource, ImageAsset> {
+	public:
+		ImageAssetLoader() = default;
+		ImageAssetLoader(const ImageAssetLoader&) = delete; // Delete copy constructor
+		ImageAssetLoader& operator=(const ImageAssetLoader&) = delete; // Delete copy assignment operator
+
+		~ImageAssetLoader() override = default;
+	};
 } // namespace Grafkit::Asset
 
 #endif // ASSET_LOADER_SYSTEM_H
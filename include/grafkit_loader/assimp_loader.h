@@ -1,19 +1,79 @@
 #ifndef ASSIMP_H
 #define ASSIMP_H
 
+#include <memory>
+#include <string>
+
 #include <grafkit/common.h>
+#include <grafkit/descriptors/mesh_desc.h>
 #include <grafkit/interface/resource.h>
+#include <grafkit/resource/scenegraph_builder.h>
+
+struct aiScene;
+
+namespace Grafkit::Utils {
+	class ThreadPool;
+} // namespace Grafkit::Utils
 
 namespace Grafkit::Asset {
 
+	struct AssimpLoaderOptions {
+		// Stands in for the materials the resource manager does not have, those fail the load when left empty
+		std::string defaultMaterial;
+		// Meshes are reordered for the vertex cache, overdraw and vertex fetch when built
+		bool isOptimized = true;
+	};
+
+	/**
+	 * @brief Every mesh of a scene as a primitive of a single descriptor, with the node hierarchy referring to them
+	 * Mesh indices of the nodes are primitive indices. Material indices of the primitives are the ones of the
+	 * scene, the descriptor maps their names to them.
+	 */
+	struct AssimpScene {
+		Resource::MeshDescV2 meshes;
+		Resource::SceneGraphDesc scene;
+	};
+
 	// TODO: This has to be an extension to asset/resource loader
 
 	class AssimpLoader {
 	public:
-		AssimpLoader() = default;
-		~AssimpLoader() = default;
+		// Zero worker count picks one per hardware thread
+		explicit AssimpLoader(const AssimpLoaderOptions& options = {}, size_t workerCount = 0);
+		~AssimpLoader();
+
+		AssimpLoader(const AssimpLoader&) = delete;
+		AssimpLoader& operator=(const AssimpLoader&) = delete;
+		AssimpLoader(AssimpLoader&&) = delete;
+		AssimpLoader& operator=(AssimpLoader&&) = delete;
+
+		// Reads the file and converts it on the CPU, without touching the device
+		[[nodiscard]] AssimpScene Import(const std::string& filename) const;
+
+		/**
+		 * @brief Converts the triangle meshes of a scene into a single arena, one task per mesh
+		 * A counting pass sizes every stream up front, so the tasks write their own ranges of them without
+		 * reallocating. Streams missing from some of the meshes are zero filled there; points and lines are skipped.
+		 */
+		[[nodiscard]] Resource::MeshDescV2 ConvertMeshes(const aiScene& scene) const;
+
+		/**
+		 * @brief Imports a file and builds a scenegraph of it
+		 * Nodes referring to the same meshes share a Mesh, built through a BuildScheduler and stored in the resource
+		 * manager under the file name followed by '#' and a number. Materials are looked up there by name.
+		 */
+		[[nodiscard]] Grafkit::ScenegraphPtr Load(const Core::DeviceRef& device,
+			const Resource::ResourceManagerRef& resources,
+			const std::string& filename) const;
+
+		[[nodiscard]] Grafkit::ScenegraphPtr Build(const Core::DeviceRef& device,
+			const Resource::ResourceManagerRef& resources,
+			const std::string& name,
+			const AssimpScene& scene) const;
 
-		Grafkit::ScenegraphPtr Load(const std::string& filename);
+	private:
+		AssimpLoaderOptions m_options;
+		std::unique_ptr<Utils::ThreadPool> m_workers;
 	};
 } // namespace Grafkit::Asset
 #endif // ASSIMP_H
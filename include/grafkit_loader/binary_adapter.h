@@ -0,0 +1,41 @@
+#ifndef ASSET_BINARY_DESERIALIZER_H
+#define ASSET_BINARY_DESERIALIZER_H
+
+#include <span>
+#include <typeindex>
+#include <vector>
+
+#include <grafkit/common.h>
+#include <grafkit/interface/asset.h>
+
+namespace Grafkit::Asset {
+	constexpr uint32_t BINARY_ASSET_MAGIC = 0x41424B47; // 'GKBA'
+	constexpr uint32_t BINARY_ASSET_VERSION = 1;
+
+	/**
+	 * @brief Descriptor in the binary form, see binary_desc.h
+	 * Reads without any text parsing; the shipped counterpart of JsonAsset.
+	 */
+	class GKAPI BinaryAsset : virtual public ISerializedAsset {
+	public:
+		explicit BinaryAsset(std::vector<uint8_t> data);
+		explicit BinaryAsset(AssetDataPtr data);
+		~BinaryAsset() override = default;
+
+		void Deserialize(const std::type_index& assetType, void* object) override;
+
+		[[nodiscard]] std::span<const uint8_t> GetData() const override { return m_data->GetData(); }
+
+		// Writes an object of a generated descriptor type into a binary asset
+		[[nodiscard]] static std::vector<uint8_t> Serialize(const std::type_index& assetType, const void* object);
+
+		template <class T> [[nodiscard]] static std::vector<uint8_t> Serialize(const T& object)
+		{
+			return Serialize(typeid(T), &object);
+		}
+
+	private:
+		const AssetDataPtr m_data;
+	};
+} // namespace Grafkit::Asset
+#endif // ASSET_BINARY_DESERIALIZER_H
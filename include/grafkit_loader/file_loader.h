@@ -1,6 +1,7 @@
 #ifndef ASSET_FILE_LOADER_H
 #define ASSET_FILE_LOADER_H
 
+#include <filesystem>
 #include <typeindex>
 
 #include <grafkit/common.h>
@@ -10,6 +11,9 @@ namespace Grafkit::Asset {
 
 	class GKAPI FileAssetSource : virtual public IAssetSource {
 	public:
+		// Files below this size are read into memory, mapping them costs more than the copy
+		static constexpr size_t MAPPING_THRESHOLD = 64 * 1024;
+
 		FileAssetSource() = default;
 		FileAssetSource(const FileAssetSource&) = delete; // Delete copy constructor
 		FileAssetSource& operator=(const FileAssetSource&) = delete; // Delete copy assignment operator
@@ -17,6 +21,10 @@ namespace Grafkit::Asset {
 		~FileAssetSource() override = default;
 
 		void ReadData(const std::string& assetName, std::vector<uint8_t>& data) const final;
+		[[nodiscard]] AssetDataPtr OpenData(const std::string& assetName) const override;
+
+		// Reads the whole file with a single sized read
+		static void ReadFile(const std::filesystem::path& path, std::vector<uint8_t>& data);
 	};
 } // namespace Grafkit::Asset
 #endif // ASSET_FILE_LOADER_H
@@ -0,0 +1,60 @@
+#ifndef ASSET_FILE_WATCHER_H
+#define ASSET_FILE_WATCHER_H
+
+#include <chrono>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <grafkit/common.h>
+
+#if defined(__linux__)
+#define GRAFKIT_HAS_INOTIFY 1
+#else
+#define GRAFKIT_HAS_INOTIFY 0
+#endif
+
+namespace Grafkit::Asset {
+
+	/**
+	 * @brief Reports files changed in the watched directories and their subdirectories
+	 *
+	 * Changes are reported once the file is closed after writing or moved in place, so half written files are not
+	 * picked up. Paths are the watched directory joined with the file's relative path, lexically normalized; watch
+	 * the directories the way assets are named to be able to pass them to ResourceManager::Reload as is.
+	 * Uses inotify on Linux, elsewhere it compares modification times, at most once per poll interval.
+	 */
+	class GKAPI FileWatcher {
+	public:
+		static constexpr std::chrono::milliseconds POLL_INTERVAL { 500 };
+
+		FileWatcher();
+		~FileWatcher();
+
+		FileWatcher(const FileWatcher&) = delete;
+		FileWatcher& operator=(const FileWatcher&) = delete;
+		FileWatcher(FileWatcher&&) = delete;
+		FileWatcher& operator=(FileWatcher&&) = delete;
+
+		void Watch(const std::filesystem::path& directory);
+
+		// Does not block, each changed file is reported once
+		[[nodiscard]] std::vector<std::string> Poll();
+
+	private:
+		void AddDirectory(const std::filesystem::path& directory);
+
+#if GRAFKIT_HAS_INOTIFY
+		int m_fd = -1;
+		std::map<int, std::filesystem::path> m_directories;
+#else
+		std::vector<std::filesystem::path> m_directories;
+		std::map<std::filesystem::path, std::filesystem::file_time_type> m_modificationTimes;
+		std::chrono::steady_clock::time_point m_lastPoll {};
+#endif
+	};
+
+} // namespace Grafkit::Asset
+
+#endif // ASSET_FILE_WATCHER_H
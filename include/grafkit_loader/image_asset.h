@@ -0,0 +1,33 @@
+#ifndef ASSET_IMAGE_DESERIALIZER_H
+#define ASSET_IMAGE_DESERIALIZER_H
+
+#include <span>
+#include <typeindex>
+#include <vector>
+
+#include <grafkit/common.h>
+#include <grafkit/interface/asset.h>
+
+namespace Grafkit::Asset {
+	/**
+	 * @brief PNG, JPEG or HDR file, decoded into an ImageDesc
+	 *
+	 * Decoding happens in Deserialize, which the resource manager runs on its workers, so images loaded with
+	 * LoadAsync are decoded in parallel. Color images are expanded to RGBA, grayscale stays single channel and
+	 * HDR images are read as RGBA floats.
+	 */
+	class GKAPI ImageAsset : virtual public ISerializedAsset {
+	public:
+		explicit ImageAsset(std::vector<uint8_t> data);
+		explicit ImageAsset(AssetDataPtr data);
+		~ImageAsset() override = default;
+
+		void Deserialize(const std::type_index& assetType, void* object) override;
+
+		[[nodiscard]] std::span<const uint8_t> GetData() const override { return m_data->GetData(); }
+
+	private:
+		const AssetDataPtr m_data;
+	};
+} // namespace Grafkit::Asset
+#endif // ASSET_IMAGE_DESERIALIZER_H
@@ -1,7 +1,7 @@
 #ifndef ASSET_JSON_DESERIALIZER_H
 #define ASSET_JSON_DESERIALIZER_H
 
-#include <any>
+#include <span>
 #include <typeindex>
 #include <vector>
 
@@ -11,15 +11,16 @@
 namespace Grafkit::Asset {
 	class GKAPI JsonAsset : virtual public ISerializedAsset {
 	public:
-		JsonAsset(std::vector<uint8_t> data);
+		explicit JsonAsset(std::vector<uint8_t> data);
+		explicit JsonAsset(AssetDataPtr data);
 		~JsonAsset() override = default;
 
-		void Deserialize(const std::type_index& assetType, std::any& object) override;
+		void Deserialize(const std::type_index& assetType, void* object) override;
 
-		void ReadData(std::vector<uint8_t>& data) const override;
+		[[nodiscard]] std::span<const uint8_t> GetData() const override { return m_data->GetData(); }
 
 	private:
-		const std::vector<uint8_t> m_data;
+		const AssetDataPtr m_data;
 	};
 } // namespace Grafkit::Asset
 #endif // ASSET_JSON_DESERIALIZER_H
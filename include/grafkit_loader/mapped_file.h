@@ -0,0 +1,53 @@
+#ifndef ASSET_MAPPED_FILE_H
+#define ASSET_MAPPED_FILE_H
+
+#include <filesystem>
+#include <span>
+#include <vector>
+
+#include <grafkit/common.h>
+#include <grafkit/interface/asset.h>
+
+#if defined(_WIN32) || defined(__unix__) || defined(__APPLE__)
+#define GRAFKIT_HAS_MMAP 1
+#else
+#define GRAFKIT_HAS_MMAP 0
+#endif
+
+namespace Grafkit::Asset {
+
+	/**
+	 * @brief Read-only memory mapping of a whole file
+	 *
+	 * The mapping is page aligned, so fixed layout data can be read in place without copying.
+	 * Platforms without mmap read the file into an owned buffer instead.
+	 */
+	class GKAPI MappedFile final : public IAssetData {
+	public:
+		explicit MappedFile(const std::filesystem::path& path);
+		~MappedFile() override;
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+		MappedFile(MappedFile&&) = delete;
+		MappedFile& operator=(MappedFile&&) = delete;
+
+		[[nodiscard]] std::span<const uint8_t> GetData() const override { return {m_data, m_size}; }
+		[[nodiscard]] size_t GetSize() const { return m_size; }
+
+	private:
+		const uint8_t* m_data = nullptr;
+		size_t m_size = 0;
+#if defined(_WIN32)
+		void* m_file = nullptr;
+		void* m_mapping = nullptr;
+#elif !GRAFKIT_HAS_MMAP
+		std::vector<uint8_t> m_buffer;
+#endif
+	};
+
+	using MappedFilePtr = std::shared_ptr<MappedFile>;
+
+} // namespace Grafkit::Asset
+
+#endif // ASSET_MAPPED_FILE_H
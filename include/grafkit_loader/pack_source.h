@@ -0,0 +1,82 @@
+#ifndef ASSET_PACK_SOURCE_H
+#define ASSET_PACK_SOURCE_H
+
+#include <filesystem>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include <grafkit/common.h>
+#include <grafkit/descriptors/pack_desc.h>
+#include <grafkit/interface/asset.h>
+
+namespace Grafkit::Asset {
+
+	class MappedFile;
+
+	constexpr uint32_t PACK_MAGIC = 0x4B504B47; // 'GKPK'
+	constexpr uint32_t PACK_VERSION = 1;
+	constexpr uint32_t PACK_ENTRY_COMPRESSED = 1u << 0;
+
+	// FNV-1a of the name, with backslashes and leading "./" normalized the same way as the packer does
+	[[nodiscard]] GKAPI uint64_t HashAssetName(std::string_view name);
+
+	/**
+	 * @brief Memory mapped pack file, see pack_desc.gen.yaml for the layout
+	 */
+	class GKAPI PackFile {
+	public:
+		explicit PackFile(const std::filesystem::path& path);
+		~PackFile();
+
+		PackFile(const PackFile&) = delete;
+		PackFile& operator=(const PackFile&) = delete;
+		PackFile(PackFile&&) = delete;
+		PackFile& operator=(PackFile&&) = delete;
+
+		[[nodiscard]] const PackEntry* Find(std::string_view name) const;
+
+		[[nodiscard]] std::span<const PackEntry> GetEntries() const { return m_entries; }
+		[[nodiscard]] std::string_view GetName(const PackEntry& entry) const;
+
+		// Bytes of the entry as stored in the pack, compressed or not
+		[[nodiscard]] std::span<const uint8_t> GetStoredData(const PackEntry& entry) const;
+
+		// Target has to be entry.size long
+		void ReadEntry(const PackEntry& entry, std::span<uint8_t> target) const;
+
+	private:
+		std::unique_ptr<MappedFile> m_file;
+		const PackHeader* m_header = nullptr;
+		std::span<const PackEntry> m_entries;
+		std::span<const uint32_t> m_blocks;
+		std::string_view m_strings;
+	};
+
+	using PackFilePtr = std::shared_ptr<PackFile>;
+
+	/**
+	 * @brief Asset source reading from one or more mounted pack files
+	 * Uncompressed entries are handed out in place from the mapping, without copying.
+	 */
+	class GKAPI PackAssetSource : virtual public IAssetSource {
+	public:
+		PackAssetSource() = default;
+		PackAssetSource(const PackAssetSource&) = delete; // Delete copy constructor
+		PackAssetSource& operator=(const PackAssetSource&) = delete; // Delete copy assignment operator
+
+		~PackAssetSource() override = default;
+
+		// Packs mounted later shadow the entries of earlier ones
+		void Mount(const std::filesystem::path& packPath);
+
+		void ReadData(const std::string& assetName, std::vector<uint8_t>& data) const final;
+		[[nodiscard]] AssetDataPtr OpenData(const std::string& assetName) const override;
+
+	private:
+		[[nodiscard]] std::pair<PackFilePtr, const PackEntry*> Find(const std::string& assetName) const;
+
+		std::vector<PackFilePtr> m_packs;
+	};
+} // namespace Grafkit::Asset
+#endif // ASSET_PACK_SOURCE_H
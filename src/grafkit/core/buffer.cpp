@@ -5,8 +5,18 @@
 
 using namespace Grafkit::Core;
 
+namespace
+{
+	bool IsHostVisible(const VmaMemoryUsage memoryUsage)
+	{
+		return memoryUsage == VMA_MEMORY_USAGE_CPU_ONLY || memoryUsage == VMA_MEMORY_USAGE_CPU_TO_GPU ||
+			   memoryUsage == VMA_MEMORY_USAGE_GPU_TO_CPU;
+	}
+} // namespace
+
 void Buffer::Destroy(const DeviceRef &device)
 {
+	device->CancelFlush(*this);
 	vmaDestroyBuffer(device->GetVmaAllocator(), buffer, allocation);
 }
 
@@ -19,6 +29,10 @@ Buffer Buffer::CreateBuffer(const DeviceRef &device,
 
 	VmaAllocationCreateInfo vmaAllocInfo = {};
 	vmaAllocInfo.usage = memoryUsage;
+	if (IsHostVisible(memoryUsage))
+	{
+		vmaAllocInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+	}
 
 	Buffer buffer = {};
 
@@ -33,32 +47,75 @@ Buffer Buffer::CreateBuffer(const DeviceRef &device,
 		throw std::runtime_error("failed to create buffer");
 	}
 
+	// Coherent memory needs no flushes, updates of such buffers are a copy and nothing else
+	VkMemoryPropertyFlags memoryFlags = 0;
+	vmaGetAllocationMemoryProperties(device->GetVmaAllocator(), buffer.allocation, &memoryFlags);
+	buffer.mappedData = static_cast<uint8_t *>(buffer.allocationInfo.pMappedData);
+	buffer.isCoherent = (memoryFlags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) != 0;
+
 	return buffer;
 }
 
 void Buffer::Update(const DeviceRef &device, const void *data, const size_t size)
 {
-	void *mappedData = nullptr;
+	Update(data, 0, size);
+	Flush(device);
+}
 
-	if (vmaMapMemory(device->GetVmaAllocator(), allocation, &mappedData) != VK_SUCCESS)
+void Buffer::Update(const void *data, const size_t offset, const size_t size)
+{
+	if (mappedData == nullptr)
 	{
-		throw std::runtime_error("Failed to map memory");
+		throw std::logic_error("Buffer is not mapped");
 	}
+	assert(offset + size <= allocationInfo.size);
+
+	memcpy(mappedData + offset, data, size);
+	MarkDirty(offset, size);
+}
 
-	memcpy(mappedData, data, size);
-	vmaUnmapMemory(device->GetVmaAllocator(), allocation);
+void Buffer::MarkDirty(const size_t offset, const size_t size)
+{
+	assert(offset + size <= allocationInfo.size);
+	dirtyBegin = std::min(dirtyBegin, offset);
+	dirtyEnd = std::max(dirtyEnd, offset + size);
+}
 
-	if (vmaFlushAllocation(device->GetVmaAllocator(), allocation, 0, size) != VK_SUCCESS)
+void Buffer::Flush(const DeviceRef &device)
+{
+	const size_t begin = dirtyBegin;
+	const size_t end = dirtyEnd;
+	dirtyBegin = SIZE_MAX;
+	dirtyEnd = 0;
+	if (begin >= end || isCoherent)
+	{
+		return;
+	}
+
+	if (vmaFlushAllocation(device->GetVmaAllocator(), allocation, begin, end - begin) != VK_SUCCESS)
 	{
 		throw std::runtime_error("Failed to flush memory");
 	}
 }
 
+void Buffer::Write(const DeviceRef &device, const size_t size, const std::function<void(std::span<uint8_t>)> &writer)
+{
+	if (mappedData == nullptr)
+	{
+		throw std::logic_error("Buffer is not mapped");
+	}
+	assert(size <= allocationInfo.size);
+
+	writer(std::span<uint8_t>(mappedData, size));
+	MarkDirty(0, size);
+	Flush(device);
+}
+
 void Grafkit::Core::RingBuffer::Destroy(const DeviceRef &device)
 {
 	for (auto &buffer : buffers)
 	{
-		vmaDestroyBuffer(device->GetVmaAllocator(), buffer.buffer, buffer.allocation);
+		buffer.Destroy(device);
 	}
 	buffers.clear();
 }
@@ -72,37 +129,27 @@ RingBuffer RingBuffer::CreateBuffer(const DeviceRef &device,
 
 	for (size_t i = 0; i < device->GetMaxConcurrentFrames(); i++)
 	{
-		VkBufferCreateInfo bufferInfo = Initializers::BufferCreateInfo(usage, size);
-
-		VmaAllocationCreateInfo vmaAllocInfo = {};
-		vmaAllocInfo.usage = memoryUsage;
-		vmaAllocInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
-
-		Buffer buffer = {};
-
-		// allocate the buffer
-		if (vmaCreateBuffer(device->GetVmaAllocator(),
-				&bufferInfo,
-				&vmaAllocInfo,
-				&buffer.buffer,
-				&buffer.allocation,
-				&buffer.allocationInfo) != VK_SUCCESS)
-		{
-			throw std::runtime_error("failed to create buffer");
-		}
-
-		ringBuffer.buffers.push_back(buffer);
-		ringBuffer.mappedData.push_back(buffer.allocationInfo.pMappedData);
+		ringBuffer.buffers.push_back(Buffer::CreateBuffer(device, size, usage, memoryUsage));
 	}
 
 	return ringBuffer;
 }
 
-void Grafkit::Core::RingBuffer::Update([[maybe_unused]] const DeviceRef &device,
+void Grafkit::Core::RingBuffer::Update(const DeviceRef &device,
+	const void *data,
+	const size_t size,
+	const uint32_t frameIndex)
+{
+	Update(device, data, 0, size, frameIndex);
+}
+
+void Grafkit::Core::RingBuffer::Update(const DeviceRef &device,
 	const void *data,
+	const size_t offset,
 	const size_t size,
 	const uint32_t frameIndex)
 {
 	assert(frameIndex < buffers.size());
-	memcpy(mappedData[frameIndex], data, size);
+	buffers[frameIndex].Update(data, offset, size);
+	device->QueueFlush(buffers[frameIndex]);
 }
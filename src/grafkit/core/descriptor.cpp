@@ -7,6 +7,7 @@
 #include "grafkit/core/device.h"
 #include "grafkit/core/image.h"
 #include "grafkit/core/initializers.h"
+#include "grafkit/core/uniform_allocator.h"
 #include "grafkit/core/vulkan_utils.h"
 
 using namespace Grafkit::Core;
@@ -34,6 +35,14 @@ DescriptorSet::~DescriptorSet()
 void DescriptorSet::Bind(const Core::CommandBufferRef &commandBuffer,
 	const VkPipelineLayout &pipelineLayout,
 	const uint32_t frame) const noexcept
+{
+	Bind(commandBuffer, pipelineLayout, frame, {});
+}
+
+void DescriptorSet::Bind(const Core::CommandBufferRef &commandBuffer,
+	const VkPipelineLayout &pipelineLayout,
+	const uint32_t frame,
+	const std::span<const uint32_t> dynamicOffsets) const noexcept
 {
 	assert(frame < m_descriptorSets.size());
 	vkCmdBindDescriptorSets(**commandBuffer,
@@ -42,8 +51,8 @@ void DescriptorSet::Bind(const Core::CommandBufferRef &commandBuffer,
 		m_descriptorOffset,
 		1,
 		&m_descriptorSets[frame],
-		0,
-		nullptr);
+		static_cast<uint32_t>(dynamicOffsets.size()),
+		dynamicOffsets.data());
 }
 
 void DescriptorSet::Update(const Buffer &buffer, const uint32_t binding, const std::optional<uint32_t> frame) noexcept
@@ -69,6 +78,17 @@ void DescriptorSet::Update(const RingBuffer &ringBuffer, const uint32_t binding)
 		Update(bufferInfo, binding, i);
 	}
 }
+
+void DescriptorSet::Update(const UniformAllocator &allocator, const uint32_t binding, const VkDeviceSize range) noexcept
+{
+	// The same buffer for every frame, the dynamic offset picks the part of the frame
+	const VkDescriptorBufferInfo bufferInfo{
+		allocator.GetBuffer(),
+		0,
+		range,
+	};
+	Update(bufferInfo, binding, std::nullopt, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC);
+}
 void DescriptorSet::Update(const ImagePtr &image,
 	const VkSampler &sampler,
 	const uint32_t binding,
@@ -81,14 +101,15 @@ void DescriptorSet::Update(const ImagePtr &image,
 
 void DescriptorSet::Update(const VkDescriptorBufferInfo &bufferInfo,
 	const uint32_t binding,
-	const std::optional<uint32_t> frame) noexcept
+	const std::optional<uint32_t> frame,
+	const VkDescriptorType descriptorType) noexcept
 {
 	if (frame.has_value())
 	{
 		auto &descriptorSet = m_descriptorSets[frame.value()];
 
 		VkWriteDescriptorSet descriptorWrite =
-			Initializers::WriteDescriptorSet(descriptorSet, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, binding, &bufferInfo);
+			Initializers::WriteDescriptorSet(descriptorSet, descriptorType, binding, &bufferInfo);
 
 		Log::Instance().Trace(
 			"Updating descriptor set for buffer; Binding=%d Object=%p Frame=%d Buffer=%p Offset=%d Range=%d",
@@ -105,10 +126,8 @@ void DescriptorSet::Update(const VkDescriptorBufferInfo &bufferInfo,
 	{
 		for (auto &descriptorSet : m_descriptorSets)
 		{
-			VkWriteDescriptorSet descriptorWrite = Initializers::WriteDescriptorSet(descriptorSet,
-				VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-				binding,
-				&bufferInfo);
+			VkWriteDescriptorSet descriptorWrite =
+				Initializers::WriteDescriptorSet(descriptorSet, descriptorType, binding, &bufferInfo);
 
 			Log::Instance().Trace(
 				"Updating descriptor set for buffer; Binding=%d Object=%p Buffer=%p Offset=%d Range=%d",
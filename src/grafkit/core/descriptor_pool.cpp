@@ -52,6 +52,8 @@ DescriptorPool::~DescriptorPool()
 
 VkDescriptorSet DescriptorPool::AllocateDescriptorSet(const VkDescriptorSetLayout &layout)
 {
+	std::lock_guard<std::mutex> lock(m_mutex);
+
 	// get or create a pool to allocate from
 	VkDescriptorPool poolToUse = GetPool();
 
@@ -99,6 +101,8 @@ VkDescriptorSet DescriptorPool::AllocateDescriptorSet(const VkDescriptorSetLayou
 
 void Grafkit::Core::DescriptorPool::DeallocateDescriptorSet(VkDescriptorSet descriptorSet)
 {
+	std::lock_guard<std::mutex> lock(m_mutex);
+
 	auto poolIt = m_descriptorPoolMap.find(descriptorSet);
 	assert(poolIt != m_descriptorPoolMap.end());
 
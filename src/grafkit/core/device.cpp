@@ -21,6 +21,7 @@ Device::Device(const Core::InstanceRef &instance)
 	CreateLogicalDevice();
 	CreateGraphicsQueue();
 	CreatePresentQueue();
+	CreateTransferQueue();
 	CreateCommandPool();
 
 	vkGetPhysicalDeviceProperties(m_physicalDevice, &m_deviceProperties);
@@ -44,12 +45,19 @@ Device::Device(const Core::InstanceRef &instance)
 			{VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, INITIAL_DESCRIPTOR_SET_SIZE},
 			{VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT, INITIAL_DESCRIPTOR_SET_SIZE},
 		}));
+
+	m_uploadManager = std::make_unique<Core::UploadManager>(MakeReference(*this));
+	m_geometryArena = std::make_unique<Core::GeometryArena>(MakeReference(*this));
+	m_uniformAllocator = std::make_unique<Core::UniformAllocator>(MakeReference(*this));
 }
 
 Device::~Device()
 {
 	WaitIdle();
 
+	m_uniformAllocator.reset();
+	m_geometryArena.reset();
+	m_uploadManager.reset();
 	m_descriptorPool.reset();
 
 	vmaDestroyAllocator(m_allocator);
@@ -65,6 +73,9 @@ void Device::WaitIdle() const
 
 VkCommandBuffer Device::BeginSingleTimeCommands() const
 {
+	// Released by EndSingleTimeCommands
+	m_singleTimeCommandMutex.lock();
+
 	VkCommandBuffer commandBuffer;
 	VkCommandBufferAllocateInfo allocInfo = {};
 	allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
@@ -92,10 +103,27 @@ void Device::EndSingleTimeCommands(const VkCommandBuffer &commandBuffer) const
 	submitInfo.commandBufferCount = 1;
 	submitInfo.pCommandBuffers = &commandBuffer;
 
-	vkQueueSubmit(m_graphicsQueue, 1, &submitInfo, VK_NULL_HANDLE);
-	vkQueueWaitIdle(m_graphicsQueue);
+	{
+		std::lock_guard<std::mutex> lock(m_queueMutex);
+		vkQueueSubmit(m_graphicsQueue, 1, &submitInfo, VK_NULL_HANDLE);
+		vkQueueWaitIdle(m_graphicsQueue);
+	}
 
 	vkFreeCommandBuffers(m_device, m_commandPool, 1, &commandBuffer);
+
+	m_singleTimeCommandMutex.unlock();
+}
+
+void Device::Submit(const VkQueue &queue, const VkSubmitInfo &submitInfo, const VkFence fence) const
+{
+	std::lock_guard<std::mutex> lock(m_queueMutex);
+	VK_CHECK_RESULT(vkQueueSubmit(queue, 1, &submitInfo, fence));
+}
+
+VkResult Device::Present(const VkPresentInfoKHR &presentInfo) const
+{
+	std::lock_guard<std::mutex> lock(m_queueMutex);
+	return vkQueuePresentKHR(m_presentQueue, &presentInfo);
 }
 
 [[nodiscard]] DescriptorPoolRef Device::GetDescriptorPool() const
@@ -103,6 +131,82 @@ void Device::EndSingleTimeCommands(const VkCommandBuffer &commandBuffer) const
 	return MakeReference(*m_descriptorPool);
 }
 
+[[nodiscard]] UploadManagerRef Device::GetUploadManager() const
+{
+	return MakeReference(*m_uploadManager);
+}
+
+[[nodiscard]] GeometryArenaRef Device::GetGeometryArena() const
+{
+	return MakeReference(*m_geometryArena);
+}
+
+[[nodiscard]] UniformAllocatorRef Device::GetUniformAllocator() const
+{
+	return MakeReference(*m_uniformAllocator);
+}
+
+void Device::QueueFlush(Buffer &buffer)
+{
+	const size_t begin = buffer.dirtyBegin;
+	const size_t end = buffer.dirtyEnd;
+	buffer.dirtyBegin = SIZE_MAX;
+	buffer.dirtyEnd = 0;
+	if (begin >= end || buffer.isCoherent)
+	{
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(m_flushMutex);
+	const auto it = std::find_if(m_queuedFlushes.begin(),
+		m_queuedFlushes.end(),
+		[&buffer](const QueuedFlush &queued) { return queued.allocation == buffer.allocation; });
+	if (it != m_queuedFlushes.end())
+	{
+		it->begin = std::min<VkDeviceSize>(it->begin, begin);
+		it->end = std::max<VkDeviceSize>(it->end, end);
+		return;
+	}
+	m_queuedFlushes.push_back({buffer.allocation, begin, end});
+}
+
+void Device::CancelFlush(const Buffer &buffer)
+{
+	std::lock_guard<std::mutex> lock(m_flushMutex);
+	std::erase_if(m_queuedFlushes,
+		[&buffer](const QueuedFlush &queued) { return queued.allocation == buffer.allocation; });
+}
+
+void Device::FlushQueued()
+{
+	std::lock_guard<std::mutex> lock(m_flushMutex);
+	if (m_queuedFlushes.empty())
+	{
+		return;
+	}
+
+	// One call for every buffer; the ranges are widened to the non-coherent atom size by VMA
+	std::vector<VmaAllocation> allocations;
+	std::vector<VkDeviceSize> offsets;
+	std::vector<VkDeviceSize> sizes;
+	for (const QueuedFlush &queued : m_queuedFlushes)
+	{
+		allocations.push_back(queued.allocation);
+		offsets.push_back(queued.begin);
+		sizes.push_back(queued.end - queued.begin);
+	}
+	m_queuedFlushes.clear();
+
+	if (vmaFlushAllocations(m_allocator,
+			static_cast<uint32_t>(allocations.size()),
+			allocations.data(),
+			offsets.data(),
+			sizes.data()) != VK_SUCCESS)
+	{
+		throw std::runtime_error("Failed to flush memory");
+	}
+}
+
 // -----------------------------------------------------------------------------------------------------------------------------------
 // MARK: Auxiliary methods
 
@@ -141,7 +245,11 @@ void Device::CreateLogicalDevice()
 {
 	const auto indices = GetQueueFamilies();
 
-	const std::set<uint32_t> uniqueQueueFamilies = {indices.graphicsFamily.value(), indices.presentFamily.value()};
+	std::set<uint32_t> uniqueQueueFamilies = {indices.graphicsFamily.value(), indices.presentFamily.value()};
+	if (indices.transferFamily.has_value())
+	{
+		uniqueQueueFamilies.insert(indices.transferFamily.value());
+	}
 	std::vector<VkDeviceQueueCreateInfo> queueCreateInfos;
 
 	float queuePriority = 1.0f;
@@ -161,9 +269,15 @@ void Device::CreateLogicalDevice()
 	vulkan13Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES;
 	vulkan13Features.synchronization2 = VK_TRUE;
 
+	// Uploads signal their tickets on a timeline semaphore
+	VkPhysicalDeviceVulkan12Features vulkan12Features{};
+	vulkan12Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+	vulkan12Features.pNext = &vulkan13Features;
+	vulkan12Features.timelineSemaphore = VK_TRUE;
+
 	VkPhysicalDeviceFeatures2 deviceFeatures2{};
 	deviceFeatures2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
-	deviceFeatures2.pNext = &vulkan13Features;
+	deviceFeatures2.pNext = &vulkan12Features;
 	deviceFeatures2.features = deviceFeatures;
 
 	VkDeviceCreateInfo createInfo{};
@@ -214,6 +328,17 @@ void Device::CreatePresentQueue()
 	vkGetDeviceQueue(m_device, indices.presentFamily.value(), 0, &m_presentQueue);
 }
 
+void Device::CreateTransferQueue()
+{
+	QueueFamilyIndices indices = GetQueueFamilies();
+	if (!indices.transferFamily.has_value())
+	{
+		m_transferQueue = m_graphicsQueue;
+		return;
+	}
+	vkGetDeviceQueue(m_device, indices.transferFamily.value(), 0, &m_transferQueue);
+}
+
 void Device::CreateCommandPool()
 {
 	QueueFamilyIndices indices = GetQueueFamilies();
@@ -258,20 +383,30 @@ QueueFamilyIndices Device::FindQueueFamilies(const VkPhysicalDevice &physicalDev
 	uint32_t index = 0;
 	for (const auto &queueFamily : queueFamilies)
 	{
-		if (queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT)
+		if (!indices.IsComplete())
 		{
-			indices.graphicsFamily = index;
-		}
+			if (queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT)
+			{
+				indices.graphicsFamily = index;
+			}
+
+			VkBool32 presentSupport = false;
+			vkGetPhysicalDeviceSurfaceSupportKHR(physicalDevice, index, m_instance->GetVkSurface(), &presentSupport);
 
-		VkBool32 presentSupport = false;
-		vkGetPhysicalDeviceSurfaceSupportKHR(physicalDevice, index, m_instance->GetVkSurface(), &presentSupport);
+			if (presentSupport)
+			{
+				indices.presentFamily = index;
+			}
+		}
 
-		if (presentSupport)
+		// Dedicated transfer families are usually backed by the copy engines of the GPU
+		if (!indices.transferFamily.has_value() && (queueFamily.queueFlags & VK_QUEUE_TRANSFER_BIT) &&
+			!(queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT))
 		{
-			indices.presentFamily = index;
+			indices.transferFamily = index;
 		}
 
-		if (indices.IsComplete())
+		if (indices.IsComplete() && indices.transferFamily.has_value())
 		{
 			break;
 		}
@@ -0,0 +1,280 @@
+#include "stdafx.h"
+
+#include "grafkit/core/device.h"
+#include "grafkit/core/geometry_arena.h"
+
+using namespace Grafkit::Core;
+
+GeometryArena::GeometryArena(const DeviceRef &device, const VkDeviceSize blockSize)
+	: m_device(device)
+	, m_blockSize(blockSize)
+{
+}
+
+GeometryArena::~GeometryArena()
+{
+	for (Block &block : m_blocks)
+	{
+		DestroyBlock(block);
+	}
+}
+
+// MARK: Public methods
+GeometryArena::Handle GeometryArena::Allocate(const VkDeviceSize vertexSize,
+	const VkDeviceSize vertexStride,
+	const VkDeviceSize indexSize)
+{
+	Entry entry{
+		.vertexSize = vertexSize,
+		.vertexStride = std::max(vertexStride, VkDeviceSize{1}),
+		.indexSize = indexSize,
+	};
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	bool isPlaced = false;
+	for (uint32_t i = 0; i < m_blocks.size() && !isPlaced; ++i)
+	{
+		entry.block = i;
+		isPlaced = m_blocks[i].allocator != VK_NULL_HANDLE && Place(m_blocks[i], entry);
+	}
+
+	if (!isPlaced)
+	{
+		const VkDeviceSize size = GetGeometryAllocationSize(entry.vertexSize, entry.vertexStride, entry.indexSize);
+		Block block = CreateBlock(std::max(m_blockSize, size));
+		if (!Place(block, entry))
+		{
+			DestroyBlock(block);
+			throw std::runtime_error("Failed to allocate geometry");
+		}
+
+		// Into the slot of a released block if there is one
+		const auto slot = std::find_if(m_blocks.begin(),
+			m_blocks.end(),
+			[](const Block &released) { return released.allocator == VK_NULL_HANDLE; });
+		entry.block = static_cast<uint32_t>(slot - m_blocks.begin());
+		if (slot != m_blocks.end())
+		{
+			*slot = block;
+		}
+		else
+		{
+			m_blocks.push_back(block);
+		}
+	}
+
+	if (!m_freeHandles.empty())
+	{
+		const Handle handle = m_freeHandles.back();
+		m_freeHandles.pop_back();
+		m_entries[handle] = entry;
+		return handle;
+	}
+
+	m_entries.push_back(entry);
+	return static_cast<Handle>(m_entries.size() - 1);
+}
+
+void GeometryArena::Free(const Handle handle)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	Entry &entry = m_entries.at(handle);
+	if (entry.allocation == VK_NULL_HANDLE)
+	{
+		throw std::logic_error("Geometry is already freed");
+	}
+
+	// Empty blocks are kept until the frames in flight are done binding them
+	Block &block = m_blocks[entry.block];
+	vmaVirtualFree(block.allocator, entry.allocation);
+	if (--block.allocationCount == 0)
+	{
+		block.emptySince = m_frameIndex;
+	}
+	entry = {};
+	m_freeHandles.push_back(handle);
+}
+
+GeometryRange GeometryArena::GetRange(const Handle handle) const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	const Entry &entry = m_entries.at(handle);
+	return {
+		.buffer = m_blocks[entry.block].buffer.buffer,
+		.vertexOffset = entry.vertexOffset,
+		.indexOffset = entry.indexOffset,
+		.generation = GetGeneration(),
+	};
+}
+
+void GeometryArena::BeginFrame()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	// Frames recorded up to this many frames ago are done by now
+	++m_frameIndex;
+	const uint64_t frameCount = m_device->GetMaxConcurrentFrames();
+	for (Block &block : m_blocks)
+	{
+		if (block.allocator != VK_NULL_HANDLE && block.allocationCount == 0 &&
+			block.emptySince + frameCount <= m_frameIndex)
+		{
+			DestroyBlock(block);
+		}
+	}
+	while (!m_blocks.empty() && m_blocks.back().allocator == VK_NULL_HANDLE)
+	{
+		m_blocks.pop_back();
+	}
+}
+
+void GeometryArena::Defragment()
+{
+	// Copies still on their way into the old blocks have to land first
+	const UploadManagerRef uploadManager = m_device->GetUploadManager();
+	uploadManager->Wait(uploadManager->Flush());
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	VkDeviceSize liveSize = 0;
+	for (const Entry &entry : m_entries)
+	{
+		if (entry.allocation != VK_NULL_HANDLE)
+		{
+			liveSize += GetGeometryAllocationSize(entry.vertexSize, entry.vertexStride, entry.indexSize);
+		}
+	}
+
+	// A fresh block fills up from its start, so the entries end up packed one after another
+	Block block = CreateBlock(std::max(m_blockSize, liveSize));
+	std::vector<Entry> entries = m_entries;
+	std::vector<std::vector<VkBufferCopy>> regions(m_blocks.size());
+	try
+	{
+		for (Entry &entry : entries)
+		{
+			if (entry.allocation == VK_NULL_HANDLE)
+			{
+				continue;
+			}
+
+			const Entry source = entry;
+			entry.block = 0;
+			if (!Place(block, entry))
+			{
+				throw std::runtime_error("Failed to defragment geometry");
+			}
+			if (entry.vertexSize != 0)
+			{
+				regions[source.block].push_back({source.vertexOffset, entry.vertexOffset, entry.vertexSize});
+			}
+			if (entry.indexSize != 0)
+			{
+				regions[source.block].push_back({source.indexOffset, entry.indexOffset, entry.indexSize});
+			}
+		}
+
+		// Single time commands wait for the graphics queue to go idle, that covers the frames reading the old blocks
+		VkCommandBuffer commandBuffer = m_device->BeginSingleTimeCommands();
+		for (size_t i = 0; i < m_blocks.size(); ++i)
+		{
+			if (!regions[i].empty())
+			{
+				vkCmdCopyBuffer(commandBuffer,
+					m_blocks[i].buffer.buffer,
+					block.buffer.buffer,
+					static_cast<uint32_t>(regions[i].size()),
+					regions[i].data());
+			}
+		}
+
+		VkMemoryBarrier barrier = Initializers::MemoryBarrier();
+		barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		barrier.dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT;
+		vkCmdPipelineBarrier(commandBuffer,
+			VK_PIPELINE_STAGE_TRANSFER_BIT,
+			VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
+			0,
+			1,
+			&barrier,
+			0,
+			nullptr,
+			0,
+			nullptr);
+		m_device->EndSingleTimeCommands(commandBuffer);
+	}
+	catch (...)
+	{
+		DestroyBlock(block);
+		throw;
+	}
+
+	for (Block &oldBlock : m_blocks)
+	{
+		DestroyBlock(oldBlock);
+	}
+	m_blocks = {block};
+	m_entries = std::move(entries);
+	m_generation.fetch_add(1, std::memory_order_release);
+}
+
+size_t GeometryArena::GetBlockCount() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return static_cast<size_t>(std::count_if(m_blocks.begin(),
+		m_blocks.end(),
+		[](const Block &block) { return block.allocator != VK_NULL_HANDLE; }));
+}
+
+// MARK: Auxiliary methods
+GeometryArena::Block GeometryArena::CreateBlock(const VkDeviceSize size) const
+{
+	Block block{};
+
+	// Vertices and indices share the buffer; it is a copy source when the arena is defragmented
+	block.buffer = Buffer::CreateBuffer(m_device,
+		size,
+		VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT |
+			VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+		VMA_MEMORY_USAGE_GPU_ONLY);
+
+	VmaVirtualBlockCreateInfo blockInfo{};
+	blockInfo.size = size;
+	if (vmaCreateVirtualBlock(&blockInfo, &block.allocator) != VK_SUCCESS)
+	{
+		block.buffer.Destroy(m_device);
+		throw std::runtime_error("Failed to create geometry allocator");
+	}
+
+	return block;
+}
+
+void GeometryArena::DestroyBlock(Block &block) const
+{
+	if (block.allocator == VK_NULL_HANDLE)
+	{
+		return;
+	}
+	vmaClearVirtualBlock(block.allocator);
+	vmaDestroyVirtualBlock(block.allocator);
+	block.buffer.Destroy(m_device);
+	block = {};
+}
+
+bool GeometryArena::Place(Block &block, Entry &entry) const
+{
+	const std::optional<GeometryLayout> layout =
+		AllocateGeometry(block.allocator, entry.vertexSize, entry.vertexStride, entry.indexSize, entry.allocation);
+	if (!layout.has_value())
+	{
+		return false;
+	}
+
+	entry.vertexOffset = layout->vertexOffset;
+	entry.indexOffset = layout->indexOffset;
+	++block.allocationCount;
+	return true;
+}
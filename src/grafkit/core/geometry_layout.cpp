@@ -0,0 +1,51 @@
+#include "stdafx.h"
+
+#include "grafkit/core/geometry_layout.h"
+
+using namespace Grafkit::Core;
+
+namespace
+{
+	// Strides of packed vertices are not powers of two, this works with any alignment
+	constexpr VkDeviceSize AlignUp(const VkDeviceSize value, const VkDeviceSize alignment)
+	{
+		return (value + alignment - 1) / alignment * alignment;
+	}
+} // namespace
+
+VkDeviceSize Grafkit::Core::GetGeometryAllocationSize(const VkDeviceSize vertexSize,
+	const VkDeviceSize vertexStride,
+	const VkDeviceSize indexSize)
+{
+	return vertexSize + vertexStride - 1 + indexSize + GEOMETRY_INDEX_ALIGNMENT - 1;
+}
+
+GeometryLayout Grafkit::Core::GetGeometryLayout(const VkDeviceSize offset,
+	const VkDeviceSize vertexSize,
+	const VkDeviceSize vertexStride)
+{
+	const VkDeviceSize vertexOffset = AlignUp(offset, vertexStride);
+	return {
+		.vertexOffset = vertexOffset,
+		.indexOffset = AlignUp(vertexOffset + vertexSize, GEOMETRY_INDEX_ALIGNMENT),
+	};
+}
+
+std::optional<GeometryLayout> Grafkit::Core::AllocateGeometry(const VmaVirtualBlock block,
+	const VkDeviceSize vertexSize,
+	const VkDeviceSize vertexStride,
+	const VkDeviceSize indexSize,
+	VmaVirtualAllocation &allocation)
+{
+	VmaVirtualAllocationCreateInfo allocInfo{};
+	allocInfo.size = GetGeometryAllocationSize(vertexSize, vertexStride, indexSize);
+	allocInfo.alignment = GEOMETRY_INDEX_ALIGNMENT;
+
+	VkDeviceSize offset = 0;
+	if (vmaVirtualAllocate(block, &allocInfo, &allocation, &offset) != VK_SUCCESS)
+	{
+		allocation = VK_NULL_HANDLE;
+		return std::nullopt;
+	}
+	return GetGeometryLayout(offset, vertexSize, vertexStride);
+}
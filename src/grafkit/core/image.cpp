@@ -1,15 +1,69 @@
 #include "stdafx.h"
 
-#include "grafkit/core/buffer.h"
 #include "grafkit/core/device.h"
 #include "grafkit/core/image.h"
 #include "grafkit/core/initializers.h"
+#include "grafkit/core/mip_chain.h"
 #include "grafkit/core/vulkan_utils.h"
 
 using namespace Grafkit::Core;
 
 constexpr bool USE_IMAGE_MEMORY_BARRIER_2 = true;
 
+namespace
+{
+	uint32_t GetLevelCount(const VkExtent3D size, const bool mipmapped)
+	{
+		return mipmapped ? GetMipLevelCount(size) : 1;
+	}
+
+	bool CanBlitMipChain(const DeviceRef &device, const VkFormat format)
+	{
+		constexpr VkFormatFeatureFlags features = VK_FORMAT_FEATURE_BLIT_SRC_BIT | VK_FORMAT_FEATURE_BLIT_DST_BIT |
+			VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT;
+
+		VkFormatProperties properties{};
+		vkGetPhysicalDeviceFormatProperties(device->GetVkPhysicalDevice(), format, &properties);
+		return (properties.optimalTilingFeatures & features) == features;
+	}
+
+	struct MipChannels
+	{
+		MipChannelType type;
+		uint32_t count;
+	};
+
+	// Formats the mip chain can be filtered on the CPU for
+	MipChannels GetMipChannels(const VkFormat format)
+	{
+		switch (format)
+		{
+		case VK_FORMAT_R8_UNORM:
+			return {MipChannelType::Unorm8, 1};
+		case VK_FORMAT_R8G8_UNORM:
+			return {MipChannelType::Unorm8, 2};
+		case VK_FORMAT_R8G8B8A8_UNORM:
+		case VK_FORMAT_B8G8R8A8_UNORM:
+			return {MipChannelType::Unorm8, 4};
+		case VK_FORMAT_R32_SFLOAT:
+			return {MipChannelType::Float32, 1};
+		case VK_FORMAT_R32G32_SFLOAT:
+			return {MipChannelType::Float32, 2};
+		case VK_FORMAT_R32G32B32A32_SFLOAT:
+			return {MipChannelType::Float32, 4};
+		default:
+			throw std::runtime_error("Mip chain cannot be generated for format: " + std::to_string(format));
+		}
+	}
+
+	VkImageAspectFlags GetAspectMask(const VkFormat format)
+	{
+		// if the format is a depth format, we will need to have it use the correct
+		// aspect flag
+		return format == VK_FORMAT_D32_SFLOAT ? VK_IMAGE_ASPECT_DEPTH_BIT : VK_IMAGE_ASPECT_COLOR_BIT;
+	}
+} // namespace
+
 Grafkit::Core::Image::Image(const DeviceRef &device,
 	const VkImage &image,
 	const VkImageView &imageView,
@@ -25,6 +79,11 @@ Grafkit::Core::Image::Image(const DeviceRef &device,
 
 Grafkit::Core::Image::~Image()
 {
+	// The copy may still be reading into the image
+	if (m_uploadTicket != 0)
+	{
+		m_device->GetUploadManager()->Wait(m_uploadTicket);
+	}
 	vkDestroyImageView(**m_device, m_imageView, nullptr);
 	if (m_allocation.has_value())
 	{
@@ -32,6 +91,11 @@ Grafkit::Core::Image::~Image()
 	}
 }
 
+bool Image::IsReady() const
+{
+	return m_uploadTicket == 0 || m_device->GetUploadManager()->IsComplete(m_uploadTicket);
+}
+
 /// ---------------------------------------------------------------------------------------------
 
 ImagePtr Image::CreateImage(const DeviceRef &device,
@@ -47,10 +111,7 @@ ImagePtr Image::CreateImage(const DeviceRef &device,
 
 	VkImageCreateInfo imageInfo = Initializers::ImageCreateInfo(type, size, format, usage);
 
-	if (mipmapped)
-	{
-		imageInfo.mipLevels = static_cast<uint32_t>(std::floor(std::log2(std::max(size.width, size.height)))) + 1;
-	}
+	imageInfo.mipLevels = GetLevelCount(size, mipmapped);
 
 	// always allocate images on dedicated GPU memory
 	VmaAllocationCreateInfo allocInfo = {};
@@ -60,13 +121,7 @@ ImagePtr Image::CreateImage(const DeviceRef &device,
 	// allocate and create the image
 	VK_CHECK_RESULT(vmaCreateImage(device->GetVmaAllocator(), &imageInfo, &allocInfo, &image, &allocation, nullptr));
 
-	// if the format is a depth format, we will need to have it use the correct
-	// aspect flag
-	VkImageAspectFlags aspectFlag = VK_IMAGE_ASPECT_COLOR_BIT;
-	if (format == VK_FORMAT_D32_SFLOAT)
-	{
-		aspectFlag = VK_IMAGE_ASPECT_DEPTH_BIT;
-	}
+	const VkImageAspectFlags aspectFlag = GetAspectMask(format);
 
 	VkImageView imageView = VK_NULL_HANDLE;
 
@@ -102,21 +157,14 @@ ImagePtr Image::CreateImage(const DeviceRef &device,
 ImagePtr Image::CreateImage(const DeviceRef &device,
 	const void *data,
 	const VkExtent3D size,
-	const uint32_t channels,
+	const uint32_t bytesPerPixel,
 	const VkFormat format,
 	const VkImageType type,
 	const bool mipmapped,
 	const VkImageUsageFlags usage,
 	const VkImageLayout layout)
 {
-	const size_t dataSize = size.depth * size.width * size.height * channels;
-	Buffer uploadbuffer =
-		Buffer::CreateBuffer(device, dataSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VMA_MEMORY_USAGE_CPU_TO_GPU);
-
-	if (data != nullptr)
-	{
-		uploadbuffer.Update(device, data, dataSize);
-	}
+	const size_t dataSize = size_t{size.depth} * size.width * size.height * bytesPerPixel;
 
 	ImagePtr newImage = Image::CreateImage(device,
 		size,
@@ -126,36 +174,39 @@ ImagePtr Image::CreateImage(const DeviceRef &device,
 		usage | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
 		layout);
 
-	auto *commandBuffer = device->BeginSingleTimeCommands();
-
-	TransitionImageLayout(commandBuffer,
-		newImage->GetImage(),
-		VK_IMAGE_LAYOUT_UNDEFINED,
-		VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
-
-	VkBufferImageCopy copyRegion = {};
-	copyRegion.bufferOffset = 0;
-	copyRegion.bufferRowLength = 0;
-	copyRegion.bufferImageHeight = 0;
-
-	copyRegion.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-	copyRegion.imageSubresource.mipLevel = 0;
-	copyRegion.imageSubresource.baseArrayLayer = 0;
-	copyRegion.imageSubresource.layerCount = 1;
-	copyRegion.imageExtent = size;
-
-	vkCmdCopyBufferToImage(commandBuffer,
-		uploadbuffer.buffer,
-		newImage->GetImage(),
-		VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-		1,
-		&copyRegion);
-
-	TransitionImageLayout(commandBuffer, newImage->GetImage(), VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, layout);
-
-	device->EndSingleTimeCommands(commandBuffer);
+	ImageUploadRegion region{
+		.image = newImage->GetImage(),
+		.extent = size,
+		.size = dataSize,
+		.mipLevels = GetLevelCount(size, mipmapped),
+		.aspectMask = GetAspectMask(format),
+		.layout = layout,
+	};
+
+	// No queue wait here, the copy goes with the other uploads of the batch. The mip chain is blitted on the GPU
+	// after it, unless the format cannot be blitted, then it is filtered on the CPU right into the staging memory.
+	if (region.mipLevels == 1 || CanBlitMipChain(device, format))
+	{
+		newImage->m_uploadTicket = device->GetUploadManager()->Upload(region, data);
+		return newImage;
+	}
 
-	uploadbuffer.Destroy(device);
+	const MipChannels channels = GetMipChannels(format);
+	region.stagedLevels = region.mipLevels;
+	newImage->m_uploadTicket = device->GetUploadManager()->Upload(region,
+		[&](const std::span<uint8_t> staging)
+		{
+			if (data != nullptr)
+			{
+				std::memcpy(staging.data(), data, dataSize);
+			}
+			else
+			{
+				std::memset(staging.data(), 0, dataSize);
+			}
+			GenerateMipChain(
+				staging, GetMipChainLayout(size, region.mipLevels, bytesPerPixel), channels.count, channels.type);
+		});
 
 	return newImage;
 }
@@ -0,0 +1,36 @@
+#include "stdafx.h"
+
+#include "grafkit/core/linear_allocator.h"
+
+using namespace Grafkit::Core;
+
+LinearAllocator::LinearAllocator(const VkDeviceSize size, const VkDeviceSize alignment)
+	: m_size(size)
+	, m_alignment(std::max(alignment, VkDeviceSize{1}))
+{
+	if ((m_alignment & (m_alignment - 1)) != 0)
+	{
+		throw std::invalid_argument("Alignment is not a power of two");
+	}
+}
+
+void LinearAllocator::Reset()
+{
+	m_head.store(0, std::memory_order_relaxed);
+}
+
+std::optional<VkDeviceSize> LinearAllocator::Allocate(const VkDeviceSize size)
+{
+	// The head keeps the padding up to the next aligned offset, so every offset handed out stays aligned
+	const VkDeviceSize offset = m_head.fetch_add(AlignUp(size, m_alignment), std::memory_order_relaxed);
+	if (offset + size > m_size)
+	{
+		return std::nullopt;
+	}
+	return offset;
+}
+
+VkDeviceSize LinearAllocator::GetUsedSize() const
+{
+	return std::min(m_head.load(std::memory_order_relaxed), m_size);
+}
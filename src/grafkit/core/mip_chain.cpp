@@ -0,0 +1,179 @@
+#include "stdafx.h"
+
+#include <cmath>
+
+#include "grafkit/core/mip_chain.h"
+
+using namespace Grafkit::Core;
+
+namespace
+{
+	constexpr size_t AlignUp(const size_t value, const size_t alignment)
+	{
+		return (value + alignment - 1) / alignment * alignment;
+	}
+
+	VkExtent3D GetNextExtent(const VkExtent3D extent)
+	{
+		return {std::max(extent.width / 2, 1u), std::max(extent.height / 2, 1u), std::max(extent.depth / 2, 1u)};
+	}
+
+	// Source texels of a destination texel along one axis; the last one takes the odd texel as well
+	struct Footprint
+	{
+		uint32_t begin = 0;
+		uint32_t end = 0;
+	};
+
+	std::vector<Footprint> GetFootprints(const uint32_t sourceSize, const uint32_t size)
+	{
+		std::vector<Footprint> footprints(size);
+		for (uint32_t i = 0; i < size; ++i)
+		{
+			footprints[i] = {
+				static_cast<uint32_t>(uint64_t{i} * sourceSize / size),
+				static_cast<uint32_t>(uint64_t{i + 1} * sourceSize / size),
+			};
+		}
+		return footprints;
+	}
+
+	template <typename T> struct Accumulator;
+
+	template <> struct Accumulator<uint8_t>
+	{
+		using Type = uint32_t;
+
+		static uint8_t Resolve(const uint32_t sum, const uint32_t count)
+		{
+			return static_cast<uint8_t>((sum + count / 2) / count);
+		}
+	};
+
+	template <> struct Accumulator<float>
+	{
+		using Type = float;
+
+		static float Resolve(const float sum, const uint32_t count)
+		{
+			return sum / static_cast<float>(count);
+		}
+	};
+
+	template <typename T>
+	void Downsample(const std::span<const uint8_t> sourceData,
+		const MipLevel &source,
+		const std::span<uint8_t> destinationData,
+		const MipLevel &destination,
+		const uint32_t channels)
+	{
+		using Sum = typename Accumulator<T>::Type;
+
+		const auto xs = GetFootprints(source.extent.width, destination.extent.width);
+		const auto ys = GetFootprints(source.extent.height, destination.extent.height);
+		const auto zs = GetFootprints(source.extent.depth, destination.extent.depth);
+
+		const size_t rowPitch = size_t{source.extent.width} * channels * sizeof(T);
+		const size_t slicePitch = rowPitch * source.extent.height;
+
+		// Channels are read and written through memcpy, the data does not have to be aligned for T
+		std::vector<Sum> sums(channels);
+		uint8_t *texel = destinationData.data();
+		for (const Footprint &z : zs)
+		{
+			for (const Footprint &y : ys)
+			{
+				for (const Footprint &x : xs)
+				{
+					std::fill(sums.begin(), sums.end(), Sum{0});
+					for (uint32_t sz = z.begin; sz < z.end; ++sz)
+					{
+						for (uint32_t sy = y.begin; sy < y.end; ++sy)
+						{
+							const uint8_t *row = sourceData.data() + sz * slicePitch + sy * rowPitch;
+							for (uint32_t sx = x.begin; sx < x.end; ++sx)
+							{
+								const uint8_t *sample = row + size_t{sx} * channels * sizeof(T);
+								for (uint32_t c = 0; c < channels; ++c)
+								{
+									T value;
+									std::memcpy(&value, sample + c * sizeof(T), sizeof(T));
+									sums[c] += static_cast<Sum>(value);
+								}
+							}
+						}
+					}
+
+					const uint32_t count = (x.end - x.begin) * (y.end - y.begin) * (z.end - z.begin);
+					for (uint32_t c = 0; c < channels; ++c)
+					{
+						const T value = Accumulator<T>::Resolve(sums[c], count);
+						std::memcpy(texel, &value, sizeof(T));
+						texel += sizeof(T);
+					}
+				}
+			}
+		}
+	}
+} // namespace
+
+uint32_t Grafkit::Core::GetMipLevelCount(const VkExtent3D extent)
+{
+	const uint32_t size = std::max({extent.width, extent.height, extent.depth, 1u});
+	return static_cast<uint32_t>(std::floor(std::log2(size))) + 1;
+}
+
+std::vector<MipLevel> Grafkit::Core::GetMipChainLayout(const VkExtent3D extent,
+	const uint32_t levelCount,
+	const size_t pixelSize)
+{
+	std::vector<MipLevel> levels;
+	levels.reserve(levelCount);
+
+	VkExtent3D levelExtent = extent;
+	size_t offset = 0;
+	for (uint32_t i = 0; i < levelCount; ++i)
+	{
+		offset = AlignUp(offset, MIP_LEVEL_ALIGNMENT);
+		const size_t size = size_t{levelExtent.width} * levelExtent.height * levelExtent.depth * pixelSize;
+		levels.push_back({levelExtent, offset, size});
+		offset += size;
+		levelExtent = GetNextExtent(levelExtent);
+	}
+	return levels;
+}
+
+size_t Grafkit::Core::GetMipChainSize(const VkExtent3D extent, const uint32_t levelCount, const size_t pixelSize)
+{
+	const auto levels = GetMipChainLayout(extent, levelCount, pixelSize);
+	return levels.empty() ? 0 : levels.back().offset + levels.back().size;
+}
+
+void Grafkit::Core::GenerateMipChain(const std::span<uint8_t> data,
+	const std::span<const MipLevel> levels,
+	const uint32_t channels,
+	const MipChannelType type)
+{
+	if (!levels.empty() && levels.back().offset + levels.back().size > data.size())
+	{
+		throw std::invalid_argument("Mip chain does not fit the data");
+	}
+
+	for (size_t i = 1; i < levels.size(); ++i)
+	{
+		const MipLevel &source = levels[i - 1];
+		const MipLevel &destination = levels[i];
+		const auto sourceData = std::span<const uint8_t>(data.subspan(source.offset, source.size));
+		const auto destinationData = data.subspan(destination.offset, destination.size);
+
+		switch (type)
+		{
+		case MipChannelType::Unorm8:
+			Downsample<uint8_t>(sourceData, source, destinationData, destination, channels);
+			break;
+		case MipChannelType::Float32:
+			Downsample<float>(sourceData, source, destinationData, destination, channels);
+			break;
+		}
+	}
+}
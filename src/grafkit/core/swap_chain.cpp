@@ -86,7 +86,9 @@ void SwapChain::SubmitCommandBuffer(const VkCommandBuffer &commandBuffer)
 	submitInfo.signalSemaphoreCount = 1;
 	submitInfo.pSignalSemaphores = &m_renderFinishedSemaphores[m_currentFrame];
 
-	VK_CHECK_RESULT(vkQueueSubmit(m_device->GetVkGraphicsQueue(), 1, &submitInfo, m_inFlightFences[m_currentFrame]));
+	// Uploads made since the last frame reach the graphics queue ahead of it
+	m_device->GetUploadManager()->Flush();
+	m_device->Submit(m_device->GetVkGraphicsQueue(), submitInfo, m_inFlightFences[m_currentFrame]);
 }
 
 void SwapChain::Present()
@@ -100,7 +102,7 @@ void SwapChain::Present()
 	presentInfo.pSwapchains = &m_swapChain;
 	presentInfo.pImageIndices = &m_imageIndex;
 
-	const auto result = vkQueuePresentKHR(m_device->GetVkPresentQueue(), &presentInfo);
+	const auto result = m_device->Present(presentInfo);
 
 	if ((result == VK_ERROR_OUT_OF_DATE_KHR) || (result == VK_SUBOPTIMAL_KHR))
 	{
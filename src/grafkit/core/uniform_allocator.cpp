@@ -0,0 +1,58 @@
+#include "stdafx.h"
+
+#include "grafkit/core/device.h"
+#include "grafkit/core/uniform_allocator.h"
+
+using namespace Grafkit::Core;
+
+UniformAllocator::UniformAllocator(const DeviceRef &device, const VkDeviceSize frameSize)
+	: m_device(device)
+	, m_alignment(std::max(device->GetDeviceLimits().minUniformBufferOffsetAlignment, VkDeviceSize{1}))
+	, m_frameSize(LinearAllocator::AlignUp(frameSize, m_alignment))
+	, m_frame(m_frameSize, m_alignment)
+{
+	m_buffer = Buffer::CreateBuffer(m_device,
+		m_frameSize * m_device->GetMaxConcurrentFrames(),
+		VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+		VMA_MEMORY_USAGE_CPU_TO_GPU);
+}
+
+UniformAllocator::~UniformAllocator()
+{
+	m_buffer.Destroy(m_device);
+}
+
+// MARK: Public methods
+void UniformAllocator::BeginFrame(const uint32_t frameIndex)
+{
+	assert(frameIndex < m_device->GetMaxConcurrentFrames());
+	m_frameOffset = m_frameSize * frameIndex;
+	m_frame.Reset();
+}
+
+void UniformAllocator::EndFrame()
+{
+	const VkDeviceSize size = m_frame.GetUsedSize();
+	if (size == 0)
+	{
+		return;
+	}
+
+	m_buffer.MarkDirty(static_cast<size_t>(m_frameOffset), static_cast<size_t>(size));
+	m_device->QueueFlush(m_buffer);
+}
+
+UniformAllocation UniformAllocator::Allocate(const VkDeviceSize size)
+{
+	const std::optional<VkDeviceSize> offset = m_frame.Allocate(size);
+	if (!offset.has_value())
+	{
+		throw std::runtime_error("Out of uniform memory for the frame");
+	}
+
+	return {
+		.buffer = m_buffer.buffer,
+		.offset = static_cast<uint32_t>(m_frameOffset + *offset),
+		.data = std::span<uint8_t>(m_buffer.mappedData + m_frameOffset + *offset, size),
+	};
+}
@@ -0,0 +1,779 @@
+#include "stdafx.h"
+
+#include "grafkit/core/device.h"
+#include "grafkit/core/mip_chain.h"
+#include "grafkit/core/upload_manager.h"
+
+using namespace Grafkit::Core;
+
+namespace
+{
+	// Keeps every staged range aligned for the copies, whatever it holds
+	constexpr VkDeviceSize STAGING_ALIGNMENT = 16;
+
+	constexpr VkDeviceSize AlignUp(const VkDeviceSize value, const VkDeviceSize alignment)
+	{
+		return (value + alignment - 1) / alignment * alignment;
+	}
+
+	VkImageSubresourceRange GetSubresourceRange(const ImageUploadRegion &region,
+		const uint32_t baseLevel,
+		const uint32_t levelCount)
+	{
+		VkImageSubresourceRange range{};
+		range.aspectMask = region.aspectMask;
+		range.baseMipLevel = baseLevel;
+		range.levelCount = levelCount;
+		range.baseArrayLayer = 0;
+		range.layerCount = 1;
+		return range;
+	}
+
+	VkDeviceSize GetPixelSize(const ImageUploadRegion &region)
+	{
+		const VkDeviceSize texelCount = VkDeviceSize{region.extent.width} * region.extent.height * region.extent.depth;
+		return texelCount != 0 ? region.size / texelCount : 0;
+	}
+
+	bool HasMipChain(const ImageUploadRegion &region)
+	{
+		return region.stagedLevels < region.mipLevels;
+	}
+
+	VkOffset3D ToOffset(const VkExtent3D extent)
+	{
+		return {
+			static_cast<int32_t>(extent.width),
+			static_cast<int32_t>(extent.height),
+			static_cast<int32_t>(extent.depth),
+		};
+	}
+} // namespace
+
+UploadManager::UploadManager(const DeviceRef &device, const VkDeviceSize stagingSize)
+	: m_device(device)
+	, m_stagingSize(stagingSize)
+{
+	const QueueFamilyIndices families = m_device->GetQueueFamilies();
+	m_graphicsFamily = families.graphicsFamily.value();
+	m_transferFamily = families.transferFamily.value_or(m_graphicsFamily);
+
+	VkCommandPoolCreateInfo poolInfo = Initializers::CommandPoolCreateInfo();
+	poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+	poolInfo.queueFamilyIndex = m_graphicsFamily;
+	VK_CHECK_RESULT(vkCreateCommandPool(**m_device, &poolInfo, nullptr, &m_graphicsPool));
+
+	if (HasTransferQueue())
+	{
+		poolInfo.queueFamilyIndex = m_transferFamily;
+		VK_CHECK_RESULT(vkCreateCommandPool(**m_device, &poolInfo, nullptr, &m_transferPool));
+	}
+
+	VkSemaphoreTypeCreateInfo timelineInfo{};
+	timelineInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+	timelineInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+	timelineInfo.initialValue = 0;
+
+	VkSemaphoreCreateInfo semaphoreInfo = Initializers::SemaphoreCreateInfo();
+	semaphoreInfo.pNext = &timelineInfo;
+	VK_CHECK_RESULT(vkCreateSemaphore(**m_device, &semaphoreInfo, nullptr, &m_timeline));
+
+	// The ring stays mapped for its whole life
+	m_staging =
+		Buffer::CreateBuffer(m_device, m_stagingSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VMA_MEMORY_USAGE_CPU_ONLY);
+	m_stagingData = m_staging.mappedData;
+}
+
+UploadManager::~UploadManager()
+{
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		FlushLocked(lock);
+		while (!m_batches.empty())
+		{
+			WaitOldest();
+		}
+	}
+
+	for (const VkSemaphore semaphore : m_freeSemaphores)
+	{
+		vkDestroySemaphore(**m_device, semaphore, nullptr);
+	}
+	vkDestroySemaphore(**m_device, m_timeline, nullptr);
+	if (m_transferPool != VK_NULL_HANDLE)
+	{
+		vkDestroyCommandPool(**m_device, m_transferPool, nullptr);
+	}
+	vkDestroyCommandPool(**m_device, m_graphicsPool, nullptr);
+	m_staging.Destroy(m_device);
+}
+
+// MARK: Public methods
+uint64_t UploadManager::Upload(const std::span<const UploadRegion> regions, const Writer &writer)
+{
+	std::vector<VkDeviceSize> offsets;
+	offsets.reserve(regions.size());
+	VkDeviceSize stagingSize = 0;
+	for (const UploadRegion &region : regions)
+	{
+		stagingSize = AlignUp(stagingSize, STAGING_ALIGNMENT);
+		offsets.push_back(stagingSize);
+		stagingSize += region.size;
+	}
+
+	const auto write = [&](const std::span<uint8_t> staging)
+	{
+		std::vector<std::span<uint8_t>> ranges;
+		ranges.reserve(regions.size());
+		for (size_t i = 0; i < regions.size(); ++i)
+		{
+			ranges.push_back(staging.subspan(offsets[i], regions[i].size));
+		}
+		writer(ranges);
+	};
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+	VkDeviceSize stagingOffset = 0;
+	const VkBuffer source = Stage(stagingSize, write, stagingOffset, lock);
+
+	for (size_t i = 0; i < regions.size(); ++i)
+	{
+		if (regions[i].size == 0)
+		{
+			continue;
+		}
+		m_copies.push_back({
+			.source = source,
+			.destination = regions[i].destination,
+			.region = {stagingOffset + offsets[i], regions[i].offset, regions[i].size},
+			.dstStageMask = regions[i].dstStageMask,
+			.dstAccessMask = regions[i].dstAccessMask,
+		});
+	}
+
+	return m_nextTicket;
+}
+
+uint64_t UploadManager::Upload(const UploadRegion &region, const void *data)
+{
+	return Upload(std::span<const UploadRegion>(&region, 1),
+		[&region, data](const std::span<const std::span<uint8_t>> staging)
+		{ std::memcpy(staging[0].data(), data, region.size); });
+}
+
+uint64_t UploadManager::Upload(const ImageUploadRegion &region, const std::function<void(std::span<uint8_t>)> &writer)
+{
+	const VkDeviceSize stagingSize = GetMipChainSize(region.extent, region.stagedLevels, GetPixelSize(region));
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+	VkDeviceSize stagingOffset = 0;
+	const VkBuffer source = Stage(stagingSize, writer, stagingOffset, lock);
+	m_imageCopies.push_back({
+		.source = source,
+		.sourceOffset = stagingOffset,
+		.target = region,
+	});
+
+	return m_nextTicket;
+}
+
+uint64_t UploadManager::Upload(const ImageUploadRegion &region, const void *data)
+{
+	return Upload(region,
+		[data](const std::span<uint8_t> staging)
+		{
+			if (data != nullptr)
+			{
+				std::memcpy(staging.data(), data, staging.size());
+			}
+			else
+			{
+				std::memset(staging.data(), 0, staging.size());
+			}
+		});
+}
+
+uint64_t UploadManager::Flush()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	return FlushLocked(lock);
+}
+
+bool UploadManager::IsComplete(const uint64_t ticket)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	Collect();
+	return ticket <= m_completedTicket;
+}
+
+void UploadManager::Wait(const uint64_t ticket)
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	if (ticket >= m_nextTicket)
+	{
+		FlushLocked(lock);
+	}
+
+	// The ticket of a dropped batch is handed to the next one, nothing signals it until that is submitted
+	const uint64_t target = std::min(ticket, m_nextTicket - 1);
+	if (target <= m_completedTicket)
+	{
+		return;
+	}
+
+	// Other threads keep on uploading while this one waits
+	lock.unlock();
+	VkSemaphoreWaitInfo waitInfo{};
+	waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+	waitInfo.semaphoreCount = 1;
+	waitInfo.pSemaphores = &m_timeline;
+	waitInfo.pValues = &target;
+	VK_CHECK_RESULT(vkWaitSemaphores(**m_device, &waitInfo, UINT64_MAX));
+
+	lock.lock();
+	Collect();
+}
+
+// MARK: Auxiliary methods
+VkBuffer UploadManager::Stage(const VkDeviceSize size,
+	const std::function<void(std::span<uint8_t>)> &write,
+	VkDeviceSize &offset,
+	std::unique_lock<std::mutex> &lock)
+{
+	if (size > m_stagingSize)
+	{
+		lock.unlock();
+		Buffer staging =
+			Buffer::CreateBuffer(m_device, size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VMA_MEMORY_USAGE_CPU_ONLY);
+		try
+		{
+			staging.Write(m_device, size, write);
+		}
+		catch (...)
+		{
+			staging.Destroy(m_device);
+			throw;
+		}
+
+		lock.lock();
+		m_dedicatedStaging.push_back(staging);
+		offset = 0;
+		return staging.buffer;
+	}
+
+	// The range belongs to the pending batch, which is not submitted until the writer is done with it
+	offset = Reserve(size, lock);
+	++m_writerCount;
+	lock.unlock();
+
+	std::exception_ptr error;
+	try
+	{
+		write(std::span<uint8_t>(m_stagingData + offset, size));
+		// Writers share the ring, so each flushes its own range rather than going through the dirty range of the buffer
+		if (!m_staging.isCoherent &&
+			vmaFlushAllocation(m_device->GetVmaAllocator(), m_staging.allocation, offset, size) != VK_SUCCESS)
+		{
+			throw std::runtime_error("Failed to flush memory");
+		}
+	}
+	catch (...)
+	{
+		error = std::current_exception();
+	}
+
+	lock.lock();
+	--m_writerCount;
+	m_writersDone.notify_all();
+	if (error)
+	{
+		std::rethrow_exception(error);
+	}
+	return m_staging.buffer;
+}
+
+VkDeviceSize UploadManager::Reserve(const VkDeviceSize size, std::unique_lock<std::mutex> &lock)
+{
+	while (true)
+	{
+		if (m_head == m_tail)
+		{
+			m_head = 0;
+			m_tail = 0;
+		}
+
+		// The head never catches up with the tail, they only meet when the ring is empty
+		const VkDeviceSize offset = AlignUp(m_head, STAGING_ALIGNMENT);
+		if (m_head >= m_tail)
+		{
+			if (offset + size <= m_stagingSize)
+			{
+				m_head = offset + size;
+				return offset;
+			}
+			if (size < m_tail)
+			{
+				m_head = size;
+				return 0;
+			}
+		}
+		else if (offset + size < m_tail)
+		{
+			m_head = offset + size;
+			return offset;
+		}
+
+		// Out of space, submit what is pending and wait for the oldest batch to give its range back
+		if (m_batches.empty())
+		{
+			FlushLocked(lock);
+			continue;
+		}
+		WaitOldest();
+	}
+}
+
+uint64_t UploadManager::FlushLocked(std::unique_lock<std::mutex> &lock)
+{
+	m_writersDone.wait(lock, [this]() { return m_writerCount == 0; });
+	Collect();
+
+	if (m_copies.empty() && m_imageCopies.empty())
+	{
+		// Ranges of failed writers may still be reserved, nothing is left to read them
+		if (m_batches.empty())
+		{
+			m_tail = m_head;
+		}
+		return m_nextTicket - 1;
+	}
+
+	Batch batch{
+		.ticket = m_nextTicket,
+		.stagingEnd = m_head,
+		.dedicatedStaging = std::move(m_dedicatedStaging),
+	};
+	m_dedicatedStaging.clear();
+
+	try
+	{
+		Record(batch);
+	}
+	catch (...)
+	{
+		// The uploads of the batch are dropped; its ticket was never signalled, so the next batch takes it over
+		m_copies.clear();
+		m_imageCopies.clear();
+		Release(batch);
+		if (m_batches.empty())
+		{
+			m_tail = m_head;
+		}
+		throw;
+	}
+
+	m_copies.clear();
+	m_imageCopies.clear();
+	m_batches.push_back(std::move(batch));
+	return m_nextTicket++;
+}
+
+void UploadManager::Record(Batch &batch)
+{
+	const bool hasTransferQueue = HasTransferQueue();
+	batch.transferCommands = BeginCommands(hasTransferQueue ? m_transferPool : m_graphicsPool);
+
+	// Images take their copies in the transfer layout
+	std::vector<VkImageMemoryBarrier> imageBarriers;
+	imageBarriers.reserve(m_imageCopies.size());
+	for (const ImageCopy &copy : m_imageCopies)
+	{
+		VkImageMemoryBarrier &barrier = imageBarriers.emplace_back(Initializers::ImageMemoryBarrier());
+		barrier.srcAccessMask = 0;
+		barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+		barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+		barrier.image = copy.target.image;
+		barrier.subresourceRange = GetSubresourceRange(copy.target, 0, copy.target.mipLevels);
+	}
+	if (!imageBarriers.empty())
+	{
+		vkCmdPipelineBarrier(batch.transferCommands,
+			VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+			VK_PIPELINE_STAGE_TRANSFER_BIT,
+			0,
+			0,
+			nullptr,
+			0,
+			nullptr,
+			static_cast<uint32_t>(imageBarriers.size()),
+			imageBarriers.data());
+	}
+
+	// Consecutive copies between the same two buffers go in one command
+	std::vector<VkBufferCopy> regions;
+	for (size_t first = 0; first < m_copies.size();)
+	{
+		regions.clear();
+		size_t last = first;
+		while (last < m_copies.size() && m_copies[last].source == m_copies[first].source &&
+			m_copies[last].destination == m_copies[first].destination)
+		{
+			regions.push_back(m_copies[last++].region);
+		}
+		vkCmdCopyBuffer(batch.transferCommands,
+			m_copies[first].source,
+			m_copies[first].destination,
+			static_cast<uint32_t>(regions.size()),
+			regions.data());
+		first = last;
+	}
+
+	std::vector<VkBufferImageCopy> imageRegions;
+	for (const ImageCopy &copy : m_imageCopies)
+	{
+		imageRegions.clear();
+		const auto levels =
+			GetMipChainLayout(copy.target.extent, copy.target.stagedLevels, GetPixelSize(copy.target));
+		for (uint32_t level = 0; level < levels.size(); ++level)
+		{
+			VkBufferImageCopy &region = imageRegions.emplace_back();
+			region.bufferOffset = copy.sourceOffset + levels[level].offset;
+			region.imageSubresource.aspectMask = copy.target.aspectMask;
+			region.imageSubresource.mipLevel = level;
+			region.imageSubresource.baseArrayLayer = 0;
+			region.imageSubresource.layerCount = 1;
+			region.imageExtent = levels[level].extent;
+		}
+		vkCmdCopyBufferToImage(batch.transferCommands,
+			copy.source,
+			copy.target.image,
+			VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+			static_cast<uint32_t>(imageRegions.size()),
+			imageRegions.data());
+	}
+
+	// Hands the data over to its readers, with a transfer queue these also release the resources to graphics
+	VkPipelineStageFlags dstStageMask = 0;
+	VkAccessFlags bufferAccessMask = 0;
+	std::vector<VkBufferMemoryBarrier> bufferBarriers;
+	for (const Copy &copy : m_copies)
+	{
+		dstStageMask |= copy.dstStageMask;
+		bufferAccessMask |= copy.dstAccessMask;
+		if (hasTransferQueue)
+		{
+			VkBufferMemoryBarrier &barrier = bufferBarriers.emplace_back(Initializers::BufferMemoryBarrier());
+			barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+			barrier.srcQueueFamilyIndex = m_transferFamily;
+			barrier.dstQueueFamilyIndex = m_graphicsFamily;
+			barrier.buffer = copy.destination;
+			barrier.offset = copy.region.dstOffset;
+			barrier.size = copy.region.size;
+		}
+	}
+	// Images with a mip chain to blit stay in the transfer layout for the graphics queue
+	std::vector<VkAccessFlags> imageAccessMasks;
+	imageAccessMasks.reserve(m_imageCopies.size());
+	for (size_t i = 0; i < m_imageCopies.size(); ++i)
+	{
+		const ImageUploadRegion &target = m_imageCopies[i].target;
+		const bool hasMipChain = HasMipChain(target);
+		const VkAccessFlags accessMask =
+			hasMipChain ? VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT : target.dstAccessMask;
+		imageAccessMasks.push_back(accessMask);
+
+		VkImageMemoryBarrier &barrier = imageBarriers[i];
+		dstStageMask |= hasMipChain ? VK_PIPELINE_STAGE_TRANSFER_BIT : target.dstStageMask;
+		barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		barrier.dstAccessMask = hasTransferQueue ? 0 : accessMask;
+		barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+		barrier.newLayout = hasMipChain ? VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL : target.layout;
+		if (hasTransferQueue)
+		{
+			barrier.srcQueueFamilyIndex = m_transferFamily;
+			barrier.dstQueueFamilyIndex = m_graphicsFamily;
+		}
+	}
+
+	if (!hasTransferQueue)
+	{
+		VkMemoryBarrier memoryBarrier = Initializers::MemoryBarrier();
+		memoryBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		memoryBarrier.dstAccessMask = bufferAccessMask;
+		vkCmdPipelineBarrier(batch.transferCommands,
+			VK_PIPELINE_STAGE_TRANSFER_BIT,
+			dstStageMask,
+			0,
+			m_copies.empty() ? 0 : 1,
+			&memoryBarrier,
+			0,
+			nullptr,
+			static_cast<uint32_t>(imageBarriers.size()),
+			imageBarriers.data());
+		RecordMipChains(batch.transferCommands);
+		VK_CHECK_RESULT(vkEndCommandBuffer(batch.transferCommands));
+
+		SubmitBatch(m_device->GetVkGraphicsQueue(), batch.transferCommands, batch.ticket);
+		return;
+	}
+
+	// Queue family ownership transfer: released by the transfer queue, acquired by the graphics queue
+	vkCmdPipelineBarrier(batch.transferCommands,
+		VK_PIPELINE_STAGE_TRANSFER_BIT,
+		VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+		0,
+		0,
+		nullptr,
+		static_cast<uint32_t>(bufferBarriers.size()),
+		bufferBarriers.data(),
+		static_cast<uint32_t>(imageBarriers.size()),
+		imageBarriers.data());
+	VK_CHECK_RESULT(vkEndCommandBuffer(batch.transferCommands));
+
+	batch.released = AcquireSemaphore();
+	VkSubmitInfo releaseInfo = Initializers::SubmitInfo();
+	releaseInfo.commandBufferCount = 1;
+	releaseInfo.pCommandBuffers = &batch.transferCommands;
+	releaseInfo.signalSemaphoreCount = 1;
+	releaseInfo.pSignalSemaphores = &batch.released;
+	m_device->Submit(m_device->GetVkTransferQueue(), releaseInfo, VK_NULL_HANDLE);
+
+	for (size_t i = 0; i < bufferBarriers.size(); ++i)
+	{
+		bufferBarriers[i].srcAccessMask = 0;
+		bufferBarriers[i].dstAccessMask = m_copies[i].dstAccessMask;
+	}
+	for (size_t i = 0; i < imageBarriers.size(); ++i)
+	{
+		imageBarriers[i].srcAccessMask = 0;
+		imageBarriers[i].dstAccessMask = imageAccessMasks[i];
+	}
+	batch.acquireCommands = BeginCommands(m_graphicsPool);
+	vkCmdPipelineBarrier(batch.acquireCommands,
+		dstStageMask,
+		dstStageMask,
+		0,
+		0,
+		nullptr,
+		static_cast<uint32_t>(bufferBarriers.size()),
+		bufferBarriers.data(),
+		static_cast<uint32_t>(imageBarriers.size()),
+		imageBarriers.data());
+	RecordMipChains(batch.acquireCommands);
+	VK_CHECK_RESULT(vkEndCommandBuffer(batch.acquireCommands));
+
+	SubmitBatch(m_device->GetVkGraphicsQueue(), batch.acquireCommands, batch.ticket, batch.released, dstStageMask);
+}
+
+void UploadManager::RecordMipChains(const VkCommandBuffer commandBuffer) const
+{
+	for (const ImageCopy &copy : m_imageCopies)
+	{
+		if (HasMipChain(copy.target))
+		{
+			RecordMipChain(commandBuffer, copy.target);
+		}
+	}
+}
+
+void UploadManager::RecordMipChain(const VkCommandBuffer commandBuffer, const ImageUploadRegion &region)
+{
+	const auto levels = GetMipChainLayout(region.extent, region.mipLevels, 0);
+
+	// Each level is read by the blit of the next one once it has been written
+	VkImageMemoryBarrier barrier = Initializers::ImageMemoryBarrier();
+	barrier.image = region.image;
+	barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+	barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+	barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+	barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+
+	for (uint32_t level = region.stagedLevels; level < region.mipLevels; ++level)
+	{
+		barrier.subresourceRange = GetSubresourceRange(region, level - 1, 1);
+		vkCmdPipelineBarrier(commandBuffer,
+			VK_PIPELINE_STAGE_TRANSFER_BIT,
+			VK_PIPELINE_STAGE_TRANSFER_BIT,
+			0,
+			0,
+			nullptr,
+			0,
+			nullptr,
+			1,
+			&barrier);
+
+		VkImageBlit blit{};
+		blit.srcSubresource = {region.aspectMask, level - 1, 0, 1};
+		blit.srcOffsets[1] = ToOffset(levels[level - 1].extent);
+		blit.dstSubresource = {region.aspectMask, level, 0, 1};
+		blit.dstOffsets[1] = ToOffset(levels[level].extent);
+		vkCmdBlitImage(commandBuffer,
+			region.image,
+			VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+			region.image,
+			VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+			1,
+			&blit,
+			VK_FILTER_LINEAR);
+	}
+
+	// Staged levels other than the last one were never read, the blitted ones were except for the very last level
+	std::vector<VkImageMemoryBarrier> barriers;
+	const auto moveToLayout =
+		[&](const uint32_t baseLevel, const uint32_t levelCount, const VkImageLayout layout, const VkAccessFlags access)
+	{
+		if (levelCount == 0)
+		{
+			return;
+		}
+		VkImageMemoryBarrier &levelBarrier = barriers.emplace_back(Initializers::ImageMemoryBarrier());
+		levelBarrier.image = region.image;
+		levelBarrier.srcAccessMask = access;
+		levelBarrier.dstAccessMask = region.dstAccessMask;
+		levelBarrier.oldLayout = layout;
+		levelBarrier.newLayout = region.layout;
+		levelBarrier.subresourceRange = GetSubresourceRange(region, baseLevel, levelCount);
+	};
+	moveToLayout(0, region.stagedLevels - 1, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_ACCESS_TRANSFER_WRITE_BIT);
+	moveToLayout(region.stagedLevels - 1,
+		region.mipLevels - region.stagedLevels,
+		VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+		VK_ACCESS_TRANSFER_READ_BIT);
+	moveToLayout(region.mipLevels - 1, 1, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_ACCESS_TRANSFER_WRITE_BIT);
+
+	vkCmdPipelineBarrier(commandBuffer,
+		VK_PIPELINE_STAGE_TRANSFER_BIT,
+		region.dstStageMask,
+		0,
+		0,
+		nullptr,
+		0,
+		nullptr,
+		static_cast<uint32_t>(barriers.size()),
+		barriers.data());
+}
+
+void UploadManager::SubmitBatch(const VkQueue &queue,
+	const VkCommandBuffer commandBuffer,
+	const uint64_t ticket,
+	const VkSemaphore waitSemaphore,
+	const VkPipelineStageFlags waitStageMask) const
+{
+	// The value of a binary semaphore to wait on is ignored
+	const uint64_t waitValue = 0;
+	VkTimelineSemaphoreSubmitInfo timelineInfo{};
+	timelineInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+	timelineInfo.waitSemaphoreValueCount = waitSemaphore != VK_NULL_HANDLE ? 1 : 0;
+	timelineInfo.pWaitSemaphoreValues = &waitValue;
+	timelineInfo.signalSemaphoreValueCount = 1;
+	timelineInfo.pSignalSemaphoreValues = &ticket;
+
+	VkSubmitInfo submitInfo = Initializers::SubmitInfo();
+	submitInfo.pNext = &timelineInfo;
+	if (waitSemaphore != VK_NULL_HANDLE)
+	{
+		submitInfo.waitSemaphoreCount = 1;
+		submitInfo.pWaitSemaphores = &waitSemaphore;
+		submitInfo.pWaitDstStageMask = &waitStageMask;
+	}
+	submitInfo.commandBufferCount = 1;
+	submitInfo.pCommandBuffers = &commandBuffer;
+	submitInfo.signalSemaphoreCount = 1;
+	submitInfo.pSignalSemaphores = &m_timeline;
+
+	m_device->Submit(queue, submitInfo, VK_NULL_HANDLE);
+}
+
+VkCommandBuffer UploadManager::BeginCommands(const VkCommandPool pool) const
+{
+	const VkCommandBufferAllocateInfo allocInfo =
+		Initializers::CommandBufferAllocateInfo(pool, VK_COMMAND_BUFFER_LEVEL_PRIMARY, 1);
+
+	VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+	VK_CHECK_RESULT(vkAllocateCommandBuffers(**m_device, &allocInfo, &commandBuffer));
+
+	VkCommandBufferBeginInfo beginInfo = Initializers::CommandBufferBeginInfo();
+	beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+	VK_CHECK_RESULT(vkBeginCommandBuffer(commandBuffer, &beginInfo));
+
+	return commandBuffer;
+}
+
+VkSemaphore UploadManager::AcquireSemaphore()
+{
+	if (!m_freeSemaphores.empty())
+	{
+		const VkSemaphore semaphore = m_freeSemaphores.back();
+		m_freeSemaphores.pop_back();
+		return semaphore;
+	}
+
+	const VkSemaphoreCreateInfo semaphoreInfo = Initializers::SemaphoreCreateInfo();
+	VkSemaphore semaphore = VK_NULL_HANDLE;
+	VK_CHECK_RESULT(vkCreateSemaphore(**m_device, &semaphoreInfo, nullptr, &semaphore));
+	return semaphore;
+}
+
+// Batches finish in the order they were submitted, the timeline tells how far they got
+void UploadManager::Collect()
+{
+	if (m_batches.empty())
+	{
+		return;
+	}
+
+	uint64_t completed = 0;
+	VK_CHECK_RESULT(vkGetSemaphoreCounterValue(**m_device, m_timeline, &completed));
+	while (!m_batches.empty() && m_batches.front().ticket <= completed)
+	{
+		Retire(m_batches.front());
+		m_batches.pop_front();
+	}
+}
+
+void UploadManager::WaitOldest()
+{
+	Batch &batch = m_batches.front();
+
+	VkSemaphoreWaitInfo waitInfo{};
+	waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+	waitInfo.semaphoreCount = 1;
+	waitInfo.pSemaphores = &m_timeline;
+	waitInfo.pValues = &batch.ticket;
+	VK_CHECK_RESULT(vkWaitSemaphores(**m_device, &waitInfo, UINT64_MAX));
+
+	Retire(batch);
+	m_batches.pop_front();
+}
+
+void UploadManager::Retire(Batch &batch)
+{
+	Release(batch);
+	m_tail = batch.stagingEnd;
+	m_completedTicket = batch.ticket;
+}
+
+void UploadManager::Release(Batch &batch)
+{
+	if (batch.transferCommands != VK_NULL_HANDLE)
+	{
+		vkFreeCommandBuffers(**m_device,
+			HasTransferQueue() ? m_transferPool : m_graphicsPool,
+			1,
+			&batch.transferCommands);
+	}
+	if (batch.acquireCommands != VK_NULL_HANDLE)
+	{
+		vkFreeCommandBuffers(**m_device, m_graphicsPool, 1, &batch.acquireCommands);
+	}
+	if (batch.released != VK_NULL_HANDLE)
+	{
+		m_freeSemaphores.push_back(batch.released);
+	}
+	for (Buffer &staging : batch.dedicatedStaging)
+	{
+		staging.Destroy(m_device);
+	}
+	batch.dedicatedStaging.clear();
+}
@@ -57,6 +57,10 @@ Core::CommandBufferRef BaseRenderContext::BeginCommandBuffer()
 
 	m_frameIndex = m_swapChain->GetCurrentFrameIndex();
 
+	// The fence of the frame is signaled by now, its uniforms are no longer read
+	m_device->GetUniformAllocator()->BeginFrame(m_frameIndex);
+	m_device->GetGeometryArena()->BeginFrame();
+
 	Core::CommandBufferPtr &commandBuffer = m_commandBuffers[m_frameIndex];
 	commandBuffer->Reset();
 
@@ -70,6 +74,8 @@ void BaseRenderContext::EndFrame(const Core::CommandBufferRef &commandBuffer)
 {
 	commandBuffer->End();
 
+	m_device->GetUniformAllocator()->EndFrame();
+	m_device->FlushQueued();
 	m_swapChain->SubmitCommandBuffer(**commandBuffer);
 	m_swapChain->Present();
 }
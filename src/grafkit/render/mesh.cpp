@@ -1,7 +1,9 @@
 #include "stdafx.h"
 
 #include "grafkit/core/command_buffer.h"
+#include "grafkit/core/device.h"
 #include "grafkit/render/mesh.h"
+#include "grafkit/render/vertex_packing.h"
 
 namespace Grafkit
 {
@@ -9,23 +11,38 @@ namespace Grafkit
 	// MARK: Mesh
 	Mesh::Mesh(const Core::DeviceRef &device,
 		uint32_t id,
-		const Core::Buffer &vertexBuffer,
-		const Core::Buffer &indexBuffer,
+		const Core::GeometryArena::Handle geometry,
 		std::vector<Primitive> primitives,
-		std::unordered_map<uint32_t, MaterialPtr> materials)
+		std::unordered_map<uint32_t, MaterialPtr> materials,
+		const VertexFormat vertexFormat,
+		const glm::mat4 &positionTransform,
+		std::vector<Meshlet> meshlets,
+		const uint64_t uploadTicket)
 		: m_device(device)
 		, m_id(id)
-		, m_vertexBuffer(vertexBuffer)
-		, m_indexBuffer(indexBuffer)
+		, m_geometry(geometry)
 		, m_primitives(std::move(primitives))
 		, m_materials(std::move(materials))
+		, m_vertexFormat(vertexFormat)
+		, m_positionTransform(positionTransform)
+		, m_meshlets(std::move(meshlets))
+		, m_uploadTicket(uploadTicket)
 	{
 	}
 
 	Mesh::~Mesh()
 	{
-		m_indexBuffer.Destroy(m_device);
-		m_vertexBuffer.Destroy(m_device);
+		// The copies into the geometry may still be pending
+		if (m_uploadTicket != 0)
+		{
+			m_device->GetUploadManager()->Wait(m_uploadTicket);
+		}
+		m_device->GetGeometryArena()->Free(m_geometry);
+	}
+
+	Core::GeometryRange Mesh::GetGeometry() const
+	{
+		return m_device->GetGeometryArena()->GetRange(m_geometry);
 	}
 
 	MeshPtr Mesh::Create(const Core::DeviceRef &device,
@@ -34,26 +51,94 @@ namespace Grafkit
 		std::vector<Primitive> primitives,
 		std::unordered_map<uint32_t, MaterialPtr> materials)
 	{
-		// Create vertex buffer
-		Core::Buffer vertexBuffer = Core::Buffer::CreateBuffer(device,
-			sizeof(vertices[0]) * vertices.size(),
-			VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
-			VMA_MEMORY_USAGE_CPU_TO_GPU);
-		vertexBuffer.Update(device, vertices.data(), sizeof(vertices[0]) * vertices.size());
+		const auto *vertexData = reinterpret_cast<const uint8_t *>(vertices.data());
+		const auto *indexData = reinterpret_cast<const uint8_t *>(indices.data());
+		return Create(device,
+			std::span<const uint8_t>(vertexData, sizeof(Vertex) * vertices.size()),
+			std::span<const uint8_t>(indexData, sizeof(uint32_t) * indices.size()),
+			std::move(primitives),
+			std::move(materials));
+	}
 
-		// Create index buffer
-		Core::Buffer indexBuffer = Core::Buffer::CreateBuffer(device,
-			sizeof(indices[0]) * indices.size(),
-			VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
-			VMA_MEMORY_USAGE_CPU_TO_GPU);
-		indexBuffer.Update(device, indices.data(), sizeof(indices[0]) * indices.size());
+	MeshPtr Mesh::Create(const Core::DeviceRef &device,
+		const std::span<const uint8_t> vertexData,
+		const std::span<const uint8_t> indexData,
+		std::vector<Primitive> primitives,
+		std::unordered_map<uint32_t, MaterialPtr> materials,
+		const VertexFormat vertexFormat,
+		const glm::mat4 &positionTransform,
+		std::vector<Meshlet> meshlets)
+	{
+		return Create(
+			device,
+			vertexData.size(),
+			indexData.size(),
+			[&vertexData, &indexData](const std::span<uint8_t> vertexDestination,
+				const std::span<uint8_t> indexDestination)
+			{
+				std::memcpy(vertexDestination.data(), vertexData.data(), vertexData.size());
+				std::memcpy(indexDestination.data(), indexData.data(), indexData.size());
+			},
+			std::move(primitives),
+			std::move(materials),
+			vertexFormat,
+			positionTransform,
+			std::move(meshlets));
+	}
+
+	MeshPtr Mesh::Create(const Core::DeviceRef &device,
+		const size_t vertexDataSize,
+		const size_t indexDataSize,
+		const DataWriter &writer,
+		std::vector<Primitive> primitives,
+		std::unordered_map<uint32_t, MaterialPtr> materials,
+		const VertexFormat vertexFormat,
+		const glm::mat4 &positionTransform,
+		std::vector<Meshlet> meshlets)
+	{
+		const Core::GeometryArenaRef arena = device->GetGeometryArena();
+		const Core::GeometryArena::Handle geometry =
+			arena->Allocate(vertexDataSize, GetVertexStride(vertexFormat), indexDataSize);
+		uint64_t uploadTicket = 0;
+		try
+		{
+			const Core::GeometryRange range = arena->GetRange(geometry);
+
+			// Both are written into staging at once, the copies go out with the next batch of uploads
+			const std::array<Core::UploadRegion, 2> regions = {{
+				{
+					.destination = range.buffer,
+					.offset = range.vertexOffset,
+					.size = vertexDataSize,
+					.dstStageMask = VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
+					.dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT,
+				},
+				{
+					.destination = range.buffer,
+					.offset = range.indexOffset,
+					.size = indexDataSize,
+					.dstStageMask = VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
+					.dstAccessMask = VK_ACCESS_INDEX_READ_BIT,
+				},
+			}};
+			uploadTicket = device->GetUploadManager()->Upload(regions,
+				[&writer](const std::span<const std::span<uint8_t>> staging) { writer(staging[0], staging[1]); });
+		}
+		catch (...)
+		{
+			arena->Free(geometry);
+			throw;
+		}
 
 		return std::make_shared<Mesh>(device,
 			0,
-			vertexBuffer,
-			indexBuffer,
+			geometry,
 			std::move(primitives),
-			std::move(materials));
+			std::move(materials),
+			vertexFormat,
+			positionTransform,
+			std::move(meshlets),
+			uploadTicket);
 	}
 
 	// MARK: FullScreenQuad
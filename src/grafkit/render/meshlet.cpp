@@ -0,0 +1,107 @@
+#include "stdafx.h"
+
+#include <grafkit/render/mesh.h>
+#include <grafkit/render/meshlet.h>
+
+using namespace Grafkit;
+
+void MeshletCuller::SetView(const glm::mat4 &modelViewProjection, const glm::vec3 &cameraPosition)
+{
+	// Gribb-Hartmann: planes are sums and differences of the rows of the matrix, near is w + z for a [-1, 1] depth
+	const auto row = [&modelViewProjection](const int index)
+	{
+		return glm::vec4(modelViewProjection[0][index],
+			modelViewProjection[1][index],
+			modelViewProjection[2][index],
+			modelViewProjection[3][index]);
+	};
+
+	m_planes = {
+		row(3) + row(0),
+		row(3) - row(0),
+		row(3) + row(1),
+		row(3) - row(1),
+		row(3) + row(2),
+		row(3) - row(2),
+	};
+
+	for (glm::vec4 &plane : m_planes)
+	{
+		const float length = glm::length(glm::vec3(plane));
+		if (length > 0.0f)
+		{
+			plane = plane / length;
+		}
+	}
+	m_cameraPosition = cameraPosition;
+}
+
+bool MeshletCuller::IsInFrustum(const Meshlet &meshlet) const
+{
+	for (const glm::vec4 &plane : m_planes)
+	{
+		if (glm::dot(glm::vec3(plane), meshlet.center) + plane.w < -meshlet.radius)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+bool MeshletCuller::IsBackfacing(const Meshlet &meshlet) const
+{
+	if (meshlet.coneCutoff >= 1.0f)
+	{
+		return false;
+	}
+
+	// Every direction from the camera to the sphere has to be within 90 degrees minus the cone angle of the axis
+	const glm::vec3 direction = meshlet.center - m_cameraPosition;
+	return glm::dot(direction, meshlet.coneAxis) >=
+		   meshlet.coneCutoff * (glm::length(direction) + meshlet.radius) + meshlet.radius;
+}
+
+void MeshletCuller::Cull(const Primitive &primitive,
+	const std::span<const Meshlet> meshlets,
+	std::vector<DrawRange> &ranges)
+{
+	if (meshlets.empty())
+	{
+		ranges.push_back({primitive.firstIndex, primitive.indexCount});
+		return;
+	}
+
+	DrawRange current{};
+	for (const Meshlet &meshlet : meshlets)
+	{
+		++m_stats.meshletCount;
+		if (!IsInFrustum(meshlet))
+		{
+			++m_stats.frustumCulled;
+			continue;
+		}
+		if (m_isBackfaceCulling && IsBackfacing(meshlet))
+		{
+			++m_stats.backfaceCulled;
+			continue;
+		}
+
+		const uint32_t firstIndex = primitive.firstIndex + meshlet.triangleOffset * 3;
+		if (current.indexCount != 0 && current.firstIndex + current.indexCount == firstIndex)
+		{
+			current.indexCount += meshlet.triangleCount * 3;
+			continue;
+		}
+
+		if (current.indexCount != 0)
+		{
+			ranges.push_back(current);
+		}
+		current = {firstIndex, meshlet.triangleCount * 3};
+	}
+
+	if (current.indexCount != 0)
+	{
+		ranges.push_back(current);
+	}
+}
@@ -14,10 +14,12 @@
 #include "grafkit/render/mesh.h"
 #include "grafkit/render/render_graph.h"
 #include "grafkit/render/scenegraph.h"
+#include "grafkit/render/vertex_packing.h"
 
 using namespace Grafkit;
 
-constexpr bool USE_BUFFER_BINDING_OPTIMALIZATION = false;
+// Meshes share the buffers of the geometry arena, draws only rebind when the block or the index type changes
+constexpr bool USE_BUFFER_BINDING_OPTIMALIZATION = true;
 
 void Node::UpdateLocalMatrix()
 {
@@ -68,8 +70,20 @@ void Grafkit::Scenegraph::AddDescriptorSet(const uint32_t set, const Core::Descr
 	m_isDirty = true;
 }
 
+void Grafkit::Scenegraph::SetDynamicOffsets(const uint32_t set, std::vector<uint32_t> offsets)
+{
+	m_dynamicOffsets[set] = std::move(offsets);
+}
+
 void Scenegraph::Update(const TimeInfo &timeInfo)
 {
+	// Draw commands hold offsets into the geometry arena, which move when it is defragmented
+	if (!m_meshesToNodes.empty() &&
+		m_meshesToNodes.front().first->GetGeometry().generation != m_geometryGeneration)
+	{
+		m_isDirty = true;
+	}
+
 	if (m_isDirty)
 	{
 		UpdateRenderGraph();
@@ -107,12 +121,22 @@ void Scenegraph::Draw(const Core::CommandBufferRef &commandBuffer,
 {
 	VkBuffer lastVertexBuffer = VK_NULL_HANDLE;
 	VkBuffer lastIndexBuffer = VK_NULL_HANDLE;
+	VkIndexType lastIndexType = VK_INDEX_TYPE_UINT32;
 	const auto &renderStage = m_commandList[stageIndex].first;
 
 	// Dind common descriptor sets
 	for (const auto &descriptorSet : m_descriptorSets)
 	{
-		descriptorSet.second->Bind(commandBuffer, renderStage->GetPipelineLayout(), frameIndex);
+		const auto dynamicOffsets = m_dynamicOffsets.find(descriptorSet.first);
+		if (dynamicOffsets != m_dynamicOffsets.end())
+		{
+			descriptorSet.second->Bind(
+				commandBuffer, renderStage->GetPipelineLayout(), frameIndex, dynamicOffsets->second);
+		}
+		else
+		{
+			descriptorSet.second->Bind(commandBuffer, renderStage->GetPipelineLayout(), frameIndex);
+		}
 	}
 
 	// Execute draw commands
@@ -126,24 +150,25 @@ void Scenegraph::Draw(const Core::CommandBufferRef &commandBuffer,
 		// TODO: Add instance support
 		if constexpr (USE_BUFFER_BINDING_OPTIMALIZATION)
 		{
-			if (command.vertexBuffer != lastVertexBuffer)
+			if (command.geometryBuffer != lastVertexBuffer)
 			{
 				std::array<VkDeviceSize, 1> offsets = {0};
-				vkCmdBindVertexBuffers(**commandBuffer, 0, 1, &command.vertexBuffer, offsets.data());
-				lastVertexBuffer = command.vertexBuffer;
+				vkCmdBindVertexBuffers(**commandBuffer, 0, 1, &command.geometryBuffer, offsets.data());
+				lastVertexBuffer = command.geometryBuffer;
 			}
 
-			if (command.indexBuffer != lastIndexBuffer)
+			if (command.geometryBuffer != lastIndexBuffer || command.indexType != lastIndexType)
 			{
-				vkCmdBindIndexBuffer(**commandBuffer, command.indexBuffer, 0, VK_INDEX_TYPE_UINT32);
-				lastIndexBuffer = command.indexBuffer;
+				vkCmdBindIndexBuffer(**commandBuffer, command.geometryBuffer, 0, command.indexType);
+				lastIndexBuffer = command.geometryBuffer;
+				lastIndexType = command.indexType;
 			}
 		}
 		else
 		{
 			std::array<VkDeviceSize, 1> offsets = {0};
-			vkCmdBindVertexBuffers(**commandBuffer, 0, 1, &command.vertexBuffer, offsets.data());
-			vkCmdBindIndexBuffer(**commandBuffer, command.indexBuffer, 0, VK_INDEX_TYPE_UINT32);
+			vkCmdBindVertexBuffers(**commandBuffer, 0, 1, &command.geometryBuffer, offsets.data());
+			vkCmdBindIndexBuffer(**commandBuffer, command.geometryBuffer, 0, command.indexType);
 		}
 
 		// Bind descriptor sets
@@ -158,18 +183,23 @@ void Scenegraph::Draw(const Core::CommandBufferRef &commandBuffer,
 
 		// Push constants
 		// TODO: Render stage should be able to bind push constants
+		// The position transform scales each axis on its own, it is kept apart so normals only see the model matrix
+		const ModelView modelView{
+			.model = command.node->modelView,
+			.positionTransform = command.positionTransform,
+		};
 		vkCmdPushConstants(**commandBuffer,
 			m_commandList[stageIndex].first->GetPipelineLayout(),
 			VK_SHADER_STAGE_VERTEX_BIT,
 			0,
-			sizeof(glm::mat4),
-			&command.node->modelView);
+			sizeof(ModelView),
+			&modelView);
 
 		vkCmdDrawIndexed(**commandBuffer,
 			command.indexCount,
 			command.instanceCount,
 			command.firstIndex,
-			command.vertexOffset,
+			static_cast<int32_t>(command.vertexOffset),
 			0);
 	}
 }
@@ -189,8 +219,10 @@ void Scenegraph::UpdateRenderGraph()
 	for (const auto &meshToNode : m_meshesToNodes)
 	{
 		const MeshPtr &mesh = meshToNode.first;
-		const Core::Buffer &vertexBuffer = mesh->GetVertexBuffer();
-		const Core::Buffer &indexBuffer = mesh->GetIndexBuffer();
+		const Core::GeometryRange geometry = mesh->GetGeometry();
+		const uint32_t firstVertex =
+			static_cast<uint32_t>(geometry.vertexOffset / GetVertexStride(mesh->GetVertexFormat()));
+		m_geometryGeneration = geometry.generation;
 
 		for (const auto &primitive : mesh->GetPrimitives())
 		{
@@ -235,18 +267,20 @@ void Scenegraph::UpdateRenderGraph()
 			// Add draw command to the stage
 			listIt->second.push_back(DrawCommand{
 				.descriptorSets = std::move(descriptorSets),
-				.vertexBuffer = vertexBuffer.buffer,
-				.indexBuffer = indexBuffer.buffer,
-				.firstIndex = primitive.firstIndex,
+				.geometryBuffer = geometry.buffer,
+				.indexType = primitive.indexType,
+				.firstIndex = static_cast<uint32_t>(geometry.indexOffset / GetIndexSize(primitive.indexType)) +
+					primitive.firstIndex,
 				.indexCount = primitive.indexCount,
-				.vertexOffset = primitive.vertexOffset,
+				.vertexOffset = firstVertex + primitive.vertexOffset,
 				.instanceCount = 1,
 				.node = meshToNode.second,
+				.positionTransform = mesh->GetPositionTransform(),
 			});
 		}
 	}
 
-	// Order by vertex and index buffer [pointers] to ensure the least amount of buffer switches
+	// Order by vertex and index buffer [pointers] and index type to ensure the least amount of buffer switches
 	if constexpr (USE_BUFFER_BINDING_OPTIMALIZATION)
 	{
 		for (auto &stage : m_commandList)
@@ -254,8 +288,7 @@ void Scenegraph::UpdateRenderGraph()
 			std::sort(stage.second.begin(),
 				stage.second.end(),
 				[](const DrawCommand &a, const DrawCommand &b) {
-					return a.vertexBuffer < b.vertexBuffer ||
-						   (a.vertexBuffer == b.vertexBuffer && a.indexBuffer < b.indexBuffer);
+					return std::tie(a.geometryBuffer, a.indexType) < std::tie(b.geometryBuffer, b.indexType);
 				});
 		}
 	}
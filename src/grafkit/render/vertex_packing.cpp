@@ -0,0 +1,296 @@
+#include "stdafx.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <grafkit/render/vertex_packing.h>
+
+using namespace Grafkit;
+
+namespace
+{
+	// Keeps flat meshes from dividing by zero
+	constexpr float MIN_EXTENT = 1e-6f;
+
+	float SignNotZero(const float value)
+	{
+		return value >= 0.0f ? 1.0f : -1.0f;
+	}
+
+	template <typename PackedT>
+	void PackAttributes(const Vertex &vertex, PackedT &packed)
+	{
+		using namespace VertexPacking;
+
+		packed.color = {PackUnorm8(vertex.color.x), PackUnorm8(vertex.color.y), PackUnorm8(vertex.color.z), 255};
+		packed.uv = {PackUnorm16(vertex.uv.x), PackUnorm16(vertex.uv.y)};
+		packed.normal = PackOctahedral(vertex.normal);
+
+		// Any direction perpendicular to the normal, from the axis least parallel to it
+		const glm::vec3 axis =
+			std::abs(vertex.normal.x) > 0.9f ? glm::vec3(0.0f, 1.0f, 0.0f) : glm::vec3(1.0f, 0.0f, 0.0f);
+		packed.tangent = PackOctahedral(axis - vertex.normal * glm::dot(vertex.normal, axis));
+	}
+
+	template <typename PackedT, typename FuncT>
+	void Pack(const std::span<const Vertex> vertices, const std::span<uint8_t> destination, FuncT &&packPosition)
+	{
+		for (size_t i = 0; i < vertices.size(); ++i)
+		{
+			PackedT packed{};
+			packed.position = packPosition(vertices[i].position);
+			PackAttributes(vertices[i], packed);
+			std::memcpy(destination.data() + i * sizeof(PackedT), &packed, sizeof(PackedT));
+		}
+	}
+} // namespace
+
+uint32_t Grafkit::GetVertexStride(const VertexFormat format)
+{
+	switch (format)
+	{
+	case VertexFormat::Float:
+		return sizeof(Vertex);
+	case VertexFormat::Snorm16:
+		return sizeof(CompactVertex);
+	case VertexFormat::Half:
+		return sizeof(HalfVertex);
+	}
+	throw std::invalid_argument("Unknown vertex format");
+}
+
+uint32_t Grafkit::GetIndexSize(const VkIndexType indexType)
+{
+	return indexType == VK_INDEX_TYPE_UINT16 ? sizeof(uint16_t) : sizeof(uint32_t);
+}
+
+Core::VertexDescription Grafkit::GetVertexDescription(const VertexFormat format,
+	const uint32_t inputBinding,
+	const uint32_t vertexBinding)
+{
+	switch (format)
+	{
+	case VertexFormat::Float:
+		return Vertex::GetVertexDescription(inputBinding, vertexBinding);
+	case VertexFormat::Snorm16:
+		return CompactVertex::GetVertexDescription(inputBinding, vertexBinding);
+	case VertexFormat::Half:
+		return HalfVertex::GetVertexDescription(inputBinding, vertexBinding);
+	}
+	throw std::invalid_argument("Unknown vertex format");
+}
+
+PositionBounds Grafkit::CalculateBounds(const std::span<const Vertex> vertices)
+{
+	return CalculateBounds(std::span<const std::span<const Vertex>>(&vertices, 1));
+}
+
+PositionBounds Grafkit::CalculateBounds(const std::span<const std::span<const Vertex>> ranges)
+{
+	const auto first = std::find_if(ranges.begin(), ranges.end(), [](const auto &range) { return !range.empty(); });
+	if (first == ranges.end())
+	{
+		return {};
+	}
+
+	glm::vec3 min = first->front().position;
+	glm::vec3 max = first->front().position;
+	for (const std::span<const Vertex> &vertices : ranges)
+	{
+		for (const Vertex &vertex : vertices)
+		{
+			for (int axis = 0; axis < 3; ++axis)
+			{
+				min[axis] = std::min(min[axis], vertex.position[axis]);
+				max[axis] = std::max(max[axis], vertex.position[axis]);
+			}
+		}
+	}
+
+	PositionBounds bounds{};
+	for (int axis = 0; axis < 3; ++axis)
+	{
+		bounds.center[axis] = (min[axis] + max[axis]) * 0.5f;
+		bounds.extent[axis] = std::max((max[axis] - min[axis]) * 0.5f, MIN_EXTENT);
+	}
+	return bounds;
+}
+
+glm::mat4 Grafkit::GetPositionTransform(const VertexFormat format, const PositionBounds &bounds)
+{
+	glm::mat4 transform(1.0f);
+	if (format == VertexFormat::Float)
+	{
+		return transform;
+	}
+
+	if (format == VertexFormat::Snorm16)
+	{
+		transform[0][0] = bounds.extent.x;
+		transform[1][1] = bounds.extent.y;
+		transform[2][2] = bounds.extent.z;
+	}
+	transform[3] = glm::vec4(bounds.center, 1.0f);
+	return transform;
+}
+
+std::vector<uint8_t> Grafkit::PackVertices(const std::span<const Vertex> vertices,
+	const VertexFormat format,
+	const PositionBounds &bounds)
+{
+	std::vector<uint8_t> data(vertices.size() * GetVertexStride(format));
+	PackVertices(vertices, format, bounds, data);
+	return data;
+}
+
+void Grafkit::PackVertices(const std::span<const Vertex> vertices,
+	const VertexFormat format,
+	const PositionBounds &bounds,
+	const std::span<uint8_t> destination)
+{
+	using namespace VertexPacking;
+
+	if (destination.size() < vertices.size() * GetVertexStride(format))
+	{
+		throw std::out_of_range("Destination of the packed vertices is too small");
+	}
+
+	switch (format)
+	{
+	case VertexFormat::Float:
+		std::memcpy(destination.data(), vertices.data(), vertices.size_bytes());
+		return;
+	case VertexFormat::Snorm16:
+		Pack<CompactVertex>(vertices,
+			destination,
+			[&bounds](const glm::vec3 &position)
+			{
+				const glm::vec3 normalized = (position - bounds.center) / bounds.extent;
+				return std::array<int16_t, 4>{
+					PackSnorm16(normalized.x), PackSnorm16(normalized.y), PackSnorm16(normalized.z), 0};
+			});
+		return;
+	case VertexFormat::Half:
+		Pack<HalfVertex>(vertices,
+			destination,
+			[&bounds](const glm::vec3 &position)
+			{
+				const glm::vec3 relative = position - bounds.center;
+				return std::array<uint16_t, 4>{PackHalf(relative.x), PackHalf(relative.y), PackHalf(relative.z), 0};
+			});
+		return;
+	}
+	throw std::invalid_argument("Unknown vertex format");
+}
+
+// MARK: Scalar encodings
+
+int16_t VertexPacking::PackSnorm16(const float value)
+{
+	return static_cast<int16_t>(std::lround(std::clamp(value, -1.0f, 1.0f) * 32767.0f));
+}
+
+uint16_t VertexPacking::PackUnorm16(const float value)
+{
+	return static_cast<uint16_t>(std::lround(std::clamp(value, 0.0f, 1.0f) * 65535.0f));
+}
+
+uint8_t VertexPacking::PackUnorm8(const float value)
+{
+	return static_cast<uint8_t>(std::lround(std::clamp(value, 0.0f, 1.0f) * 255.0f));
+}
+
+uint16_t VertexPacking::PackHalf(const float value)
+{
+	uint32_t bits = 0;
+	std::memcpy(&bits, &value, sizeof(bits));
+
+	const auto sign = static_cast<uint16_t>((bits >> 16) & 0x8000u);
+	const int32_t exponent = static_cast<int32_t>((bits >> 23) & 0xffu) - 127 + 15;
+	uint32_t mantissa = bits & 0x7fffffu;
+
+	if ((bits & 0x7fffffffu) > 0x7f800000u)
+	{
+		return sign | 0x7e00u; // NaN
+	}
+	if (exponent >= 31)
+	{
+		return sign | 0x7c00u; // Overflows to infinity
+	}
+	if (exponent <= 0)
+	{
+		// Subnormal, or too small to be anything but zero
+		if (exponent < -10)
+		{
+			return sign;
+		}
+		mantissa |= 0x800000u;
+		const auto shift = static_cast<uint32_t>(14 - exponent);
+		const auto half = static_cast<uint16_t>(mantissa >> shift);
+		return sign | static_cast<uint16_t>(half + ((mantissa >> (shift - 1)) & 1u));
+	}
+
+	// Rounding may carry into the exponent, which is still the right result
+	const auto half = static_cast<uint16_t>((static_cast<uint32_t>(exponent) << 10) | (mantissa >> 13));
+	return sign | static_cast<uint16_t>(half + ((mantissa >> 12) & 1u));
+}
+
+float VertexPacking::UnpackHalf(const uint16_t value)
+{
+	const uint32_t sign = static_cast<uint32_t>(value & 0x8000u) << 16;
+	const uint32_t exponent = (value >> 10) & 0x1fu;
+	const uint32_t mantissa = value & 0x3ffu;
+
+	uint32_t bits = 0;
+	if (exponent == 0)
+	{
+		const float subnormal = std::ldexp(static_cast<float>(mantissa), -24);
+		return sign ? -subnormal : subnormal;
+	}
+	if (exponent == 31)
+	{
+		bits = sign | 0x7f800000u | (mantissa << 13);
+	}
+	else
+	{
+		bits = sign | ((exponent - 15 + 127) << 23) | (mantissa << 13);
+	}
+
+	float result = 0.0f;
+	std::memcpy(&result, &bits, sizeof(result));
+	return result;
+}
+
+std::array<int16_t, 2> VertexPacking::PackOctahedral(const glm::vec3 &direction)
+{
+	const float length = std::abs(direction.x) + std::abs(direction.y) + std::abs(direction.z);
+	if (length == 0.0f)
+	{
+		return {0, 0};
+	}
+
+	float x = direction.x / length;
+	float y = direction.y / length;
+	if (direction.z < 0.0f)
+	{
+		// The lower half is folded over the diagonals
+		const float foldedX = (1.0f - std::abs(y)) * SignNotZero(x);
+		const float foldedY = (1.0f - std::abs(x)) * SignNotZero(y);
+		x = foldedX;
+		y = foldedY;
+	}
+	return {PackSnorm16(x), PackSnorm16(y)};
+}
+
+glm::vec3 VertexPacking::UnpackOctahedral(const std::array<int16_t, 2> &packed)
+{
+	// Same as the GPU decodes snorm, -32768 clamps to -1
+	const float x = std::max(static_cast<float>(packed[0]) / 32767.0f, -1.0f);
+	const float y = std::max(static_cast<float>(packed[1]) / 32767.0f, -1.0f);
+
+	glm::vec3 direction(x, y, 1.0f - std::abs(x) - std::abs(y));
+	const float fold = std::max(-direction.z, 0.0f);
+	direction.x += direction.x >= 0.0f ? -fold : fold;
+	direction.y += direction.y >= 0.0f ? -fold : fold;
+	return glm::normalize(direction);
+}
@@ -0,0 +1,217 @@
+#include "stdafx.h"
+
+#include <bit>
+
+#include "grafkit/resource/animation_clip.h"
+
+using namespace Grafkit::Resource;
+
+// The clip is read in place, so the on-disk byte order has to match the host
+static_assert(std::endian::native == std::endian::little, "Animation clips are stored little endian");
+
+namespace
+{
+	constexpr uint64_t AlignUp(const uint64_t value, const uint64_t alignment)
+	{
+		return (value + alignment - 1) & ~(alignment - 1);
+	}
+
+	constexpr uint32_t PaddedKeyCount(const uint32_t keyCount)
+	{
+		return static_cast<uint32_t>(AlignUp(keyCount, ANIMATION_CLIP_KEY_ALIGNMENT));
+	}
+
+	void CheckRange(const std::span<const uint8_t> data, const uint64_t offset, const uint64_t size,
+		const uint64_t alignment, const char *what)
+	{
+		if (offset > data.size() || size > data.size() - offset)
+		{
+			throw std::runtime_error(std::string("Animation clip ") + what + " is out of bounds");
+		}
+		if (offset % alignment != 0)
+		{
+			throw std::runtime_error(std::string("Animation clip ") + what + " is misaligned");
+		}
+	}
+} // namespace
+
+AnimationClipView::AnimationClipView(std::span<const uint8_t> data)
+	: m_data(data)
+{
+	if (data.size() < sizeof(AnimationClipHeader))
+	{
+		throw std::runtime_error("Animation clip is truncated");
+	}
+	if (reinterpret_cast<uintptr_t>(data.data()) % alignof(AnimationClipHeader) != 0)
+	{
+		throw std::runtime_error("Animation clip data has to be 16 byte aligned");
+	}
+
+	const auto *header = reinterpret_cast<const AnimationClipHeader *>(data.data());
+	if (header->magic != ANIMATION_CLIP_MAGIC)
+	{
+		throw std::runtime_error("Not an animation clip");
+	}
+	if (header->version != ANIMATION_CLIP_VERSION)
+	{
+		throw std::runtime_error("Unsupported animation clip version: " + std::to_string(header->version));
+	}
+
+	const uint64_t keyCount = header->keyCount;
+	CheckRange(data,
+		header->channelTableOffset,
+		header->channelCount * sizeof(AnimationChannelEntry),
+		alignof(AnimationChannelEntry),
+		"channel table");
+	CheckRange(data, header->nameOffset, header->nameLength, 1, "name");
+	CheckRange(data, header->timeStreamOffset, keyCount * sizeof(float), ANIMATION_CLIP_STREAM_ALIGNMENT, "times");
+	CheckRange(
+		data, header->valueStreamOffset, keyCount * sizeof(glm::vec4), ANIMATION_CLIP_STREAM_ALIGNMENT, "values");
+	CheckRange(data,
+		header->interpolationStreamOffset,
+		keyCount * sizeof(KeyInterpolation),
+		ANIMATION_CLIP_STREAM_ALIGNMENT,
+		"interpolations");
+
+	m_header = header;
+
+	for (const auto &channel : GetChannels())
+	{
+		if (channel.keyCount == 0 || channel.firstKey % ANIMATION_CLIP_KEY_ALIGNMENT != 0 ||
+			channel.firstKey + PaddedKeyCount(channel.keyCount) > keyCount)
+		{
+			m_header = nullptr;
+			throw std::runtime_error("Animation clip channel " + std::to_string(channel.id) + " is corrupt");
+		}
+	}
+}
+
+std::string_view AnimationClipView::GetName() const
+{
+	return {StreamAt<char>(m_header->nameOffset), m_header->nameLength};
+}
+
+std::span<const AnimationChannelEntry> AnimationClipView::GetChannels() const
+{
+	return {StreamAt<AnimationChannelEntry>(m_header->channelTableOffset), m_header->channelCount};
+}
+
+std::span<const float> AnimationClipView::GetKeyTimes(const AnimationChannelEntry &channel) const
+{
+	return {StreamAt<float>(m_header->timeStreamOffset) + channel.firstKey, PaddedKeyCount(channel.keyCount)};
+}
+
+std::span<const glm::vec4> AnimationClipView::GetKeyValues(const AnimationChannelEntry &channel) const
+{
+	return {StreamAt<glm::vec4>(m_header->valueStreamOffset) + channel.firstKey, PaddedKeyCount(channel.keyCount)};
+}
+
+std::span<const KeyInterpolation> AnimationClipView::GetKeyInterpolations(const AnimationChannelEntry &channel) const
+{
+	return {StreamAt<KeyInterpolation>(m_header->interpolationStreamOffset) + channel.firstKey,
+		PaddedKeyCount(channel.keyCount)};
+}
+
+size_t AnimationClipView::FindKey(const AnimationChannelEntry &channel, const float time) const
+{
+	const auto times = GetKeyTimes(channel).first(channel.keyCount);
+	const auto it = std::upper_bound(times.begin(), times.end(), time);
+	return it == times.begin() ? 0 : static_cast<size_t>(std::distance(times.begin(), it) - 1);
+}
+
+glm::vec4 AnimationClipView::Sample(const AnimationChannelEntry &channel, const float time) const
+{
+	const auto values = GetKeyValues(channel);
+	const size_t keyIndex = FindKey(channel, time);
+	if (keyIndex + 1 >= channel.keyCount)
+	{
+		return values[keyIndex];
+	}
+
+	// Keys sharing a time make a jump, the span between them is empty
+	const auto times = GetKeyTimes(channel);
+	const float span = times[keyIndex + 1] - times[keyIndex];
+	const float t = span > 0.0f ? glm::clamp((time - times[keyIndex]) / span, 0.0f, 1.0f) : 0.0f;
+
+	switch (GetKeyInterpolations(channel)[keyIndex])
+	{
+	case KeyInterpolation::Step:
+		return values[keyIndex];
+	case KeyInterpolation::Smooth:
+		return glm::mix(values[keyIndex], values[keyIndex + 1], t * t * (3.0f - 2.0f * t));
+	case KeyInterpolation::Linear:
+	default:
+		return glm::mix(values[keyIndex], values[keyIndex + 1], t);
+	}
+}
+
+std::vector<uint8_t> Grafkit::Resource::CookAnimationClip(const AnimationClipDesc &desc)
+{
+	AnimationClipHeader header{};
+	header.magic = ANIMATION_CLIP_MAGIC;
+	header.version = ANIMATION_CLIP_VERSION;
+	header.channelCount = static_cast<uint32_t>(desc.channels.size());
+	header.duration = desc.duration;
+	header.flags = desc.isLooping ? ANIMATION_CLIP_FLAG_LOOPING : 0;
+
+	std::vector<AnimationChannelEntry> channels;
+	channels.reserve(desc.channels.size());
+	uint32_t keyCount = 0;
+	for (const auto &channel : desc.channels)
+	{
+		if (channel.keys.empty())
+		{
+			throw std::runtime_error("Animation channel " + std::to_string(channel.id) + " has no keys");
+		}
+		// Keys carry no tangents, a cubic spline could only be sampled as a line
+		if (std::any_of(channel.keys.begin(),
+				channel.keys.end(),
+				[](const auto &key) { return key.interpolation == KeyInterpolation::CubicSpline; }))
+		{
+			throw std::runtime_error(
+				"Animation channel " + std::to_string(channel.id) + " has cubic spline keys, which are not supported");
+		}
+		const auto channelKeyCount = static_cast<uint32_t>(channel.keys.size());
+		channels.push_back({channel.id, channel.target, keyCount, channelKeyCount});
+		keyCount += PaddedKeyCount(channelKeyCount);
+	}
+	header.keyCount = keyCount;
+
+	header.channelTableOffset = sizeof(AnimationClipHeader);
+	header.nameOffset =
+		static_cast<uint32_t>(header.channelTableOffset + channels.size() * sizeof(AnimationChannelEntry));
+	header.nameLength = static_cast<uint32_t>(desc.name.size());
+	header.timeStreamOffset = AlignUp(header.nameOffset + header.nameLength, ANIMATION_CLIP_STREAM_ALIGNMENT);
+	header.valueStreamOffset =
+		AlignUp(header.timeStreamOffset + keyCount * sizeof(float), ANIMATION_CLIP_STREAM_ALIGNMENT);
+	header.interpolationStreamOffset =
+		AlignUp(header.valueStreamOffset + keyCount * sizeof(glm::vec4), ANIMATION_CLIP_STREAM_ALIGNMENT);
+	const uint64_t size = AlignUp(
+		header.interpolationStreamOffset + keyCount * sizeof(KeyInterpolation), ANIMATION_CLIP_STREAM_ALIGNMENT);
+
+	std::vector<uint8_t> data(size, 0);
+	std::memcpy(data.data(), &header, sizeof(header));
+	std::memcpy(
+		data.data() + header.channelTableOffset, channels.data(), channels.size() * sizeof(AnimationChannelEntry));
+	std::memcpy(data.data() + header.nameOffset, desc.name.data(), desc.name.size());
+
+	auto *times = reinterpret_cast<float *>(data.data() + header.timeStreamOffset);
+	auto *values = reinterpret_cast<glm::vec4 *>(data.data() + header.valueStreamOffset);
+	auto *interpolations = reinterpret_cast<KeyInterpolation *>(data.data() + header.interpolationStreamOffset);
+
+	for (size_t i = 0; i < desc.channels.size(); ++i)
+	{
+		const auto &keys = desc.channels[i].keys;
+		const auto &entry = channels[i];
+		for (uint32_t k = 0; k < PaddedKeyCount(entry.keyCount); ++k)
+		{
+			// Padding repeats the last key, so sampling past the end stays on the last value
+			const auto &key = keys[std::min<size_t>(k, keys.size() - 1)];
+			times[entry.firstKey + k] = key.time;
+			values[entry.firstKey + k] = key.value;
+			interpolations[entry.firstKey + k] = key.interpolation;
+		}
+	}
+
+	return data;
+}
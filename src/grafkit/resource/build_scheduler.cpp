@@ -0,0 +1,242 @@
+#include "stdafx.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+#include "grafkit/resource/build_scheduler.h"
+#include "grafkit/utils/thread_pool.h"
+
+using namespace Grafkit::Resource;
+
+namespace
+{
+	enum VisitState : uint8_t
+	{
+		NotVisited = 0,
+		Visiting,
+		Visited,
+	};
+
+	std::string Describe(const ResourceId &id)
+	{
+		return "'" + id.name + "' (" + id.type.name() + ")";
+	}
+} // namespace
+
+BuildScheduler::BuildScheduler(const ResourceManagerRef &resources, const size_t workerCount)
+	: m_resources(resources)
+	, m_workers(std::make_unique<Utils::ThreadPool>(workerCount))
+{
+}
+
+BuildScheduler::~BuildScheduler() = default;
+
+BuildScheduler &BuildScheduler::Add(const std::type_index type, const std::string &name, IResourceLoaderPtr loader)
+{
+	if (loader == nullptr)
+	{
+		throw std::invalid_argument("Loader is null for resource: " + name);
+	}
+
+	const auto [it, inserted] = m_nodeIndices.emplace(std::make_pair(type, name), m_nodes.size());
+	if (!inserted)
+	{
+		throw std::invalid_argument("Resource is already scheduled: " + name);
+	}
+
+	m_nodes.push_back({{type, name}, std::move(loader)});
+	return *this;
+}
+
+std::vector<std::string> BuildScheduler::Validate() const
+{
+	std::vector<std::string> errors;
+	[[maybe_unused]] const Graph graph = MakeGraph(errors);
+	return errors;
+}
+
+void BuildScheduler::Build(const Core::DeviceRef &device)
+{
+	std::vector<std::string> errors;
+	const Graph graph = MakeGraph(errors);
+	if (!errors.empty())
+	{
+		std::string message = "Unable to schedule resource builds:";
+		for (const auto &error : errors)
+		{
+			message += "\n\t" + error;
+		}
+		throw std::runtime_error(message);
+	}
+
+	std::mutex mutex;
+	std::condition_variable finishedCondition;
+	std::deque<std::pair<size_t, std::exception_ptr>> finished;
+
+	size_t inFlight = 0;
+	std::exception_ptr firstError;
+
+	const auto dispatch = [&](const size_t index)
+	{
+		if (firstError)
+		{
+			return;
+		}
+
+		const Node &node = m_nodes[index];
+		try
+		{
+			if (!node.loader->ResolveDependencies(m_resources))
+			{
+				throw std::runtime_error("Unresolved dependencies for resource: " + node.id.name);
+			}
+		}
+		catch (...)
+		{
+			firstError = firstError ? firstError : std::current_exception();
+			return;
+		}
+
+		++inFlight;
+		m_workers->Enqueue(
+			[&, index]()
+			{
+				std::exception_ptr error;
+				try
+				{
+					m_nodes[index].loader->Build(device);
+				}
+				catch (...)
+				{
+					error = std::current_exception();
+				}
+
+				{
+					std::lock_guard<std::mutex> lock(mutex);
+					finished.emplace_back(index, error);
+				}
+				finishedCondition.notify_one();
+			});
+	};
+
+	std::vector<size_t> pendingCounts(m_nodes.size());
+	for (size_t i = 0; i < m_nodes.size(); ++i)
+	{
+		pendingCounts[i] = graph.dependencies[i].size();
+		if (pendingCounts[i] == 0)
+		{
+			dispatch(i);
+		}
+	}
+
+	// Builds reference the locals above, keep waiting until every one of them is done even after an error
+	while (inFlight > 0)
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		finishedCondition.wait(lock, [&finished]() { return !finished.empty(); });
+		const auto [index, error] = finished.front();
+		finished.pop_front();
+		lock.unlock();
+
+		--inFlight;
+		if (error)
+		{
+			firstError = firstError ? firstError : error;
+			continue;
+		}
+
+		const Node &node = m_nodes[index];
+		m_resources->Add(node.id.type, node.id.name, node.loader->GetResource());
+
+		if (firstError)
+		{
+			continue;
+		}
+
+		for (const size_t dependent : graph.dependents[index])
+		{
+			if (--pendingCounts[dependent] == 0)
+			{
+				dispatch(dependent);
+			}
+		}
+	}
+
+	m_nodes.clear();
+	m_nodeIndices.clear();
+
+	if (firstError)
+	{
+		std::rethrow_exception(firstError);
+	}
+}
+
+BuildScheduler::Graph BuildScheduler::MakeGraph(std::vector<std::string> &errors) const
+{
+	Graph graph;
+	graph.dependencies.resize(m_nodes.size());
+	graph.dependents.resize(m_nodes.size());
+
+	for (size_t i = 0; i < m_nodes.size(); ++i)
+	{
+		for (const ResourceId &dependency : m_nodes[i].loader->GetDependencies())
+		{
+			const auto it = m_nodeIndices.find(std::make_pair(dependency.type, dependency.name));
+			if (it != m_nodeIndices.end())
+			{
+				graph.dependencies[i].push_back(it->second);
+				graph.dependents[it->second].push_back(i);
+			}
+			else if (!m_resources->Contains(dependency))
+			{
+				errors.push_back(
+					"Missing dependency " + Describe(dependency) + " of " + Describe(m_nodes[i].id));
+			}
+		}
+	}
+
+	std::vector<uint8_t> states(m_nodes.size(), NotVisited);
+	std::vector<size_t> path;
+	for (size_t i = 0; i < m_nodes.size(); ++i)
+	{
+		if (states[i] == NotVisited)
+		{
+			FindCycles(graph, i, states, path, errors);
+		}
+	}
+
+	return graph;
+}
+
+void BuildScheduler::FindCycles(const Graph &graph,
+	const size_t index,
+	std::vector<uint8_t> &states,
+	std::vector<size_t> &path,
+	std::vector<std::string> &errors) const
+{
+	states[index] = Visiting;
+	path.push_back(index);
+
+	for (const size_t dependency : graph.dependencies[index])
+	{
+		if (states[dependency] == Visiting)
+		{
+			// Dependency is on the path, everything from there on is part of the cycle
+			std::string cycle = "Dependency cycle: ";
+			const auto start = std::find(path.begin(), path.end(), dependency);
+			for (auto it = start; it != path.end(); ++it)
+			{
+				cycle += Describe(m_nodes[*it].id) + " -> ";
+			}
+			errors.push_back(cycle + Describe(m_nodes[dependency].id));
+		}
+		else if (states[dependency] == NotVisited)
+		{
+			FindCycles(graph, dependency, states, path, errors);
+		}
+	}
+
+	path.pop_back();
+	states[index] = Visited;
+}
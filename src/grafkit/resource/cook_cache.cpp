@@ -0,0 +1,117 @@
+#include "stdafx.h"
+
+#include <fstream>
+#include <thread>
+
+#include "grafkit/resource/cook_cache.h"
+
+using namespace Grafkit::Resource;
+
+namespace
+{
+	constexpr uint64_t FNV_PRIME = 0x100000001B3ull;
+} // namespace
+
+CookCache::CookCache(std::filesystem::path directory)
+	: m_directory(std::move(directory))
+{
+	std::filesystem::create_directories(m_directory);
+}
+
+uint64_t CookCache::Hash(const std::span<const uint8_t> data, uint64_t seed)
+{
+	for (const uint8_t byte : data)
+	{
+		seed ^= byte;
+		seed *= FNV_PRIME;
+	}
+	return seed;
+}
+
+uint64_t CookCache::Hash(const std::string_view text, const uint64_t seed)
+{
+	return Hash({reinterpret_cast<const uint8_t *>(text.data()), text.size()}, seed);
+}
+
+std::filesystem::path CookCache::GetPath(const std::string_view name) const
+{
+	char fileName[32];
+	std::snprintf(fileName, sizeof(fileName), "%016llx.gkcc", static_cast<unsigned long long>(Hash(name)));
+	return m_directory / fileName;
+}
+
+std::optional<std::vector<uint8_t>> CookCache::Load(const std::string_view name, const uint64_t key) const
+{
+	const std::filesystem::path path = GetPath(name);
+	std::ifstream file(path, std::ios::binary);
+	if (!file.is_open())
+	{
+		return std::nullopt;
+	}
+
+	std::error_code error;
+	const uintmax_t fileSize = std::filesystem::file_size(path, error);
+	if (error)
+	{
+		return std::nullopt;
+	}
+
+	CookCacheHeader header{};
+	if (!file.read(reinterpret_cast<char *>(&header), sizeof(header)) || header.magic != COOK_CACHE_MAGIC ||
+		header.version != COOK_CACHE_VERSION || header.key != key)
+	{
+		return std::nullopt;
+	}
+
+	// The size comes from the file, it is checked before anything is allocated for it
+	if (header.dataSize > fileSize - sizeof(header))
+	{
+		Grafkit::Core::Log::Instance().Warning("Corrupt cooked asset cache entry: %s", std::string(name).c_str());
+		return std::nullopt;
+	}
+
+	std::vector<uint8_t> data(header.dataSize);
+	if (!file.read(reinterpret_cast<char *>(data.data()), static_cast<std::streamsize>(data.size())) ||
+		Hash(data) != header.dataHash)
+	{
+		Grafkit::Core::Log::Instance().Warning("Corrupt cooked asset cache entry: %s", std::string(name).c_str());
+		return std::nullopt;
+	}
+
+	return data;
+}
+
+void CookCache::Store(const std::string_view name, const uint64_t key, const std::span<const uint8_t> data) const
+{
+	const std::filesystem::path path = GetPath(name);
+
+	// Write a temporary file first, so a crash or a concurrent reader never sees a half written entry
+	std::filesystem::path tempPath = path;
+	tempPath += "." + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id())) + ".tmp";
+
+	{
+		const CookCacheHeader header{
+			.magic = COOK_CACHE_MAGIC,
+			.version = COOK_CACHE_VERSION,
+			.key = key,
+			.dataSize = data.size(),
+			.dataHash = Hash(data),
+		};
+
+		std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+		file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+		file.write(reinterpret_cast<const char *>(data.data()), static_cast<std::streamsize>(data.size()));
+		if (!file)
+		{
+			throw std::runtime_error("Failed to write cooked asset cache entry: " + tempPath.string());
+		}
+	}
+
+	std::filesystem::rename(tempPath, path);
+}
+
+void CookCache::Invalidate(const std::string_view name) const
+{
+	std::error_code error;
+	std::filesystem::remove(GetPath(name), error);
+}
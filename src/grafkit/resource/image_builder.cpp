@@ -6,6 +6,67 @@
 using namespace Grafkit::Resource;
 using Grafkit::Core::Image;
 
+namespace
+{
+	std::vector<uint8_t> CookImage(const CookedImageHeader &header, const std::span<const uint8_t> pixels)
+	{
+		std::vector<uint8_t> data(sizeof(CookedImageHeader) + pixels.size());
+		std::memcpy(data.data(), &header, sizeof(header));
+		std::memcpy(data.data() + sizeof(header), pixels.data(), pixels.size());
+		return data;
+	}
+
+	std::span<const uint8_t> ReadCookedImage(const std::span<const uint8_t> data, CookedImageHeader &header)
+	{
+		if (data.size() < sizeof(CookedImageHeader))
+		{
+			throw std::runtime_error("Cooked image is truncated");
+		}
+		std::memcpy(&header, data.data(), sizeof(header));
+		if (header.pixelSize != data.size() - sizeof(CookedImageHeader))
+		{
+			throw std::runtime_error("Cooked image is corrupt");
+		}
+		return data.subspan(sizeof(CookedImageHeader));
+	}
+
+	VkFormat ToVkFormat(const ImageFormat format)
+	{
+		switch (format)
+		{
+		case ImageFormat::RGBA:
+			return VK_FORMAT_R8G8B8A8_UNORM;
+		case ImageFormat::Grayscale:
+			return VK_FORMAT_R8_UNORM;
+		case ImageFormat::RGBAFloat:
+			return VK_FORMAT_R32G32B32A32_SFLOAT;
+		case ImageFormat::RGB:
+		default:
+			throw std::runtime_error("Unsupported image format: " + std::to_string(static_cast<int>(format)));
+		}
+	}
+
+	// Device memory of the image along with its mip chain
+	ResourceUsage GetImageUsage(uint32_t width, uint32_t height, const size_t pixelSize, const bool useMipmap)
+	{
+		ResourceUsage usage{};
+		usage.gpuBytes = static_cast<size_t>(width) * height * pixelSize;
+		while (useMipmap && (width > 1 || height > 1))
+		{
+			width = std::max(width / 2, 1u);
+			height = std::max(height / 2, 1u);
+			usage.gpuBytes += static_cast<size_t>(width) * height * pixelSize;
+		}
+		return usage;
+	}
+
+	uint32_t GetPixelSize(const ImageDesc &descriptor)
+	{
+		const uint32_t channelSize = descriptor.format == ImageFormat::RGBAFloat ? sizeof(float) : 1;
+		return descriptor.channels * channelSize;
+	}
+} // namespace
+
 void ImageBuilder::Build(const Core::DeviceRef &device)
 {
 	m_resource = Image::CreateImage(device,
@@ -15,14 +76,70 @@ void ImageBuilder::Build(const Core::DeviceRef &device)
 			m_descriptor.size.y,
 			1,
 		},
-		m_descriptor.channels,
-		static_cast<VkFormat>(m_descriptor.format),
+		GetPixelSize(m_descriptor),
+		ToVkFormat(m_descriptor.format),
 		VK_IMAGE_TYPE_2D,
 		m_descriptor.useMipmap,
 		VK_IMAGE_USAGE_SAMPLED_BIT,
 		VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
 }
 
+ResourceUsage ImageBuilder::GetUsage() const
+{
+	return GetImageUsage(m_descriptor.size.x, m_descriptor.size.y, GetPixelSize(m_descriptor), m_descriptor.useMipmap);
+}
+
+std::vector<uint8_t> ImageBuilder::Cook()
+{
+	const CookedImageHeader header{
+		.width = m_descriptor.size.x,
+		.height = m_descriptor.size.y,
+		.depth = 1,
+		.channels = m_descriptor.channels,
+		.format = static_cast<uint32_t>(m_descriptor.format),
+		.flags = m_descriptor.useMipmap ? COOKED_IMAGE_FLAG_MIPMAP : 0,
+		.pixelSize = m_descriptor.image.size(),
+	};
+	return CookImage(header, m_descriptor.image);
+}
+
+void ImageBuilder::LoadCooked(const std::span<const uint8_t> data)
+{
+	CookedImageHeader header{};
+	const auto pixels = ReadCookedImage(data, header);
+
+	m_descriptor.size = {header.width, header.height, header.depth};
+	m_descriptor.channels = header.channels;
+	m_descriptor.format = static_cast<ImageFormat>(header.format);
+	m_descriptor.useMipmap = (header.flags & COOKED_IMAGE_FLAG_MIPMAP) != 0;
+	m_descriptor.image.assign(pixels.begin(), pixels.end());
+	ExpandToRgba();
+}
+
+void ImageBuilder::ExpandToRgba()
+{
+	if (m_descriptor.format != ImageFormat::RGB)
+	{
+		return;
+	}
+
+	auto &image = m_descriptor.image;
+	const size_t pixelCount = image.size() / 3;
+	image.resize(pixelCount * 4);
+
+	// Back to front, so the source pixels are not overwritten before they are moved
+	for (size_t i = pixelCount; i-- > 0;)
+	{
+		image[i * 4 + 3] = 0xff;
+		image[i * 4 + 2] = image[i * 3 + 2];
+		image[i * 4 + 1] = image[i * 3 + 1];
+		image[i * 4 + 0] = image[i * 3 + 0];
+	}
+
+	m_descriptor.format = ImageFormat::RGBA;
+	m_descriptor.channels = 4;
+}
+
 void SolidImageBuilder::Build(const Core::DeviceRef &device)
 {
 	m_resource = Image::CreateImage(device,
@@ -36,11 +153,78 @@ void SolidImageBuilder::Build(const Core::DeviceRef &device)
 		VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
 }
 
+ResourceUsage SolidImageBuilder::GetUsage() const
+{
+	return GetImageUsage(1, 1, sizeof(m_descriptor.color), false);
+}
+
 void CheckerImageBuilder::Build(const Core::DeviceRef &device)
+{
+	constexpr uint32_t bytesPerPixel = 4;
+	if (m_bitmap.empty())
+	{
+		GenerateBitmap();
+	}
+
+	m_resource = Image::CreateImage(device,
+		m_bitmap.data(),
+		{
+			m_descriptor.size.x,
+			m_descriptor.size.y,
+			1,
+		},
+		bytesPerPixel,
+		VK_FORMAT_R8G8B8A8_UNORM,
+		VK_IMAGE_TYPE_2D,
+		m_descriptor.useMipmap,
+		VK_IMAGE_USAGE_SAMPLED_BIT,
+		VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+}
+
+ResourceUsage CheckerImageBuilder::GetUsage() const
+{
+	return GetImageUsage(m_descriptor.size.x, m_descriptor.size.y, 4, m_descriptor.useMipmap);
+}
+
+std::vector<uint8_t> CheckerImageBuilder::Cook()
+{
+	if (m_bitmap.empty())
+	{
+		GenerateBitmap();
+	}
+
+	const CookedImageHeader header{
+		.width = m_descriptor.size.x,
+		.height = m_descriptor.size.y,
+		.depth = 1,
+		.channels = 4,
+		.format = static_cast<uint32_t>(ImageFormat::RGBA),
+		.flags = m_descriptor.useMipmap ? COOKED_IMAGE_FLAG_MIPMAP : 0,
+		.pixelSize = m_bitmap.size(),
+	};
+	return CookImage(header, m_bitmap);
+}
+
+void CheckerImageBuilder::LoadCooked(const std::span<const uint8_t> data)
+{
+	CookedImageHeader header{};
+	const auto pixels = ReadCookedImage(data, header);
+	if (header.channels != 4)
+	{
+		throw std::runtime_error("Cooked checker image has to be RGBA");
+	}
+
+	m_descriptor.size = {header.width, header.height, header.depth};
+	m_descriptor.useMipmap = (header.flags & COOKED_IMAGE_FLAG_MIPMAP) != 0;
+	m_bitmap.assign(pixels.begin(), pixels.end());
+}
+
+void CheckerImageBuilder::GenerateBitmap()
 {
 	constexpr uint32_t channels = 4;
 	const auto size = m_descriptor.size.x * m_descriptor.size.y * channels;
-	std::vector<uint8_t> bitmap(size);
+	m_bitmap.resize(size);
+	std::vector<uint8_t> &bitmap = m_bitmap;
 
 	for (int y = 0; y < m_descriptor.size.y; ++y)
 	{
@@ -65,18 +249,4 @@ void CheckerImageBuilder::Build(const Core::DeviceRef &device)
 			}
 		}
 	}
-
-	m_resource = Image::CreateImage(device,
-		bitmap.data(),
-		{
-			m_descriptor.size.x,
-			m_descriptor.size.y,
-			1,
-		},
-		channels,
-		VK_FORMAT_R8G8B8A8_UNORM,
-		VK_IMAGE_TYPE_2D,
-		m_descriptor.useMipmap,
-		VK_IMAGE_USAGE_SAMPLED_BIT,
-		VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
 }
@@ -45,6 +45,26 @@ bool Grafkit::Resource::MaterialBuilder::ResolveDependencies(const RefWrapper<Re
 	return result;
 }
 
+std::vector<ResourceId> MaterialBuilder::GetDependencies() const
+{
+	std::vector<ResourceId> dependencies;
+
+	if (m_renderStage == nullptr && !m_descriptor.stage.empty())
+	{
+		dependencies.push_back({typeid(Grafkit::RenderStage), m_descriptor.stage});
+	}
+
+	if (m_images.empty())
+	{
+		for (const auto &[bindId, textureName] : m_descriptor.textures)
+		{
+			dependencies.push_back({typeid(Core::Image), textureName});
+		}
+	}
+
+	return dependencies;
+}
+
 void MaterialBuilder::Build(const Core::DeviceRef &device)
 {
 	m_resource = std::make_shared<Grafkit::Material>();
@@ -0,0 +1,494 @@
+#include "stdafx.h"
+
+#include <algorithm>
+#include <numeric>
+
+#include <grafkit/descriptors/mesh_desc.h>
+#include <grafkit/resource/mesh_optimizer.h>
+
+using namespace Grafkit::Resource;
+
+namespace
+{
+	// FIFO cache as the vertex shader invocation cache of most GPUs behaves; a vertex is in the cache while fewer
+	// than cacheSize misses happened since it was put there
+	class CacheSimulator
+	{
+	public:
+		CacheSimulator(const uint32_t vertexCount, const uint32_t cacheSize)
+			: m_timestamps(vertexCount, 0)
+			, m_cacheSize(cacheSize)
+		{
+		}
+
+		// True on a miss
+		bool Access(const uint32_t vertex)
+		{
+			if (m_timestamps[vertex] != 0 && m_time - m_timestamps[vertex] < m_cacheSize)
+			{
+				return false;
+			}
+			m_timestamps[vertex] = ++m_time;
+			return true;
+		}
+
+		// Every vertex cached so far gets stale
+		void Reset()
+		{
+			m_time += m_cacheSize;
+		}
+
+	private:
+		std::vector<uint32_t> m_timestamps;
+		uint32_t m_cacheSize;
+		uint32_t m_time = 0;
+	};
+
+	void ValidateIndices(const std::span<const uint32_t> indices, const uint32_t vertexCount)
+	{
+		if (indices.size() % 3 != 0)
+		{
+			throw std::invalid_argument("Index count is not a multiple of three");
+		}
+		if (std::any_of(indices.begin(), indices.end(), [vertexCount](uint32_t index) { return index >= vertexCount; }))
+		{
+			throw std::invalid_argument("Index out of vertex range");
+		}
+	}
+
+	// Triangles around each vertex, in compressed row form
+	struct Adjacency
+	{
+		std::vector<uint32_t> offsets;
+		std::vector<uint32_t> triangles;
+
+		Adjacency(const std::span<const uint32_t> indices, const uint32_t vertexCount)
+			: offsets(vertexCount + 1, 0)
+			, triangles(indices.size())
+		{
+			for (const uint32_t index : indices)
+			{
+				++offsets[index + 1];
+			}
+			std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+			std::vector<uint32_t> cursors(offsets.begin(), offsets.end() - 1);
+			for (size_t i = 0; i < indices.size(); ++i)
+			{
+				triangles[cursors[indices[i]]++] = static_cast<uint32_t>(i / 3);
+			}
+		}
+	};
+
+	constexpr uint32_t NO_VERTEX = ~0u;
+
+	// A vertex still having triangles to emit; from the dead-end stack first, most recently used, then in input order
+	uint32_t SkipDeadEnd(const std::vector<uint32_t> &liveCounts, std::vector<uint32_t> &deadEnds, uint32_t &cursor)
+	{
+		while (!deadEnds.empty())
+		{
+			const uint32_t vertex = deadEnds.back();
+			deadEnds.pop_back();
+			if (liveCounts[vertex] > 0)
+			{
+				return vertex;
+			}
+		}
+
+		for (; cursor < liveCounts.size(); ++cursor)
+		{
+			if (liveCounts[cursor] > 0)
+			{
+				return cursor;
+			}
+		}
+		return NO_VERTEX;
+	}
+} // namespace
+
+void MeshOptimizeStats::Add(const MeshOptimizeStats &other)
+{
+	const size_t total = triangleCount + other.triangleCount;
+	if (total == 0)
+	{
+		return;
+	}
+	const auto weight = [total](const size_t count) { return static_cast<float>(count) / static_cast<float>(total); };
+	acmrBefore = acmrBefore * weight(triangleCount) + other.acmrBefore * weight(other.triangleCount);
+	acmrAfter = acmrAfter * weight(triangleCount) + other.acmrAfter * weight(other.triangleCount);
+	triangleCount = total;
+}
+
+// MARK: Vertex cache
+
+float MeshOptimizer::CalculateAcmr(const std::span<const uint32_t> indices,
+	const uint32_t vertexCount,
+	const uint32_t cacheSize)
+{
+	ValidateIndices(indices, vertexCount);
+	if (indices.empty())
+	{
+		return 0.0f;
+	}
+
+	CacheSimulator cache(vertexCount, cacheSize);
+	size_t misses = 0;
+	for (const uint32_t index : indices)
+	{
+		misses += cache.Access(index) ? 1 : 0;
+	}
+	return static_cast<float>(misses) / static_cast<float>(indices.size() / 3);
+}
+
+std::vector<uint32_t> MeshOptimizer::OptimizeVertexCache(const std::span<const uint32_t> indices,
+	const uint32_t vertexCount,
+	const uint32_t cacheSize)
+{
+	ValidateIndices(indices, vertexCount);
+
+	const Adjacency adjacency(indices, vertexCount);
+	std::vector<uint32_t> liveCounts(vertexCount);
+	for (uint32_t vertex = 0; vertex < vertexCount; ++vertex)
+	{
+		liveCounts[vertex] = adjacency.offsets[vertex + 1] - adjacency.offsets[vertex];
+	}
+
+	std::vector<uint32_t> timestamps(vertexCount, 0);
+	std::vector<bool> isEmitted(indices.size() / 3, false);
+	std::vector<uint32_t> deadEnds;
+	std::vector<uint32_t> candidates;
+
+	std::vector<uint32_t> result;
+	result.reserve(indices.size());
+
+	uint32_t time = cacheSize + 1;
+	uint32_t cursor = 0;
+	uint32_t fanning = SkipDeadEnd(liveCounts, deadEnds, cursor);
+
+	while (fanning != NO_VERTEX)
+	{
+		// Emit every remaining triangle around the fanning vertex
+		candidates.clear();
+		for (uint32_t i = adjacency.offsets[fanning]; i < adjacency.offsets[fanning + 1]; ++i)
+		{
+			const uint32_t triangle = adjacency.triangles[i];
+			if (isEmitted[triangle])
+			{
+				continue;
+			}
+			isEmitted[triangle] = true;
+
+			for (uint32_t corner = 0; corner < 3; ++corner)
+			{
+				const uint32_t vertex = indices[triangle * 3 + corner];
+				result.push_back(vertex);
+				deadEnds.push_back(vertex);
+				candidates.push_back(vertex);
+				--liveCounts[vertex];
+				if (time - timestamps[vertex] > cacheSize)
+				{
+					timestamps[vertex] = time++;
+				}
+			}
+		}
+
+		// Next one is the candidate staying in the cache the longest while its triangles get emitted
+		fanning = NO_VERTEX;
+		int bestPriority = -1;
+		for (const uint32_t vertex : candidates)
+		{
+			if (liveCounts[vertex] == 0)
+			{
+				continue;
+			}
+			int priority = 0;
+			if (time - timestamps[vertex] + 2 * liveCounts[vertex] <= cacheSize)
+			{
+				priority = static_cast<int>(time - timestamps[vertex]);
+			}
+			if (priority > bestPriority)
+			{
+				bestPriority = priority;
+				fanning = vertex;
+			}
+		}
+
+		if (fanning == NO_VERTEX)
+		{
+			fanning = SkipDeadEnd(liveCounts, deadEnds, cursor);
+		}
+	}
+
+	return result;
+}
+
+// MARK: Overdraw
+
+std::vector<uint32_t> MeshOptimizer::OptimizeOverdraw(const std::span<const uint32_t> indices,
+	const std::span<const glm::vec3> positions,
+	const uint32_t cacheSize,
+	const float threshold)
+{
+	const auto vertexCount = static_cast<uint32_t>(positions.size());
+	ValidateIndices(indices, vertexCount);
+
+	const size_t triangleCount = indices.size() / 3;
+	if (triangleCount == 0)
+	{
+		return {};
+	}
+
+	// Misses of each triangle in the given order
+	std::vector<uint32_t> misses(triangleCount);
+	{
+		CacheSimulator cache(vertexCount, cacheSize);
+		for (size_t triangle = 0; triangle < triangleCount; ++triangle)
+		{
+			for (uint32_t corner = 0; corner < 3; ++corner)
+			{
+				misses[triangle] += cache.Access(indices[triangle * 3 + corner]) ? 1 : 0;
+			}
+		}
+	}
+
+	// Hard boundaries are where the cache starts over, all three vertices of the triangle miss
+	std::vector<size_t> hardBoundaries;
+	for (size_t triangle = 0; triangle < triangleCount; ++triangle)
+	{
+		if (triangle == 0 || misses[triangle] == 3)
+		{
+			hardBoundaries.push_back(triangle);
+		}
+	}
+	hardBoundaries.push_back(triangleCount);
+
+	// Soft boundaries split hard clusters once the ACMR from the last split, with a cold cache, gets close enough to
+	// the one of the whole cluster
+	std::vector<size_t> boundaries;
+	CacheSimulator cache(vertexCount, cacheSize);
+	for (size_t i = 0; i + 1 < hardBoundaries.size(); ++i)
+	{
+		const size_t begin = hardBoundaries[i];
+		const size_t end = hardBoundaries[i + 1];
+
+		uint32_t clusterMisses = 0;
+		for (size_t triangle = begin; triangle < end; ++triangle)
+		{
+			clusterMisses += misses[triangle];
+		}
+		const float clusterAcmr = static_cast<float>(clusterMisses) / static_cast<float>(end - begin);
+
+		boundaries.push_back(begin);
+		cache.Reset();
+		uint32_t runningMisses = 0;
+		size_t start = begin;
+		for (size_t triangle = begin; triangle + 1 < end; ++triangle)
+		{
+			for (uint32_t corner = 0; corner < 3; ++corner)
+			{
+				runningMisses += cache.Access(indices[triangle * 3 + corner]) ? 1 : 0;
+			}
+			const float acmr = static_cast<float>(runningMisses) / static_cast<float>(triangle + 1 - start);
+			if (acmr <= clusterAcmr * threshold)
+			{
+				boundaries.push_back(triangle + 1);
+				cache.Reset();
+				start = triangle + 1;
+				runningMisses = 0;
+			}
+		}
+	}
+	boundaries.push_back(triangleCount);
+
+	// Area weighted centroid and normal of every cluster and the whole mesh
+	const auto triangleCentroid = [&](const size_t triangle)
+	{
+		return (positions[indices[triangle * 3]] + positions[indices[triangle * 3 + 1]] +
+				   positions[indices[triangle * 3 + 2]]) /
+			3.0f;
+	};
+	const auto triangleNormal = [&](const size_t triangle)
+	{
+		const glm::vec3 &a = positions[indices[triangle * 3]];
+		return glm::cross(positions[indices[triangle * 3 + 1]] - a, positions[indices[triangle * 3 + 2]] - a);
+	};
+
+	glm::vec3 meshCentroid(0.0f);
+	float meshArea = 0.0f;
+	for (size_t triangle = 0; triangle < triangleCount; ++triangle)
+	{
+		const float area = glm::length(triangleNormal(triangle));
+		meshCentroid += triangleCentroid(triangle) * area;
+		meshArea += area;
+	}
+	meshCentroid = meshArea > 0.0f ? meshCentroid / meshArea : meshCentroid;
+
+	const size_t clusterCount = boundaries.size() - 1;
+	std::vector<float> sortKeys(clusterCount);
+	for (size_t cluster = 0; cluster < clusterCount; ++cluster)
+	{
+		glm::vec3 centroid(0.0f);
+		glm::vec3 normal(0.0f);
+		float area = 0.0f;
+		for (size_t triangle = boundaries[cluster]; triangle < boundaries[cluster + 1]; ++triangle)
+		{
+			const glm::vec3 triangleArea = triangleNormal(triangle);
+			const float length = glm::length(triangleArea);
+			centroid += triangleCentroid(triangle) * length;
+			normal += triangleArea;
+			area += length;
+		}
+		centroid = area > 0.0f ? centroid / area : centroid;
+		const float normalLength = glm::length(normal);
+		sortKeys[cluster] = normalLength > 0.0f ? glm::dot(centroid - meshCentroid, normal / normalLength) : 0.0f;
+	}
+
+	// Outward facing clusters on the outside of the mesh occlude the rest, they go first
+	std::vector<size_t> order(clusterCount);
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(
+		order.begin(), order.end(), [&sortKeys](const size_t a, const size_t b) { return sortKeys[a] > sortKeys[b]; });
+
+	std::vector<uint32_t> result;
+	result.reserve(indices.size());
+	for (const size_t cluster : order)
+	{
+		result.insert(result.end(),
+			indices.begin() + static_cast<ptrdiff_t>(boundaries[cluster] * 3),
+			indices.begin() + static_cast<ptrdiff_t>(boundaries[cluster + 1] * 3));
+	}
+	return result;
+}
+
+// MARK: Vertex fetch
+
+std::vector<uint32_t> MeshOptimizer::OptimizeVertexFetch(const std::span<uint32_t> indices, const uint32_t vertexCount)
+{
+	ValidateIndices(indices, vertexCount);
+
+	std::vector<uint32_t> remap(vertexCount, NO_VERTEX);
+	uint32_t next = 0;
+	for (uint32_t &index : indices)
+	{
+		if (remap[index] == NO_VERTEX)
+		{
+			remap[index] = next++;
+		}
+		index = remap[index];
+	}
+
+	for (uint32_t &target : remap)
+	{
+		if (target == NO_VERTEX)
+		{
+			target = next++;
+		}
+	}
+	return remap;
+}
+
+// MARK: Meshes
+
+std::vector<uint32_t> MeshOptimizer::OptimizeIndices(std::vector<uint32_t> &indices,
+	const std::span<const glm::vec3> positions,
+	const MeshOptimizeOptions &options,
+	MeshOptimizeStats &stats)
+{
+	const auto vertexCount = static_cast<uint32_t>(positions.size());
+	stats.triangleCount = indices.size() / 3;
+	stats.acmrBefore = CalculateAcmr(indices, vertexCount, options.cacheSize);
+
+	if (options.vertexCache)
+	{
+		indices = OptimizeVertexCache(indices, vertexCount, options.cacheSize);
+	}
+	if (options.overdraw)
+	{
+		indices = OptimizeOverdraw(indices, positions, options.cacheSize, options.overdrawThreshold);
+	}
+
+	std::vector<uint32_t> remap;
+	if (options.vertexFetch)
+	{
+		remap = OptimizeVertexFetch(indices, vertexCount);
+	}
+
+	stats.acmrAfter = CalculateAcmr(indices, vertexCount, options.cacheSize);
+	return remap;
+}
+
+MeshOptimizeStats MeshOptimizer::Optimize(MeshDescV2 &mesh, const MeshOptimizeOptions &options)
+{
+	const auto remapStream = [](auto &stream, const PrimitiveDescV2 &primitive, std::span<const uint32_t> remap)
+	{
+		if (stream.empty())
+		{
+			return;
+		}
+		if (stream.size() < uint64_t{primitive.vertexOffset} + primitive.vertexCount)
+		{
+			throw std::out_of_range("Vertex stream shorter than the positions");
+		}
+		using ValueType = typename std::decay_t<decltype(stream)>::value_type;
+		const auto begin = stream.begin() + primitive.vertexOffset;
+		std::vector<ValueType> vertices(begin, begin + primitive.vertexCount);
+		RemapVertices(vertices, remap);
+		std::copy(vertices.begin(), vertices.end(), begin);
+	};
+
+	MeshOptimizeStats stats{};
+	for (const PrimitiveDescV2 &primitive : mesh.primitives)
+	{
+		if (uint64_t{primitive.indexOffset} + primitive.indexCount > mesh.indices.size() ||
+			uint64_t{primitive.vertexOffset} + primitive.vertexCount > mesh.positions.size())
+		{
+			throw std::out_of_range("Primitive out of the range of the mesh: " + mesh.name);
+		}
+
+		const auto indexBegin = mesh.indices.begin() + primitive.indexOffset;
+		std::vector<uint32_t> indices(indexBegin, indexBegin + primitive.indexCount);
+		const std::span<const glm::vec3> positions(
+			mesh.positions.data() + primitive.vertexOffset, primitive.vertexCount);
+
+		MeshOptimizeStats primitiveStats{};
+		const std::vector<uint32_t> remap = OptimizeIndices(indices, positions, options, primitiveStats);
+		std::copy(indices.begin(), indices.end(), indexBegin);
+
+		if (!remap.empty())
+		{
+			remapStream(mesh.positions, primitive, remap);
+			remapStream(mesh.normals, primitive, remap);
+			remapStream(mesh.tangents, primitive, remap);
+			remapStream(mesh.bitangents, primitive, remap);
+			remapStream(mesh.texCoords, primitive, remap);
+		}
+		stats.Add(primitiveStats);
+
+		// Levels of detail index the same vertices; they follow the remap and get their own triangle order
+		MeshOptimizeOptions lodOptions = options;
+		lodOptions.vertexFetch = false;
+		for (const PrimitiveLodDesc &lod : primitive.lods)
+		{
+			if (uint64_t{lod.indexOffset} + lod.indexCount > mesh.indices.size())
+			{
+				throw std::out_of_range("Level of detail out of the range of the mesh: " + mesh.name);
+			}
+
+			const auto lodBegin = mesh.indices.begin() + lod.indexOffset;
+			std::vector<uint32_t> lodIndices(lodBegin, lodBegin + lod.indexCount);
+			if (!remap.empty())
+			{
+				ValidateIndices(lodIndices, primitive.vertexCount);
+				for (uint32_t &index : lodIndices)
+				{
+					index = remap[index];
+				}
+			}
+
+			MeshOptimizeStats lodStats{};
+			(void)OptimizeIndices(lodIndices, positions, lodOptions, lodStats);
+			std::copy(lodIndices.begin(), lodIndices.end(), lodBegin);
+		}
+	}
+	return stats;
+}
@@ -0,0 +1,603 @@
+#include "stdafx.h"
+
+#include <algorithm>
+#include <future>
+#include <numeric>
+#include <unordered_set>
+
+#include <grafkit/descriptors/mesh_desc.h>
+#include <grafkit/resource/mesh_simplifier.h>
+#include <grafkit/utils/thread_pool.h>
+
+using namespace Grafkit::Resource;
+
+namespace
+{
+	constexpr uint32_t NO_VERTEX = ~0u;
+
+	// Keeps collapses along a border from pulling it inwards, relative to the faces around it
+	constexpr double BORDER_WEIGHT = 10.0;
+
+	// Sum of squared distances from planes, each one weighted
+	struct Quadric
+	{
+		double a00 = 0, a01 = 0, a02 = 0, a11 = 0, a12 = 0, a22 = 0;
+		double b0 = 0, b1 = 0, b2 = 0;
+		double c = 0;
+
+		// Plane of unit normal n through distance d from the origin
+		static Quadric FromPlane(const glm::vec3 &n, const double d, const double weight)
+		{
+			const double x = n.x, y = n.y, z = n.z;
+			return {weight * x * x,
+				weight * x * y,
+				weight * x * z,
+				weight * y * y,
+				weight * y * z,
+				weight * z * z,
+				weight * x * d,
+				weight * y * d,
+				weight * z * d,
+				weight * d * d};
+		}
+
+		Quadric &operator+=(const Quadric &o)
+		{
+			a00 += o.a00, a01 += o.a01, a02 += o.a02, a11 += o.a11, a12 += o.a12, a22 += o.a22;
+			b0 += o.b0, b1 += o.b1, b2 += o.b2;
+			c += o.c;
+			return *this;
+		}
+
+		[[nodiscard]] double Evaluate(const glm::vec3 &p) const
+		{
+			const double x = p.x, y = p.y, z = p.z;
+			const double result = a00 * x * x + 2 * a01 * x * y + 2 * a02 * x * z + a11 * y * y + 2 * a12 * y * z +
+								  a22 * z * z + 2 * (b0 * x + b1 * y + b2 * z) + c;
+			return std::max(result, 0.0);
+		}
+	};
+
+	uint64_t EdgeKey(const uint32_t a, const uint32_t b)
+	{
+		return (static_cast<uint64_t>(a) << 32) | b;
+	}
+
+	enum class VertexKind : uint8_t
+	{
+		Manifold, // Interior, may collapse anywhere
+		Border,	  // On an open edge, collapses along it
+		Seam,	  // Split at the same position, collapses along the split together with its twin
+		Locked,	  // Anything more complex
+	};
+
+	/**
+	 * @brief Topology of the current triangles, rebuilt every pass
+	 * Vertices at the same position share a canonical vertex, open edges are the ones missing their opposite
+	 * half-edge between the same vertices; they are a seam where the canonical vertices are not missing it.
+	 */
+	struct Topology
+	{
+		std::vector<VertexKind> kinds;
+		std::vector<uint32_t> openNext;
+		std::vector<uint32_t> openPrev;
+		std::vector<uint32_t> twins;
+
+		// Triangles around each vertex, in compressed row form
+		std::vector<uint32_t> offsets;
+		std::vector<uint32_t> triangles;
+
+		Topology(const std::vector<uint32_t> &indices, const std::vector<uint32_t> &canonical)
+			: kinds(canonical.size(), VertexKind::Locked)
+			, openNext(canonical.size(), NO_VERTEX)
+			, openPrev(canonical.size(), NO_VERTEX)
+			, twins(canonical.size(), NO_VERTEX)
+			, offsets(canonical.size() + 1, 0)
+			, triangles(indices.size())
+		{
+			for (const uint32_t index : indices)
+			{
+				++offsets[index + 1];
+			}
+			std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+			std::vector<uint32_t> cursors(offsets.begin(), offsets.end() - 1);
+			for (size_t i = 0; i < indices.size(); ++i)
+			{
+				triangles[cursors[indices[i]]++] = static_cast<uint32_t>(i / 3);
+			}
+
+			std::unordered_set<uint64_t> edges;
+			std::unordered_set<uint64_t> canonicalEdges;
+			edges.reserve(indices.size());
+			canonicalEdges.reserve(indices.size());
+			ForEachEdge(indices,
+				[&](const uint32_t a, const uint32_t b)
+				{
+					edges.insert(EdgeKey(a, b));
+					canonicalEdges.insert(EdgeKey(canonical[a], canonical[b]));
+				});
+
+			std::vector<uint8_t> openOut(canonical.size(), 0);
+			std::vector<uint8_t> openIn(canonical.size(), 0);
+			ForEachEdge(indices,
+				[&](const uint32_t a, const uint32_t b)
+				{
+					if (!edges.contains(EdgeKey(b, a)))
+					{
+						openOut[a] = static_cast<uint8_t>(std::min(openOut[a] + 1, 2));
+						openIn[b] = static_cast<uint8_t>(std::min(openIn[b] + 1, 2));
+						openNext[a] = b;
+						openPrev[b] = a;
+					}
+				});
+
+			// Referenced vertices of each position
+			std::vector<uint32_t> groupSizes(canonical.size(), 0);
+			std::vector<uint32_t> groupFirst(canonical.size(), NO_VERTEX);
+			for (uint32_t vertex = 0; vertex < canonical.size(); ++vertex)
+			{
+				if (offsets[vertex] == offsets[vertex + 1])
+				{
+					continue;
+				}
+				const uint32_t group = canonical[vertex];
+				if (groupSizes[group]++ == 0)
+				{
+					groupFirst[group] = vertex;
+				}
+				else
+				{
+					twins[vertex] = groupFirst[group];
+					twins[groupFirst[group]] = vertex;
+				}
+			}
+
+			const auto isBorderEdge = [&](const uint32_t a, const uint32_t b)
+			{ return !canonicalEdges.contains(EdgeKey(canonical[b], canonical[a])); };
+
+			for (uint32_t vertex = 0; vertex < canonical.size(); ++vertex)
+			{
+				const uint32_t groupSize = groupSizes[canonical[vertex]];
+				if (openOut[vertex] == 0 && openIn[vertex] == 0)
+				{
+					kinds[vertex] = groupSize == 1 ? VertexKind::Manifold : VertexKind::Locked;
+				}
+				else if (openOut[vertex] == 1 && openIn[vertex] == 1)
+				{
+					const bool isNextBorder = isBorderEdge(vertex, openNext[vertex]);
+					const bool isPrevBorder = isBorderEdge(openPrev[vertex], vertex);
+					if (isNextBorder && isPrevBorder && groupSize == 1)
+					{
+						kinds[vertex] = VertexKind::Border;
+					}
+					else if (!isNextBorder && !isPrevBorder && groupSize == 2)
+					{
+						kinds[vertex] = VertexKind::Seam;
+					}
+				}
+			}
+		}
+
+		[[nodiscard]] std::span<const uint32_t> GetTriangles(const uint32_t vertex) const
+		{
+			return {triangles.data() + offsets[vertex], triangles.data() + offsets[vertex + 1]};
+		}
+
+		template <typename FuncT>
+		static void ForEachEdge(const std::vector<uint32_t> &indices, FuncT &&func)
+		{
+			for (size_t i = 0; i < indices.size(); i += 3)
+			{
+				func(indices[i], indices[i + 1]);
+				func(indices[i + 1], indices[i + 2]);
+				func(indices[i + 2], indices[i]);
+			}
+		}
+	};
+
+	struct Collapse
+	{
+		uint32_t from;
+		uint32_t to;
+		double cost;
+		double error;
+	};
+
+	// Lowest index of every distinct position
+	std::vector<uint32_t> FindCanonicalVertices(const std::span<const glm::vec3> positions)
+	{
+		std::vector<uint32_t> order(positions.size());
+		std::iota(order.begin(), order.end(), 0);
+		const auto less = [&positions](const uint32_t a, const uint32_t b)
+		{
+			const glm::vec3 &pa = positions[a];
+			const glm::vec3 &pb = positions[b];
+			return std::tie(pa.x, pa.y, pa.z, a) < std::tie(pb.x, pb.y, pb.z, b);
+		};
+		std::sort(order.begin(), order.end(), less);
+
+		std::vector<uint32_t> canonical(positions.size());
+		for (size_t i = 0; i < order.size(); ++i)
+		{
+			const bool isSame = i > 0 && positions[order[i]] == positions[order[i - 1]];
+			canonical[order[i]] = isSame ? canonical[order[i - 1]] : order[i];
+		}
+		return canonical;
+	}
+
+	// Triangles around a vertex have to keep facing the same way once it moved
+	bool IsFlipping(const Topology &topology,
+		const std::vector<uint32_t> &indices,
+		const std::vector<glm::vec3> &positions,
+		const uint32_t from,
+		const uint32_t to)
+	{
+		for (const uint32_t triangle : topology.GetTriangles(from))
+		{
+			const uint32_t *corners = indices.data() + triangle * 3;
+			const uint32_t corner = corners[0] == from ? 0 : corners[1] == from ? 1 : 2;
+			const uint32_t b = corners[(corner + 1) % 3];
+			const uint32_t c = corners[(corner + 2) % 3];
+			if (b == to || c == to)
+			{
+				continue; // Degenerates and goes away
+			}
+
+			const glm::vec3 before = glm::cross(positions[b] - positions[from], positions[c] - positions[from]);
+			const glm::vec3 after = glm::cross(positions[b] - positions[to], positions[c] - positions[to]);
+			if (glm::dot(before, after) <= 1e-2f * glm::length(before) * glm::length(after))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	size_t CountSharedTriangles(const Topology &topology,
+		const std::vector<uint32_t> &indices,
+		const uint32_t from,
+		const uint32_t to)
+	{
+		size_t count = 0;
+		for (const uint32_t triangle : topology.GetTriangles(from))
+		{
+			const uint32_t *corners = indices.data() + triangle * 3;
+			count += corners[0] == to || corners[1] == to || corners[2] == to ? 1 : 0;
+		}
+		return count;
+	}
+
+	// Drops the indices of earlier levels of detail, the full detail ones are packed in the order of the primitives
+	void RemoveLods(MeshDescV2 &mesh)
+	{
+		if (std::all_of(mesh.primitives.begin(),
+				mesh.primitives.end(),
+				[](const PrimitiveDescV2 &primitive) { return primitive.lods.empty(); }))
+		{
+			return;
+		}
+
+		std::vector<uint32_t> indices;
+		for (PrimitiveDescV2 &primitive : mesh.primitives)
+		{
+			if (uint64_t{primitive.indexOffset} + primitive.indexCount > mesh.indices.size())
+			{
+				throw std::out_of_range("Primitive out of the range of the mesh: " + mesh.name);
+			}
+			const auto begin = mesh.indices.begin() + primitive.indexOffset;
+			primitive.indexOffset = static_cast<uint32_t>(indices.size());
+			indices.insert(indices.end(), begin, begin + primitive.indexCount);
+			primitive.lods.clear();
+		}
+		mesh.indices = std::move(indices);
+	}
+} // namespace
+
+std::vector<uint32_t> MeshSimplifier::Simplify(const std::span<const uint32_t> indices,
+	const std::span<const glm::vec3> positions,
+	const size_t targetIndexCount,
+	const float maxError,
+	float *resultError)
+{
+	if (indices.size() % 3 != 0)
+	{
+		throw std::invalid_argument("Index count is not a multiple of three");
+	}
+	if (std::any_of(indices.begin(), indices.end(), [&positions](uint32_t index) { return index >= positions.size(); }))
+	{
+		throw std::invalid_argument("Index out of vertex range");
+	}
+
+	std::vector<uint32_t> result(indices.begin(), indices.end());
+	if (resultError != nullptr)
+	{
+		*resultError = 0.0f;
+	}
+	if (result.size() <= targetIndexCount || positions.empty())
+	{
+		return result;
+	}
+
+	// Errors are measured in the unit box of the positions
+	glm::vec3 min = positions.front();
+	glm::vec3 max = positions.front();
+	for (const glm::vec3 &position : positions)
+	{
+		min = glm::min(min, position);
+		max = glm::max(max, position);
+	}
+	const glm::vec3 size = max - min;
+	const float extent = std::max({size.x, size.y, size.z, 1e-12f});
+	std::vector<glm::vec3> normalized(positions.size());
+	std::transform(positions.begin(),
+		positions.end(),
+		normalized.begin(),
+		[&](const glm::vec3 &position) { return (position - min) / extent; });
+
+	const std::vector<uint32_t> canonical = FindCanonicalVertices(positions);
+
+	// Quadrics of the faces and the borders, gathered on the canonical vertices
+	// Collapses are ranked by the ones weighted by area and length, but a weighted sum is not a distance. The error is
+	// measured on unweighted planes instead: their sum bounds the squared distance from every plane it gathered.
+	std::vector<Quadric> quadrics(positions.size());
+	std::vector<Quadric> errorQuadrics(positions.size());
+	{
+		const Topology topology(result, canonical);
+		for (size_t i = 0; i < result.size(); i += 3)
+		{
+			const glm::vec3 &p0 = normalized[result[i]];
+			const glm::vec3 normal = glm::cross(normalized[result[i + 1]] - p0, normalized[result[i + 2]] - p0);
+			const float doubleArea = glm::length(normal);
+			if (doubleArea <= 0.0f)
+			{
+				continue;
+			}
+			const glm::vec3 unitNormal = normal / doubleArea;
+			const Quadric face = Quadric::FromPlane(unitNormal, -glm::dot(unitNormal, p0), doubleArea * 0.5);
+			const Quadric facePlane = Quadric::FromPlane(unitNormal, -glm::dot(unitNormal, p0), 1.0);
+			for (size_t corner = 0; corner < 3; ++corner)
+			{
+				quadrics[canonical[result[i + corner]]] += face;
+				errorQuadrics[canonical[result[i + corner]]] += facePlane;
+
+				const uint32_t a = result[i + corner];
+				const uint32_t b = result[i + (corner + 1) % 3];
+				if (topology.openNext[a] == b && topology.kinds[a] == VertexKind::Border)
+				{
+					const glm::vec3 edge = normalized[b] - normalized[a];
+					const float length = glm::length(edge);
+					if (length > 0.0f)
+					{
+						const glm::vec3 side = glm::normalize(glm::cross(edge, unitNormal));
+						const double sideDistance = -glm::dot(side, normalized[a]);
+						const Quadric border =
+							Quadric::FromPlane(side, sideDistance, BORDER_WEIGHT * length * length);
+						const Quadric borderPlane = Quadric::FromPlane(side, sideDistance, 1.0);
+						quadrics[canonical[a]] += border;
+						quadrics[canonical[b]] += border;
+						errorQuadrics[canonical[a]] += borderPlane;
+						errorQuadrics[canonical[b]] += borderPlane;
+					}
+				}
+			}
+		}
+	}
+
+	const double maxSquaredError = static_cast<double>(maxError) * maxError;
+	double worstSquaredError = 0.0;
+
+	while (result.size() > targetIndexCount)
+	{
+		const Topology topology(result, canonical);
+
+		// Where a vertex may collapse to, and its twin along with it
+		const auto findTwinTarget = [&](const uint32_t from, const uint32_t to) -> uint32_t
+		{
+			const uint32_t twin = topology.twins[from];
+			if (twin == NO_VERTEX || topology.kinds[twin] != VertexKind::Seam)
+			{
+				return NO_VERTEX;
+			}
+			const uint32_t twinTo = to == topology.openNext[from] ? topology.openPrev[twin] : topology.openNext[twin];
+			return twinTo != NO_VERTEX && canonical[twinTo] == canonical[to] ? twinTo : NO_VERTEX;
+		};
+
+		const auto canCollapse = [&](const uint32_t from, const uint32_t to)
+		{
+			if (canonical[from] == canonical[to])
+			{
+				return false;
+			}
+			switch (topology.kinds[from])
+			{
+			case VertexKind::Manifold:
+				return true;
+			case VertexKind::Border:
+				return to == topology.openNext[from] || to == topology.openPrev[from];
+			case VertexKind::Seam:
+				return (to == topology.openNext[from] || to == topology.openPrev[from]) &&
+					   findTwinTarget(from, to) != NO_VERTEX;
+			case VertexKind::Locked:
+				return false;
+			}
+			return false;
+		};
+
+		std::vector<Collapse> collapses;
+		Topology::ForEachEdge(result,
+			[&](const uint32_t a, const uint32_t b)
+			{
+				for (const auto [from, to] : {std::pair{a, b}, std::pair{b, a}})
+				{
+					if (canCollapse(from, to))
+					{
+						const double error = errorQuadrics[canonical[from]].Evaluate(normalized[to]);
+						if (error <= maxSquaredError)
+						{
+							collapses.push_back({from, to, quadrics[canonical[from]].Evaluate(normalized[to]), error});
+						}
+					}
+				}
+			});
+		std::sort(collapses.begin(),
+			collapses.end(),
+			[](const Collapse &a, const Collapse &b) { return a.cost < b.cost; });
+
+		// Collapses of a pass do not touch each other's triangles, the checks stay valid while applying them
+		std::vector<uint8_t> isLocked(positions.size(), 0);
+		std::vector<uint32_t> remap(positions.size());
+		std::iota(remap.begin(), remap.end(), 0);
+
+		const auto lockAround = [&](const uint32_t vertex)
+		{
+			for (const uint32_t triangle : topology.GetTriangles(vertex))
+			{
+				for (uint32_t corner = 0; corner < 3; ++corner)
+				{
+					isLocked[canonical[result[triangle * 3 + corner]]] = 1;
+				}
+			}
+		};
+
+		size_t triangleCount = result.size() / 3;
+		const size_t targetTriangleCount = targetIndexCount / 3;
+		size_t collapseCount = 0;
+		for (const Collapse &collapse : collapses)
+		{
+			if (triangleCount <= targetTriangleCount)
+			{
+				break;
+			}
+			if (isLocked[canonical[collapse.from]] || isLocked[canonical[collapse.to]])
+			{
+				continue;
+			}
+
+			const uint32_t twin = topology.kinds[collapse.from] == VertexKind::Seam ? topology.twins[collapse.from]
+																					  : NO_VERTEX;
+			const uint32_t twinTo = twin != NO_VERTEX ? findTwinTarget(collapse.from, collapse.to) : NO_VERTEX;
+			if (IsFlipping(topology, result, normalized, collapse.from, collapse.to) ||
+				(twin != NO_VERTEX && IsFlipping(topology, result, normalized, twin, twinTo)))
+			{
+				continue;
+			}
+
+			remap[collapse.from] = collapse.to;
+			triangleCount -= CountSharedTriangles(topology, result, collapse.from, collapse.to);
+			lockAround(collapse.from);
+			if (twin != NO_VERTEX)
+			{
+				remap[twin] = twinTo;
+				triangleCount -= CountSharedTriangles(topology, result, twin, twinTo);
+				lockAround(twin);
+			}
+
+			quadrics[canonical[collapse.to]] += quadrics[canonical[collapse.from]];
+			errorQuadrics[canonical[collapse.to]] += errorQuadrics[canonical[collapse.from]];
+			worstSquaredError = std::max(worstSquaredError, collapse.error);
+			++collapseCount;
+		}
+
+		if (collapseCount == 0)
+		{
+			break;
+		}
+
+		// Triangles having two corners at the same place went away with the collapsed edge
+		size_t write = 0;
+		for (size_t i = 0; i < result.size(); i += 3)
+		{
+			const uint32_t a = remap[result[i]];
+			const uint32_t b = remap[result[i + 1]];
+			const uint32_t c = remap[result[i + 2]];
+			if (canonical[a] != canonical[b] && canonical[b] != canonical[c] && canonical[c] != canonical[a])
+			{
+				result[write++] = a;
+				result[write++] = b;
+				result[write++] = c;
+			}
+		}
+		result.resize(write);
+	}
+
+	if (resultError != nullptr)
+	{
+		*resultError = static_cast<float>(std::sqrt(worstSquaredError));
+	}
+	return result;
+}
+
+void MeshSimplifier::GenerateLods(MeshDescV2 &mesh, const MeshLodOptions &options)
+{
+	RemoveLods(mesh);
+	for (PrimitiveDescV2 &primitive : mesh.primitives)
+	{
+		if (uint64_t{primitive.indexOffset} + primitive.indexCount > mesh.indices.size() ||
+			uint64_t{primitive.vertexOffset} + primitive.vertexCount > mesh.positions.size())
+		{
+			throw std::out_of_range("Primitive out of the range of the mesh: " + mesh.name);
+		}
+
+		const std::span<const glm::vec3> positions(
+			mesh.positions.data() + primitive.vertexOffset, primitive.vertexCount);
+		std::vector<uint32_t> indices(mesh.indices.begin() + primitive.indexOffset,
+			mesh.indices.begin() + primitive.indexOffset + primitive.indexCount);
+
+		// Each level is simplified from the previous one, their errors add up
+		float error = 0.0f;
+		for (const float ratio : options.ratios)
+		{
+			const auto targetIndexCount = static_cast<size_t>(primitive.indexCount * ratio) / 3 * 3;
+			float levelError = 0.0f;
+			std::vector<uint32_t> lod =
+				Simplify(indices, positions, targetIndexCount, options.maxError - error, &levelError);
+			const float reduction = static_cast<float>(lod.size()) / static_cast<float>(indices.size());
+			if (lod.empty() || reduction > options.minReduction)
+			{
+				break;
+			}
+
+			error += levelError;
+			primitive.lods.push_back({
+				.indexOffset = static_cast<uint32_t>(mesh.indices.size()),
+				.indexCount = static_cast<uint32_t>(lod.size()),
+				.error = error,
+			});
+			mesh.indices.insert(mesh.indices.end(), lod.begin(), lod.end());
+			indices = std::move(lod);
+		}
+	}
+}
+
+void MeshSimplifier::GenerateLods(const std::span<MeshDescV2> meshes,
+	const MeshLodOptions &options,
+	Utils::ThreadPool &pool)
+{
+	std::vector<std::future<void>> tasks;
+	tasks.reserve(meshes.size());
+	for (MeshDescV2 &mesh : meshes)
+	{
+		tasks.push_back(pool.Submit([&mesh, &options]() { GenerateLods(mesh, options); }));
+	}
+
+	// Every task has to finish before returning, they refer to the meshes
+	std::exception_ptr error;
+	for (std::future<void> &task : tasks)
+	{
+		try
+		{
+			task.get();
+		}
+		catch (...)
+		{
+			if (!error)
+			{
+				error = std::current_exception();
+			}
+		}
+	}
+	if (error)
+	{
+		std::rethrow_exception(error);
+	}
+}
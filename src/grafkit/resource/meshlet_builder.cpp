@@ -0,0 +1,267 @@
+#include "stdafx.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+#include <grafkit/resource/meshlet_builder.h>
+
+using namespace Grafkit;
+using namespace Grafkit::Resource;
+
+namespace
+{
+	constexpr uint32_t INVALID_INDEX = std::numeric_limits<uint32_t>::max();
+
+	// Triangles around each vertex, in compressed row form
+	struct Adjacency
+	{
+		std::vector<uint32_t> offsets;
+		std::vector<uint32_t> triangles;
+
+		Adjacency(const std::span<const uint32_t> indices, const size_t vertexCount)
+			: offsets(vertexCount + 1, 0)
+			, triangles(indices.size())
+		{
+			for (const uint32_t index : indices)
+			{
+				++offsets[index + 1];
+			}
+			std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+			std::vector<uint32_t> cursors(offsets.begin(), offsets.end() - 1);
+			for (size_t i = 0; i < indices.size(); ++i)
+			{
+				triangles[cursors[indices[i]]++] = static_cast<uint32_t>(i / 3);
+			}
+		}
+
+		[[nodiscard]] std::span<const uint32_t> GetTriangles(const uint32_t vertex) const
+		{
+			return {triangles.data() + offsets[vertex], triangles.data() + offsets[vertex + 1]};
+		}
+	};
+
+	// Ritter's bounding sphere, within a few percent of the smallest one
+	void CalculateSphere(const std::span<const glm::vec3> points, glm::vec3 &center, float &radius)
+	{
+		const auto farthest = [&points](const glm::vec3 &from)
+		{
+			return *std::max_element(points.begin(),
+				points.end(),
+				[&from](const glm::vec3 &a, const glm::vec3 &b)
+				{ return glm::dot(a - from, a - from) < glm::dot(b - from, b - from); });
+		};
+
+		const glm::vec3 a = farthest(points.front());
+		const glm::vec3 b = farthest(a);
+		center = (a + b) * 0.5f;
+		radius = glm::length(b - a) * 0.5f;
+
+		for (const glm::vec3 &point : points)
+		{
+			const float distance = glm::length(point - center);
+			if (distance > radius)
+			{
+				const float grownRadius = (radius + distance) * 0.5f;
+				center = center + (point - center) * ((grownRadius - radius) / distance);
+				radius = grownRadius;
+			}
+		}
+	}
+} // namespace
+
+MeshletData MeshletBuilder::Build(const std::span<const uint32_t> indices,
+	const std::span<const glm::vec3> positions,
+	const MeshletOptions &options)
+{
+	if (indices.size() % 3 != 0)
+	{
+		throw std::invalid_argument("Index count is not a multiple of three");
+	}
+	if (std::any_of(indices.begin(), indices.end(), [&positions](uint32_t index) { return index >= positions.size(); }))
+	{
+		throw std::invalid_argument("Index out of vertex range");
+	}
+	// Triangles store meshlet local indices in a byte
+	if (options.maxVertices < 3 || options.maxVertices > 256 || options.maxTriangles == 0)
+	{
+		throw std::invalid_argument("Meshlet limits are out of range");
+	}
+
+	const auto triangleCount = static_cast<uint32_t>(indices.size() / 3);
+	const Adjacency adjacency(indices, positions.size());
+
+	MeshletData data{};
+	std::vector<bool> isUsed(triangleCount, false);
+	std::vector<uint32_t> localIndices(positions.size(), INVALID_INDEX);
+	// Unused triangles around each vertex
+	std::vector<uint32_t> liveTriangles(positions.size());
+	for (size_t vertex = 0; vertex < positions.size(); ++vertex)
+	{
+		liveTriangles[vertex] = static_cast<uint32_t>(adjacency.GetTriangles(static_cast<uint32_t>(vertex)).size());
+	}
+
+	Meshlet current{};
+	const auto countNewVertices = [&](const uint32_t triangle)
+	{
+		uint32_t count = 0;
+		for (uint32_t corner = 0; corner < 3; ++corner)
+		{
+			count += localIndices[indices[triangle * 3 + corner]] == INVALID_INDEX ? 1 : 0;
+		}
+		return count;
+	};
+
+	// Triangles finishing off vertices first, so those do not have to be repeated in a later meshlet
+	const auto countLiveTriangles = [&](const uint32_t triangle)
+	{
+		return liveTriangles[indices[triangle * 3]] + liveTriangles[indices[triangle * 3 + 1]] +
+			   liveTriangles[indices[triangle * 3 + 2]];
+	};
+
+	const auto finish = [&]()
+	{
+		if (current.triangleCount == 0)
+		{
+			return;
+		}
+		for (uint32_t i = 0; i < current.vertexCount; ++i)
+		{
+			localIndices[data.vertices[current.vertexOffset + i]] = INVALID_INDEX;
+		}
+		CalculateBounds(current, data, positions);
+		data.meshlets.push_back(current);
+		current = {
+			.vertexOffset = static_cast<uint32_t>(data.vertices.size()),
+			.triangleOffset = static_cast<uint32_t>(data.triangles.size() / 3),
+		};
+	};
+
+	uint32_t cursor = 0;
+	for (uint32_t remaining = triangleCount; remaining > 0; --remaining)
+	{
+		// Unused triangle around the meshlet adding the fewest vertices, then the one having the fewest live triangles
+		uint32_t best = INVALID_INDEX;
+		uint32_t bestNewVertices = 4;
+		uint32_t bestLiveTriangles = 0;
+		for (uint32_t i = 0; i < current.vertexCount; ++i)
+		{
+			for (const uint32_t triangle : adjacency.GetTriangles(data.vertices[current.vertexOffset + i]))
+			{
+				if (isUsed[triangle])
+				{
+					continue;
+				}
+				const uint32_t newVertices = countNewVertices(triangle);
+				const uint32_t live = countLiveTriangles(triangle);
+				if (newVertices < bestNewVertices || (newVertices == bestNewVertices && live < bestLiveTriangles))
+				{
+					best = triangle;
+					bestNewVertices = newVertices;
+					bestLiveTriangles = live;
+				}
+			}
+		}
+
+		if (best == INVALID_INDEX)
+		{
+			while (isUsed[cursor])
+			{
+				++cursor;
+			}
+			best = cursor;
+			bestNewVertices = countNewVertices(best);
+		}
+
+		if (current.vertexCount + bestNewVertices > options.maxVertices ||
+			current.triangleCount + 1 > options.maxTriangles)
+		{
+			finish();
+		}
+
+		for (uint32_t corner = 0; corner < 3; ++corner)
+		{
+			const uint32_t vertex = indices[best * 3 + corner];
+			if (localIndices[vertex] == INVALID_INDEX)
+			{
+				localIndices[vertex] = current.vertexCount++;
+				data.vertices.push_back(vertex);
+			}
+			--liveTriangles[vertex];
+			data.triangles.push_back(static_cast<uint8_t>(localIndices[vertex]));
+		}
+		++current.triangleCount;
+		isUsed[best] = true;
+	}
+	finish();
+
+	return data;
+}
+
+std::vector<uint32_t> MeshletBuilder::BuildIndices(const MeshletData &data)
+{
+	std::vector<uint32_t> indices;
+	indices.reserve(data.triangles.size());
+	for (const Meshlet &meshlet : data.meshlets)
+	{
+		for (uint32_t i = 0; i < meshlet.triangleCount * 3; ++i)
+		{
+			indices.push_back(data.vertices[meshlet.vertexOffset + data.triangles[meshlet.triangleOffset * 3 + i]]);
+		}
+	}
+	return indices;
+}
+
+void MeshletBuilder::CalculateBounds(Meshlet &meshlet,
+	const MeshletData &data,
+	const std::span<const glm::vec3> positions)
+{
+	std::vector<glm::vec3> points(meshlet.vertexCount);
+	for (uint32_t i = 0; i < meshlet.vertexCount; ++i)
+	{
+		points[i] = positions[data.vertices[meshlet.vertexOffset + i]];
+	}
+	if (points.empty())
+	{
+		return;
+	}
+	CalculateSphere(points, meshlet.center, meshlet.radius);
+
+	// Counter-clockwise triangles face front, as in glTF
+	std::vector<glm::vec3> normals;
+	normals.reserve(meshlet.triangleCount);
+	glm::vec3 normalSum(0.0f);
+	for (uint32_t i = 0; i < meshlet.triangleCount; ++i)
+	{
+		const uint8_t *triangle = data.triangles.data() + (meshlet.triangleOffset + i) * 3;
+		const glm::vec3 &a = points[triangle[0]];
+		const glm::vec3 normal = glm::cross(points[triangle[1]] - a, points[triangle[2]] - a);
+		const float length = glm::length(normal);
+		if (length > 0.0f)
+		{
+			normals.push_back(normal / length);
+			normalSum += normals.back();
+		}
+	}
+
+	meshlet.coneCutoff = 1.0f;
+	const float sumLength = glm::length(normalSum);
+	if (normals.empty() || sumLength < 1e-6f)
+	{
+		return;
+	}
+
+	meshlet.coneAxis = normalSum / sumLength;
+	float minDot = 1.0f;
+	for (const glm::vec3 &normal : normals)
+	{
+		minDot = std::min(minDot, glm::dot(normal, meshlet.coneAxis));
+	}
+
+	// The cone has to be narrower than a half space to be culled from anywhere
+	if (minDot > 0.0f)
+	{
+		meshlet.coneCutoff = std::sqrt(std::max(0.0f, 1.0f - minDot * minDot));
+	}
+}
@@ -4,9 +4,17 @@
 #include <string>
 
 #include <grafkit/interface/resource.h>
+#include <grafkit/utils/thread_pool.h>
 
 using namespace Grafkit::Resource;
 
+namespace {
+	bool IsOverBudget(const ResourceUsage &usage, const MemoryBudget &budget)
+	{
+		return usage.cpuBytes > budget.cpuBytes || usage.gpuBytes > budget.gpuBytes;
+	}
+} // namespace
+
 ResourceLoaderRegistry::LoaderFunc ResourceLoaderRegistry::GetLoader(std::type_index type) const
 {
 	auto it = m_loaders.find(type);
@@ -15,3 +23,369 @@ ResourceLoaderRegistry::LoaderFunc ResourceLoaderRegistry::GetLoader(std::type_i
 	}
 	return nullptr;
 }
+
+ResourceLoaderRegistry::BuilderFunc ResourceLoaderRegistry::GetBuilder(std::type_index type) const
+{
+	auto it = m_builders.find(type);
+	if (it != m_builders.end()) {
+		return it->second;
+	}
+	return nullptr;
+}
+
+// MARK: Resource manager
+
+ResourceManager::ResourceManager(const Asset::IAssetLoaderRef loader, const size_t workerCount)
+	: m_loader(loader)
+	, m_workers(std::make_unique<Utils::ThreadPool>(workerCount))
+{
+}
+
+ResourceManager::~ResourceManager()
+{
+	// Let the workers finish before the queues go away
+	m_workers.reset();
+}
+
+void ResourceManager::EnqueueLoad(std::type_index type, const std::string &name, CompletionFunc completion)
+{
+	auto job = std::make_shared<LoadJob>(
+		LoadJob {type, name, std::move(completion), nullptr, nullptr, nullptr, {}, nullptr});
+	++m_pendingCount;
+
+	// Already loaded, still complete it from Update() so callbacks always fire on the same place
+	if (const auto entry = m_resources.Find({type, name}); entry != nullptr) {
+		entry->lastUsed.store(++m_useCounter, std::memory_order_relaxed);
+		job->resource = entry->resource;
+		m_waiting.push_back(std::move(job));
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_evictedMutex);
+		if (const auto evicted = m_evicted.find(type); evicted != m_evicted.end()) {
+			evicted->second.erase(name);
+		}
+	}
+
+	Prepare(job);
+}
+
+void ResourceManager::Prepare(const LoadJobPtr &job)
+{
+	m_workers->Enqueue([this, job]() {
+		try {
+			const ResourceLoaderRegistry::BuilderFunc builderFunc =
+				ResourceLoaderRegistry::Instance().GetBuilder(job->type);
+			if (!builderFunc) {
+				throw std::runtime_error("No builder registered for resource: " + job->name);
+			}
+			job->builder = builderFunc(*m_loader, job->name, m_cookCache.get());
+			job->dependencies = job->builder->GetDependencies();
+		} catch (...) {
+			job->error = std::current_exception();
+		}
+
+		std::lock_guard<std::mutex> lock(m_preparedMutex);
+		m_prepared.push_back(job);
+	});
+}
+
+void ResourceManager::Update(const Core::DeviceRef &device)
+{
+	// Frames that could have used the replaced resources are done by now
+	++m_frameIndex;
+	while (!m_retired.empty() && m_retired.front().first + m_framesInFlight <= m_frameIndex) {
+		m_retired.pop_front();
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_preparedMutex);
+		for (auto &job : m_prepared) {
+			if (job->batch != nullptr) {
+				++job->batch->preparedCount;
+			} else {
+				m_waiting.push_back(std::move(job));
+			}
+		}
+		m_prepared.clear();
+	}
+
+	// Building a resource may resolve the dependencies of another one, repeat until nothing changes
+	bool progress = true;
+	while (progress && !m_waiting.empty()) {
+		progress = false;
+
+		std::deque<LoadJobPtr> waiting;
+		waiting.swap(m_waiting);
+
+		for (auto &job : waiting) {
+			if (!job->error && !job->resource) {
+				try {
+					if (!job->builder->ResolveDependencies(MakeReference(*this))) {
+						m_waiting.push_back(std::move(job));
+						continue;
+					}
+					job->builder->Build(device);
+					job->resource = job->builder->GetResource();
+					Store(job->type, job->name, job->resource, job->builder->GetUsage(), true, job->dependencies);
+				} catch (...) {
+					job->error = std::current_exception();
+				}
+			}
+
+			CompleteLoad(job);
+			progress = true;
+		}
+	}
+
+	// Nothing is in flight that could provide the missing dependencies
+	if (!m_waiting.empty() && m_pendingCount.load() == m_waiting.size()) {
+		std::deque<LoadJobPtr> waiting;
+		waiting.swap(m_waiting);
+		for (auto &job : waiting) {
+			job->error = std::make_exception_ptr(
+				std::runtime_error("Unresolved dependencies for resource: " + job->name));
+			CompleteLoad(job);
+		}
+	}
+
+	// Reloads are applied in order, each one once all of its builders are ready
+	while (!m_reloads.empty() && m_reloads.front()->preparedCount == m_reloads.front()->jobs.size()) {
+		ApplyReload(*m_reloads.front(), device);
+		m_reloads.pop_front();
+	}
+
+	EnforceBudgets();
+}
+
+void ResourceManager::CompleteLoad(const LoadJobPtr &job)
+{
+	--m_pendingCount;
+	job->builder.reset();
+	job->completion(job->error ? nullptr : job->resource, job->error);
+}
+
+std::shared_ptr<void> ResourceManager::Get(const std::type_index type, const std::string &name)
+{
+	if (m_stagingThread.load(std::memory_order_relaxed) == std::this_thread::get_id()) {
+		if (const auto staged = m_staging.find(type); staged != m_staging.end()) {
+			if (const auto it = staged->second.find(name); it != staged->second.end()) {
+				return it->second;
+			}
+		}
+	}
+
+	if (const auto entry = m_resources.Find({type, name}); entry != nullptr) {
+		entry->lastUsed.store(++m_useCounter, std::memory_order_relaxed);
+		return entry->resource;
+	}
+
+	// Builders waiting for it in Update() pick it up once it is back
+	{
+		std::lock_guard<std::mutex> lock(m_evictedMutex);
+		const auto evicted = m_evicted.find(type);
+		if (evicted == m_evicted.end() || evicted->second.erase(name) == 0) {
+			return nullptr;
+		}
+	}
+
+	// Not through EnqueueLoad, it may be called from any thread while the waiting queue belongs to Update()
+	auto job = std::make_shared<LoadJob>(LoadJob {
+		type, name, [](const std::shared_ptr<void> &, std::exception_ptr) {}, nullptr, nullptr, nullptr, {}, nullptr});
+	++m_pendingCount;
+	Prepare(job);
+	return nullptr;
+}
+
+// MARK: Memory budgets
+
+void ResourceManager::EnforceBudgets()
+{
+	for (const auto &[type, budget] : m_typeBudgets) {
+		if (IsOverBudget(m_typeUsages[type], budget)) {
+			Evict(type, budget);
+		}
+	}
+
+	if (IsOverBudget(m_usage, m_budget)) {
+		Evict(std::nullopt, m_budget);
+	}
+}
+
+void ResourceManager::Store(const std::type_index type,
+	const std::string &name,
+	std::shared_ptr<void> resource,
+	const ResourceUsage &usage,
+	const bool isReloadable,
+	std::vector<ResourceId> dependencies)
+{
+	auto entry = std::make_shared<ResourceEntry>();
+	entry->resource = std::move(resource);
+	entry->usage = usage;
+	entry->lastUsed = ++m_useCounter;
+	entry->isReloadable = isReloadable;
+	entry->dependencies = std::move(dependencies);
+
+	const auto previous = m_resources.InsertOrAssign({type, name}, std::move(entry));
+	const ResourceUsage previousUsage = previous ? previous->usage : ResourceUsage {};
+
+	ResourceUsage &typeUsage = m_typeUsages[type];
+	m_usage.cpuBytes += usage.cpuBytes - previousUsage.cpuBytes;
+	m_usage.gpuBytes += usage.gpuBytes - previousUsage.gpuBytes;
+	typeUsage.cpuBytes += usage.cpuBytes - previousUsage.cpuBytes;
+	typeUsage.gpuBytes += usage.gpuBytes - previousUsage.gpuBytes;
+}
+
+void ResourceManager::Evict(const std::optional<std::type_index> &type, const MemoryBudget &budget)
+{
+	struct Candidate {
+		uint64_t lastUsed;
+		std::type_index type;
+		std::string name;
+	};
+
+	// Referenced ones are in use, evicting them would not free anything
+	std::vector<Candidate> candidates;
+	m_resources.ForEach([&](const ResourceId &id, const std::shared_ptr<ResourceEntry> &entry) {
+		if ((!type.has_value() || id.type == *type) && entry->isReloadable && entry->resource.use_count() == 1) {
+			candidates.push_back({entry->lastUsed.load(std::memory_order_relaxed), id.type, id.name});
+		}
+	});
+
+	std::sort(candidates.begin(), candidates.end(), [](const Candidate &a, const Candidate &b) {
+		return a.lastUsed < b.lastUsed;
+	});
+
+	const ResourceUsage &usage = type.has_value() ? m_typeUsages[*type] : m_usage;
+	for (const auto &candidate : candidates) {
+		if (!IsOverBudget(usage, budget)) {
+			break;
+		}
+
+		const auto entry = m_resources.Erase({candidate.type, candidate.name});
+		ResourceUsage &typeUsage = m_typeUsages[candidate.type];
+		m_usage.cpuBytes -= entry->usage.cpuBytes;
+		m_usage.gpuBytes -= entry->usage.gpuBytes;
+		typeUsage.cpuBytes -= entry->usage.cpuBytes;
+		typeUsage.gpuBytes -= entry->usage.gpuBytes;
+
+		{
+			std::lock_guard<std::mutex> lock(m_evictedMutex);
+			m_evicted[candidate.type].insert(candidate.name);
+		}
+		Grafkit::Core::Log::Instance().Trace("Evicted resource: %s", candidate.name.c_str());
+	}
+}
+
+// MARK: Hot reload
+
+void ResourceManager::Reload(const std::string &name)
+{
+	// Resources loaded from the asset, then everything depending on them, each one once
+	std::vector<ResourceId> affected;
+	std::vector<std::pair<ResourceId, std::shared_ptr<ResourceEntry>>> reloadable;
+	m_resources.ForEach([&](const ResourceId &id, const std::shared_ptr<ResourceEntry> &entry) {
+		if (entry->isReloadable) {
+			reloadable.emplace_back(id, entry);
+			if (id.name == name) {
+				affected.push_back(id);
+			}
+		}
+	});
+
+	for (size_t i = 0; i < affected.size(); ++i) {
+		for (const auto &[id, entry] : reloadable) {
+			if (std::find(entry->dependencies.begin(), entry->dependencies.end(), affected[i]) !=
+					entry->dependencies.end() &&
+				std::find(affected.begin(), affected.end(), id) == affected.end()) {
+				affected.push_back(id);
+			}
+		}
+	}
+
+	if (affected.empty()) {
+		return;
+	}
+
+	auto batch = std::make_unique<ReloadBatch>();
+	for (const auto &id : affected) {
+		auto job =
+			std::make_shared<LoadJob>(LoadJob {id.type, id.name, {}, nullptr, nullptr, nullptr, {}, batch.get()});
+		batch->jobs.push_back(job);
+		++m_pendingCount;
+		Prepare(job);
+	}
+	m_reloads.push_back(std::move(batch));
+}
+
+void ResourceManager::ApplyReload(ReloadBatch &batch, const Core::DeviceRef &device)
+{
+	m_pendingCount -= batch.jobs.size();
+
+	std::vector<LoadJobPtr> remaining = batch.jobs;
+	m_stagingThread.store(std::this_thread::get_id(), std::memory_order_relaxed);
+	try {
+		for (const auto &job : batch.jobs) {
+			if (job->error) {
+				std::rethrow_exception(job->error);
+			}
+		}
+
+		// A job is built once nothing it depends on is left to rebuild
+		bool progress = true;
+		while (progress && !remaining.empty()) {
+			progress = false;
+			for (auto it = remaining.begin(); it != remaining.end();) {
+				const LoadJobPtr job = *it;
+				const bool isReady = std::none_of(remaining.begin(), remaining.end(), [&job](const LoadJobPtr &other) {
+					const ResourceId id {other->type, other->name};
+					return std::find(job->dependencies.begin(), job->dependencies.end(), id) != job->dependencies.end();
+				});
+				if (!isReady) {
+					++it;
+					continue;
+				}
+
+				if (!job->builder->ResolveDependencies(MakeReference(*this))) {
+					throw std::runtime_error("Unresolved dependencies for resource: " + job->name);
+				}
+				job->builder->Build(device);
+				job->resource = job->builder->GetResource();
+				m_staging[job->type][job->name] = job->resource;
+
+				it = remaining.erase(it);
+				progress = true;
+			}
+		}
+
+		if (!remaining.empty()) {
+			throw std::runtime_error("Dependency cycle while reloading resource: " + remaining.front()->name);
+		}
+	} catch (const std::exception &e) {
+		m_stagingThread.store({}, std::memory_order_relaxed);
+		m_staging.clear();
+		Grafkit::Core::Log::Instance().Error("Failed to reload %s: %s", batch.jobs.front()->name.c_str(), e.what());
+		return;
+	} catch (...) {
+		m_stagingThread.store({}, std::memory_order_relaxed);
+		m_staging.clear();
+		Grafkit::Core::Log::Instance().Error("Failed to reload %s: unknown error", batch.jobs.front()->name.c_str());
+		return;
+	}
+	m_stagingThread.store({}, std::memory_order_relaxed);
+	m_staging.clear();
+
+	for (const auto &job : batch.jobs) {
+		if (const auto entry = m_resources.Find({job->type, job->name}); entry != nullptr) {
+			m_retired.emplace_back(m_frameIndex, entry->resource);
+		}
+		Store(job->type, job->name, job->resource, job->builder->GetUsage(), true, job->dependencies);
+	}
+
+	for (const auto &job : batch.jobs) {
+		for (const auto &callback : m_reloadCallbacks) {
+			callback({job->type, job->name}, job->resource);
+		}
+	}
+}
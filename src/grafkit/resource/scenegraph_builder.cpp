@@ -1,37 +1,57 @@
 #include "stdafx.h"
 #include <grafkit/render/material.h>
 #include <grafkit/render/mesh.h>
+#include <grafkit/render/vertex_packing.h>
 #include <grafkit/resource/scenegraph_builder.h>
 
 using namespace Grafkit;
 using namespace Grafkit::Resource;
 
-MeshBuilder &MeshBuilder::AddPrimitive(const std::vector<Vertex> &vertices,
-	const std::vector<uint32_t> &indices,
+static_assert(std::is_trivially_copyable_v<Vertex> && std::is_trivially_copyable_v<Primitive> &&
+				  std::is_trivially_copyable_v<Meshlet>,
+	"Merged mesh buffers are cooked as raw bytes");
+
+namespace
+{
+	constexpr uint64_t AlignUp(const uint64_t value, const uint64_t alignment)
+	{
+		return (value + alignment - 1) & ~(alignment - 1);
+	}
+
+	// Largest vertex count a primitive can address with 16 bit indices
+	constexpr size_t MAX_UINT16_VERTEX_COUNT = size_t{std::numeric_limits<uint16_t>::max()} + 1;
+
+	template <typename IndexT>
+	void WriteIndices(const std::vector<uint32_t> &indices, const std::span<uint8_t> destination)
+	{
+		for (size_t i = 0; i < indices.size(); ++i)
+		{
+			const auto index = static_cast<IndexT>(indices[i]);
+			std::memcpy(destination.data() + i * sizeof(IndexT), &index, sizeof(IndexT));
+		}
+	}
+} // namespace
+
+MeshBuilder &MeshBuilder::AddPrimitive(std::vector<Vertex> &&vertices,
+	std::vector<uint32_t> &&indices,
 	const uint32_t materialIndex)
 {
-	m_descriptor.primitives.push_back({
-		.vertices = vertices,
-		.indices = indices,
+	return AddPrimitive({
+		.vertices = std::move(vertices),
+		.indices = std::move(indices),
 		.materialIndex = materialIndex,
 	});
-	return *this;
 }
 
-MeshBuilder &MeshBuilder::AddPrimitive(const std::vector<Vertex> &vertices,
-	const std::vector<uint32_t> &indices,
+MeshBuilder &MeshBuilder::AddPrimitive(std::vector<Vertex> &&vertices,
+	std::vector<uint32_t> &&indices,
 	const MaterialPtr &material)
 {
 	// TOOD: Check if material already exists
 	const auto materialIndex =
 		m_materials.empty() ? 0 : std::max_element(m_materials.begin(), m_materials.end())->first + 1;
 	m_materials.emplace(materialIndex, material);
-	m_descriptor.primitives.push_back({
-		.vertices = vertices,
-		.indices = indices,
-		.materialIndex = materialIndex,
-	});
-	return *this;
+	return AddPrimitive(std::move(vertices), std::move(indices), materialIndex);
 }
 
 MeshBuilder &MeshBuilder::AddMaterial(const uint32_t index, const MaterialPtr &material)
@@ -44,7 +64,7 @@ MeshBuilder &MeshBuilder::AddMaterial(const uint32_t index, const MaterialPtr &m
 bool MeshBuilder::ResolveDependencies(const RefWrapper<ResourceManager> &resources)
 {
 	bool result = true;
-	if (m_materials.empty() && m_descriptor.materials.empty())
+	if (m_materials.empty() && !m_descriptor.materials.empty())
 	{
 		for (const auto &[index, materialName] : m_descriptor.materials)
 		{
@@ -62,37 +82,294 @@ bool MeshBuilder::ResolveDependencies(const RefWrapper<ResourceManager> &resourc
 	return result;
 }
 
-void MeshBuilder::Build(const Core::DeviceRef &device)
+std::vector<ResourceId> MeshBuilder::GetDependencies() const
+{
+	std::vector<ResourceId> dependencies;
+	if (m_materials.empty())
+	{
+		for (const auto &[index, materialName] : m_descriptor.materials)
+		{
+			dependencies.push_back({typeid(Material), materialName});
+		}
+	}
+	return dependencies;
+}
+
+void MeshBuilder::Prepare()
 {
-	std::vector<Grafkit::Primitive> primitives;
-	std::vector<Grafkit::Vertex> vertices;
-	std::vector<uint32_t> indices;
+	m_primitives.clear();
+	m_meshlets.clear();
+	m_reordered.clear();
+	m_optimizeStats = {};
+
+	// Reordering needs copies of the primitives, the descriptor is left as it is for preparing again
+	const bool isReordered = m_optimizeOptions.has_value() || m_meshletOptions.has_value();
+	if (isReordered)
+	{
+		m_reordered.reserve(m_descriptor.primitives.size());
+	}
+	m_primitives.reserve(m_descriptor.primitives.size());
 
+	size_t vertexCount = 0;
+	size_t indexDataSize = 0;
 	for (const auto &primitiveDesc : m_descriptor.primitives)
 	{
-		const auto materialIt = m_materials.find(primitiveDesc.materialIndex);
+		const std::vector<uint32_t> *indices = &primitiveDesc.indices;
+		const auto firstMeshlet = static_cast<uint32_t>(m_meshlets.size());
+		if (isReordered)
+		{
+			MeshBuilderPrimitiveDesc &reordered = m_reordered.emplace_back(primitiveDesc);
+			if (m_optimizeOptions.has_value())
+			{
+				m_optimizeStats.Add(MeshOptimizer::Optimize(reordered.vertices, reordered.indices, *m_optimizeOptions));
+			}
+			if (m_meshletOptions.has_value())
+			{
+				const MeshletData meshlets
+					= MeshletBuilder::Build(reordered.vertices, reordered.indices, *m_meshletOptions);
+				reordered.indices = MeshletBuilder::BuildIndices(meshlets);
+				m_meshlets.insert(m_meshlets.end(), meshlets.meshlets.begin(), meshlets.meshlets.end());
+			}
+			indices = &reordered.indices;
+		}
+
+		// Indices stay local to the primitive, the draw adds the vertex offset
+		const size_t primitiveVertexCount = primitiveDesc.vertices.size();
+		const bool isShort = primitiveVertexCount <= MAX_UINT16_VERTEX_COUNT;
+		const size_t indexSize = isShort ? sizeof(uint16_t) : sizeof(uint32_t);
+		indexDataSize = AlignUp(indexDataSize, indexSize);
+
+		m_primitives.push_back({.id = static_cast<uint32_t>(m_primitives.size()),
+			.firstIndex = static_cast<uint32_t>(indexDataSize / indexSize),
+			.indexCount = static_cast<uint32_t>(indices->size()),
+			.vertexOffset = static_cast<uint32_t>(vertexCount),
+			.vertexCount = static_cast<uint32_t>(primitiveVertexCount),
+			.materialId = primitiveDesc.materialIndex,
+			.indexType = isShort ? VK_INDEX_TYPE_UINT16 : VK_INDEX_TYPE_UINT32,
+			.firstMeshlet = firstMeshlet,
+			.meshletCount = static_cast<uint32_t>(m_meshlets.size()) - firstMeshlet});
+
+		vertexCount += primitiveVertexCount;
+		indexDataSize += indices->size() * indexSize;
+	}
+	m_vertexCount = vertexCount;
+	m_indexDataSize = indexDataSize;
+
+	if (m_optimizeOptions.has_value())
+	{
+		Grafkit::Core::Log::Instance().Trace("Mesh optimized, %zu triangles, ACMR %.3f -> %.3f",
+			m_optimizeStats.triangleCount,
+			m_optimizeStats.acmrBefore,
+			m_optimizeStats.acmrAfter);
+	}
+	m_isPrepared = true;
+}
+
+void MeshBuilder::WritePrimitives(const std::span<uint8_t> vertexData,
+	const std::span<uint8_t> indexData,
+	const VertexFormat vertexFormat,
+	const PositionBounds &bounds) const
+{
+	const uint32_t stride = GetVertexStride(vertexFormat);
+	size_t indexEnd = 0;
+	for (size_t i = 0; i < m_primitives.size(); ++i)
+	{
+		const Primitive &primitive = m_primitives[i];
+		const MeshBuilderPrimitiveDesc &source = m_reordered.empty() ? m_descriptor.primitives[i] : m_reordered[i];
+
+		PackVertices(source.vertices,
+			vertexFormat,
+			bounds,
+			vertexData.subspan(size_t{primitive.vertexOffset} * stride, source.vertices.size() * stride));
+
+		// Alignment padding is zeroed, so the same mesh always gives the same bytes
+		const size_t indexSize = GetIndexSize(primitive.indexType);
+		const size_t indexOffset = size_t{primitive.firstIndex} * indexSize;
+		std::fill(indexData.begin() + static_cast<ptrdiff_t>(indexEnd),
+			indexData.begin() + static_cast<ptrdiff_t>(indexOffset),
+			uint8_t{0});
+		if (primitive.indexType == VK_INDEX_TYPE_UINT16)
+		{
+			WriteIndices<uint16_t>(source.indices, indexData.subspan(indexOffset));
+		}
+		else
+		{
+			WriteIndices<uint32_t>(source.indices, indexData.subspan(indexOffset));
+		}
+		indexEnd = indexOffset + source.indices.size() * indexSize;
+	}
+}
+
+void MeshBuilder::Merge()
+{
+	if (!m_isPrepared)
+	{
+		Prepare();
+	}
+
+	// Cooked vertices keep full precision, they are packed when built
+	m_vertices.resize(m_vertexCount);
+	m_indexData.resize(m_indexDataSize);
+	WritePrimitives({reinterpret_cast<uint8_t *>(m_vertices.data()), m_vertices.size() * sizeof(Vertex)},
+		m_indexData,
+		VertexFormat::Float,
+		{});
+	m_isMerged = true;
+}
+
+void MeshBuilder::Build(const Core::DeviceRef &device)
+{
+	if (!m_isPrepared && !m_isMerged)
+	{
+		Prepare();
+	}
 
-		if (materialIt == m_materials.end())
+	for (const auto &primitive : m_primitives)
+	{
+		if (m_materials.find(primitive.materialId) == m_materials.end())
 		{
 			throw std::runtime_error("Error: Material is null");
 		}
+	}
+
+	// Merged or cooked buffers are packed from, otherwise the primitives are written straight into staging
+	const uint32_t stride = GetVertexStride(m_vertexFormat);
+	PositionBounds bounds{};
+	Mesh::DataWriter writer;
+	if (m_isMerged)
+	{
+		bounds = CalculateBounds(m_vertices);
+		writer = [this, &bounds](const std::span<uint8_t> vertexData, const std::span<uint8_t> indexData)
+		{
+			PackVertices(m_vertices, m_vertexFormat, bounds, vertexData);
+			std::memcpy(indexData.data(), m_indexData.data(), m_indexData.size());
+		};
+	}
+	else
+	{
+		std::vector<std::span<const Vertex>> ranges;
+		ranges.reserve(m_primitives.size());
+		for (size_t i = 0; i < m_primitives.size(); ++i)
+		{
+			ranges.emplace_back(m_reordered.empty() ? m_descriptor.primitives[i].vertices : m_reordered[i].vertices);
+		}
+		bounds = CalculateBounds(ranges);
+		writer = [this, &bounds](const std::span<uint8_t> vertexData, const std::span<uint8_t> indexData)
+		{ WritePrimitives(vertexData, indexData, m_vertexFormat, bounds); };
+	}
+
+	const size_t vertexCount = m_isMerged ? m_vertices.size() : m_vertexCount;
+	const size_t indexDataSize = m_isMerged ? m_indexData.size() : m_indexDataSize;
+	m_resource = Mesh::Create(device,
+		vertexCount * stride,
+		indexDataSize,
+		writer,
+		std::move(m_primitives),
+		std::move(m_materials),
+		m_vertexFormat,
+		GetPositionTransform(m_vertexFormat, bounds),
+		m_meshlets);
+
+	// Nothing of the layout is needed once it is on the GPU
+	m_reordered = {};
+	m_isPrepared = false;
+}
 
-		const auto materialId = materialIt->first;
-		const auto material = materialIt->second;
+ResourceUsage MeshBuilder::GetUsage() const
+{
+	ResourceUsage usage{};
+	usage.gpuBytes = m_vertexCount * GetVertexStride(m_vertexFormat) + m_indexDataSize;
+	if (m_resource != nullptr)
+	{
+		usage.cpuBytes = m_resource->GetPrimitives().size() * sizeof(Primitive) + m_meshlets.size() * sizeof(Meshlet);
+	}
+	return usage;
+}
 
-		primitives.push_back({.id = static_cast<uint32_t>(primitives.size()),
-			.firstIndex = static_cast<uint32_t>(indices.size()),
-			.indexCount = static_cast<uint32_t>(primitiveDesc.indices.size()),
-			.vertexOffset = static_cast<uint32_t>(vertices.size()),
-			.vertexCount = static_cast<uint32_t>(primitiveDesc.vertices.size()),
-			.materialId = materialId});
+std::vector<uint8_t> MeshBuilder::Cook()
+{
+	if (!m_isMerged)
+	{
+		Merge();
+	}
+
+	std::vector<CookedMaterialEntry> materials;
+	std::string names;
+	for (const auto &[index, name] : m_descriptor.materials)
+	{
+		materials.push_back({index, static_cast<uint32_t>(names.size()), static_cast<uint32_t>(name.size()), 0});
+		names += name;
+	}
+
+	CookedMeshHeader header{};
+	header.primitiveCount = static_cast<uint32_t>(m_primitives.size());
+	header.vertexCount = static_cast<uint32_t>(m_vertices.size());
+	header.indexSize = static_cast<uint32_t>(m_indexData.size());
+	header.materialCount = static_cast<uint32_t>(materials.size());
+	header.meshletCount = static_cast<uint32_t>(m_meshlets.size());
+	header.vertexOffset = AlignUp(sizeof(CookedMeshHeader) + m_primitives.size() * sizeof(Primitive), 16);
+	header.indexOffset = AlignUp(header.vertexOffset + m_vertices.size() * sizeof(Vertex), 16);
+	header.meshletOffset = AlignUp(header.indexOffset + m_indexData.size(), 16);
+	header.materialOffset = AlignUp(header.meshletOffset + m_meshlets.size() * sizeof(Meshlet), 16);
+	header.nameOffset = header.materialOffset + materials.size() * sizeof(CookedMaterialEntry);
 
-		vertices.insert(vertices.end(), primitiveDesc.vertices.begin(), primitiveDesc.vertices.end());
-		std::transform(primitiveDesc.indices.begin(),
-			primitiveDesc.indices.end(),
-			std::back_inserter(indices),
-			[offset = indices.size()](uint32_t index) { return index + offset; });
+	std::vector<uint8_t> data(header.nameOffset + names.size(), 0);
+	std::memcpy(data.data(), &header, sizeof(header));
+	std::memcpy(data.data() + sizeof(header), m_primitives.data(), m_primitives.size() * sizeof(Primitive));
+	std::memcpy(data.data() + header.vertexOffset, m_vertices.data(), m_vertices.size() * sizeof(Vertex));
+	std::memcpy(data.data() + header.indexOffset, m_indexData.data(), m_indexData.size());
+	std::memcpy(data.data() + header.meshletOffset, m_meshlets.data(), m_meshlets.size() * sizeof(Meshlet));
+	std::memcpy(
+		data.data() + header.materialOffset, materials.data(), materials.size() * sizeof(CookedMaterialEntry));
+	std::memcpy(data.data() + header.nameOffset, names.data(), names.size());
+	return data;
+}
+
+void MeshBuilder::LoadCooked(const std::span<const uint8_t> data)
+{
+	CookedMeshHeader header{};
+	if (data.size() < sizeof(header))
+	{
+		throw std::runtime_error("Cooked mesh is truncated");
+	}
+	std::memcpy(&header, data.data(), sizeof(header));
+
+	if (header.vertexOffset < sizeof(header) + uint64_t{header.primitiveCount} * sizeof(Primitive) ||
+		header.indexOffset < header.vertexOffset + uint64_t{header.vertexCount} * sizeof(Vertex) ||
+		header.meshletOffset < header.indexOffset + header.indexSize ||
+		header.materialOffset < header.meshletOffset + uint64_t{header.meshletCount} * sizeof(Meshlet) ||
+		header.nameOffset < header.materialOffset + uint64_t{header.materialCount} * sizeof(CookedMaterialEntry) ||
+		header.nameOffset > data.size())
+	{
+		throw std::runtime_error("Cooked mesh is corrupt");
+	}
+
+	m_primitives.resize(header.primitiveCount);
+	m_vertices.resize(header.vertexCount);
+	m_indexData.resize(header.indexSize);
+	m_vertexCount = m_vertices.size();
+	m_indexDataSize = m_indexData.size();
+	m_meshlets.resize(header.meshletCount);
+	std::memcpy(m_primitives.data(), data.data() + sizeof(header), m_primitives.size() * sizeof(Primitive));
+	std::memcpy(m_vertices.data(), data.data() + header.vertexOffset, m_vertices.size() * sizeof(Vertex));
+	std::memcpy(m_indexData.data(), data.data() + header.indexOffset, m_indexData.size());
+	std::memcpy(m_meshlets.data(), data.data() + header.meshletOffset, m_meshlets.size() * sizeof(Meshlet));
+
+	const std::string_view names(
+		reinterpret_cast<const char *>(data.data() + header.nameOffset), data.size() - header.nameOffset);
+	m_descriptor.materials.clear();
+	for (uint32_t i = 0; i < header.materialCount; ++i)
+	{
+		CookedMaterialEntry material{};
+		std::memcpy(&material, data.data() + header.materialOffset + i * sizeof(material), sizeof(material));
+		if (uint64_t{material.nameOffset} + material.nameLength > names.size())
+		{
+			throw std::runtime_error("Cooked mesh is corrupt");
+		}
+		m_descriptor.materials[material.index] = std::string(names.substr(material.nameOffset, material.nameLength));
 	}
 
-	m_resource = Mesh::Create(device, vertices, indices, std::move(primitives), std::move(m_materials));
+	// The merged buffers replace the primitives of the descriptor
+	m_descriptor.primitives.clear();
+	m_isMerged = true;
 }
@@ -0,0 +1,98 @@
+#include "stdafx.h"
+
+#include "grafkit/utils/thread_pool.h"
+
+using Grafkit::Utils::ThreadPool;
+
+ThreadPool::ThreadPool(size_t threadCount)
+{
+	if (threadCount == 0)
+	{
+		const size_t hardwareThreads = std::thread::hardware_concurrency();
+		threadCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+	}
+
+	m_threads.reserve(threadCount);
+	for (size_t i = 0; i < threadCount; ++i)
+	{
+		m_threads.emplace_back([this]() { WorkerLoop(); });
+	}
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stopping = true;
+	}
+	m_taskAvailable.notify_all();
+
+	for (auto &thread : m_threads)
+	{
+		thread.join();
+	}
+}
+
+void ThreadPool::Enqueue(std::function<void()> task)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (m_stopping)
+		{
+			throw std::runtime_error("Thread pool is shutting down");
+		}
+		m_tasks.push(std::move(task));
+	}
+	m_taskAvailable.notify_one();
+}
+
+void ThreadPool::WaitIdle()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_idle.wait(lock, [this]() { return m_tasks.empty() && m_activeTasks == 0; });
+}
+
+void ThreadPool::WorkerLoop()
+{
+	while (true)
+	{
+		std::function<void()> task;
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_taskAvailable.wait(lock, [this]() { return m_stopping || !m_tasks.empty(); });
+
+			// Drain the queue before stopping, so no submitted task is dropped
+			if (m_tasks.empty())
+			{
+				return;
+			}
+
+			task = std::move(m_tasks.front());
+			m_tasks.pop();
+			++m_activeTasks;
+		}
+
+		try
+		{
+			task();
+		}
+		catch (const std::exception &e)
+		{
+			Core::Log::Instance().Error("Unhandled exception in worker thread: %s", e.what());
+		}
+		catch (...)
+		{
+			// Anything escaping the task would end the worker, and every task still queued with it
+			Core::Log::Instance().Error("Unhandled unknown exception in worker thread");
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			--m_activeTasks;
+			if (m_tasks.empty() && m_activeTasks == 0)
+			{
+				m_idle.notify_all();
+			}
+		}
+	}
+}
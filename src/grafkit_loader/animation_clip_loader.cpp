@@ -0,0 +1,24 @@
+#include "stdafx.h"
+
+#include <fstream>
+
+#include <grafkit_loader/animation_clip_loader.h>
+
+using Grafkit::Asset::MappedAnimationClip;
+
+MappedAnimationClip::MappedAnimationClip(const std::filesystem::path& path)
+	: m_file(path)
+	, m_clip(m_file.GetData())
+{
+}
+
+void Grafkit::Asset::WriteAnimationClip(const std::filesystem::path& path, const Resource::AnimationClipDesc& desc)
+{
+	const std::vector<uint8_t> data = Resource::CookAnimationClip(desc);
+
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	if (!file.is_open()) {
+		throw std::runtime_error("Failed to open file for writing: " + path.string());
+	}
+	file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+}
@@ -1,6 +1,34 @@
 #include "stdafx.h"
 
+#include <algorithm>
+#include <future>
+#include <limits>
+#include <utility>
+
+#ifdef __clang__
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wold-style-cast"
+#pragma clang diagnostic ignored "-Wmicrosoft-enum-value"
+#pragma clang diagnostic ignored "-Wsign-conversion"
+#pragma clang diagnostic ignored "-Wimplicit-float-conversion"
+#pragma clang diagnostic ignored "-Wdeprecated-copy"
+#endif
+
+#include <assimp/Importer.hpp>
+#include <assimp/mesh.h>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+
+#ifdef __clang__
+#pragma clang diagnostic pop
+#endif
+
 #include <grafkit/core/log.h>
+#include <grafkit/render/material.h>
+#include <grafkit/render/mesh.h>
+#include <grafkit/render/scenegraph.h>
+#include <grafkit/resource/build_scheduler.h>
+#include <grafkit/utils/thread_pool.h>
 
 #include "assimp_util.h"
 #include "grafkit_loader/assimp_loader.h"
@@ -9,42 +37,278 @@ using namespace Grafkit::Asset;
 using namespace Grafkit::Asset::Assimp;
 using Grafkit::Core::Log;
 
-Grafkit::ScenegraphPtr AssimpLoader::Load([[maybe_unused]] const std::string& filename)
+namespace {
+	// Vulkan samples textures top row first, Assimp has it the other way around
+	constexpr unsigned int IMPORT_FLAGS = aiProcess_Triangulate | aiProcess_JoinIdenticalVertices
+		| aiProcess_SortByPType | aiProcess_GenSmoothNormals | aiProcess_CalcTangentSpace | aiProcess_FlipUVs
+		| aiProcess_ValidateDataStructure;
+
+	bool IsTriangle(const aiFace& face) { return face.mNumIndices == 3; }
+
+	glm::vec3 ToVec3(const aiVector3D& vector) { return { vector.x, vector.y, vector.z }; }
+
+	// Writes a mesh into the ranges of its primitive, the arena is sized already
+	void ConvertMesh(const aiMesh& mesh, const Grafkit::Resource::PrimitiveDescV2& primitive,
+		Grafkit::Resource::MeshDescV2& arena)
+	{
+		const size_t first = primitive.vertexOffset;
+		for (uint32_t i = 0; i < mesh.mNumVertices; ++i) {
+			arena.positions[first + i] = ToVec3(mesh.mVertices[i]);
+		}
+		if (mesh.HasNormals()) {
+			for (uint32_t i = 0; i < mesh.mNumVertices; ++i) {
+				arena.normals[first + i] = ToVec3(mesh.mNormals[i]);
+			}
+		}
+		if (mesh.HasTangentsAndBitangents()) {
+			for (uint32_t i = 0; i < mesh.mNumVertices; ++i) {
+				arena.tangents[first + i] = ToVec3(mesh.mTangents[i]);
+				arena.bitangents[first + i] = ToVec3(mesh.mBitangents[i]);
+			}
+		}
+		if (mesh.HasTextureCoords(0)) {
+			for (uint32_t i = 0; i < mesh.mNumVertices; ++i) {
+				arena.texCoords[first + i] = { mesh.mTextureCoords[0][i].x, mesh.mTextureCoords[0][i].y };
+			}
+		}
+
+		// Indices stay local to the primitive
+		uint32_t* indices = arena.indices.data() + primitive.indexOffset;
+		for (uint32_t i = 0; i < mesh.mNumFaces; ++i) {
+			const aiFace& face = mesh.mFaces[i];
+			if (IsTriangle(face)) {
+				*indices++ = face.mIndices[0];
+				*indices++ = face.mIndices[1];
+				*indices++ = face.mIndices[2];
+			}
+		}
+	}
+
+	Grafkit::Resource::NodeDesc ConvertNode(const aiNode& node, const Grafkit::Resource::MeshDescV2& meshes)
+	{
+		aiVector3D scaling;
+		aiQuaternion rotation;
+		aiVector3D position;
+		node.mTransformation.Decompose(scaling, rotation, position);
+
+		Grafkit::Resource::NodeDesc result {
+			.name = node.mName.C_Str(),
+			.translation = ToVec3(position),
+			.rotation = glm::quat(rotation.w, rotation.x, rotation.y, rotation.z),
+			.scale = ToVec3(scaling),
+			.meshIndices = {},
+			.children = {},
+		};
+
+		for (uint32_t i = 0; i < node.mNumMeshes; ++i) {
+			if (meshes.primitives.at(node.mMeshes[i]).indexCount > 0) {
+				result.meshIndices.push_back(node.mMeshes[i]);
+			}
+		}
+		result.children.reserve(node.mNumChildren);
+		for (uint32_t i = 0; i < node.mNumChildren; ++i) {
+			result.children.push_back(ConvertNode(*node.mChildren[i], meshes));
+		}
+		return result;
+	}
+
+	std::shared_ptr<Grafkit::Resource::MeshBuilder> CreateMeshBuilder(const Grafkit::Resource::MeshDescV2& meshes,
+		const std::vector<uint32_t>& primitiveIndices, const std::map<uint32_t, std::string>& materialNames)
+	{
+		Grafkit::Resource::MeshBuilderDesc desc {};
+		desc.primitives.reserve(primitiveIndices.size());
+		for (const uint32_t primitiveIndex : primitiveIndices) {
+			const Grafkit::Resource::PrimitiveDescV2& primitive = meshes.primitives[primitiveIndex];
+
+			Grafkit::Resource::MeshBuilderPrimitiveDesc& primitiveDesc = desc.primitives.emplace_back();
+			primitiveDesc.materialIndex = primitive.materialIndex;
+			primitiveDesc.vertices.resize(primitive.vertexCount);
+			for (uint32_t i = 0; i < primitive.vertexCount; ++i) {
+				const size_t vertex = size_t { primitive.vertexOffset } + i;
+				primitiveDesc.vertices[i].position = meshes.positions[vertex];
+				primitiveDesc.vertices[i].normal = meshes.normals[vertex];
+				primitiveDesc.vertices[i].uv = meshes.texCoords[vertex];
+			}
+			const auto indexBegin = meshes.indices.begin() + primitive.indexOffset;
+			primitiveDesc.indices.assign(indexBegin, indexBegin + primitive.indexCount);
+
+			const auto materialName = materialNames.find(primitive.materialIndex);
+			if (materialName == materialNames.end()) {
+				throw std::runtime_error("Material has no name: " + std::to_string(primitive.materialIndex));
+			}
+			desc.materials[primitive.materialIndex] = materialName->second;
+		}
+		return std::make_shared<Grafkit::Resource::MeshBuilder>(std::move(desc));
+	}
+} // namespace
+
+AssimpLoader::AssimpLoader(const AssimpLoaderOptions& options, const size_t workerCount)
+	: m_options(options)
+	, m_workers(std::make_unique<Utils::ThreadPool>(workerCount))
+{
+}
+
+AssimpLoader::~AssimpLoader() = default;
+
+AssimpScene AssimpLoader::Import(const std::string& filename) const
+{
+	// The importer owns the scene
+	::Assimp::Importer importer;
+	const aiScene* aiscene = importer.ReadFile(filename, IMPORT_FLAGS);
+	if (aiscene == nullptr || aiscene->mRootNode == nullptr || (aiscene->mFlags & AI_SCENE_FLAGS_INCOMPLETE) != 0) {
+		throw std::runtime_error("Failed to import " + filename + ": " + importer.GetErrorString());
+	}
+
+	AssimpScene result {};
+	result.meshes = ConvertMeshes(*aiscene);
+	result.meshes.name = filename;
+	result.scene.nodes.push_back(ConvertNode(*aiscene->mRootNode, result.meshes));
+
+	Log::Instance().Info("Imported %s: %zu meshes, %zu vertices, %zu triangles", filename.c_str(),
+		result.meshes.primitives.size(), result.meshes.positions.size(), result.meshes.indices.size() / 3);
+	return result;
+}
+
+Grafkit::Resource::MeshDescV2 AssimpLoader::ConvertMeshes(const aiScene& scene) const
+{
+	Resource::MeshDescV2 result {};
+	result.type = Resource::MeshType::Static;
+
+	// Materials of the same name are one and the same, the first index stands for all of them
+	std::vector<uint32_t> materialRemap(scene.mNumMaterials);
+	for (uint32_t i = 0; i < scene.mNumMaterials; ++i) {
+		materialRemap[i] = result.materials.try_emplace(GetMaterialName(&scene, i), i).first->second;
+	}
+
+	// Counting pass, primitive indices are the mesh indices of the scene; points and lines get empty primitives
+	bool hasTangents = false;
+	uint64_t vertexCount = 0;
+	uint64_t indexCount = 0;
+	result.primitives.reserve(scene.mNumMeshes);
+	for (uint32_t i = 0; i < scene.mNumMeshes; ++i) {
+		const aiMesh& mesh = *scene.mMeshes[i];
+		const uint64_t triangleCount = (mesh.mPrimitiveTypes & aiPrimitiveType_TRIANGLE) == 0
+			? 0
+			: static_cast<uint64_t>(std::count_if(mesh.mFaces, mesh.mFaces + mesh.mNumFaces, IsTriangle));
+		const uint32_t meshVertexCount = triangleCount > 0 ? mesh.mNumVertices : 0;
+		if (mesh.mMaterialIndex >= scene.mNumMaterials) {
+			throw std::out_of_range("Material index out of range in mesh: " + std::string(mesh.mName.C_Str()));
+		}
+
+		result.primitives.push_back({
+			.indexOffset = static_cast<uint32_t>(indexCount),
+			.indexCount = static_cast<uint32_t>(triangleCount * 3),
+			.vertexOffset = static_cast<uint32_t>(vertexCount),
+			.vertexCount = meshVertexCount,
+			.materialIndex = materialRemap[mesh.mMaterialIndex],
+			.lods = {},
+		});
+		vertexCount += meshVertexCount;
+		indexCount += triangleCount * 3;
+
+		hasTangents = hasTangents || (triangleCount > 0 && mesh.HasTangentsAndBitangents());
+	}
+	if (vertexCount > std::numeric_limits<uint32_t>::max() || indexCount > std::numeric_limits<uint32_t>::max()) {
+		throw std::runtime_error("Scene does not fit 32 bit offsets");
+	}
+
+	// Mesh builders read normals and texture coordinates, they are zero where a mesh has none
+	result.positions.resize(vertexCount);
+	result.normals.resize(vertexCount);
+	result.texCoords.resize(vertexCount);
+	if (hasTangents) {
+		result.tangents.resize(vertexCount);
+		result.bitangents.resize(vertexCount);
+	}
+	result.indices.resize(indexCount);
+
+	// Tasks write disjoint ranges of the arena, and have to finish before returning as they refer to it
+	std::vector<std::future<void>> tasks;
+	tasks.reserve(scene.mNumMeshes);
+	for (uint32_t i = 0; i < scene.mNumMeshes; ++i) {
+		if (result.primitives[i].indexCount > 0) {
+			const aiMesh* mesh = scene.mMeshes[i];
+			const Resource::PrimitiveDescV2* primitive = &result.primitives[i];
+			tasks.push_back(
+				m_workers->Submit([mesh, primitive, &result]() { ConvertMesh(*mesh, *primitive, result); }));
+		}
+	}
+
+	std::exception_ptr error;
+	for (std::future<void>& task : tasks) {
+		try {
+			task.get();
+		} catch (...) {
+			if (!error) {
+				error = std::current_exception();
+			}
+		}
+	}
+	if (error) {
+		std::rethrow_exception(error);
+	}
+	return result;
+}
+
+Grafkit::ScenegraphPtr AssimpLoader::Load(
+	const Core::DeviceRef& device, const Resource::ResourceManagerRef& resources, const std::string& filename) const
+{
+	return Build(device, resources, filename, Import(filename));
+}
+
+Grafkit::ScenegraphPtr AssimpLoader::Build(const Core::DeviceRef& device,
+	const Resource::ResourceManagerRef& resources, const std::string& name, const AssimpScene& scene) const
 {
+	// Names the meshes are built against, the default material stands in for the missing ones
+	std::map<uint32_t, std::string> materialNames;
+	for (const auto& [materialName, index] : scene.meshes.materials) {
+		const bool isMissing = !resources->Contains({ typeid(Grafkit::Material), materialName });
+		const bool isSubstituted = isMissing && !m_options.defaultMaterial.empty();
+		materialNames[index] = isSubstituted ? m_options.defaultMaterial : materialName;
+	}
+
+	// A mesh for each distinct set of primitives the nodes refer to
+	std::map<std::vector<uint32_t>, std::string> meshNames;
+	Resource::BuildScheduler scheduler(resources);
+	const auto addMeshes = [&](const auto& self, const Resource::NodeDesc& node) -> void {
+		if (!node.meshIndices.empty()) {
+			const std::string meshName = name + "#" + std::to_string(meshNames.size());
+			if (meshNames.try_emplace(node.meshIndices, meshName).second) {
+				auto builder = CreateMeshBuilder(scene.meshes, node.meshIndices, materialNames);
+				if (m_options.isOptimized) {
+					builder->Optimize();
+				}
+				scheduler.Add(meshName, builder);
+			}
+		}
+		for (const Resource::NodeDesc& child : node.children) {
+			self(self, child);
+		}
+	};
+	for (const Resource::NodeDesc& node : scene.scene.nodes) {
+		addMeshes(addMeshes, node);
+	}
+
+	// Reports every material missing before building anything
+	scheduler.Build(device);
+
+	auto scenegraph = std::make_shared<Grafkit::Scenegraph>();
+	const auto createNodes = [&](const auto& self, const Resource::NodeDesc& nodeDesc, const NodePtr& parent) -> void {
+		const MeshPtr mesh = nodeDesc.meshIndices.empty()
+			? nullptr
+			: resources->Get<Grafkit::Mesh>(meshNames.at(nodeDesc.meshIndices));
+		const NodePtr node = scenegraph->CreateNode(mesh, parent);
+		node->translation = nodeDesc.translation;
+		node->rotation = nodeDesc.rotation;
+		node->scale = nodeDesc.scale;
+		for (const Resource::NodeDesc& child : nodeDesc.children) {
+			self(self, child, node);
+		}
+	};
 
-	// // Load materials
-	// if (aiscene->HasMaterials()) {
-	// 	Log::Instance().Info("Loading materials");
-	// 	for (uint32_t materialIndex = 0; materialIndex < aiscene->mNumMaterials; materialIndex++) {
-	// 		// aiMaterial* srcMaterial = aiscene->mMaterials[i];
-
-	// 		// material->SetName(GetMaterialName(i));
-
-	// 		// Log::Instance().Info("Loading material #%d", i);
-	// 		// // LOGGER(Log::Logger().Trace("- #%d %s", i, material->GetName().c_str()));
-
-	// 		// aiReturn texFound = AI_FAILURE;
-
-	// 		// // --- SNIP ---
-	// 		// // -- -- load textures
-	// 		// // textura -> material
-	// 		// for (size_t k = 0; k < sizeof(texture_load_map) / sizeof(texture_load_map[0]); k++) {
-	// 		// 	for (size_t j = 0; j < srcMaterial->GetTextureCount(texture_load_map[k].ai); j++) {
-	// 		// 		LOGGER(Log::Logger().Trace("-- texture #%s #%d", texture_load_map[k].tt, j));
-	// 		// 		// TODO: does it work at all ?
-	// 		// 		// material->AddTexture(assimpTexture(texture_load_map[k].ai, curr_mat, j, resman),
-	// 		// 		// texture_load_map[k].tt);
-	// 		// 	}
-	// 		// }
-	// 		// // --- SMAP ---
-
-	// 		// // there is not much to set up atm
-	// 		// material->Colors().diffuse = aiMatkey4ToFloat4(srcMaterial, AI_MATKEY_COLOR_DIFFUSE);
-	// 		// material->Colors().specular = aiMatkey4ToFloat4(srcMaterial, AI_MATKEY_COLOR_SPECULAR);
-
-	// 		// env->GetBuilder().AddMaterial(material);
-	// 	}
-	// }
-
-	return {};
+	const NodePtr root = scenegraph->CreateNode();
+	for (const Resource::NodeDesc& node : scene.scene.nodes) {
+		createNodes(createNodes, node, root);
+	}
+	return scenegraph;
 }
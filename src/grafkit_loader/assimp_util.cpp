@@ -23,11 +23,11 @@
 
 #include "assimp_util.h"
 
-std::string Grafkit::Asset::Assimp::GetMaterialName(aiScene* aiscene, uint32_t index)
+std::string Grafkit::Asset::Assimp::GetMaterialName(const aiScene* aiscene, uint32_t index)
 {
 	if (index < aiscene->mNumMaterials) {
 		aiString name;
-		aiMaterial* srcMaterial = aiscene->mMaterials[index];
+		const aiMaterial* srcMaterial = aiscene->mMaterials[index];
 
 		if (srcMaterial->Get(AI_MATKEY_NAME, name) == AI_SUCCESS) {
 			return name.C_Str();
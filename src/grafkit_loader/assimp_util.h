@@ -10,7 +10,7 @@ struct aiScene;
 struct aiMaterial;
 
 namespace Grafkit ::Asset ::Assimp {
-	std::string GetMaterialName(aiScene* aiscene, uint32_t index);
+	std::string GetMaterialName(const aiScene* aiscene, uint32_t index);
 	glm::vec4 Matkey4ToFloat4(const aiMaterial* mat, const char* key);
 
 } // namespace Grafkit::Asset::Assimp
@@ -0,0 +1,76 @@
+#include "stdafx.h"
+
+#include <grafkit/descriptors/binary_desc.h>
+#include <grafkit_loader/binary_adapter.h>
+
+#include "binary/generated/binary_register_generated.h"
+#include "binary_registry.h"
+
+using namespace Grafkit::Serialization;
+using Grafkit::Asset::BinaryAssetHeader;
+
+BinarySerializerRegistry::BinarySerializerRegistry() { Serialization::RegisterBinarySerializers(*this); }
+
+void BinarySerializerRegistry::Register(std::type_index type,
+	const uint64_t schemaHash,
+	BinarySerializerFunc serializer,
+	BinaryDeserializerFunc deserializer)
+{
+	m_entries[type.name()] = { schemaHash, std::move(serializer), std::move(deserializer) };
+}
+
+std::vector<uint8_t> BinarySerializerRegistry::Serialize(std::type_index type, const void* object) const
+{
+	const Entry& entry = GetEntry(type);
+
+	std::vector<uint8_t> data(sizeof(BinaryAssetHeader));
+	BinaryWriter writer(data);
+	entry.serializer(writer, object);
+
+	BinaryAssetHeader header {};
+	header.magic = Asset::BINARY_ASSET_MAGIC;
+	header.version = Asset::BINARY_ASSET_VERSION;
+	header.schemaHash = entry.schemaHash;
+	header.payloadSize = data.size() - sizeof(BinaryAssetHeader);
+	std::memcpy(data.data(), &header, sizeof(header));
+	return data;
+}
+
+void BinarySerializerRegistry::Deserialize(
+	const std::span<const uint8_t> data, std::type_index type, void* object) const
+{
+	const Entry& entry = GetEntry(type);
+
+	BinaryAssetHeader header {};
+	if (data.size() < sizeof(header)) {
+		throw std::runtime_error("Binary asset is truncated");
+	}
+	std::memcpy(&header, data.data(), sizeof(header));
+	if (header.magic != Asset::BINARY_ASSET_MAGIC) {
+		throw std::runtime_error("Not a binary asset");
+	}
+	if (header.version != Asset::BINARY_ASSET_VERSION) {
+		throw std::runtime_error("Unsupported binary asset version: " + std::to_string(header.version));
+	}
+	if (header.schemaHash != entry.schemaHash) {
+		throw std::runtime_error(std::string("Binary asset was written by an other version of ") + type.name());
+	}
+	if (header.payloadSize != data.size() - sizeof(header)) {
+		throw std::runtime_error("Binary asset size does not match its header");
+	}
+
+	BinaryReader reader(data.subspan(sizeof(header)));
+	entry.deserializer(reader, object);
+	if (reader.GetRemaining() != 0) {
+		throw std::runtime_error("Binary asset has trailing data");
+	}
+}
+
+const BinarySerializerRegistry::Entry& BinarySerializerRegistry::GetEntry(std::type_index type) const
+{
+	auto it = m_entries.find(type.name());
+	if (it == m_entries.end()) {
+		throw std::runtime_error(std::string("No binary serializer found for type: ") + type.name());
+	}
+	return it->second;
+}
@@ -0,0 +1,58 @@
+#ifndef BINARY_REGISTRY_H
+#define BINARY_REGISTRY_H
+
+#include <functional>
+#include <span>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+#include "binary/binary_stream.h"
+
+namespace Grafkit::Serialization {
+	using BinarySerializerFunc = std::function<void(BinaryWriter&, const void*)>;
+	using BinaryDeserializerFunc = std::function<void(BinaryReader&, void*)>;
+
+	class BinarySerializerRegistry {
+	public:
+		static BinarySerializerRegistry& Instance()
+		{
+			static BinarySerializerRegistry instance;
+			return instance;
+		}
+		BinarySerializerRegistry(const BinarySerializerRegistry&) = delete;
+		BinarySerializerRegistry& operator=(const BinarySerializerRegistry&) = delete;
+
+		// The schema hash is generated from the fields, assets written by an other version of the type are rejected
+		template <typename T>
+		void Register(uint64_t schemaHash, BinarySerializerFunc serializer, BinaryDeserializerFunc deserializer)
+		{
+			Register(typeid(T), schemaHash, std::move(serializer), std::move(deserializer));
+		}
+		void Register(std::type_index type,
+			uint64_t schemaHash,
+			BinarySerializerFunc serializer,
+			BinaryDeserializerFunc deserializer);
+
+		// Header and payload of a binary asset
+		[[nodiscard]] std::vector<uint8_t> Serialize(std::type_index type, const void* object) const;
+		void Deserialize(std::span<const uint8_t> data, std::type_index type, void* object) const;
+
+	private:
+		struct Entry {
+			uint64_t schemaHash;
+			BinarySerializerFunc serializer;
+			BinaryDeserializerFunc deserializer;
+		};
+
+		BinarySerializerRegistry();
+		~BinarySerializerRegistry() = default;
+
+		const Entry& GetEntry(std::type_index type) const;
+
+		std::unordered_map<std::string, Entry> m_entries;
+	};
+
+} // namespace Grafkit::Serialization
+
+#endif // BINARY_REGISTRY_H
@@ -0,0 +1,158 @@
+#ifndef BINARY_STREAM_H
+#define BINARY_STREAM_H
+
+#include <bit>
+#include <cstring>
+#include <map>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+namespace Grafkit::Serialization {
+	// Values are written as they are in memory, which makes the format little endian
+	static_assert(std::endian::native == std::endian::little, "Binary assets are stored little endian");
+
+	template <typename T> struct IsBinaryVector : std::false_type { };
+	template <typename T, typename A> struct IsBinaryVector<std::vector<T, A>> : std::true_type { };
+
+	template <typename T> struct IsBinaryMap : std::false_type { };
+	template <typename K, typename V, typename C, typename A>
+	struct IsBinaryMap<std::map<K, V, C, A>> : std::true_type { };
+
+	// Types copied as a whole, arrays of them in a single copy
+	template <typename T> struct IsBinaryRaw : std::bool_constant<std::is_arithmetic_v<T> || std::is_enum_v<T>> { };
+	template <glm::length_t N, typename T, glm::qualifier Q>
+	struct IsBinaryRaw<glm::vec<N, T, Q>> : std::true_type { };
+	template <> struct IsBinaryRaw<glm::mat4> : std::true_type { };
+
+	/**
+	 * @brief Appends values to a buffer
+	 * Containers are prefixed with their element count, generated types provide to_binary().
+	 */
+	class BinaryWriter {
+	public:
+		explicit BinaryWriter(std::vector<uint8_t>& buffer)
+			: m_buffer(buffer)
+		{
+		}
+
+		template <typename T> void Write(const T& value)
+		{
+			if constexpr (IsBinaryRaw<T>::value) {
+				WriteBytes(&value, sizeof(T));
+			} else if constexpr (std::is_same_v<T, std::string>) {
+				WriteSize(value.size());
+				WriteBytes(value.data(), value.size());
+			} else if constexpr (IsBinaryVector<T>::value) {
+				WriteSize(value.size());
+				if constexpr (IsBinaryRaw<typename T::value_type>::value) {
+					WriteBytes(value.data(), value.size() * sizeof(typename T::value_type));
+				} else {
+					for (const auto& element : value) {
+						Write(element);
+					}
+				}
+			} else if constexpr (IsBinaryMap<T>::value) {
+				WriteSize(value.size());
+				for (const auto& [key, element] : value) {
+					Write(key);
+					Write(element);
+				}
+			} else {
+				to_binary(*this, value);
+			}
+		}
+
+		void WriteBytes(const void* data, const size_t size)
+		{
+			if (size > 0) {
+				const size_t offset = m_buffer.size();
+				m_buffer.resize(offset + size);
+				std::memcpy(m_buffer.data() + offset, data, size);
+			}
+		}
+
+	private:
+		void WriteSize(const size_t size) { Write(static_cast<uint64_t>(size)); }
+
+		std::vector<uint8_t>& m_buffer;
+	};
+
+	/**
+	 * @brief Reads values back from a buffer written by BinaryWriter
+	 * Every read is bounds checked, a truncated or corrupt buffer throws instead of reading past its end.
+	 */
+	class BinaryReader {
+	public:
+		explicit BinaryReader(std::span<const uint8_t> data)
+			: m_data(data)
+		{
+		}
+
+		template <typename T> void Read(T& value)
+		{
+			if constexpr (IsBinaryRaw<T>::value) {
+				ReadBytes(&value, sizeof(T));
+			} else if constexpr (std::is_same_v<T, std::string>) {
+				value.resize(ReadSize(1));
+				ReadBytes(value.data(), value.size());
+			} else if constexpr (IsBinaryVector<T>::value) {
+				using ElementType = typename T::value_type;
+				if constexpr (IsBinaryRaw<ElementType>::value) {
+					value.resize(ReadSize(sizeof(ElementType)));
+					ReadBytes(value.data(), value.size() * sizeof(ElementType));
+				} else {
+					value.clear();
+					value.resize(ReadSize(1));
+					for (auto& element : value) {
+						Read(element);
+					}
+				}
+			} else if constexpr (IsBinaryMap<T>::value) {
+				value.clear();
+				const size_t count = ReadSize(1);
+				for (size_t i = 0; i < count; ++i) {
+					typename T::key_type key {};
+					Read(key);
+					Read(value[key]);
+				}
+			} else {
+				from_binary(*this, value);
+			}
+		}
+
+		void ReadBytes(void* data, const size_t size)
+		{
+			if (size > GetRemaining()) {
+				throw std::runtime_error("Binary asset is truncated");
+			}
+			if (size > 0) {
+				std::memcpy(data, m_data.data() + m_offset, size);
+				m_offset += size;
+			}
+		}
+
+		[[nodiscard]] size_t GetRemaining() const { return m_data.size() - m_offset; }
+
+	private:
+		// Element counts are checked against what is left, so a corrupt count can not allocate too much
+		size_t ReadSize(const size_t minElementSize)
+		{
+			uint64_t size = 0;
+			Read(size);
+			if (size > GetRemaining() / minElementSize) {
+				throw std::runtime_error("Binary asset is truncated");
+			}
+			return static_cast<size_t>(size);
+		}
+
+		std::span<const uint8_t> m_data;
+		size_t m_offset = 0;
+	};
+
+} // namespace Grafkit::Serialization
+
+#endif // BINARY_STREAM_H
@@ -0,0 +1,117 @@
+/**
+ * @file binary_register_generated.h
+ * @brief Binary serialization functions
+ *
+ * This file has been automatically generated and should not be modified.
+ *
+ * Generated at: 2026-10-19 18:20:33
+ * Source files:
+ *   - animation_desc.gen.yaml
+ *   - binary_desc.gen.yaml
+ *   - cook_desc.gen.yaml
+ *   - image_desc.gen.yaml
+ *   - material_desc.gen.yaml
+ *   - mesh_desc.gen.yaml
+ *   - pack_desc.gen.yaml
+ *   - scene_desc.gen.yaml
+ * Template file: binary_register.j2
+ */
+
+#include "binary_serializers.h"
+#include "binary/binary_registry.h"
+
+namespace Grafkit::Serialization
+{
+
+	inline void RegisterBinarySerializers(BinarySerializerRegistry &registry)
+	{
+		// MARK: animation_desc
+
+		registry.Register<Grafkit::Resource::AnimationKeyDesc>(0x130092f57a2bd145,
+			[](BinaryWriter &writer, const void *object)
+			{ to_binary(writer, *static_cast<const Grafkit::Resource::AnimationKeyDesc *>(object)); },
+			[](BinaryReader &reader, void *object)
+			{ from_binary(reader, *static_cast<Grafkit::Resource::AnimationKeyDesc *>(object)); });
+
+		registry.Register<Grafkit::Resource::AnimationChannelDesc>(0x7d4d799b63470ca6,
+			[](BinaryWriter &writer, const void *object)
+			{ to_binary(writer, *static_cast<const Grafkit::Resource::AnimationChannelDesc *>(object)); },
+			[](BinaryReader &reader, void *object)
+			{ from_binary(reader, *static_cast<Grafkit::Resource::AnimationChannelDesc *>(object)); });
+
+		registry.Register<Grafkit::Resource::AnimationClipDesc>(0xd1ef28c77a73d7fc,
+			[](BinaryWriter &writer, const void *object)
+			{ to_binary(writer, *static_cast<const Grafkit::Resource::AnimationClipDesc *>(object)); },
+			[](BinaryReader &reader, void *object)
+			{ from_binary(reader, *static_cast<Grafkit::Resource::AnimationClipDesc *>(object)); });
+
+		// MARK: binary_desc
+
+		// MARK: cook_desc
+
+		// MARK: image_desc
+
+		registry.Register<Grafkit::Resource::ImageDesc>(0xc69e41a921b82f11,
+			[](BinaryWriter &writer, const void *object)
+			{ to_binary(writer, *static_cast<const Grafkit::Resource::ImageDesc *>(object)); },
+			[](BinaryReader &reader, void *object)
+			{ from_binary(reader, *static_cast<Grafkit::Resource::ImageDesc *>(object)); });
+
+		registry.Register<Grafkit::Resource::SolidImageDesc>(0xdaa060ca073b8bfd,
+			[](BinaryWriter &writer, const void *object)
+			{ to_binary(writer, *static_cast<const Grafkit::Resource::SolidImageDesc *>(object)); },
+			[](BinaryReader &reader, void *object)
+			{ from_binary(reader, *static_cast<Grafkit::Resource::SolidImageDesc *>(object)); });
+
+		registry.Register<Grafkit::Resource::CheckerImageDesc>(0x0404aefb7cb29d4d,
+			[](BinaryWriter &writer, const void *object)
+			{ to_binary(writer, *static_cast<const Grafkit::Resource::CheckerImageDesc *>(object)); },
+			[](BinaryReader &reader, void *object)
+			{ from_binary(reader, *static_cast<Grafkit::Resource::CheckerImageDesc *>(object)); });
+
+		// MARK: material_desc
+
+		registry.Register<Grafkit::Resource::MaterialDesc>(0xfa17f78fa570e61a,
+			[](BinaryWriter &writer, const void *object)
+			{ to_binary(writer, *static_cast<const Grafkit::Resource::MaterialDesc *>(object)); },
+			[](BinaryReader &reader, void *object)
+			{ from_binary(reader, *static_cast<Grafkit::Resource::MaterialDesc *>(object)); });
+
+		// MARK: mesh_desc
+
+		registry.Register<Grafkit::Resource::PrimitiveDesc>(0xa7db023aa098f002,
+			[](BinaryWriter &writer, const void *object)
+			{ to_binary(writer, *static_cast<const Grafkit::Resource::PrimitiveDesc *>(object)); },
+			[](BinaryReader &reader, void *object)
+			{ from_binary(reader, *static_cast<Grafkit::Resource::PrimitiveDesc *>(object)); });
+
+		registry.Register<Grafkit::Resource::MeshDesc>(0xd28d9765ae9f25f3,
+			[](BinaryWriter &writer, const void *object)
+			{ to_binary(writer, *static_cast<const Grafkit::Resource::MeshDesc *>(object)); },
+			[](BinaryReader &reader, void *object)
+			{ from_binary(reader, *static_cast<Grafkit::Resource::MeshDesc *>(object)); });
+
+		registry.Register<Grafkit::Resource::PrimitiveLodDesc>(0x63a870c68a7e6819,
+			[](BinaryWriter &writer, const void *object)
+			{ to_binary(writer, *static_cast<const Grafkit::Resource::PrimitiveLodDesc *>(object)); },
+			[](BinaryReader &reader, void *object)
+			{ from_binary(reader, *static_cast<Grafkit::Resource::PrimitiveLodDesc *>(object)); });
+
+		registry.Register<Grafkit::Resource::PrimitiveDescV2>(0x12ca38b7affb4801,
+			[](BinaryWriter &writer, const void *object)
+			{ to_binary(writer, *static_cast<const Grafkit::Resource::PrimitiveDescV2 *>(object)); },
+			[](BinaryReader &reader, void *object)
+			{ from_binary(reader, *static_cast<Grafkit::Resource::PrimitiveDescV2 *>(object)); });
+
+		registry.Register<Grafkit::Resource::MeshDescV2>(0xd3aec0dedd1da14b,
+			[](BinaryWriter &writer, const void *object)
+			{ to_binary(writer, *static_cast<const Grafkit::Resource::MeshDescV2 *>(object)); },
+			[](BinaryReader &reader, void *object)
+			{ from_binary(reader, *static_cast<Grafkit::Resource::MeshDescV2 *>(object)); });
+
+		// MARK: pack_desc
+
+		// MARK: scene_desc
+	}
+
+} // namespace Grafkit::Serialization
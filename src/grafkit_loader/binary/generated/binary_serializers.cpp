@@ -0,0 +1,276 @@
+/**
+ * @file binary_serializers.cpp
+ * @brief Binary serialization functions
+ *
+ * This file has been automatically generated and should not be modified.
+ *
+ * Generated at: 2026-10-19 18:20:33
+ * Source files:
+ *   - animation_desc.gen.yaml
+ *   - binary_desc.gen.yaml
+ *   - cook_desc.gen.yaml
+ *   - image_desc.gen.yaml
+ *   - material_desc.gen.yaml
+ *   - mesh_desc.gen.yaml
+ *   - pack_desc.gen.yaml
+ *   - scene_desc.gen.yaml
+ * Template file: binary_template.j2
+ */
+
+#include "stdafx.h"
+
+#include <grafkit/common.h>
+#include <map>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "binary/binary_stream.h"
+#include "binary/generated/binary_serializers.h"
+
+// NOLINTBEGIN(readability-identifier-naming) The naming follows the json serializers
+
+// MARK: animation_desc
+namespace Grafkit::Resource
+{
+	void to_binary(Grafkit::Serialization::BinaryWriter &writer, const AnimationKeyDesc &obj)
+	{
+		writer.Write(obj.time);
+		writer.Write(obj.interpolation);
+		writer.Write(obj.value);
+	}
+
+	void from_binary(Grafkit::Serialization::BinaryReader &reader, AnimationKeyDesc &obj)
+	{
+		reader.Read(obj.time);
+		reader.Read(obj.interpolation);
+		reader.Read(obj.value);
+	}
+
+	void to_binary(Grafkit::Serialization::BinaryWriter &writer, const AnimationChannelDesc &obj)
+	{
+		writer.Write(obj.id);
+		writer.Write(obj.target);
+		writer.Write(obj.keys);
+	}
+
+	void from_binary(Grafkit::Serialization::BinaryReader &reader, AnimationChannelDesc &obj)
+	{
+		reader.Read(obj.id);
+		reader.Read(obj.target);
+		reader.Read(obj.keys);
+	}
+
+	void to_binary(Grafkit::Serialization::BinaryWriter &writer, const AnimationClipDesc &obj)
+	{
+		writer.Write(obj.name);
+		writer.Write(obj.duration);
+		writer.Write(obj.isLooping);
+		writer.Write(obj.channels);
+	}
+
+	void from_binary(Grafkit::Serialization::BinaryReader &reader, AnimationClipDesc &obj)
+	{
+		reader.Read(obj.name);
+		reader.Read(obj.duration);
+		reader.Read(obj.isLooping);
+		reader.Read(obj.channels);
+	}
+} // namespace Grafkit::Resource
+
+// MARK: binary_desc
+namespace Grafkit::Asset
+{
+} // namespace Grafkit::Asset
+
+// MARK: cook_desc
+namespace Grafkit::Resource
+{
+} // namespace Grafkit::Resource
+
+// MARK: image_desc
+namespace Grafkit::Resource
+{
+	void to_binary(Grafkit::Serialization::BinaryWriter &writer, const ImageDesc &obj)
+	{
+		writer.Write(obj.image);
+		writer.Write(obj.size);
+		writer.Write(obj.format);
+		writer.Write(obj.channels);
+		writer.Write(obj.useMipmap);
+	}
+
+	void from_binary(Grafkit::Serialization::BinaryReader &reader, ImageDesc &obj)
+	{
+		reader.Read(obj.image);
+		reader.Read(obj.size);
+		reader.Read(obj.format);
+		reader.Read(obj.channels);
+		reader.Read(obj.useMipmap);
+	}
+
+	void to_binary(Grafkit::Serialization::BinaryWriter &writer, const SolidImageDesc &obj)
+	{
+		writer.Write(obj.color);
+	}
+
+	void from_binary(Grafkit::Serialization::BinaryReader &reader, SolidImageDesc &obj)
+	{
+		reader.Read(obj.color);
+	}
+
+	void to_binary(Grafkit::Serialization::BinaryWriter &writer, const CheckerImageDesc &obj)
+	{
+		writer.Write(obj.size);
+		writer.Write(obj.divisions);
+		writer.Write(obj.color1);
+		writer.Write(obj.color2);
+		writer.Write(obj.useMipmap);
+	}
+
+	void from_binary(Grafkit::Serialization::BinaryReader &reader, CheckerImageDesc &obj)
+	{
+		reader.Read(obj.size);
+		reader.Read(obj.divisions);
+		reader.Read(obj.color1);
+		reader.Read(obj.color2);
+		reader.Read(obj.useMipmap);
+	}
+} // namespace Grafkit::Resource
+
+// MARK: material_desc
+namespace Grafkit::Resource
+{
+	void to_binary(Grafkit::Serialization::BinaryWriter &writer, const MaterialDesc &obj)
+	{
+		writer.Write(obj.name);
+		writer.Write(obj.type);
+		writer.Write(obj.stage);
+		writer.Write(obj.textures);
+	}
+
+	void from_binary(Grafkit::Serialization::BinaryReader &reader, MaterialDesc &obj)
+	{
+		reader.Read(obj.name);
+		reader.Read(obj.type);
+		reader.Read(obj.stage);
+		reader.Read(obj.textures);
+	}
+} // namespace Grafkit::Resource
+
+// MARK: mesh_desc
+namespace Grafkit::Resource
+{
+	void to_binary(Grafkit::Serialization::BinaryWriter &writer, const PrimitiveDesc &obj)
+	{
+		writer.Write(obj.positions);
+		writer.Write(obj.normals);
+		writer.Write(obj.tangents);
+		writer.Write(obj.bitangents);
+		writer.Write(obj.texCoords);
+		writer.Write(obj.indices);
+		writer.Write(obj.materialIndex);
+	}
+
+	void from_binary(Grafkit::Serialization::BinaryReader &reader, PrimitiveDesc &obj)
+	{
+		reader.Read(obj.positions);
+		reader.Read(obj.normals);
+		reader.Read(obj.tangents);
+		reader.Read(obj.bitangents);
+		reader.Read(obj.texCoords);
+		reader.Read(obj.indices);
+		reader.Read(obj.materialIndex);
+	}
+
+	void to_binary(Grafkit::Serialization::BinaryWriter &writer, const MeshDesc &obj)
+	{
+		writer.Write(obj.name);
+		writer.Write(obj.primitives);
+		writer.Write(obj.materials);
+		writer.Write(obj.type);
+	}
+
+	void from_binary(Grafkit::Serialization::BinaryReader &reader, MeshDesc &obj)
+	{
+		reader.Read(obj.name);
+		reader.Read(obj.primitives);
+		reader.Read(obj.materials);
+		reader.Read(obj.type);
+	}
+
+	void to_binary(Grafkit::Serialization::BinaryWriter &writer, const PrimitiveLodDesc &obj)
+	{
+		writer.Write(obj.indexOffset);
+		writer.Write(obj.indexCount);
+		writer.Write(obj.error);
+	}
+
+	void from_binary(Grafkit::Serialization::BinaryReader &reader, PrimitiveLodDesc &obj)
+	{
+		reader.Read(obj.indexOffset);
+		reader.Read(obj.indexCount);
+		reader.Read(obj.error);
+	}
+
+	void to_binary(Grafkit::Serialization::BinaryWriter &writer, const PrimitiveDescV2 &obj)
+	{
+		writer.Write(obj.indexOffset);
+		writer.Write(obj.indexCount);
+		writer.Write(obj.vertexOffset);
+		writer.Write(obj.vertexCount);
+		writer.Write(obj.materialIndex);
+		writer.Write(obj.lods);
+	}
+
+	void from_binary(Grafkit::Serialization::BinaryReader &reader, PrimitiveDescV2 &obj)
+	{
+		reader.Read(obj.indexOffset);
+		reader.Read(obj.indexCount);
+		reader.Read(obj.vertexOffset);
+		reader.Read(obj.vertexCount);
+		reader.Read(obj.materialIndex);
+		reader.Read(obj.lods);
+	}
+
+	void to_binary(Grafkit::Serialization::BinaryWriter &writer, const MeshDescV2 &obj)
+	{
+		writer.Write(obj.name);
+		writer.Write(obj.positions);
+		writer.Write(obj.normals);
+		writer.Write(obj.tangents);
+		writer.Write(obj.bitangents);
+		writer.Write(obj.texCoords);
+		writer.Write(obj.indices);
+		writer.Write(obj.primitives);
+		writer.Write(obj.materials);
+		writer.Write(obj.type);
+	}
+
+	void from_binary(Grafkit::Serialization::BinaryReader &reader, MeshDescV2 &obj)
+	{
+		reader.Read(obj.name);
+		reader.Read(obj.positions);
+		reader.Read(obj.normals);
+		reader.Read(obj.tangents);
+		reader.Read(obj.bitangents);
+		reader.Read(obj.texCoords);
+		reader.Read(obj.indices);
+		reader.Read(obj.primitives);
+		reader.Read(obj.materials);
+		reader.Read(obj.type);
+	}
+} // namespace Grafkit::Resource
+
+// MARK: pack_desc
+namespace Grafkit::Asset
+{
+} // namespace Grafkit::Asset
+
+// MARK: scene_desc
+namespace Grafkit::Resource
+{
+} // namespace Grafkit::Resource
+
+// NOLINTEND(readability-identifier-naming)
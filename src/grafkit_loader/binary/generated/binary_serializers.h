@@ -0,0 +1,114 @@
+/**
+ * @file binary_serializers.h
+ * @brief Binary serialization functions
+ *
+ * This file has been automatically generated and should not be modified.
+ *
+ * Generated at: 2026-10-19 18:20:33
+ * Source files:
+ *   - animation_desc.gen.yaml
+ *   - binary_desc.gen.yaml
+ *   - cook_desc.gen.yaml
+ *   - image_desc.gen.yaml
+ *   - material_desc.gen.yaml
+ *   - mesh_desc.gen.yaml
+ *   - pack_desc.gen.yaml
+ *   - scene_desc.gen.yaml
+ * Template file: binary_header.j2
+ */
+
+// NOLINTBEGIN(readability-identifier-naming) The naming follows the json serializers
+#include <grafkit/common.h>
+#include <map>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "binary/binary_stream.h"
+#include <grafkit/descriptors/animation_desc.h>
+#include <grafkit/descriptors/binary_desc.h>
+#include <grafkit/descriptors/cook_desc.h>
+#include <grafkit/descriptors/image_desc.h>
+#include <grafkit/descriptors/material_desc.h>
+#include <grafkit/descriptors/mesh_desc.h>
+#include <grafkit/descriptors/pack_desc.h>
+#include <grafkit/descriptors/scene_desc.h>
+
+// MARK: animation_desc
+namespace Grafkit::Resource
+{
+	void to_binary(Grafkit::Serialization::BinaryWriter &writer, const AnimationKeyDesc &obj);
+	void from_binary(Grafkit::Serialization::BinaryReader &reader, AnimationKeyDesc &obj);
+
+	void to_binary(Grafkit::Serialization::BinaryWriter &writer, const AnimationChannelDesc &obj);
+	void from_binary(Grafkit::Serialization::BinaryReader &reader, AnimationChannelDesc &obj);
+
+	void to_binary(Grafkit::Serialization::BinaryWriter &writer, const AnimationClipDesc &obj);
+	void from_binary(Grafkit::Serialization::BinaryReader &reader, AnimationClipDesc &obj);
+
+} // namespace Grafkit::Resource
+
+// MARK: binary_desc
+namespace Grafkit::Asset
+{
+} // namespace Grafkit::Asset
+
+// MARK: cook_desc
+namespace Grafkit::Resource
+{
+} // namespace Grafkit::Resource
+
+// MARK: image_desc
+namespace Grafkit::Resource
+{
+	void to_binary(Grafkit::Serialization::BinaryWriter &writer, const ImageDesc &obj);
+	void from_binary(Grafkit::Serialization::BinaryReader &reader, ImageDesc &obj);
+
+	void to_binary(Grafkit::Serialization::BinaryWriter &writer, const SolidImageDesc &obj);
+	void from_binary(Grafkit::Serialization::BinaryReader &reader, SolidImageDesc &obj);
+
+	void to_binary(Grafkit::Serialization::BinaryWriter &writer, const CheckerImageDesc &obj);
+	void from_binary(Grafkit::Serialization::BinaryReader &reader, CheckerImageDesc &obj);
+
+} // namespace Grafkit::Resource
+
+// MARK: material_desc
+namespace Grafkit::Resource
+{
+	void to_binary(Grafkit::Serialization::BinaryWriter &writer, const MaterialDesc &obj);
+	void from_binary(Grafkit::Serialization::BinaryReader &reader, MaterialDesc &obj);
+
+} // namespace Grafkit::Resource
+
+// MARK: mesh_desc
+namespace Grafkit::Resource
+{
+	void to_binary(Grafkit::Serialization::BinaryWriter &writer, const PrimitiveDesc &obj);
+	void from_binary(Grafkit::Serialization::BinaryReader &reader, PrimitiveDesc &obj);
+
+	void to_binary(Grafkit::Serialization::BinaryWriter &writer, const MeshDesc &obj);
+	void from_binary(Grafkit::Serialization::BinaryReader &reader, MeshDesc &obj);
+
+	void to_binary(Grafkit::Serialization::BinaryWriter &writer, const PrimitiveLodDesc &obj);
+	void from_binary(Grafkit::Serialization::BinaryReader &reader, PrimitiveLodDesc &obj);
+
+	void to_binary(Grafkit::Serialization::BinaryWriter &writer, const PrimitiveDescV2 &obj);
+	void from_binary(Grafkit::Serialization::BinaryReader &reader, PrimitiveDescV2 &obj);
+
+	void to_binary(Grafkit::Serialization::BinaryWriter &writer, const MeshDescV2 &obj);
+	void from_binary(Grafkit::Serialization::BinaryReader &reader, MeshDescV2 &obj);
+
+} // namespace Grafkit::Resource
+
+// MARK: pack_desc
+namespace Grafkit::Asset
+{
+} // namespace Grafkit::Asset
+
+// MARK: scene_desc
+namespace Grafkit::Resource
+{
+} // namespace Grafkit::Resource
+
+// NOLINTEND(readability-identifier-naming)
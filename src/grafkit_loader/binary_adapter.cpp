@@ -0,0 +1,24 @@
+#include "stdafx.h"
+
+#include "binary/binary_registry.h"
+#include "grafkit_loader/binary_adapter.h"
+
+Grafkit::Asset::BinaryAsset::BinaryAsset(std::vector<uint8_t> data)
+	: m_data(std::make_shared<BufferAssetData>(std::move(data)))
+{
+}
+
+Grafkit::Asset::BinaryAsset::BinaryAsset(AssetDataPtr data)
+	: m_data(std::move(data))
+{
+}
+
+void Grafkit::Asset::BinaryAsset::Deserialize(const std::type_index& assetType, void* object)
+{
+	Serialization::BinarySerializerRegistry::Instance().Deserialize(m_data->GetData(), assetType, object);
+}
+
+std::vector<uint8_t> Grafkit::Asset::BinaryAsset::Serialize(const std::type_index& assetType, const void* object)
+{
+	return Serialization::BinarySerializerRegistry::Instance().Serialize(assetType, object);
+}
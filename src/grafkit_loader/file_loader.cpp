@@ -4,15 +4,48 @@
 #include <fstream>
 
 #include <grafkit_loader/file_loader.h>
+#include <grafkit_loader/mapped_file.h>
 
-void Grafkit::Asset::FileAssetSource::ReadData(const std::string& assetName, std::vector<uint8_t>& data) const
+using Grafkit::Asset::FileAssetSource;
+
+void FileAssetSource::ReadData(const std::string& assetName, std::vector<uint8_t>& data) const
 {
-	std::filesystem::path assetPath = assetName;
+	ReadFile(assetName, data);
+}
 
-	std::ifstream file(assetPath, std::ios::binary);
-	if (!file.is_open()) {
+Grafkit::Asset::AssetDataPtr FileAssetSource::OpenData(const std::string& assetName) const
+{
+	const std::filesystem::path assetPath = assetName;
+
+	std::error_code error;
+	const auto fileSize = std::filesystem::file_size(assetPath, error);
+	if (error) {
 		throw std::runtime_error("File not found: " + assetPath.string());
 	}
 
-	std::copy(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>(), std::back_inserter(data));
+	if (GRAFKIT_HAS_MMAP && fileSize >= MAPPING_THRESHOLD) {
+		return std::make_shared<MappedFile>(assetPath);
+	}
+
+	std::vector<uint8_t> data;
+	ReadFile(assetPath, data);
+	return std::make_shared<BufferAssetData>(std::move(data));
+}
+
+void FileAssetSource::ReadFile(const std::filesystem::path& path, std::vector<uint8_t>& data)
+{
+	std::ifstream file(path, std::ios::binary | std::ios::ate);
+	if (!file.is_open()) {
+		throw std::runtime_error("File not found: " + path.string());
+	}
+
+	const std::streamsize size = file.tellg();
+	file.seekg(0, std::ios::beg);
+
+	// Append, the same way as the other asset sources do
+	const size_t offset = data.size();
+	data.resize(offset + static_cast<size_t>(size));
+	if (!file.read(reinterpret_cast<char*>(data.data() + offset), size)) {
+		throw std::runtime_error("Failed to read file: " + path.string());
+	}
 }
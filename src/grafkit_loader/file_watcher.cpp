@@ -0,0 +1,159 @@
+#include "stdafx.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+#include <grafkit/core/log.h>
+#include <grafkit_loader/file_watcher.h>
+
+#if GRAFKIT_HAS_INOTIFY
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+using Grafkit::Asset::FileWatcher;
+
+namespace {
+	std::string MakeName(const std::filesystem::path& directory, const std::filesystem::path& file)
+	{
+		return (directory / file).lexically_normal().generic_string();
+	}
+} // namespace
+
+#if GRAFKIT_HAS_INOTIFY
+
+namespace {
+	constexpr uint32_t FILE_EVENTS = IN_CLOSE_WRITE | IN_MOVED_TO;
+	constexpr uint32_t DIRECTORY_EVENTS = IN_CREATE | IN_MOVED_TO;
+} // namespace
+
+FileWatcher::FileWatcher()
+	: m_fd(inotify_init1(IN_NONBLOCK | IN_CLOEXEC))
+{
+	if (m_fd < 0) {
+		throw std::runtime_error("Failed to initialize inotify: " + std::string(std::strerror(errno)));
+	}
+}
+
+FileWatcher::~FileWatcher() { close(m_fd); }
+
+void FileWatcher::AddDirectory(const std::filesystem::path& directory)
+{
+	const int wd = inotify_add_watch(m_fd, directory.c_str(), FILE_EVENTS | DIRECTORY_EVENTS | IN_ONLYDIR);
+	if (wd < 0) {
+		throw std::runtime_error("Failed to watch directory: " + directory.string());
+	}
+	m_directories[wd] = directory;
+}
+
+std::vector<std::string> FileWatcher::Poll()
+{
+	std::vector<std::string> changes;
+	alignas(inotify_event) std::array<char, 4096> buffer {};
+
+	ssize_t length = 0;
+	while ((length = read(m_fd, buffer.data(), buffer.size())) > 0) {
+		for (ssize_t offset = 0; offset < length;) {
+			const auto* event = reinterpret_cast<const inotify_event*>(buffer.data() + offset);
+			offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+
+			if (event->mask & IN_Q_OVERFLOW) {
+				Grafkit::Core::Log::Instance().Warning("File watcher queue overflow, changes were lost");
+				continue;
+			}
+
+			const auto directory = m_directories.find(event->wd);
+			if (directory == m_directories.end() || event->len == 0) {
+				continue;
+			}
+
+			const std::filesystem::path path = directory->second / event->name;
+			if (event->mask & IN_ISDIR) {
+				// New subdirectories are watched as well, files already written into them are missed. One may be
+				// gone again by the time its event is read, that only loses its changes.
+				if (event->mask & DIRECTORY_EVENTS) {
+					try {
+						AddDirectory(path);
+					} catch (const std::exception& e) {
+						Grafkit::Core::Log::Instance().Warning("%s", e.what());
+					}
+				}
+			} else if (event->mask & FILE_EVENTS) {
+				changes.push_back(MakeName(directory->second, event->name));
+			}
+		}
+	}
+
+	// A file written several times between two polls is reported once
+	std::sort(changes.begin(), changes.end());
+	changes.erase(std::unique(changes.begin(), changes.end()), changes.end());
+	return changes;
+}
+
+#else
+
+FileWatcher::FileWatcher() = default;
+
+FileWatcher::~FileWatcher() = default;
+
+void FileWatcher::AddDirectory(const std::filesystem::path& directory)
+{
+	m_directories.push_back(directory);
+	for (const auto& entry : std::filesystem::recursive_directory_iterator(directory)) {
+		if (entry.is_regular_file()) {
+			m_modificationTimes[entry.path()] = entry.last_write_time();
+		}
+	}
+}
+
+std::vector<std::string> FileWatcher::Poll()
+{
+	std::vector<std::string> changes;
+
+	const auto now = std::chrono::steady_clock::now();
+	if (now - m_lastPoll < POLL_INTERVAL) {
+		return changes;
+	}
+	m_lastPoll = now;
+
+	for (const auto& directory : m_directories) {
+		std::error_code error;
+		for (const auto& entry : std::filesystem::recursive_directory_iterator(directory, error)) {
+			// Files removed while walking the tree are skipped, they show up as changes once they are back
+			if (!entry.is_regular_file(error)) {
+				continue;
+			}
+			const auto modificationTime = entry.last_write_time(error);
+			if (error) {
+				continue;
+			}
+			const auto [it, inserted] = m_modificationTimes.emplace(entry.path(), modificationTime);
+			if (inserted || it->second != modificationTime) {
+				it->second = modificationTime;
+				changes.push_back(MakeName(directory, entry.path().lexically_relative(directory)));
+			}
+		}
+	}
+	return changes;
+}
+
+#endif
+
+void FileWatcher::Watch(const std::filesystem::path& directory)
+{
+	if (!std::filesystem::is_directory(directory)) {
+		throw std::runtime_error("Not a directory: " + directory.string());
+	}
+
+#if GRAFKIT_HAS_INOTIFY
+	AddDirectory(directory);
+	for (const auto& entry : std::filesystem::recursive_directory_iterator(directory)) {
+		if (entry.is_directory()) {
+			AddDirectory(entry.path());
+		}
+	}
+#else
+	AddDirectory(directory);
+#endif
+}
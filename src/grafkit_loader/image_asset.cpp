@@ -0,0 +1,70 @@
+#include "stdafx.h"
+
+#include <limits>
+
+#include <stb_image.h>
+
+#include <grafkit/descriptors/image_desc.h>
+
+#include "grafkit_loader/image_asset.h"
+
+using Grafkit::Resource::ImageDesc;
+using Grafkit::Resource::ImageFormat;
+
+namespace {
+	using StbImagePtr = std::unique_ptr<void, decltype(&stbi_image_free)>;
+
+	void DecodeImage(const std::span<const uint8_t> data, ImageDesc& desc)
+	{
+		if (data.size() > static_cast<size_t>(std::numeric_limits<int>::max())) {
+			throw std::runtime_error("Image is too large to decode");
+		}
+		const auto* buffer = reinterpret_cast<const stbi_uc*>(data.data());
+		const int size = static_cast<int>(data.size());
+
+		int width = 0;
+		int height = 0;
+		int sourceChannels = 0;
+		if (stbi_info_from_memory(buffer, size, &width, &height, &sourceChannels) == 0) {
+			throw std::runtime_error(std::string("Failed to decode image: ") + stbi_failure_reason());
+		}
+
+		// Three channel formats are barely supported by GPUs, everything with color is read as RGBA
+		const bool isHdr = stbi_is_hdr_from_memory(buffer, size) != 0;
+		const int channels = sourceChannels == 1 && !isHdr ? 1 : 4;
+		const size_t channelSize = isHdr ? sizeof(float) : sizeof(stbi_uc);
+
+		void* decoded = isHdr
+			? static_cast<void*>(stbi_loadf_from_memory(buffer, size, &width, &height, nullptr, channels))
+			: static_cast<void*>(stbi_load_from_memory(buffer, size, &width, &height, nullptr, channels));
+		const StbImagePtr pixels(decoded, &stbi_image_free);
+		if (pixels == nullptr) {
+			throw std::runtime_error(std::string("Failed to decode image: ") + stbi_failure_reason());
+		}
+
+		const auto* first = static_cast<const uint8_t*>(pixels.get());
+		desc.image.assign(first, first + static_cast<size_t>(width) * height * channels * channelSize);
+		desc.size = { static_cast<uint32_t>(width), static_cast<uint32_t>(height), 1 };
+		desc.channels = static_cast<uint32_t>(channels);
+		desc.format = isHdr ? ImageFormat::RGBAFloat : (channels == 1 ? ImageFormat::Grayscale : ImageFormat::RGBA);
+	}
+} // namespace
+
+Grafkit::Asset::ImageAsset::ImageAsset(std::vector<uint8_t> data)
+	: m_data(std::make_shared<BufferAssetData>(std::move(data)))
+{
+}
+
+Grafkit::Asset::ImageAsset::ImageAsset(AssetDataPtr data)
+	: m_data(std::move(data))
+{
+}
+
+void Grafkit::Asset::ImageAsset::Deserialize(const std::type_index& assetType, void* object)
+{
+	if (assetType != typeid(ImageDesc)) {
+		throw std::runtime_error(std::string("Images can only be read as ImageDesc, not as ") + assetType.name());
+	}
+	// Fields not stored in the file, like useMipmap, keep their value
+	DecodeImage(m_data->GetData(), *static_cast<ImageDesc*>(object));
+}
@@ -4,18 +4,22 @@
  *
  * This file has been automatically generated and should not be modified.
  *
- * Generated at: 2025-03-26 12:50:25
+ * Generated at: 2026-10-19 18:20:32
  * Source files:
  *   - animation_desc.gen.yaml
+ *   - binary_desc.gen.yaml
+ *   - cook_desc.gen.yaml
  *   - image_desc.gen.yaml
  *   - material_desc.gen.yaml
  *   - mesh_desc.gen.yaml
+ *   - pack_desc.gen.yaml
  *   - scene_desc.gen.yaml
  * Template file: json_register.j2
  */
 
 #include "json_serializers.h"
 #include "json/json_registry.h"
+#include "json/json_sax.h"
 
 namespace Grafkit::Serialization
 {
@@ -24,35 +28,77 @@ namespace Grafkit::Serialization
 	{
 		// MARK: animation_desc
 
+		registry.Register<Grafkit::Resource::AnimationKeyDesc>([](const nlohmann::json &json, void *object)
+			{ json.get_to(*static_cast<Grafkit::Resource::AnimationKeyDesc *>(object)); });
+		registry.RegisterSax<Grafkit::Resource::AnimationKeyDesc>([](std::span<const uint8_t> data, void *object)
+			{ SaxReader::Read(data, *static_cast<Grafkit::Resource::AnimationKeyDesc *>(object)); });
+
+		registry.Register<Grafkit::Resource::AnimationChannelDesc>([](const nlohmann::json &json, void *object)
+			{ json.get_to(*static_cast<Grafkit::Resource::AnimationChannelDesc *>(object)); });
+		registry.RegisterSax<Grafkit::Resource::AnimationChannelDesc>([](std::span<const uint8_t> data, void *object)
+			{ SaxReader::Read(data, *static_cast<Grafkit::Resource::AnimationChannelDesc *>(object)); });
+
+		registry.Register<Grafkit::Resource::AnimationClipDesc>([](const nlohmann::json &json, void *object)
+			{ json.get_to(*static_cast<Grafkit::Resource::AnimationClipDesc *>(object)); });
+		registry.RegisterSax<Grafkit::Resource::AnimationClipDesc>([](std::span<const uint8_t> data, void *object)
+			{ SaxReader::Read(data, *static_cast<Grafkit::Resource::AnimationClipDesc *>(object)); });
+
+		// MARK: binary_desc
+
+		// MARK: cook_desc
+
 		// MARK: image_desc
 
-		registry.Register<Grafkit::Resource::ImageDesc>(
-			[](const nlohmann::json &json, std::any &object) { object = json.get<Grafkit::Resource::ImageDesc>(); });
+		registry.Register<Grafkit::Resource::ImageDesc>([](const nlohmann::json &json, void *object)
+			{ json.get_to(*static_cast<Grafkit::Resource::ImageDesc *>(object)); });
+		registry.RegisterSax<Grafkit::Resource::ImageDesc>([](std::span<const uint8_t> data, void *object)
+			{ SaxReader::Read(data, *static_cast<Grafkit::Resource::ImageDesc *>(object)); });
 
-		registry.Register<Grafkit::Resource::SolidImageDesc>([](const nlohmann::json &json, std::any &object)
-			{ object = json.get<Grafkit::Resource::SolidImageDesc>(); });
+		registry.Register<Grafkit::Resource::SolidImageDesc>([](const nlohmann::json &json, void *object)
+			{ json.get_to(*static_cast<Grafkit::Resource::SolidImageDesc *>(object)); });
+		registry.RegisterSax<Grafkit::Resource::SolidImageDesc>([](std::span<const uint8_t> data, void *object)
+			{ SaxReader::Read(data, *static_cast<Grafkit::Resource::SolidImageDesc *>(object)); });
 
-		registry.Register<Grafkit::Resource::CheckerImageDesc>([](const nlohmann::json &json, std::any &object)
-			{ object = json.get<Grafkit::Resource::CheckerImageDesc>(); });
+		registry.Register<Grafkit::Resource::CheckerImageDesc>([](const nlohmann::json &json, void *object)
+			{ json.get_to(*static_cast<Grafkit::Resource::CheckerImageDesc *>(object)); });
+		registry.RegisterSax<Grafkit::Resource::CheckerImageDesc>([](std::span<const uint8_t> data, void *object)
+			{ SaxReader::Read(data, *static_cast<Grafkit::Resource::CheckerImageDesc *>(object)); });
 
 		// MARK: material_desc
 
-		registry.Register<Grafkit::Resource::MaterialDesc>(
-			[](const nlohmann::json &json, std::any &object) { object = json.get<Grafkit::Resource::MaterialDesc>(); });
+		registry.Register<Grafkit::Resource::MaterialDesc>([](const nlohmann::json &json, void *object)
+			{ json.get_to(*static_cast<Grafkit::Resource::MaterialDesc *>(object)); });
+		registry.RegisterSax<Grafkit::Resource::MaterialDesc>([](std::span<const uint8_t> data, void *object)
+			{ SaxReader::Read(data, *static_cast<Grafkit::Resource::MaterialDesc *>(object)); });
 
 		// MARK: mesh_desc
 
-		registry.Register<Grafkit::Resource::PrimitiveDesc>([](const nlohmann::json &json, std::any &object)
-			{ object = json.get<Grafkit::Resource::PrimitiveDesc>(); });
+		registry.Register<Grafkit::Resource::PrimitiveDesc>([](const nlohmann::json &json, void *object)
+			{ json.get_to(*static_cast<Grafkit::Resource::PrimitiveDesc *>(object)); });
+		registry.RegisterSax<Grafkit::Resource::PrimitiveDesc>([](std::span<const uint8_t> data, void *object)
+			{ SaxReader::Read(data, *static_cast<Grafkit::Resource::PrimitiveDesc *>(object)); });
+
+		registry.Register<Grafkit::Resource::MeshDesc>([](const nlohmann::json &json, void *object)
+			{ json.get_to(*static_cast<Grafkit::Resource::MeshDesc *>(object)); });
+		registry.RegisterSax<Grafkit::Resource::MeshDesc>([](std::span<const uint8_t> data, void *object)
+			{ SaxReader::Read(data, *static_cast<Grafkit::Resource::MeshDesc *>(object)); });
+
+		registry.Register<Grafkit::Resource::PrimitiveLodDesc>([](const nlohmann::json &json, void *object)
+			{ json.get_to(*static_cast<Grafkit::Resource::PrimitiveLodDesc *>(object)); });
+		registry.RegisterSax<Grafkit::Resource::PrimitiveLodDesc>([](std::span<const uint8_t> data, void *object)
+			{ SaxReader::Read(data, *static_cast<Grafkit::Resource::PrimitiveLodDesc *>(object)); });
 
-		registry.Register<Grafkit::Resource::MeshDesc>(
-			[](const nlohmann::json &json, std::any &object) { object = json.get<Grafkit::Resource::MeshDesc>(); });
+		registry.Register<Grafkit::Resource::PrimitiveDescV2>([](const nlohmann::json &json, void *object)
+			{ json.get_to(*static_cast<Grafkit::Resource::PrimitiveDescV2 *>(object)); });
+		registry.RegisterSax<Grafkit::Resource::PrimitiveDescV2>([](std::span<const uint8_t> data, void *object)
+			{ SaxReader::Read(data, *static_cast<Grafkit::Resource::PrimitiveDescV2 *>(object)); });
 
-		registry.Register<Grafkit::Resource::PrimitiveDescV2>([](const nlohmann::json &json, std::any &object)
-			{ object = json.get<Grafkit::Resource::PrimitiveDescV2>(); });
+		registry.Register<Grafkit::Resource::MeshDescV2>([](const nlohmann::json &json, void *object)
+			{ json.get_to(*static_cast<Grafkit::Resource::MeshDescV2 *>(object)); });
+		registry.RegisterSax<Grafkit::Resource::MeshDescV2>([](std::span<const uint8_t> data, void *object)
+			{ SaxReader::Read(data, *static_cast<Grafkit::Resource::MeshDescV2 *>(object)); });
 
-		registry.Register<Grafkit::Resource::MeshDescV2>(
-			[](const nlohmann::json &json, std::any &object) { object = json.get<Grafkit::Resource::MeshDescV2>(); });
+		// MARK: pack_desc
 
 		// MARK: scene_desc
 	}
@@ -4,12 +4,15 @@
  *
  * This file has been automatically generated and should not be modified.
  *
- * Generated at: 2025-03-26 12:50:25
+ * Generated at: 2026-10-19 18:20:32
  * Source files:
  *   - animation_desc.gen.yaml
+ *   - binary_desc.gen.yaml
+ *   - cook_desc.gen.yaml
  *   - image_desc.gen.yaml
  *   - material_desc.gen.yaml
  *   - mesh_desc.gen.yaml
+ *   - pack_desc.gen.yaml
  *   - scene_desc.gen.yaml
  * Template file: json_template.j2
  */
@@ -24,11 +27,132 @@
 
 #include "json/generated/json_serializers.h"
 #include "json/json_glm.h"
+#include "json/json_registry.h"
+#include "json/json_sax.h"
 
 // NOLINTBEGIN(readability-identifier-naming) The naming has to match with nlohmann_json
 
 // MARK: animation_desc
 namespace Grafkit::Resource
+{
+	void to_json(nlohmann::json &j, const AnimationKeyDesc &obj)
+	{
+		j["time"] = obj.time;
+		j["interpolation"] = obj.interpolation;
+		j["value"] = obj.value;
+	}
+
+	void from_json(const nlohmann::json &j, AnimationKeyDesc &obj)
+	{
+		Grafkit::Serialization::ReadField(j, "time", obj.time);
+		Grafkit::Serialization::ReadField(j, "interpolation", obj.interpolation);
+		Grafkit::Serialization::ReadField(j, "value", obj.value);
+	}
+
+	void from_json_field(Grafkit::Serialization::SaxReader &reader, AnimationKeyDesc &obj, const std::string_view key)
+	{
+		if (key == "time")
+		{
+			reader.Expect(obj.time);
+		}
+		else if (key == "interpolation")
+		{
+			reader.Expect(obj.interpolation);
+		}
+		else if (key == "value")
+		{
+			reader.Expect(obj.value);
+		}
+		else
+		{
+			reader.Skip();
+		}
+	}
+
+	void to_json(nlohmann::json &j, const AnimationChannelDesc &obj)
+	{
+		j["id"] = obj.id;
+		j["target"] = obj.target;
+		j["keys"] = obj.keys;
+	}
+
+	void from_json(const nlohmann::json &j, AnimationChannelDesc &obj)
+	{
+		Grafkit::Serialization::ReadField(j, "id", obj.id);
+		Grafkit::Serialization::ReadField(j, "target", obj.target);
+		Grafkit::Serialization::ReadField(j, "keys", obj.keys);
+	}
+
+	void from_json_field(Grafkit::Serialization::SaxReader &reader,
+		AnimationChannelDesc &obj,
+		const std::string_view key)
+	{
+		if (key == "id")
+		{
+			reader.Expect(obj.id);
+		}
+		else if (key == "target")
+		{
+			reader.Expect(obj.target);
+		}
+		else if (key == "keys")
+		{
+			reader.Expect(obj.keys);
+		}
+		else
+		{
+			reader.Skip();
+		}
+	}
+
+	void to_json(nlohmann::json &j, const AnimationClipDesc &obj)
+	{
+		j["name"] = obj.name;
+		j["duration"] = obj.duration;
+		j["isLooping"] = obj.isLooping;
+		j["channels"] = obj.channels;
+	}
+
+	void from_json(const nlohmann::json &j, AnimationClipDesc &obj)
+	{
+		Grafkit::Serialization::ReadField(j, "name", obj.name);
+		Grafkit::Serialization::ReadField(j, "duration", obj.duration);
+		Grafkit::Serialization::ReadField(j, "isLooping", obj.isLooping);
+		Grafkit::Serialization::ReadField(j, "channels", obj.channels);
+	}
+
+	void from_json_field(Grafkit::Serialization::SaxReader &reader, AnimationClipDesc &obj, const std::string_view key)
+	{
+		if (key == "name")
+		{
+			reader.Expect(obj.name);
+		}
+		else if (key == "duration")
+		{
+			reader.Expect(obj.duration);
+		}
+		else if (key == "isLooping")
+		{
+			reader.Expect(obj.isLooping);
+		}
+		else if (key == "channels")
+		{
+			reader.Expect(obj.channels);
+		}
+		else
+		{
+			reader.Skip();
+		}
+	}
+} // namespace Grafkit::Resource
+
+// MARK: binary_desc
+namespace Grafkit::Asset
+{
+} // namespace Grafkit::Asset
+
+// MARK: cook_desc
+namespace Grafkit::Resource
 {
 } // namespace Grafkit::Resource
 
@@ -46,11 +170,39 @@ namespace Grafkit::Resource
 
 	void from_json(const nlohmann::json &j, ImageDesc &obj)
 	{
-		obj.image = j["image"].get<std::vector<uint8_t>>();
-		obj.size = j["size"].get<glm::uvec3>();
-		obj.format = j["format"].get<ImageFormat>();
-		obj.channels = j["channels"].get<uint32_t>();
-		obj.useMipmap = j["useMipmap"].get<bool>();
+		Grafkit::Serialization::ReadField(j, "image", obj.image);
+		Grafkit::Serialization::ReadField(j, "size", obj.size);
+		Grafkit::Serialization::ReadField(j, "format", obj.format);
+		Grafkit::Serialization::ReadField(j, "channels", obj.channels);
+		Grafkit::Serialization::ReadField(j, "useMipmap", obj.useMipmap);
+	}
+
+	void from_json_field(Grafkit::Serialization::SaxReader &reader, ImageDesc &obj, const std::string_view key)
+	{
+		if (key == "image")
+		{
+			reader.Expect(obj.image);
+		}
+		else if (key == "size")
+		{
+			reader.Expect(obj.size);
+		}
+		else if (key == "format")
+		{
+			reader.Expect(obj.format);
+		}
+		else if (key == "channels")
+		{
+			reader.Expect(obj.channels);
+		}
+		else if (key == "useMipmap")
+		{
+			reader.Expect(obj.useMipmap);
+		}
+		else
+		{
+			reader.Skip();
+		}
 	}
 
 	void to_json(nlohmann::json &j, const SolidImageDesc &obj)
@@ -60,7 +212,19 @@ namespace Grafkit::Resource
 
 	void from_json(const nlohmann::json &j, SolidImageDesc &obj)
 	{
-		obj.color = j["color"].get<glm::u8vec4>();
+		Grafkit::Serialization::ReadField(j, "color", obj.color);
+	}
+
+	void from_json_field(Grafkit::Serialization::SaxReader &reader, SolidImageDesc &obj, const std::string_view key)
+	{
+		if (key == "color")
+		{
+			reader.Expect(obj.color);
+		}
+		else
+		{
+			reader.Skip();
+		}
 	}
 
 	void to_json(nlohmann::json &j, const CheckerImageDesc &obj)
@@ -74,11 +238,39 @@ namespace Grafkit::Resource
 
 	void from_json(const nlohmann::json &j, CheckerImageDesc &obj)
 	{
-		obj.size = j["size"].get<glm::uvec3>();
-		obj.divisions = j["divisions"].get<glm::uvec2>();
-		obj.color1 = j["color1"].get<glm::u8vec4>();
-		obj.color2 = j["color2"].get<glm::u8vec4>();
-		obj.useMipmap = j["useMipmap"].get<bool>();
+		Grafkit::Serialization::ReadField(j, "size", obj.size);
+		Grafkit::Serialization::ReadField(j, "divisions", obj.divisions);
+		Grafkit::Serialization::ReadField(j, "color1", obj.color1);
+		Grafkit::Serialization::ReadField(j, "color2", obj.color2);
+		Grafkit::Serialization::ReadField(j, "useMipmap", obj.useMipmap);
+	}
+
+	void from_json_field(Grafkit::Serialization::SaxReader &reader, CheckerImageDesc &obj, const std::string_view key)
+	{
+		if (key == "size")
+		{
+			reader.Expect(obj.size);
+		}
+		else if (key == "divisions")
+		{
+			reader.Expect(obj.divisions);
+		}
+		else if (key == "color1")
+		{
+			reader.Expect(obj.color1);
+		}
+		else if (key == "color2")
+		{
+			reader.Expect(obj.color2);
+		}
+		else if (key == "useMipmap")
+		{
+			reader.Expect(obj.useMipmap);
+		}
+		else
+		{
+			reader.Skip();
+		}
 	}
 } // namespace Grafkit::Resource
 
@@ -95,10 +287,34 @@ namespace Grafkit::Resource
 
 	void from_json(const nlohmann::json &j, MaterialDesc &obj)
 	{
-		obj.name = j["name"].get<std::string>();
-		obj.type = j["type"].get<uint32_t>();
-		obj.stage = j["stage"].get<std::string>();
-		obj.textures = j["textures"].get<std::map<TextureType, std::string>>();
+		Grafkit::Serialization::ReadField(j, "name", obj.name);
+		Grafkit::Serialization::ReadField(j, "type", obj.type);
+		Grafkit::Serialization::ReadField(j, "stage", obj.stage);
+		Grafkit::Serialization::ReadField(j, "textures", obj.textures);
+	}
+
+	void from_json_field(Grafkit::Serialization::SaxReader &reader, MaterialDesc &obj, const std::string_view key)
+	{
+		if (key == "name")
+		{
+			reader.Expect(obj.name);
+		}
+		else if (key == "type")
+		{
+			reader.Expect(obj.type);
+		}
+		else if (key == "stage")
+		{
+			reader.Expect(obj.stage);
+		}
+		else if (key == "textures")
+		{
+			reader.Expect(obj.textures);
+		}
+		else
+		{
+			reader.Skip();
+		}
 	}
 } // namespace Grafkit::Resource
 
@@ -118,13 +334,49 @@ namespace Grafkit::Resource
 
 	void from_json(const nlohmann::json &j, PrimitiveDesc &obj)
 	{
-		obj.positions = j["positions"].get<std::vector<glm::vec3>>();
-		obj.normals = j["normals"].get<std::vector<glm::vec3>>();
-		obj.tangents = j["tangents"].get<std::vector<glm::vec3>>();
-		obj.bitangents = j["bitangents"].get<std::vector<glm::vec3>>();
-		obj.texCoords = j["texCoords"].get<std::vector<glm::vec2>>();
-		obj.indices = j["indices"].get<std::vector<uint32_t>>();
-		obj.materialIndex = j["materialIndex"].get<uint32_t>();
+		Grafkit::Serialization::ReadField(j, "positions", obj.positions);
+		Grafkit::Serialization::ReadField(j, "normals", obj.normals);
+		Grafkit::Serialization::ReadField(j, "tangents", obj.tangents);
+		Grafkit::Serialization::ReadField(j, "bitangents", obj.bitangents);
+		Grafkit::Serialization::ReadField(j, "texCoords", obj.texCoords);
+		Grafkit::Serialization::ReadField(j, "indices", obj.indices);
+		Grafkit::Serialization::ReadField(j, "materialIndex", obj.materialIndex);
+	}
+
+	void from_json_field(Grafkit::Serialization::SaxReader &reader, PrimitiveDesc &obj, const std::string_view key)
+	{
+		if (key == "positions")
+		{
+			reader.Expect(obj.positions);
+		}
+		else if (key == "normals")
+		{
+			reader.Expect(obj.normals);
+		}
+		else if (key == "tangents")
+		{
+			reader.Expect(obj.tangents);
+		}
+		else if (key == "bitangents")
+		{
+			reader.Expect(obj.bitangents);
+		}
+		else if (key == "texCoords")
+		{
+			reader.Expect(obj.texCoords);
+		}
+		else if (key == "indices")
+		{
+			reader.Expect(obj.indices);
+		}
+		else if (key == "materialIndex")
+		{
+			reader.Expect(obj.materialIndex);
+		}
+		else
+		{
+			reader.Skip();
+		}
 	}
 
 	void to_json(nlohmann::json &j, const MeshDesc &obj)
@@ -137,10 +389,68 @@ namespace Grafkit::Resource
 
 	void from_json(const nlohmann::json &j, MeshDesc &obj)
 	{
-		obj.name = j["name"].get<std::string>();
-		obj.primitives = j["primitives"].get<std::vector<PrimitiveDesc>>();
-		obj.materials = j["materials"].get<std::map<std::string, uint32_t>>();
-		obj.type = j["type"].get<MeshType>();
+		Grafkit::Serialization::ReadField(j, "name", obj.name);
+		Grafkit::Serialization::ReadField(j, "primitives", obj.primitives);
+		Grafkit::Serialization::ReadField(j, "materials", obj.materials);
+		Grafkit::Serialization::ReadField(j, "type", obj.type);
+	}
+
+	void from_json_field(Grafkit::Serialization::SaxReader &reader, MeshDesc &obj, const std::string_view key)
+	{
+		if (key == "name")
+		{
+			reader.Expect(obj.name);
+		}
+		else if (key == "primitives")
+		{
+			reader.Expect(obj.primitives);
+		}
+		else if (key == "materials")
+		{
+			reader.Expect(obj.materials);
+		}
+		else if (key == "type")
+		{
+			reader.Expect(obj.type);
+		}
+		else
+		{
+			reader.Skip();
+		}
+	}
+
+	void to_json(nlohmann::json &j, const PrimitiveLodDesc &obj)
+	{
+		j["indexOffset"] = obj.indexOffset;
+		j["indexCount"] = obj.indexCount;
+		j["error"] = obj.error;
+	}
+
+	void from_json(const nlohmann::json &j, PrimitiveLodDesc &obj)
+	{
+		Grafkit::Serialization::ReadField(j, "indexOffset", obj.indexOffset);
+		Grafkit::Serialization::ReadField(j, "indexCount", obj.indexCount);
+		Grafkit::Serialization::ReadField(j, "error", obj.error);
+	}
+
+	void from_json_field(Grafkit::Serialization::SaxReader &reader, PrimitiveLodDesc &obj, const std::string_view key)
+	{
+		if (key == "indexOffset")
+		{
+			reader.Expect(obj.indexOffset);
+		}
+		else if (key == "indexCount")
+		{
+			reader.Expect(obj.indexCount);
+		}
+		else if (key == "error")
+		{
+			reader.Expect(obj.error);
+		}
+		else
+		{
+			reader.Skip();
+		}
 	}
 
 	void to_json(nlohmann::json &j, const PrimitiveDescV2 &obj)
@@ -150,15 +460,49 @@ namespace Grafkit::Resource
 		j["vertexOffset"] = obj.vertexOffset;
 		j["vertexCount"] = obj.vertexCount;
 		j["materialIndex"] = obj.materialIndex;
+		j["lods"] = obj.lods;
 	}
 
 	void from_json(const nlohmann::json &j, PrimitiveDescV2 &obj)
 	{
-		obj.indexOffset = j["indexOffset"].get<uint32_t>();
-		obj.indexCount = j["indexCount"].get<uint32_t>();
-		obj.vertexOffset = j["vertexOffset"].get<uint32_t>();
-		obj.vertexCount = j["vertexCount"].get<uint32_t>();
-		obj.materialIndex = j["materialIndex"].get<uint32_t>();
+		Grafkit::Serialization::ReadField(j, "indexOffset", obj.indexOffset);
+		Grafkit::Serialization::ReadField(j, "indexCount", obj.indexCount);
+		Grafkit::Serialization::ReadField(j, "vertexOffset", obj.vertexOffset);
+		Grafkit::Serialization::ReadField(j, "vertexCount", obj.vertexCount);
+		Grafkit::Serialization::ReadField(j, "materialIndex", obj.materialIndex);
+		Grafkit::Serialization::ReadField(j, "lods", obj.lods);
+	}
+
+	void from_json_field(Grafkit::Serialization::SaxReader &reader, PrimitiveDescV2 &obj, const std::string_view key)
+	{
+		if (key == "indexOffset")
+		{
+			reader.Expect(obj.indexOffset);
+		}
+		else if (key == "indexCount")
+		{
+			reader.Expect(obj.indexCount);
+		}
+		else if (key == "vertexOffset")
+		{
+			reader.Expect(obj.vertexOffset);
+		}
+		else if (key == "vertexCount")
+		{
+			reader.Expect(obj.vertexCount);
+		}
+		else if (key == "materialIndex")
+		{
+			reader.Expect(obj.materialIndex);
+		}
+		else if (key == "lods")
+		{
+			reader.Expect(obj.lods);
+		}
+		else
+		{
+			reader.Skip();
+		}
 	}
 
 	void to_json(nlohmann::json &j, const MeshDescV2 &obj)
@@ -177,19 +521,72 @@ namespace Grafkit::Resource
 
 	void from_json(const nlohmann::json &j, MeshDescV2 &obj)
 	{
-		obj.name = j["name"].get<std::string>();
-		obj.positions = j["positions"].get<std::vector<glm::vec3>>();
-		obj.normals = j["normals"].get<std::vector<glm::vec3>>();
-		obj.tangents = j["tangents"].get<std::vector<glm::vec3>>();
-		obj.bitangents = j["bitangents"].get<std::vector<glm::vec3>>();
-		obj.texCoords = j["texCoords"].get<std::vector<glm::vec2>>();
-		obj.indices = j["indices"].get<std::vector<uint32_t>>();
-		obj.primitives = j["primitives"].get<std::vector<PrimitiveDescV2>>();
-		obj.materials = j["materials"].get<std::map<std::string, uint32_t>>();
-		obj.type = j["type"].get<MeshType>();
+		Grafkit::Serialization::ReadField(j, "name", obj.name);
+		Grafkit::Serialization::ReadField(j, "positions", obj.positions);
+		Grafkit::Serialization::ReadField(j, "normals", obj.normals);
+		Grafkit::Serialization::ReadField(j, "tangents", obj.tangents);
+		Grafkit::Serialization::ReadField(j, "bitangents", obj.bitangents);
+		Grafkit::Serialization::ReadField(j, "texCoords", obj.texCoords);
+		Grafkit::Serialization::ReadField(j, "indices", obj.indices);
+		Grafkit::Serialization::ReadField(j, "primitives", obj.primitives);
+		Grafkit::Serialization::ReadField(j, "materials", obj.materials);
+		Grafkit::Serialization::ReadField(j, "type", obj.type);
+	}
+
+	void from_json_field(Grafkit::Serialization::SaxReader &reader, MeshDescV2 &obj, const std::string_view key)
+	{
+		if (key == "name")
+		{
+			reader.Expect(obj.name);
+		}
+		else if (key == "positions")
+		{
+			reader.Expect(obj.positions);
+		}
+		else if (key == "normals")
+		{
+			reader.Expect(obj.normals);
+		}
+		else if (key == "tangents")
+		{
+			reader.Expect(obj.tangents);
+		}
+		else if (key == "bitangents")
+		{
+			reader.Expect(obj.bitangents);
+		}
+		else if (key == "texCoords")
+		{
+			reader.Expect(obj.texCoords);
+		}
+		else if (key == "indices")
+		{
+			reader.Expect(obj.indices);
+		}
+		else if (key == "primitives")
+		{
+			reader.Expect(obj.primitives);
+		}
+		else if (key == "materials")
+		{
+			reader.Expect(obj.materials);
+		}
+		else if (key == "type")
+		{
+			reader.Expect(obj.type);
+		}
+		else
+		{
+			reader.Skip();
+		}
 	}
 } // namespace Grafkit::Resource
 
+// MARK: pack_desc
+namespace Grafkit::Asset
+{
+} // namespace Grafkit::Asset
+
 // MARK: scene_desc
 namespace Grafkit::Resource
 {
@@ -4,12 +4,15 @@
  *
  * This file has been automatically generated and should not be modified.
  *
- * Generated at: 2025-03-26 12:50:25
+ * Generated at: 2026-10-19 18:20:32
  * Source files:
  *   - animation_desc.gen.yaml
+ *   - binary_desc.gen.yaml
+ *   - cook_desc.gen.yaml
  *   - image_desc.gen.yaml
  *   - material_desc.gen.yaml
  *   - mesh_desc.gen.yaml
+ *   - pack_desc.gen.yaml
  *   - scene_desc.gen.yaml
  * Template file: json_header.j2
  */
@@ -22,29 +25,57 @@
 #include <vector>
 
 #include "json/json_glm.h"
+#include "json/json_sax.h"
 #include <grafkit/descriptors/animation_desc.h>
+#include <grafkit/descriptors/binary_desc.h>
+#include <grafkit/descriptors/cook_desc.h>
 #include <grafkit/descriptors/image_desc.h>
 #include <grafkit/descriptors/material_desc.h>
 #include <grafkit/descriptors/mesh_desc.h>
+#include <grafkit/descriptors/pack_desc.h>
 #include <grafkit/descriptors/scene_desc.h>
 
 // MARK: animation_desc
 namespace Grafkit::Resource
 {
+	void to_json(nlohmann::json &j, const AnimationKeyDesc &obj);
+	void from_json(const nlohmann::json &j, AnimationKeyDesc &obj);
+	void from_json_field(Grafkit::Serialization::SaxReader &reader, AnimationKeyDesc &obj, std::string_view key);
+
+	void to_json(nlohmann::json &j, const AnimationChannelDesc &obj);
+	void from_json(const nlohmann::json &j, AnimationChannelDesc &obj);
+	void from_json_field(Grafkit::Serialization::SaxReader &reader, AnimationChannelDesc &obj, std::string_view key);
+
+	void to_json(nlohmann::json &j, const AnimationClipDesc &obj);
+	void from_json(const nlohmann::json &j, AnimationClipDesc &obj);
+	void from_json_field(Grafkit::Serialization::SaxReader &reader, AnimationClipDesc &obj, std::string_view key);
 
 } // namespace Grafkit::Resource
 
+// MARK: binary_desc
+namespace Grafkit::Asset
+{
+} // namespace Grafkit::Asset
+
+// MARK: cook_desc
+namespace Grafkit::Resource
+{
+} // namespace Grafkit::Resource
+
 // MARK: image_desc
 namespace Grafkit::Resource
 {
 	void to_json(nlohmann::json &j, const ImageDesc &obj);
 	void from_json(const nlohmann::json &j, ImageDesc &obj);
+	void from_json_field(Grafkit::Serialization::SaxReader &reader, ImageDesc &obj, std::string_view key);
 
 	void to_json(nlohmann::json &j, const SolidImageDesc &obj);
 	void from_json(const nlohmann::json &j, SolidImageDesc &obj);
+	void from_json_field(Grafkit::Serialization::SaxReader &reader, SolidImageDesc &obj, std::string_view key);
 
 	void to_json(nlohmann::json &j, const CheckerImageDesc &obj);
 	void from_json(const nlohmann::json &j, CheckerImageDesc &obj);
+	void from_json_field(Grafkit::Serialization::SaxReader &reader, CheckerImageDesc &obj, std::string_view key);
 
 } // namespace Grafkit::Resource
 
@@ -53,6 +84,7 @@ namespace Grafkit::Resource
 {
 	void to_json(nlohmann::json &j, const MaterialDesc &obj);
 	void from_json(const nlohmann::json &j, MaterialDesc &obj);
+	void from_json_field(Grafkit::Serialization::SaxReader &reader, MaterialDesc &obj, std::string_view key);
 
 } // namespace Grafkit::Resource
 
@@ -61,18 +93,31 @@ namespace Grafkit::Resource
 {
 	void to_json(nlohmann::json &j, const PrimitiveDesc &obj);
 	void from_json(const nlohmann::json &j, PrimitiveDesc &obj);
+	void from_json_field(Grafkit::Serialization::SaxReader &reader, PrimitiveDesc &obj, std::string_view key);
 
 	void to_json(nlohmann::json &j, const MeshDesc &obj);
 	void from_json(const nlohmann::json &j, MeshDesc &obj);
+	void from_json_field(Grafkit::Serialization::SaxReader &reader, MeshDesc &obj, std::string_view key);
+
+	void to_json(nlohmann::json &j, const PrimitiveLodDesc &obj);
+	void from_json(const nlohmann::json &j, PrimitiveLodDesc &obj);
+	void from_json_field(Grafkit::Serialization::SaxReader &reader, PrimitiveLodDesc &obj, std::string_view key);
 
 	void to_json(nlohmann::json &j, const PrimitiveDescV2 &obj);
 	void from_json(const nlohmann::json &j, PrimitiveDescV2 &obj);
+	void from_json_field(Grafkit::Serialization::SaxReader &reader, PrimitiveDescV2 &obj, std::string_view key);
 
 	void to_json(nlohmann::json &j, const MeshDescV2 &obj);
 	void from_json(const nlohmann::json &j, MeshDescV2 &obj);
+	void from_json_field(Grafkit::Serialization::SaxReader &reader, MeshDescV2 &obj, std::string_view key);
 
 } // namespace Grafkit::Resource
 
+// MARK: pack_desc
+namespace Grafkit::Asset
+{
+} // namespace Grafkit::Asset
+
 // MARK: scene_desc
 namespace Grafkit::Resource
 {
@@ -12,7 +12,12 @@ void JsonSerializerRegistry::Register(std::type_index type, DeserializerFunc des
 	m_deserializers[type.name()] = std::move(deserializer);
 }
 
-void JsonSerializerRegistry::Deserialize(const nlohmann::json& json, std::type_index type, std::any& object)
+void JsonSerializerRegistry::RegisterSax(std::type_index type, SaxDeserializerFunc deserializer)
+{
+	m_saxDeserializers[type.name()] = std::move(deserializer);
+}
+
+void JsonSerializerRegistry::Deserialize(const nlohmann::json& json, std::type_index type, void* object)
 {
 	auto it = m_deserializers.find(type.name());
 	if (it != m_deserializers.end()) {
@@ -21,3 +26,13 @@ void JsonSerializerRegistry::Deserialize(const nlohmann::json& json, std::type_i
 		throw std::runtime_error(std::string("No deserializer found for type: ") + type.name());
 	}
 }
+
+void JsonSerializerRegistry::Deserialize(const std::span<const uint8_t> data, std::type_index type, void* object)
+{
+	auto it = m_saxDeserializers.find(type.name());
+	if (it != m_saxDeserializers.end()) {
+		it->second(data, object);
+	} else {
+		Deserialize(nlohmann::json::parse(data.begin(), data.end()), type, object);
+	}
+}
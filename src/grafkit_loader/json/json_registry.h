@@ -1,8 +1,8 @@
 #ifndef JSON_DESERIALIZER_H
 #define JSON_DESERIALIZER_H
 
-#include <any>
 #include <functional>
+#include <span>
 #include <typeindex>
 #include <unordered_map>
 #include <vector>
@@ -10,7 +10,19 @@
 #include <nlohmann/json.hpp>
 
 namespace Grafkit::Serialization {
-	using DeserializerFunc = std::function<void(const nlohmann::json&, std::any&)>;
+	// Deserializes into an existing object of the registered type
+	using DeserializerFunc = std::function<void(const nlohmann::json&, void*)>;
+	// Deserializes straight from the raw json text, without building a DOM
+	using SaxDeserializerFunc = std::function<void(std::span<const uint8_t>, void*)>;
+
+	// Reads a field in place, missing fields keep their default value
+	template <typename T> void ReadField(const nlohmann::json& json, const char* name, T& value)
+	{
+		const auto it = json.find(name);
+		if (it != json.end()) {
+			it->get_to(value);
+		}
+	}
 
 	class JsonSerializerRegistry {
 	public:
@@ -28,18 +40,28 @@ namespace Grafkit::Serialization {
 		}
 		void Register(std::type_index type, DeserializerFunc deserializer);
 
-		template <typename T> void Deserialize(const nlohmann::json& json, std::any& object)
+		template <typename T> void RegisterSax(SaxDeserializerFunc deserializer)
+		{
+			RegisterSax(typeid(T), std::move(deserializer));
+		}
+		void RegisterSax(std::type_index type, SaxDeserializerFunc deserializer);
+
+		template <typename T> void Deserialize(const nlohmann::json& json, T& object)
 		{
-			Deserialize(json, typeid(T), object);
+			Deserialize(json, typeid(T), &object);
 		}
 
-		void Deserialize(const nlohmann::json& json, std::type_index type, std::any& object);
+		void Deserialize(const nlohmann::json& json, std::type_index type, void* object);
+
+		// Streams the text into the object if the type has a SAX reader, parses it into a DOM otherwise
+		void Deserialize(std::span<const uint8_t> data, std::type_index type, void* object);
 
 	private:
 		JsonSerializerRegistry();
 		~JsonSerializerRegistry() = default;
 
 		std::unordered_map<std::string, DeserializerFunc> m_deserializers;
+		std::unordered_map<std::string, SaxDeserializerFunc> m_saxDeserializers;
 	};
 
 } // namespace Grafkit::Serialization
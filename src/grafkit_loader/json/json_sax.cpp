@@ -0,0 +1,309 @@
+#include "stdafx.h"
+
+#include <iterator>
+
+#include "json_sax.h"
+
+using namespace Grafkit::Serialization;
+
+namespace {
+	// Lets the reader know where the parser is, to count array elements ahead
+	class TrackingIterator {
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = char;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const char*;
+		using reference = const char&;
+
+		TrackingIterator(const char* current, const char** position)
+			: m_current(current)
+			, m_position(position)
+		{
+		}
+
+		reference operator*() const { return *m_current; }
+
+		TrackingIterator& operator++()
+		{
+			*m_position = ++m_current;
+			return *this;
+		}
+
+		TrackingIterator operator++(int)
+		{
+			TrackingIterator result = *this;
+			++*this;
+			return result;
+		}
+
+		bool operator==(const TrackingIterator& other) const { return m_current == other.m_current; }
+		bool operator!=(const TrackingIterator& other) const { return m_current != other.m_current; }
+
+	private:
+		const char* m_current;
+		const char** m_position;
+	};
+
+	[[noreturn]] void ThrowUnexpected(const char* token)
+	{
+		throw std::runtime_error(std::string("Unexpected JSON ") + token);
+	}
+} // namespace
+
+// MARK: Handler defaults
+
+bool SaxHandler::Scalar(
+	[[maybe_unused]] SaxReader& reader, [[maybe_unused]] SaxFrame& frame, [[maybe_unused]] SaxScalar& value) const
+{
+	ThrowUnexpected("scalar value");
+}
+
+bool SaxHandler::StartObject([[maybe_unused]] SaxReader& reader, [[maybe_unused]] SaxFrame& frame) const
+{
+	ThrowUnexpected("object");
+}
+
+bool SaxHandler::Key(
+	[[maybe_unused]] SaxReader& reader, [[maybe_unused]] SaxFrame& frame, [[maybe_unused]] std::string& key) const
+{
+	ThrowUnexpected("object key");
+}
+
+bool SaxHandler::EndObject([[maybe_unused]] SaxReader& reader, [[maybe_unused]] SaxFrame& frame) const
+{
+	ThrowUnexpected("end of object");
+}
+
+bool SaxHandler::StartArray([[maybe_unused]] SaxReader& reader, [[maybe_unused]] SaxFrame& frame) const
+{
+	ThrowUnexpected("array");
+}
+
+bool SaxHandler::EndArray([[maybe_unused]] SaxReader& reader, [[maybe_unused]] SaxFrame& frame) const
+{
+	ThrowUnexpected("end of array");
+}
+
+// MARK: Handlers
+
+bool SaxStringHandler::Scalar(SaxReader& reader, SaxFrame& frame, SaxScalar& value) const
+{
+	if (value.kind != SaxScalar::Kind::String) {
+		throw std::runtime_error("Unexpected JSON value, expected a string");
+	}
+	*static_cast<std::string*>(frame.object) = std::move(*value.string);
+	reader.Pop();
+	return true;
+}
+
+// Index is the nesting depth of the skipped value
+bool SaxSkipHandler::Scalar(SaxReader& reader, SaxFrame& frame, [[maybe_unused]] SaxScalar& value) const
+{
+	if (frame.index == 0) {
+		reader.Pop();
+	}
+	return true;
+}
+
+bool SaxSkipHandler::StartObject([[maybe_unused]] SaxReader& reader, SaxFrame& frame) const
+{
+	++frame.index;
+	return true;
+}
+
+bool SaxSkipHandler::Key(
+	[[maybe_unused]] SaxReader& reader, [[maybe_unused]] SaxFrame& frame, [[maybe_unused]] std::string& key) const
+{
+	return true;
+}
+
+bool SaxSkipHandler::EndObject(SaxReader& reader, SaxFrame& frame) const
+{
+	if (--frame.index == 0) {
+		reader.Pop();
+	}
+	return true;
+}
+
+bool SaxSkipHandler::StartArray(SaxReader& reader, SaxFrame& frame) const { return StartObject(reader, frame); }
+
+bool SaxSkipHandler::EndArray(SaxReader& reader, SaxFrame& frame) const { return EndObject(reader, frame); }
+
+// Index is the column being read, state the row within it plus one, zero between the columns
+bool SaxMat4Handler::Scalar(SaxReader& reader, SaxFrame& frame, SaxScalar& value) const
+{
+	if (frame.state == 0 || frame.state > 4) {
+		return SaxHandler::Scalar(reader, frame, value);
+	}
+	auto& matrix = *static_cast<glm::mat4*>(frame.object);
+	matrix[static_cast<int>(frame.index - 1)][static_cast<int>(frame.state - 1)] = ConvertSaxScalar<float>(value);
+	++frame.state;
+	return true;
+}
+
+bool SaxMat4Handler::StartArray(SaxReader& reader, SaxFrame& frame) const
+{
+	if (!frame.isOpen) {
+		frame.isOpen = true;
+		return true;
+	}
+	if (frame.state != 0 || frame.index >= 4) {
+		return SaxHandler::StartArray(reader, frame);
+	}
+	++frame.index;
+	frame.state = 1;
+	return true;
+}
+
+bool SaxMat4Handler::EndArray(SaxReader& reader, SaxFrame& frame) const
+{
+	if (frame.state == 0) {
+		reader.Pop();
+	} else {
+		frame.state = 0;
+	}
+	return true;
+}
+
+// MARK: Reader
+
+void SaxReader::Skip() { Push(SAX_HANDLER_INSTANCE<SaxSkipHandler>, nullptr); }
+
+void SaxReader::Push(const SaxHandler& handler, void* object) { m_frames.push_back({ &handler, object }); }
+
+void SaxReader::Parse(const std::span<const uint8_t> data)
+{
+	const auto* begin = reinterpret_cast<const char*>(data.data());
+	m_position = begin;
+	m_end = begin + data.size();
+	m_frames.reserve(16);
+
+	nlohmann::json::sax_parse(TrackingIterator(begin, &m_position), TrackingIterator(m_end, &m_position), this);
+
+	if (!m_frames.empty()) {
+		throw std::runtime_error("Unexpected end of JSON document");
+	}
+}
+
+size_t SaxReader::CountArrayElements() const
+{
+	if (m_elementCount != static_cast<size_t>(-1)) {
+		return m_elementCount;
+	}
+
+	// Commas on the top level of the array; strings are skipped, so commas in them do not count
+	size_t count = 0;
+	size_t depth = 0;
+	bool isEmpty = true;
+	for (const char* it = m_position; it < m_end; ++it) {
+		switch (*it) {
+		case '"':
+			for (++it; it < m_end && *it != '"'; ++it) {
+				it += *it == '\\' ? 1 : 0;
+			}
+			break;
+		case '[':
+		case '{':
+			++depth;
+			break;
+		case ']':
+		case '}':
+			if (depth-- == 0) {
+				return isEmpty ? 0 : count + 1;
+			}
+			break;
+		case ',':
+			count += depth == 0 ? 1 : 0;
+			break;
+		case ' ':
+		case '\t':
+		case '\r':
+		case '\n':
+			continue;
+		default:
+			break;
+		}
+		isEmpty = false;
+	}
+	return 0;
+}
+
+bool SaxReader::DispatchScalar(SaxScalar& value)
+{
+	return Dispatch([this, &value](const SaxHandler& handler, SaxFrame& frame) {
+		return handler.Scalar(*this, frame, value);
+	});
+}
+
+bool SaxReader::null()
+{
+	SaxScalar value {};
+	return DispatchScalar(value);
+}
+
+bool SaxReader::boolean(const bool val)
+{
+	SaxScalar value { .kind = SaxScalar::Kind::Boolean, .boolean = val };
+	return DispatchScalar(value);
+}
+
+bool SaxReader::number_integer(const number_integer_t val)
+{
+	SaxScalar value { .kind = SaxScalar::Kind::Integer, .integer = val };
+	return DispatchScalar(value);
+}
+
+bool SaxReader::number_unsigned(const number_unsigned_t val)
+{
+	SaxScalar value { .kind = SaxScalar::Kind::Unsigned, .unsignedInteger = val };
+	return DispatchScalar(value);
+}
+
+bool SaxReader::number_float(const number_float_t val, [[maybe_unused]] const string_t& s)
+{
+	SaxScalar value { .kind = SaxScalar::Kind::Float, .number = val };
+	return DispatchScalar(value);
+}
+
+bool SaxReader::string(string_t& val)
+{
+	SaxScalar value { .kind = SaxScalar::Kind::String, .string = &val };
+	return DispatchScalar(value);
+}
+
+bool SaxReader::binary([[maybe_unused]] binary_t& val) { ThrowUnexpected("binary value"); }
+
+bool SaxReader::start_object([[maybe_unused]] const std::size_t elements)
+{
+	return Dispatch([this](const SaxHandler& handler, SaxFrame& frame) { return handler.StartObject(*this, frame); });
+}
+
+bool SaxReader::key(string_t& val)
+{
+	return Dispatch(
+		[this, &val](const SaxHandler& handler, SaxFrame& frame) { return handler.Key(*this, frame, val); });
+}
+
+bool SaxReader::end_object()
+{
+	return Dispatch([this](const SaxHandler& handler, SaxFrame& frame) { return handler.EndObject(*this, frame); });
+}
+
+bool SaxReader::start_array(const std::size_t elements)
+{
+	m_elementCount = elements;
+	return Dispatch([this](const SaxHandler& handler, SaxFrame& frame) { return handler.StartArray(*this, frame); });
+}
+
+bool SaxReader::end_array()
+{
+	return Dispatch([this](const SaxHandler& handler, SaxFrame& frame) { return handler.EndArray(*this, frame); });
+}
+
+bool SaxReader::parse_error([[maybe_unused]] const std::size_t position,
+	[[maybe_unused]] const std::string& lastToken,
+	const nlohmann::detail::exception& ex)
+{
+	throw std::runtime_error(std::string("JSON parse error: ") + ex.what());
+}
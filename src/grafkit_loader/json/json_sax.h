@@ -0,0 +1,437 @@
+#ifndef JSON_SAX_H
+#define JSON_SAX_H
+
+#include <map>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <nlohmann/json.hpp>
+
+namespace Grafkit::Serialization {
+	class SaxReader;
+
+	// Scalar token of the stream; the string can be moved from
+	struct SaxScalar {
+		enum class Kind { Null, Boolean, Integer, Unsigned, Float, String };
+
+		Kind kind = Kind::Null;
+		bool boolean = false;
+		int64_t integer = 0;
+		uint64_t unsignedInteger = 0;
+		double number = 0.0;
+		std::string* string = nullptr;
+	};
+
+	// State of a value being read, owned by the reader
+	struct SaxFrame {
+		const class SaxHandler* handler = nullptr;
+		void* object = nullptr;
+		uint64_t state = 0;
+		uint32_t index = 0;
+		bool isOpen = false; // Inside the object or array of the value
+	};
+
+	/**
+	 * @brief Token handlers of a value type
+	 *
+	 * Handlers are stateless, everything they need is in the frame. Returning false hands the token over to
+	 * the frame pushed meanwhile, that is how containers pass their elements on. Pushing a frame invalidates
+	 * the frame reference, it must not be touched afterwards. The defaults reject the token.
+	 */
+	class SaxHandler {
+	public:
+		virtual ~SaxHandler() = default;
+
+		virtual bool Scalar(SaxReader& reader, SaxFrame& frame, SaxScalar& value) const;
+		virtual bool StartObject(SaxReader& reader, SaxFrame& frame) const;
+		virtual bool Key(SaxReader& reader, SaxFrame& frame, std::string& key) const;
+		virtual bool EndObject(SaxReader& reader, SaxFrame& frame) const;
+		virtual bool StartArray(SaxReader& reader, SaxFrame& frame) const;
+		virtual bool EndArray(SaxReader& reader, SaxFrame& frame) const;
+	};
+
+	template <typename T> const SaxHandler& GetSaxHandler();
+
+	/**
+	 * @brief Fills objects straight from the token stream, without building a json DOM
+	 * Generated types provide from_json_field(), the rest is covered by the handlers below.
+	 */
+	class SaxReader final : public nlohmann::json_sax<nlohmann::json> {
+	public:
+		template <typename T> static void Read(std::span<const uint8_t> data, T& object)
+		{
+			SaxReader reader;
+			reader.Expect(object);
+			reader.Parse(data);
+		}
+
+		// The next value of the stream is read into the given one
+		template <typename T> void Expect(T& value) { Push(GetSaxHandler<T>(), &value); }
+		// The next value of the stream is ignored
+		void Skip();
+
+		void Push(const SaxHandler& handler, void* object);
+		void Pop() { m_frames.pop_back(); }
+
+		// Number of elements of the array just started, counted ahead in the raw text
+		[[nodiscard]] size_t CountArrayElements() const;
+
+		// MARK: json_sax
+		bool null() override;
+		bool boolean(bool val) override;
+		bool number_integer(number_integer_t val) override;
+		bool number_unsigned(number_unsigned_t val) override;
+		bool number_float(number_float_t val, const string_t& s) override;
+		bool string(string_t& val) override;
+		bool binary(binary_t& val) override;
+		bool start_object(std::size_t elements) override;
+		bool key(string_t& val) override;
+		bool end_object() override;
+		bool start_array(std::size_t elements) override;
+		bool end_array() override;
+		bool parse_error(
+			std::size_t position, const std::string& lastToken, const nlohmann::detail::exception& ex) override;
+
+	private:
+		SaxReader() = default;
+
+		void Parse(std::span<const uint8_t> data);
+
+		template <typename FuncT> bool Dispatch(FuncT&& func)
+		{
+			if (m_frames.empty()) {
+				throw std::runtime_error("Unexpected JSON value after the end of the document");
+			}
+			while (!func(*m_frames.back().handler, m_frames.back())) { }
+			return true;
+		}
+
+		bool DispatchScalar(SaxScalar& value);
+
+		std::vector<SaxFrame> m_frames;
+		const char* m_position = nullptr; // Parser position, right after the last token
+		const char* m_end = nullptr;
+		size_t m_elementCount = static_cast<size_t>(-1); // Element count of the last array, if the format knows it
+	};
+
+	// MARK: Handlers
+
+	template <typename T> T ConvertSaxScalar(const SaxScalar& value)
+	{
+		using ValueType = std::conditional_t<std::is_enum_v<T>, std::underlying_type<T>, std::type_identity<T>>::type;
+		if constexpr (std::is_same_v<T, bool>) {
+			if (value.kind == SaxScalar::Kind::Boolean) {
+				return value.boolean;
+			}
+		} else {
+			switch (value.kind) {
+			case SaxScalar::Kind::Integer:
+				return static_cast<T>(static_cast<ValueType>(value.integer));
+			case SaxScalar::Kind::Unsigned:
+				return static_cast<T>(static_cast<ValueType>(value.unsignedInteger));
+			case SaxScalar::Kind::Float:
+				return static_cast<T>(static_cast<ValueType>(value.number));
+			case SaxScalar::Kind::Boolean:
+				return static_cast<T>(static_cast<ValueType>(value.boolean));
+			default:
+				break;
+			}
+		}
+		throw std::runtime_error("Unexpected JSON value, expected a number");
+	}
+
+	template <typename T> constexpr bool IS_SAX_SCALAR = std::is_arithmetic_v<T> || std::is_enum_v<T>;
+
+	template <typename T> class SaxScalarHandler final : public SaxHandler {
+	public:
+		bool Scalar(SaxReader& reader, SaxFrame& frame, SaxScalar& value) const override
+		{
+			*static_cast<T*>(frame.object) = ConvertSaxScalar<T>(value);
+			reader.Pop();
+			return true;
+		}
+	};
+
+	class SaxStringHandler final : public SaxHandler {
+	public:
+		bool Scalar(SaxReader& reader, SaxFrame& frame, SaxScalar& value) const override;
+	};
+
+	// Ignores a whole value, whatever it is
+	class SaxSkipHandler final : public SaxHandler {
+	public:
+		bool Scalar(SaxReader& reader, SaxFrame& frame, SaxScalar& value) const override;
+		bool StartObject(SaxReader& reader, SaxFrame& frame) const override;
+		bool Key(SaxReader& reader, SaxFrame& frame, std::string& key) const override;
+		bool EndObject(SaxReader& reader, SaxFrame& frame) const override;
+		bool StartArray(SaxReader& reader, SaxFrame& frame) const override;
+		bool EndArray(SaxReader& reader, SaxFrame& frame) const override;
+	};
+
+	// Elements without nested containers, worth counting ahead to reserve the vector
+	template <typename T> struct IsSaxFlatElement : std::bool_constant<IS_SAX_SCALAR<T>> { };
+	template <glm::length_t N, typename T, glm::qualifier Q>
+	struct IsSaxFlatElement<glm::vec<N, T, Q>> : std::true_type { };
+
+	template <typename T> class SaxVectorHandler final : public SaxHandler {
+	public:
+		static_assert(!std::is_same_v<T, bool>, "std::vector<bool> elements can not be read in place");
+
+		bool Scalar(SaxReader& reader, SaxFrame& frame, SaxScalar& value) const override
+		{
+			if (!frame.isOpen) {
+				return SaxHandler::Scalar(reader, frame, value);
+			}
+			// Scalars are appended right away, without a frame of their own
+			if constexpr (IS_SAX_SCALAR<T>) {
+				static_cast<std::vector<T>*>(frame.object)->push_back(ConvertSaxScalar<T>(value));
+				return true;
+			} else {
+				return PushElement(reader, frame);
+			}
+		}
+
+		bool StartObject(SaxReader& reader, SaxFrame& frame) const override
+		{
+			return frame.isOpen ? PushElement(reader, frame) : SaxHandler::StartObject(reader, frame);
+		}
+
+		bool StartArray(SaxReader& reader, SaxFrame& frame) const override
+		{
+			if (frame.isOpen) {
+				return PushElement(reader, frame);
+			}
+
+			frame.isOpen = true;
+			auto& vector = *static_cast<std::vector<T>*>(frame.object);
+			vector.clear(); // Keeps the capacity of a vector read into before
+			if constexpr (IsSaxFlatElement<T>::value) {
+				vector.reserve(reader.CountArrayElements());
+			}
+			return true;
+		}
+
+		bool EndArray(SaxReader& reader, [[maybe_unused]] SaxFrame& frame) const override
+		{
+			reader.Pop();
+			return true;
+		}
+
+	private:
+		static bool PushElement(SaxReader& reader, const SaxFrame& frame)
+		{
+			reader.Expect(static_cast<std::vector<T>*>(frame.object)->emplace_back());
+			return false;
+		}
+	};
+
+	// Maps with string keys are objects
+	template <typename T> class SaxStringMapHandler final : public SaxHandler {
+	public:
+		bool StartObject([[maybe_unused]] SaxReader& reader, SaxFrame& frame) const override
+		{
+			if (frame.isOpen) {
+				return SaxHandler::StartObject(reader, frame);
+			}
+			frame.isOpen = true;
+			static_cast<T*>(frame.object)->clear();
+			return true;
+		}
+
+		bool Key(SaxReader& reader, SaxFrame& frame, std::string& key) const override
+		{
+			reader.Expect((*static_cast<T*>(frame.object))[std::move(key)]);
+			return true;
+		}
+
+		bool EndObject(SaxReader& reader, [[maybe_unused]] SaxFrame& frame) const override
+		{
+			reader.Pop();
+			return true;
+		}
+	};
+
+	// Maps with other keys are arrays of [key, value] pairs, like nlohmann_json writes them
+	template <typename T> class SaxPairMapHandler final : public SaxHandler {
+	public:
+		using KeyType = typename T::key_type;
+		static_assert(IS_SAX_SCALAR<KeyType>, "Map keys have to be strings, numbers or enums");
+
+		bool Scalar(SaxReader& reader, SaxFrame& frame, SaxScalar& value) const override
+		{
+			// Index 1 is the key of the current pair, index 2 its value
+			if (frame.index == 1) {
+				frame.state = static_cast<uint64_t>(ConvertSaxScalar<KeyType>(value));
+				frame.index = 2;
+				return true;
+			}
+			if (frame.index == 2) {
+				return PushValue(reader, frame);
+			}
+			return SaxHandler::Scalar(reader, frame, value);
+		}
+
+		bool StartObject(SaxReader& reader, SaxFrame& frame) const override
+		{
+			return frame.index == 2 ? PushValue(reader, frame) : SaxHandler::StartObject(reader, frame);
+		}
+
+		bool StartArray(SaxReader& reader, SaxFrame& frame) const override
+		{
+			if (!frame.isOpen) {
+				frame.isOpen = true;
+				static_cast<T*>(frame.object)->clear();
+				return true;
+			}
+			if (frame.index == 0) {
+				frame.index = 1;
+				return true;
+			}
+			return frame.index == 2 ? PushValue(reader, frame) : SaxHandler::StartArray(reader, frame);
+		}
+
+		bool EndArray(SaxReader& reader, SaxFrame& frame) const override
+		{
+			if (frame.index == 0) {
+				reader.Pop();
+			} else if (frame.index == 3) {
+				frame.index = 0;
+			} else {
+				throw std::runtime_error("Unexpected end of JSON array, expected a [key, value] pair");
+			}
+			return true;
+		}
+
+	private:
+		static bool PushValue(SaxReader& reader, SaxFrame& frame)
+		{
+			auto& map = *static_cast<T*>(frame.object);
+			const auto key = static_cast<KeyType>(frame.state);
+			frame.index = 3;
+			reader.Expect(map[key]);
+			return false;
+		}
+	};
+
+	template <typename T> class SaxGlmVectorHandler final : public SaxHandler {
+	public:
+		bool StartObject(SaxReader& reader, SaxFrame& frame) const override
+		{
+			if (frame.isOpen) {
+				return SaxHandler::StartObject(reader, frame);
+			}
+			frame.isOpen = true;
+			return true;
+		}
+
+		bool Key(SaxReader& reader, SaxFrame& frame, std::string& key) const override
+		{
+			auto& vector = *static_cast<T*>(frame.object);
+			const int component = key.size() == 1 ? ComponentIndex(key[0]) : -1;
+			if (component >= 0 && component < vector.length()) {
+				reader.Expect(vector[component]);
+			} else {
+				reader.Skip();
+			}
+			return true;
+		}
+
+		bool EndObject(SaxReader& reader, [[maybe_unused]] SaxFrame& frame) const override
+		{
+			reader.Pop();
+			return true;
+		}
+
+	private:
+		static int ComponentIndex(const char name)
+		{
+			switch (name) {
+			case 'x':
+				return 0;
+			case 'y':
+				return 1;
+			case 'z':
+				return 2;
+			case 'w':
+				return 3;
+			default:
+				return -1;
+			}
+		}
+	};
+
+	// Matrices are arrays of columns, each an array of floats
+	class SaxMat4Handler final : public SaxHandler {
+	public:
+		bool Scalar(SaxReader& reader, SaxFrame& frame, SaxScalar& value) const override;
+		bool StartArray(SaxReader& reader, SaxFrame& frame) const override;
+		bool EndArray(SaxReader& reader, SaxFrame& frame) const override;
+	};
+
+	// Generated types, see from_json_field() in json_serializers.h
+	template <typename T> class SaxObjectHandler final : public SaxHandler {
+	public:
+		bool StartObject(SaxReader& reader, SaxFrame& frame) const override
+		{
+			if (frame.isOpen) {
+				return SaxHandler::StartObject(reader, frame);
+			}
+			frame.isOpen = true;
+			return true;
+		}
+
+		bool Key(SaxReader& reader, SaxFrame& frame, std::string& key) const override
+		{
+			from_json_field(reader, *static_cast<T*>(frame.object), key);
+			return true;
+		}
+
+		bool EndObject(SaxReader& reader, [[maybe_unused]] SaxFrame& frame) const override
+		{
+			reader.Pop();
+			return true;
+		}
+	};
+
+	template <typename T> struct IsStdVector : std::false_type { };
+	template <typename T, typename A> struct IsStdVector<std::vector<T, A>> : std::true_type { };
+
+	template <typename T> struct IsStdMap : std::false_type { };
+	template <typename K, typename V, typename C, typename A>
+	struct IsStdMap<std::map<K, V, C, A>> : std::true_type { };
+
+	template <typename T> struct IsGlmVector : std::false_type { };
+	template <glm::length_t N, typename T, glm::qualifier Q> struct IsGlmVector<glm::vec<N, T, Q>> : std::true_type { };
+
+	template <typename HandlerT> inline const HandlerT SAX_HANDLER_INSTANCE {};
+
+	template <typename T> const SaxHandler& GetSaxHandler()
+	{
+		if constexpr (IS_SAX_SCALAR<T>) {
+			return SAX_HANDLER_INSTANCE<SaxScalarHandler<T>>;
+		} else if constexpr (std::is_same_v<T, std::string>) {
+			return SAX_HANDLER_INSTANCE<SaxStringHandler>;
+		} else if constexpr (IsStdVector<T>::value) {
+			return SAX_HANDLER_INSTANCE<SaxVectorHandler<typename T::value_type>>;
+		} else if constexpr (IsStdMap<T>::value) {
+			if constexpr (std::is_same_v<typename T::key_type, std::string>) {
+				return SAX_HANDLER_INSTANCE<SaxStringMapHandler<T>>;
+			} else {
+				return SAX_HANDLER_INSTANCE<SaxPairMapHandler<T>>;
+			}
+		} else if constexpr (IsGlmVector<T>::value) {
+			return SAX_HANDLER_INSTANCE<SaxGlmVectorHandler<T>>;
+		} else if constexpr (std::is_same_v<T, glm::mat4>) {
+			return SAX_HANDLER_INSTANCE<SaxMat4Handler>;
+		} else {
+			return SAX_HANDLER_INSTANCE<SaxObjectHandler<T>>;
+		}
+	}
+
+} // namespace Grafkit::Serialization
+
+#endif // JSON_SAX_H
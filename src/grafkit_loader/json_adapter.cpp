@@ -4,17 +4,16 @@
 #include "json/json_registry.h"
 
 Grafkit::Asset::JsonAsset::JsonAsset(std::vector<uint8_t> data)
-	: m_data(std::move(data))
+	: m_data(std::make_shared<BufferAssetData>(std::move(data)))
 {
 }
 
-void Grafkit::Asset::JsonAsset::Deserialize(const std::type_index& assetType, std::any& object)
+Grafkit::Asset::JsonAsset::JsonAsset(AssetDataPtr data)
+	: m_data(std::move(data))
 {
-	nlohmann::json json = nlohmann::json::parse(m_data);
-	Serialization::JsonSerializerRegistry::Instance().Deserialize(json, assetType, object);
 }
 
-void Grafkit::Asset::JsonAsset::ReadData(std::vector<uint8_t>& data) const
+void Grafkit::Asset::JsonAsset::Deserialize(const std::type_index& assetType, void* object)
 {
-	std::copy(m_data.begin(), m_data.end(), std::back_inserter(data));
+	Serialization::JsonSerializerRegistry::Instance().Deserialize(m_data->GetData(), assetType, object);
 }
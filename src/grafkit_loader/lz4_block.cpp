@@ -0,0 +1,73 @@
+#include "stdafx.h"
+
+#include "lz4_block.h"
+
+namespace {
+	constexpr size_t MIN_MATCH = 4;
+
+	size_t ReadLength(const std::span<const uint8_t> source, size_t& pos, size_t length)
+	{
+		if (length != 15) {
+			return length;
+		}
+		uint8_t value = 0;
+		do {
+			if (pos >= source.size()) {
+				throw std::runtime_error("LZ4 block is truncated");
+			}
+			value = source[pos++];
+			length += value;
+		} while (value == 255);
+		return length;
+	}
+} // namespace
+
+void Grafkit::Asset::Lz4::DecompressBlock(const std::span<const uint8_t> source, const std::span<uint8_t> target)
+{
+	size_t sourcePos = 0;
+	size_t targetPos = 0;
+
+	while (sourcePos < source.size()) {
+		const uint8_t token = source[sourcePos++];
+
+		const size_t literalLength = ReadLength(source, sourcePos, token >> 4);
+		if (literalLength > source.size() - sourcePos || literalLength > target.size() - targetPos) {
+			throw std::runtime_error("LZ4 literals out of bounds");
+		}
+		std::memcpy(target.data() + targetPos, source.data() + sourcePos, literalLength);
+		sourcePos += literalLength;
+		targetPos += literalLength;
+
+		// The last sequence has literals only
+		if (sourcePos == source.size()) {
+			break;
+		}
+
+		if (source.size() - sourcePos < 2) {
+			throw std::runtime_error("LZ4 block is truncated");
+		}
+		const size_t offset = source[sourcePos] | (static_cast<size_t>(source[sourcePos + 1]) << 8);
+		sourcePos += 2;
+
+		const size_t matchLength = ReadLength(source, sourcePos, token & 0x0F) + MIN_MATCH;
+		if (offset == 0 || offset > targetPos || matchLength > target.size() - targetPos) {
+			throw std::runtime_error("LZ4 match out of bounds");
+		}
+
+		// Matches may overlap their own output, which repeats the pattern, so copy forward
+		const uint8_t* match = target.data() + targetPos - offset;
+		uint8_t* out = target.data() + targetPos;
+		if (offset >= matchLength) {
+			std::memcpy(out, match, matchLength);
+		} else {
+			for (size_t i = 0; i < matchLength; ++i) {
+				out[i] = match[i];
+			}
+		}
+		targetPos += matchLength;
+	}
+
+	if (targetPos != target.size()) {
+		throw std::runtime_error("LZ4 block size mismatch");
+	}
+}
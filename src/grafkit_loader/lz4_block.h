@@ -0,0 +1,16 @@
+#ifndef GRAFKIT_LOADER_LZ4_BLOCK_H
+#define GRAFKIT_LOADER_LZ4_BLOCK_H
+
+#include <cstdint>
+#include <span>
+
+namespace Grafkit::Asset::Lz4 {
+	/**
+	 * @brief Decodes a raw LZ4 block (no frame header)
+	 * The target has to be exactly the uncompressed size. Throws on malformed input.
+	 */
+	void DecompressBlock(std::span<const uint8_t> source, std::span<uint8_t> target);
+
+} // namespace Grafkit::Asset::Lz4
+
+#endif // GRAFKIT_LOADER_LZ4_BLOCK_H
@@ -0,0 +1,123 @@
+#include "stdafx.h"
+
+#include <grafkit_loader/file_loader.h>
+#include <grafkit_loader/mapped_file.h>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#elif GRAFKIT_HAS_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using Grafkit::Asset::MappedFile;
+
+#if defined(_WIN32)
+
+MappedFile::MappedFile(const std::filesystem::path& path)
+{
+	HANDLE file = CreateFileW(path.c_str(),
+		GENERIC_READ,
+		FILE_SHARE_READ,
+		nullptr,
+		OPEN_EXISTING,
+		FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+		nullptr);
+	if (file == INVALID_HANDLE_VALUE) {
+		throw std::runtime_error("File not found: " + path.string());
+	}
+	m_file = file;
+
+	LARGE_INTEGER size {};
+	if (!GetFileSizeEx(file, &size)) {
+		CloseHandle(file);
+		throw std::runtime_error("Failed to get file size: " + path.string());
+	}
+	m_size = static_cast<size_t>(size.QuadPart);
+
+	// Empty files cannot be mapped
+	if (m_size == 0) {
+		return;
+	}
+
+	HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (mapping == nullptr) {
+		CloseHandle(file);
+		throw std::runtime_error("Failed to map file: " + path.string());
+	}
+	m_mapping = mapping;
+
+	m_data = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+	if (m_data == nullptr) {
+		CloseHandle(mapping);
+		CloseHandle(file);
+		throw std::runtime_error("Failed to map file: " + path.string());
+	}
+}
+
+MappedFile::~MappedFile()
+{
+	if (m_data != nullptr) {
+		UnmapViewOfFile(m_data);
+	}
+	if (m_mapping != nullptr) {
+		CloseHandle(m_mapping);
+	}
+	if (m_file != nullptr) {
+		CloseHandle(m_file);
+	}
+}
+
+#elif GRAFKIT_HAS_MMAP
+
+MappedFile::MappedFile(const std::filesystem::path& path)
+{
+	const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+	if (fd < 0) {
+		throw std::runtime_error("File not found: " + path.string());
+	}
+
+	struct stat fileStat {};
+	if (fstat(fd, &fileStat) != 0) {
+		close(fd);
+		throw std::runtime_error("Failed to get file size: " + path.string());
+	}
+	m_size = static_cast<size_t>(fileStat.st_size);
+
+	// Empty files cannot be mapped
+	if (m_size != 0) {
+		void* data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (data == MAP_FAILED) {
+			close(fd);
+			throw std::runtime_error("Failed to map file: " + path.string());
+		}
+		m_data = static_cast<const uint8_t*>(data);
+	}
+
+	// The mapping keeps the file referenced
+	close(fd);
+}
+
+MappedFile::~MappedFile()
+{
+	if (m_data != nullptr) {
+		munmap(const_cast<uint8_t*>(m_data), m_size); // NOLINT munmap takes a non-const pointer
+	}
+}
+
+#else
+
+MappedFile::MappedFile(const std::filesystem::path& path)
+{
+	FileAssetSource::ReadFile(path, m_buffer);
+	m_data = m_buffer.data();
+	m_size = m_buffer.size();
+}
+
+MappedFile::~MappedFile() = default;
+
+#endif
@@ -0,0 +1,224 @@
+#include "stdafx.h"
+
+#include <grafkit_loader/mapped_file.h>
+#include <grafkit_loader/pack_source.h>
+
+#include "lz4_block.h"
+
+using Grafkit::Asset::PackAssetSource;
+using Grafkit::Asset::PackFile;
+
+namespace {
+	constexpr uint64_t FNV_OFFSET_BASIS = 0xCBF29CE484222325ull;
+	constexpr uint64_t FNV_PRIME = 0x100000001B3ull;
+
+	class PackEntryData final : public Grafkit::Asset::IAssetData {
+	public:
+		PackEntryData(Grafkit::Asset::PackFilePtr pack, const std::span<const uint8_t> data)
+			: m_pack(std::move(pack))
+			, m_data(data)
+		{
+		}
+
+		[[nodiscard]] std::span<const uint8_t> GetData() const override { return m_data; }
+
+	private:
+		Grafkit::Asset::PackFilePtr m_pack; // Keeps the mapping alive
+		std::span<const uint8_t> m_data;
+	};
+
+	void CheckRange(const std::span<const uint8_t> data, const uint64_t offset, const uint64_t size, const char* what)
+	{
+		if (offset > data.size() || size > data.size() - offset) {
+			throw std::runtime_error(std::string("Pack ") + what + " is out of bounds");
+		}
+	}
+
+	std::string_view StripCurrentDirectory(std::string_view name)
+	{
+		while (name.starts_with("./") || name.starts_with(".\\")) {
+			name.remove_prefix(2);
+		}
+		return name;
+	}
+
+	// Stored names are normalized by the packer, the looked up one may still use backslashes
+	bool IsSameAssetName(const std::string_view storedName, std::string_view name)
+	{
+		name = StripCurrentDirectory(name);
+		return std::ranges::equal(
+			storedName, name, [](const char a, const char b) { return a == (b == '\\' ? '/' : b); });
+	}
+} // namespace
+
+uint64_t Grafkit::Asset::HashAssetName(std::string_view name)
+{
+	name = StripCurrentDirectory(name);
+
+	uint64_t hash = FNV_OFFSET_BASIS;
+	for (const char c : name) {
+		hash ^= static_cast<uint8_t>(c == '\\' ? '/' : c);
+		hash *= FNV_PRIME;
+	}
+	return hash;
+}
+
+// MARK: Pack file
+
+PackFile::PackFile(const std::filesystem::path& path)
+	: m_file(std::make_unique<MappedFile>(path))
+{
+	const std::span<const uint8_t> data = m_file->GetData();
+	if (data.size() < sizeof(PackHeader)) {
+		throw std::runtime_error("Pack is truncated: " + path.string());
+	}
+
+	m_header = reinterpret_cast<const PackHeader*>(data.data());
+	if (m_header->magic != PACK_MAGIC) {
+		throw std::runtime_error("Not a pack file: " + path.string());
+	}
+	if (m_header->version != PACK_VERSION) {
+		throw std::runtime_error("Unsupported pack version: " + path.string());
+	}
+	if (m_header->blockSize == 0) {
+		throw std::runtime_error("Pack block size is zero: " + path.string());
+	}
+
+	CheckRange(data, m_header->entryTableOffset, m_header->entryCount * sizeof(PackEntry), "entry table");
+	m_entries = {reinterpret_cast<const PackEntry*>(data.data() + m_header->entryTableOffset), m_header->entryCount};
+
+	CheckRange(data, m_header->stringTableOffset, m_header->stringTableSize, "string table");
+	m_strings = {reinterpret_cast<const char*>(data.data() + m_header->stringTableOffset),
+		static_cast<size_t>(m_header->stringTableSize)};
+
+	// Block table runs up to the string table
+	if (m_header->blockTableOffset > m_header->stringTableOffset) {
+		throw std::runtime_error("Pack block table is out of bounds");
+	}
+	if (m_header->blockTableOffset % alignof(uint32_t) != 0) {
+		throw std::runtime_error("Pack block table is misaligned");
+	}
+	m_blocks = {reinterpret_cast<const uint32_t*>(data.data() + m_header->blockTableOffset),
+		static_cast<size_t>((m_header->stringTableOffset - m_header->blockTableOffset) / sizeof(uint32_t))};
+
+	for (const auto& entry : m_entries) {
+		CheckRange(data, entry.dataOffset, entry.storedSize, "entry");
+		// Uncompressed entries are copied as they are stored
+		if ((entry.flags & PACK_ENTRY_COMPRESSED) == 0 && entry.storedSize != entry.size) {
+			throw std::runtime_error("Pack entry size mismatch");
+		}
+		if (static_cast<uint64_t>(entry.nameOffset) + entry.nameLength > m_strings.size()) {
+			throw std::runtime_error("Pack entry name is out of bounds");
+		}
+	}
+}
+
+PackFile::~PackFile() = default;
+
+const Grafkit::Asset::PackEntry* PackFile::Find(const std::string_view name) const
+{
+	const uint64_t hash = HashAssetName(name);
+	auto it = std::lower_bound(m_entries.begin(),
+		m_entries.end(),
+		hash,
+		[](const PackEntry& entry, const uint64_t value) { return entry.nameHash < value; });
+
+	// Names sharing a hash sit next to each other
+	for (; it != m_entries.end() && it->nameHash == hash; ++it) {
+		if (IsSameAssetName(GetName(*it), name)) {
+			return &*it;
+		}
+	}
+	return nullptr;
+}
+
+std::string_view PackFile::GetName(const PackEntry& entry) const
+{
+	return m_strings.substr(entry.nameOffset, entry.nameLength);
+}
+
+std::span<const uint8_t> PackFile::GetStoredData(const PackEntry& entry) const
+{
+	return m_file->GetData().subspan(entry.dataOffset, entry.storedSize);
+}
+
+void PackFile::ReadEntry(const PackEntry& entry, const std::span<uint8_t> target) const
+{
+	if (target.size() != entry.size) {
+		throw std::runtime_error("Pack entry size mismatch");
+	}
+
+	const std::span<const uint8_t> stored = GetStoredData(entry);
+	if ((entry.flags & PACK_ENTRY_COMPRESSED) == 0) {
+		std::memcpy(target.data(), stored.data(), target.size());
+		return;
+	}
+
+	const uint64_t blockSize = m_header->blockSize;
+	const uint64_t blockCount = (entry.size + blockSize - 1) / blockSize;
+	if (entry.firstBlock + blockCount > m_blocks.size()) {
+		throw std::runtime_error("Pack entry blocks are out of bounds");
+	}
+
+	uint64_t storedOffset = 0;
+	for (uint64_t i = 0; i < blockCount; ++i) {
+		const uint64_t storedBlockSize = m_blocks[entry.firstBlock + i];
+		const uint64_t targetOffset = i * blockSize;
+		const uint64_t targetBlockSize = std::min(blockSize, entry.size - targetOffset);
+		if (storedBlockSize > stored.size() - storedOffset) {
+			throw std::runtime_error("Pack entry block is out of bounds");
+		}
+
+		const auto source = stored.subspan(storedOffset, storedBlockSize);
+		const auto destination = target.subspan(targetOffset, targetBlockSize);
+
+		// Incompressible blocks are stored raw
+		if (storedBlockSize == targetBlockSize) {
+			std::memcpy(destination.data(), source.data(), source.size());
+		} else {
+			Lz4::DecompressBlock(source, destination);
+		}
+		storedOffset += storedBlockSize;
+	}
+}
+
+// MARK: Pack asset source
+
+void PackAssetSource::Mount(const std::filesystem::path& packPath)
+{
+	m_packs.push_back(std::make_shared<PackFile>(packPath));
+}
+
+std::pair<Grafkit::Asset::PackFilePtr, const Grafkit::Asset::PackEntry*> PackAssetSource::Find(
+	const std::string& assetName) const
+{
+	for (auto it = m_packs.rbegin(); it != m_packs.rend(); ++it) {
+		const PackEntry* entry = (*it)->Find(assetName);
+		if (entry != nullptr) {
+			return {*it, entry};
+		}
+	}
+	throw std::runtime_error("Asset not found in packs: " + assetName);
+}
+
+void PackAssetSource::ReadData(const std::string& assetName, std::vector<uint8_t>& data) const
+{
+	const auto [pack, entry] = Find(assetName);
+
+	const size_t offset = data.size();
+	data.resize(offset + entry->size);
+	pack->ReadEntry(*entry, std::span<uint8_t>(data).subspan(offset));
+}
+
+Grafkit::Asset::AssetDataPtr PackAssetSource::OpenData(const std::string& assetName) const
+{
+	const auto [pack, entry] = Find(assetName);
+
+	if ((entry->flags & PACK_ENTRY_COMPRESSED) == 0) {
+		return std::make_shared<PackEntryData>(pack, pack->GetStoredData(*entry));
+	}
+
+	std::vector<uint8_t> data(entry->size);
+	pack->ReadEntry(*entry, data);
+	return std::make_shared<BufferAssetData>(std::move(data));
+}
@@ -0,0 +1,8 @@
+#include "stdafx.h"
+
+// Only the formats image assets are shipped in
+#define STBI_ONLY_PNG
+#define STBI_ONLY_JPEG
+#define STBI_ONLY_HDR
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
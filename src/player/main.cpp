@@ -1,3 +1,4 @@
+#include <filesystem>
 #include <optional>
 #include <string>
 #include <vector>
@@ -6,6 +7,7 @@
 #include <grafkit/common.h>
 #include <grafkit/core/buffer.h>
 #include <grafkit/core/command_buffer.h>
+#include <grafkit/core/device.h>
 #include <grafkit/core/pipeline.h>
 #include <grafkit/core/render_target.h>
 #include <grafkit/core/window.h>
@@ -18,6 +20,7 @@
 #include <grafkit/core/log.h>
 
 #include <grafkit_loader/asset_loader_system.h>
+#include <grafkit_loader/file_watcher.h>
 
 #include <grafkit/resource/image_builder.h>
 #include <grafkit/resource/material_builder.h>
@@ -34,12 +37,14 @@
 
 constexpr int WIDTH = 1024;
 constexpr int HEIGHT = 768;
+constexpr const char *ASSET_DIRECTORY = "assets";
 
 class HelloApplication : public Grafkit::Application
 {
 private:
 	Grafkit::Asset::AssetLoaderPtr m_assetLoader;
 	Grafkit::Resource::ResourceManagerPtr m_resources;
+	std::unique_ptr<Grafkit::Asset::FileWatcher> m_fileWatcher;
 
 public:
 	HelloApplication()
@@ -54,10 +59,26 @@ public:
 
 	void Init() override
 	{
+		m_resources->SetFramesInFlight(m_renderContext->GetDevice()->GetMaxConcurrentFrames());
+
+		// Changed assets are rebuilt and swapped in while running
+		if (std::filesystem::is_directory(ASSET_DIRECTORY))
+		{
+			m_fileWatcher = std::make_unique<Grafkit::Asset::FileWatcher>();
+			m_fileWatcher->Watch(ASSET_DIRECTORY);
+		}
 	}
 
 	void Update([[maybe_unused]] const Grafkit::TimeInfo &timeInfo) override
 	{
+		if (m_fileWatcher)
+		{
+			for (const auto &name : m_fileWatcher->Poll())
+			{
+				m_resources->Reload(name);
+			}
+		}
+		m_resources->Update(m_renderContext->GetDevice());
 	}
 
 	void Render() override
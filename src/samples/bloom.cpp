@@ -6,8 +6,10 @@
 #include <grafkit/common.h>
 #include <grafkit/core/buffer.h>
 #include <grafkit/core/command_buffer.h>
+#include <grafkit/core/device.h>
 #include <grafkit/core/pipeline.h>
 #include <grafkit/core/render_target.h>
+#include <grafkit/core/uniform_allocator.h>
 #include <grafkit/core/window.h>
 #include <grafkit/render.h>
 #include <grafkit/render/material.h>
@@ -20,6 +22,7 @@
 
 #include <grafkit_loader/asset_loader_system.h>
 
+#include <grafkit/resource/build_scheduler.h>
 #include <grafkit/resource/image_builder.h>
 #include <grafkit/resource/material_builder.h>
 #include <grafkit/resource/scenegraph_builder.h>
@@ -67,7 +70,7 @@ private:
 		Grafkit::NodePtr bottomNode;
 	} m_nodes;
 
-	Grafkit::Core::UniformBuffer<Grafkit::CameraView> m_ubo;
+	Grafkit::CameraView m_camera{};
 
 public:
 	HelloApplication()
@@ -155,28 +158,36 @@ public:
 			{255, 165, 79, 255},
 		};
 
-		Grafkit::Core::ImagePtr image =
-			Grafkit::Resource::CheckerImageBuilder(checkerImageDesc).BuildResource(device, resources);
-
-		Grafkit::MaterialPtr material = //
-			Grafkit::Resource::MaterialBuilder()
-				.SetRenderStage(forwardRenderStage)
-				.AddTextureImage(Grafkit::DIFFUSE_TEXTURE_BINDING, image)
-				.AddTextureImage(Grafkit::NORMAL_TEXTURE_BINDING, image)
-				.AddTextureImage(Grafkit::ROUGHNESS_TEXTURE_BINDING, image)
-				.AddTextureImage(Grafkit::METALLIC_TEXTURE_BINDING, image)
-				.AddTextureImage(Grafkit::AMBIENT_OCCLUSION_TEXTURE_BINDING, image)
-				.AddTextureImage(Grafkit::EMISSIVE_TEXTURE_BINDING, image)
-				.BuildResource(device, resources);
-
-		m_ubo = Grafkit::Core::UniformBuffer<Grafkit::CameraView>::CreateBuffer(device);
+		// Builders refer to each other by name, the scheduler builds them in order
+		m_resources->Add("forward", forwardRenderStage);
+
+		Grafkit::Resource::MaterialDesc materialDesc = {};
+		materialDesc.stage = "forward";
+		for (const auto textureType : {Grafkit::Resource::TextureType::Diffuse,
+				 Grafkit::Resource::TextureType::Normal,
+				 Grafkit::Resource::TextureType::Roughness,
+				 Grafkit::Resource::TextureType::Metallic,
+				 Grafkit::Resource::TextureType::AmbientOcclusion,
+				 Grafkit::Resource::TextureType::Emissive})
+		{
+			materialDesc.textures.emplace(textureType, "checker");
+		}
+
+		auto meshBuilder = std::make_shared<Grafkit::Resource::MeshBuilder>(
+			Grafkit::Resource::MeshBuilderDesc{{}, {{0, "checker"}}});
+		meshBuilder->AddPrimitive(TestApplication::vertices, TestApplication::indices, 0u);
+
+		Grafkit::Resource::BuildScheduler(resources)
+			.Add("cube", meshBuilder)
+			.Add("checker", std::make_shared<Grafkit::Resource::MaterialBuilder>(materialDesc))
+			.Add("checker", std::make_shared<Grafkit::Resource::CheckerImageBuilder>(checkerImageDesc))
+			.Build(device);
+
 		m_modelviewDescriptor = forwardRenderStage->CreateDescriptorSet(Grafkit::CAMERA_VIEW_SET);
-		m_modelviewDescriptor->Update(m_ubo.buffer, Grafkit::MODEL_VIEW_BINDING);
+		m_modelviewDescriptor->Update(
+			*device->GetUniformAllocator(), Grafkit::MODEL_VIEW_BINDING, sizeof(Grafkit::CameraView));
 
-		Grafkit::MeshPtr mesh = //
-			Grafkit::Resource::MeshBuilder()
-				.AddPrimitive(TestApplication::vertices, TestApplication::indices, material)
-				.BuildResource(device, resources);
+		const Grafkit::MeshPtr mesh = m_resources->Get<Grafkit::Mesh>("cube");
 
 		m_sceneGraph = std::make_shared<Grafkit::Scenegraph>();
 
@@ -195,9 +206,8 @@ public:
 
 	void Update([[maybe_unused]] const Grafkit::TimeInfo &timeInfo) override
 	{
-		m_ubo.data.projection = glm::perspective(glm::radians(45.0f), m_renderContext->GetAspectRatio(), 0.1f, 100.f);
-		m_ubo.data.camera = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, -10.0f));
-		m_ubo.Update(m_renderContext->GetDevice(), m_renderContext->GetNextFrameIndex());
+		m_camera.projection = glm::perspective(glm::radians(45.0f), m_renderContext->GetAspectRatio(), 0.1f, 100.f);
+		m_camera.camera = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, -10.0f));
 
 		m_nodes.rootNode->translation = glm::vec3(0.0f, 0.0f, 0.0f);
 		m_nodes.centerNode->translation = glm::vec3(0.0f, 0.0f, 0.0f);
@@ -245,15 +255,16 @@ public:
 		const auto &commandBuffer = m_renderContext->BeginCommandBuffer();
 		const auto &frameIndex = m_renderContext->GetNextFrameIndex();
 
+		// The part of the frame in the uniform allocator is free once the frame began
+		const auto camera = m_renderContext->GetDevice()->GetUniformAllocator()->Push(m_camera);
+		m_sceneGraph->SetDynamicOffsets(Grafkit::CAMERA_VIEW_SET, {camera.offset});
+
 		m_renderGraph->Record(commandBuffer, frameIndex);
 
 		m_renderContext->EndFrame(commandBuffer);
 	}
 
-	void Shutdown() override
-	{
-		m_ubo.Destroy(m_renderContext->GetDevice());
-	}
+	void Shutdown() override {}
 };
 
 int main()
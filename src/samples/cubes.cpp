@@ -6,7 +6,9 @@
 #include <grafkit/common.h>
 #include <grafkit/core/buffer.h>
 #include <grafkit/core/command_buffer.h>
+#include <grafkit/core/device.h>
 #include <grafkit/core/pipeline.h>
+#include <grafkit/core/uniform_allocator.h>
 #include <grafkit/core/window.h>
 #include <grafkit/render.h>
 #include <grafkit/render/material.h>
@@ -14,6 +16,7 @@
 #include <grafkit/render/render_graph.h>
 #include <grafkit/render/scenegraph.h>
 #include <grafkit/render/texture.h>
+#include <grafkit/render/vertex_packing.h>
 
 #include <grafkit/core/log.h>
 
@@ -29,8 +32,8 @@
 #include <iostream>
 
 #include "cube_mesh.h"
+#include "shaders/forward_render_compact.vert.h"
 #include "shaders/triangle.frag.h"
-#include "shaders/triangle.vert.h"
 
 #include "shaders/quad.vert.h"
 #include "shaders/red.frag.h"
@@ -61,7 +64,7 @@ private:
 		Grafkit::NodePtr bottomNode;
 	} m_nodes;
 
-	Grafkit::Core::UniformBuffer<Grafkit::CameraView> m_ubo;
+	Grafkit::CameraView m_camera{};
 
 public:
 	HelloApplication()
@@ -79,13 +82,14 @@ public:
 		const auto &device = m_renderContext->GetDevice();
 		const auto resources = Grafkit::MakeReference(*m_resources);
 
+		// The cubes are drawn from quantized vertices, the shader decodes them with the pushed position transform
 		Grafkit::RenderStagePtr stage =
 			Grafkit::RenderStageBuilder(m_renderContext->GetDevice())
 				.SetRenderTarget(m_renderContext->GetRenderTarget())
-				.SetVertexInputDescription(Grafkit::Vertex::GetVertexDescription())
+				.SetVertexInputDescription(Grafkit::GetVertexDescription(Grafkit::VertexFormat::Snorm16))
 				.AddDescriptorSetLayoutBindings(Grafkit::Material::GetLayoutBindings())
 				.AddPushConstantRange({VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(Grafkit::ModelView)})
-				.SetVertexShader(triangle_vert, triangle_vert_len)
+				.SetVertexShader(forward_render_compact_vert, forward_render_compact_vert_len)
 				.SetFragmentShader(triangle_frag, triangle_frag_len)
 				.Build();
 
@@ -113,13 +117,14 @@ public:
 				.AddTextureImage(Grafkit::EMISSIVE_TEXTURE_BINDING, image)
 				.BuildResource(device, resources);
 
-		m_ubo = Grafkit::Core::UniformBuffer<Grafkit::CameraView>::CreateBuffer(device);
 		m_modelviewDescriptor = stage->CreateDescriptorSet(Grafkit::CAMERA_VIEW_SET);
-		m_modelviewDescriptor->Update(m_ubo.buffer, Grafkit::MODEL_VIEW_BINDING);
+		m_modelviewDescriptor->Update(
+			*device->GetUniformAllocator(), Grafkit::MODEL_VIEW_BINDING, sizeof(Grafkit::CameraView));
 
 		Grafkit::MeshPtr mesh = //
 			Grafkit::Resource::MeshBuilder()
 				.AddPrimitive(TestApplication::vertices, TestApplication::indices, material)
+				.SetVertexFormat(Grafkit::VertexFormat::Snorm16)
 				.BuildResource(device, resources);
 
 		m_sceneGraph = std::make_shared<Grafkit::Scenegraph>();
@@ -139,9 +144,8 @@ public:
 
 	void Update([[maybe_unused]] const Grafkit::TimeInfo &timeInfo) override
 	{
-		m_ubo.data.projection = glm::perspective(glm::radians(45.0f), m_renderContext->GetAspectRatio(), 0.1f, 100.f);
-		m_ubo.data.camera = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, -10.0f));
-		m_ubo.Update(m_renderContext->GetDevice(), m_renderContext->GetNextFrameIndex());
+		m_camera.projection = glm::perspective(glm::radians(45.0f), m_renderContext->GetAspectRatio(), 0.1f, 100.f);
+		m_camera.camera = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, -10.0f));
 
 		m_nodes.rootNode->translation = glm::vec3(0.0f, 0.0f, 0.0f);
 		m_nodes.centerNode->translation = glm::vec3(0.0f, 0.0f, 0.0f);
@@ -188,14 +192,15 @@ public:
 	{
 		const auto &commandBuffer = m_renderContext->BeginCommandBuffer();
 		const auto &frameIndex = m_renderContext->GetNextFrameIndex();
+
+		// The part of the frame in the uniform allocator is free once the frame began
+		const auto camera = m_renderContext->GetDevice()->GetUniformAllocator()->Push(m_camera);
+		m_sceneGraph->SetDynamicOffsets(Grafkit::CAMERA_VIEW_SET, {camera.offset});
 		m_renderGraph->Record(commandBuffer, frameIndex);
 		m_renderContext->EndFrame(commandBuffer);
 	}
 
-	void Shutdown() override
-	{
-		m_ubo.Destroy(m_renderContext->GetDevice());
-	}
+	void Shutdown() override {}
 };
 
 int main()
@@ -0,0 +1,42 @@
+#version 450
+#extension GL_GOOGLE_include_directive : require
+
+#include <grafkit/shaders/vertex_decode.glsl>
+
+// CompactVertex or HalfVertex, the position transform of the mesh is pushed after the model matrix
+layout (location = 0) in vec4 inPosition;
+layout (location = 1) in vec4 inColor;
+layout (location = 2) in vec2 inUv;
+layout (location = 3) in vec2 inNormal;
+layout (location = 4) in vec2 inTangent;
+
+layout (set = 1, binding = 0) uniform UBO
+{
+	mat4 projection;
+	mat4 camera;
+} cameraView;
+
+layout (push_constant) uniform PC
+{
+	layout (offset=0) mat4  model;
+	layout (offset=64) mat4 positionTransform;
+} modelView;
+
+layout (location = 0) out vec3 outColor;
+layout (location = 1) out vec2 outUv;
+layout (location = 2) out vec3 outNormal;
+
+out gl_PerVertex
+{
+    vec4 gl_Position;
+};
+
+
+void main()
+{
+	outColor = inColor.rgb;
+	outUv = inUv;
+	outNormal = mat3(modelView.model) * OctDecode(inNormal);
+	vec3 position = DecodePosition(inPosition, modelView.positionTransform);
+	gl_Position = cameraView.projection * cameraView.camera * modelView.model * vec4(position, 1.0);
+}
@@ -0,0 +1,129 @@
+#include <cmath>
+#include <filesystem>
+#include <gtest/gtest.h>
+
+#include <grafkit/resource/animation_clip.h>
+#include <grafkit_loader/animation_clip_loader.h>
+
+using Grafkit::Asset::MappedAnimationClip;
+using Grafkit::Resource::AnimationChannelDesc;
+using Grafkit::Resource::AnimationClipDesc;
+using Grafkit::Resource::AnimationClipView;
+using Grafkit::Resource::KeyInterpolation;
+
+class TestAnimationClip : public ::testing::Test {
+protected:
+	void SetUp() override
+	{
+		m_clip.name = "walk";
+		m_clip.duration = 2.0f;
+		m_clip.isLooping = true;
+
+		AnimationChannelDesc translation { 1, 10, {} };
+		translation.keys.push_back({ 0.0f, KeyInterpolation::Linear, glm::vec4(0.0f) });
+		translation.keys.push_back({ 1.0f, KeyInterpolation::Step, glm::vec4(2.0f) });
+		translation.keys.push_back({ 2.0f, KeyInterpolation::Linear, glm::vec4(4.0f) });
+		m_clip.channels.push_back(translation);
+
+		AnimationChannelDesc rotation { 2, 11, {} };
+		for (int i = 0; i < 5; ++i) {
+			rotation.keys.push_back({ 0.5f * static_cast<float>(i), KeyInterpolation::Linear, glm::vec4(i) });
+		}
+		m_clip.channels.push_back(rotation);
+
+		m_path = std::filesystem::temp_directory_path() / "grafkit_test_clip.gkac";
+	}
+
+	void TearDown() override { std::filesystem::remove(m_path); }
+
+	AnimationClipDesc m_clip;
+	std::filesystem::path m_path;
+};
+
+TEST_F(TestAnimationClip, CookAndView)
+{
+	const std::vector<uint8_t> data = Grafkit::Resource::CookAnimationClip(m_clip);
+	const AnimationClipView view(data);
+
+	ASSERT_EQ(view.GetName(), "walk");
+	ASSERT_FLOAT_EQ(view.GetDuration(), 2.0f);
+	ASSERT_TRUE(view.IsLooping());
+	ASSERT_EQ(view.GetChannels().size(), 2);
+
+	const auto& rotation = view.GetChannels()[1];
+	ASSERT_EQ(rotation.id, 2);
+	ASSERT_EQ(rotation.target, 11);
+	ASSERT_EQ(rotation.keyCount, 5);
+	ASSERT_EQ(rotation.firstKey % Grafkit::Resource::ANIMATION_CLIP_KEY_ALIGNMENT, 0);
+
+	// Padding repeats the last key
+	const auto times = view.GetKeyTimes(rotation);
+	ASSERT_EQ(times.size(), 8);
+	ASSERT_FLOAT_EQ(times[7], 2.0f);
+
+	// Streams are cache line aligned
+	ASSERT_EQ(view.GetHeader().timeStreamOffset % 64, 0);
+	ASSERT_EQ(view.GetHeader().valueStreamOffset % 64, 0);
+	ASSERT_EQ(view.GetHeader().interpolationStreamOffset % 64, 0);
+}
+
+TEST_F(TestAnimationClip, Sample)
+{
+	const std::vector<uint8_t> data = Grafkit::Resource::CookAnimationClip(m_clip);
+	const AnimationClipView view(data);
+	const auto& translation = view.GetChannels()[0];
+
+	ASSERT_EQ(view.FindKey(translation, -1.0f), 0);
+	ASSERT_EQ(view.FindKey(translation, 1.5f), 1);
+	ASSERT_EQ(view.FindKey(translation, 5.0f), 2);
+
+	ASSERT_FLOAT_EQ(view.Sample(translation, 0.5f).x, 1.0f);
+	ASSERT_FLOAT_EQ(view.Sample(translation, 1.5f).x, 2.0f); // Step
+	ASSERT_FLOAT_EQ(view.Sample(translation, 3.0f).x, 4.0f);
+}
+
+TEST_F(TestAnimationClip, SampleKeysSharingATime)
+{
+	AnimationChannelDesc jump { 3, 12, {} };
+	jump.keys.push_back({ 1.0f, KeyInterpolation::Linear, glm::vec4(1.0f) });
+	jump.keys.push_back({ 1.0f, KeyInterpolation::Linear, glm::vec4(5.0f) });
+	jump.keys.push_back({ 2.0f, KeyInterpolation::Linear, glm::vec4(5.0f) });
+	m_clip.channels = { jump };
+
+	const std::vector<uint8_t> data = Grafkit::Resource::CookAnimationClip(m_clip);
+	const AnimationClipView view(data);
+	const auto& channel = view.GetChannels()[0];
+
+	const glm::vec4 before = view.Sample(channel, 0.5f);
+	ASSERT_FALSE(std::isnan(before.x));
+	ASSERT_FLOAT_EQ(before.x, 1.0f);
+	ASSERT_FLOAT_EQ(view.Sample(channel, 1.0f).x, 5.0f);
+}
+
+TEST_F(TestAnimationClip, RejectsCubicSplineKeys)
+{
+	m_clip.channels[0].keys[1].interpolation = KeyInterpolation::CubicSpline;
+	ASSERT_THROW(Grafkit::Resource::CookAnimationClip(m_clip), std::runtime_error);
+}
+
+TEST_F(TestAnimationClip, MappedFile)
+{
+	Grafkit::Asset::WriteAnimationClip(m_path, m_clip);
+
+	const MappedAnimationClip mapped(m_path);
+	const auto& view = mapped.GetClip();
+
+	ASSERT_EQ(view.GetName(), "walk");
+	ASSERT_EQ(view.GetChannels().size(), 2);
+	ASSERT_FLOAT_EQ(view.Sample(view.GetChannels()[1], 1.25f).x, 2.5f);
+}
+
+TEST_F(TestAnimationClip, RejectsCorruptData)
+{
+	std::vector<uint8_t> data = Grafkit::Resource::CookAnimationClip(m_clip);
+	data[0] = 0;
+	ASSERT_THROW(AnimationClipView view(data), std::runtime_error);
+
+	const std::vector<uint8_t> truncated(16, 0);
+	ASSERT_THROW(AnimationClipView view(truncated), std::runtime_error);
+}
@@ -0,0 +1,94 @@
+#include <algorithm>
+#include <cmath>
+#include <tuple>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <grafkit_loader/assimp_loader.h>
+
+using Grafkit::Asset::AssimpLoader;
+using Grafkit::Asset::AssimpScene;
+using Grafkit::Resource::MeshDescV2;
+using Grafkit::Resource::PrimitiveDescV2;
+
+namespace {
+	std::vector<glm::vec3> GetPositions(const MeshDescV2& mesh, const PrimitiveDescV2& primitive)
+	{
+		const auto begin = mesh.positions.begin() + primitive.vertexOffset;
+		std::vector<glm::vec3> positions(begin, begin + primitive.vertexCount);
+		std::sort(positions.begin(), positions.end(),
+			[](const glm::vec3& a, const glm::vec3& b) { return std::tie(a.x, a.y, a.z) < std::tie(b.x, b.y, b.z); });
+		return positions;
+	}
+} // namespace
+
+TEST(TestAssimpLoader, ConvertsMeshes)
+{
+	const AssimpLoader loader({}, 2);
+	const AssimpScene scene = loader.Import("meshes/quads.obj");
+	const MeshDescV2& mesh = scene.meshes;
+
+	// One primitive for each material of the object, the quad is split in two triangles
+	ASSERT_EQ(mesh.primitives.size(), 2u);
+	ASSERT_EQ(mesh.positions.size(), 7u);
+	ASSERT_EQ(mesh.indices.size(), 9u);
+	ASSERT_EQ(mesh.normals.size(), mesh.positions.size());
+	ASSERT_EQ(mesh.texCoords.size(), mesh.positions.size());
+
+	const PrimitiveDescV2& quad = mesh.primitives[0];
+	EXPECT_EQ(quad.indexOffset, 0u);
+	EXPECT_EQ(quad.indexCount, 6u);
+	EXPECT_EQ(quad.vertexOffset, 0u);
+	EXPECT_EQ(quad.vertexCount, 4u);
+
+	const PrimitiveDescV2& triangle = mesh.primitives[1];
+	EXPECT_EQ(triangle.indexOffset, 6u);
+	EXPECT_EQ(triangle.indexCount, 3u);
+	EXPECT_EQ(triangle.vertexOffset, 4u);
+	EXPECT_EQ(triangle.vertexCount, 3u);
+
+	// Indices are local to their primitive
+	for (const PrimitiveDescV2& primitive : mesh.primitives) {
+		for (uint32_t i = 0; i < primitive.indexCount; ++i) {
+			EXPECT_LT(mesh.indices[primitive.indexOffset + i], primitive.vertexCount);
+		}
+	}
+
+	EXPECT_EQ(GetPositions(mesh, quad),
+		std::vector<glm::vec3>({ { 0.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, { 1.0f, 0.0f, 0.0f },
+			{ 1.0f, 1.0f, 0.0f } }));
+	EXPECT_EQ(GetPositions(mesh, triangle),
+		std::vector<glm::vec3>({ { 2.0f, 0.0f, 0.0f }, { 2.0f, 1.0f, 0.0f }, { 3.0f, 0.0f, 0.0f } }));
+
+	// Material indices are the ones of the scene, mapped by name
+	ASSERT_TRUE(mesh.materials.contains("red"));
+	ASSERT_TRUE(mesh.materials.contains("blue"));
+	EXPECT_EQ(quad.materialIndex, mesh.materials.at("red"));
+	EXPECT_EQ(triangle.materialIndex, mesh.materials.at("blue"));
+	EXPECT_NE(quad.materialIndex, triangle.materialIndex);
+
+	// Smooth normals of a flat surface face the same way
+	for (const glm::vec3& normal : mesh.normals) {
+		EXPECT_NEAR(std::abs(normal.z), 1.0f, 1e-4f);
+	}
+
+	// Nodes refer to the primitives
+	ASSERT_EQ(scene.scene.nodes.size(), 1u);
+	std::vector<uint32_t> meshIndices;
+	const auto collect = [&meshIndices](const auto& self, const Grafkit::Resource::NodeDesc& node) -> void {
+		meshIndices.insert(meshIndices.end(), node.meshIndices.begin(), node.meshIndices.end());
+		for (const auto& child : node.children) {
+			self(self, child);
+		}
+	};
+	collect(collect, scene.scene.nodes[0]);
+	std::sort(meshIndices.begin(), meshIndices.end());
+	EXPECT_EQ(meshIndices, std::vector<uint32_t>({ 0, 1 }));
+}
+
+TEST(TestAssimpLoader, FailsOnMissingFile)
+{
+	const AssimpLoader loader({}, 1);
+	ASSERT_THROW((void)loader.Import("meshes/missing.obj"), std::runtime_error);
+}
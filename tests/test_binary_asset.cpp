@@ -0,0 +1,106 @@
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+
+#include <grafkit/descriptors/animation_desc.h>
+#include <grafkit/descriptors/binary_desc.h>
+#include <grafkit/descriptors/material_desc.h>
+#include <grafkit/descriptors/mesh_desc.h>
+#include <grafkit_loader/asset_loader_system.h>
+
+using Grafkit::Asset::BinaryAsset;
+using Grafkit::Asset::BinaryAssetHeader;
+
+namespace {
+	Grafkit::Resource::MeshDesc MakeMesh()
+	{
+		Grafkit::Resource::MeshDesc mesh;
+		mesh.name = "quad";
+		mesh.materials = { { "a", 1 }, { "b", 2 } };
+		auto& primitive = mesh.primitives.emplace_back();
+		primitive.positions = { { 0, 0, 0 }, { 1, 0, 0 }, { 1, 1, 0 }, { 0, 1, 0 } };
+		primitive.texCoords = { { 0, 0 }, { 1, 0 }, { 1, 1 }, { 0, 1 } };
+		primitive.indices = { 0, 1, 2, 0, 2, 3 };
+		return mesh;
+	}
+} // namespace
+
+TEST(TestBinaryAsset, RoundTrip)
+{
+	const auto mesh = MakeMesh();
+	BinaryAsset asset(BinaryAsset::Serialize(mesh));
+
+	const auto result = asset.DeserializeAs<Grafkit::Resource::MeshDesc>();
+
+	ASSERT_EQ(result.name, mesh.name);
+	ASSERT_EQ(result.materials, mesh.materials);
+	ASSERT_EQ(result.primitives.size(), 1u);
+	ASSERT_EQ(result.primitives[0].positions, mesh.primitives[0].positions);
+	ASSERT_EQ(result.primitives[0].texCoords, mesh.primitives[0].texCoords);
+	ASSERT_EQ(result.primitives[0].indices, mesh.primitives[0].indices);
+	ASSERT_TRUE(result.primitives[0].normals.empty());
+}
+
+TEST(TestBinaryAsset, MatchesJson)
+{
+	Grafkit::Asset::JsonAssetLoader jsonLoader;
+	const auto material = jsonLoader.Load("test.json")->DeserializeAs<Grafkit::Resource::MaterialDesc>();
+
+	BinaryAsset asset(BinaryAsset::Serialize(material));
+	const auto result = asset.DeserializeAs<Grafkit::Resource::MaterialDesc>();
+
+	ASSERT_EQ(result.name, material.name);
+	ASSERT_EQ(result.textures, material.textures);
+}
+
+TEST(TestBinaryAsset, LoadFromFile)
+{
+	Grafkit::Resource::AnimationClipDesc clip;
+	clip.name = "walk";
+	clip.duration = 2.0f;
+	clip.channels.push_back({ 1, 2, { { 0.0f, Grafkit::Resource::KeyInterpolation::Step, glm::vec4(1.0f) } } });
+
+	const auto path = std::filesystem::temp_directory_path() / "grafkit_test_clip.gkb";
+	{
+		const auto data = BinaryAsset::Serialize(clip);
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+	}
+
+	Grafkit::Asset::BinaryAssetLoader loader;
+	const auto result = loader.Load(path.string())->DeserializeAs<Grafkit::Resource::AnimationClipDesc>();
+	std::filesystem::remove(path);
+
+	ASSERT_EQ(result.name, "walk");
+	ASSERT_EQ(result.channels.size(), 1u);
+	ASSERT_EQ(result.channels[0].keys[0].interpolation, Grafkit::Resource::KeyInterpolation::Step);
+	ASSERT_EQ(result.channels[0].keys[0].value, glm::vec4(1.0f));
+}
+
+TEST(TestBinaryAsset, RejectsOtherType)
+{
+	BinaryAsset asset(BinaryAsset::Serialize(MakeMesh()));
+	ASSERT_THROW(asset.DeserializeAs<Grafkit::Resource::MaterialDesc>(), std::runtime_error);
+}
+
+TEST(TestBinaryAsset, RejectsCorruptData)
+{
+	const auto data = BinaryAsset::Serialize(MakeMesh());
+
+	auto truncated = data;
+	truncated.resize(data.size() - 4);
+	ASSERT_THROW(BinaryAsset(truncated).DeserializeAs<Grafkit::Resource::MeshDesc>(), std::runtime_error);
+
+	// A huge element count must not be trusted
+	auto corrupt = data;
+	BinaryAssetHeader header {};
+	std::memcpy(&header, corrupt.data(), sizeof(header));
+	const uint64_t count = ~0ull;
+	std::memcpy(corrupt.data() + sizeof(header), &count, sizeof(count));
+	ASSERT_THROW(BinaryAsset(corrupt).DeserializeAs<Grafkit::Resource::MeshDesc>(), std::runtime_error);
+
+	auto otherVersion = data;
+	header.schemaHash ^= 1;
+	std::memcpy(otherVersion.data(), &header, sizeof(header));
+	ASSERT_THROW(BinaryAsset(otherVersion).DeserializeAs<Grafkit::Resource::MeshDesc>(), std::runtime_error);
+}
@@ -0,0 +1,213 @@
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <grafkit/interface/asset.h>
+#include <grafkit/interface/resource.h>
+#include <grafkit/resource/build_scheduler.h>
+
+using Grafkit::Resource::BuildScheduler;
+using Grafkit::Resource::ResourceManager;
+
+namespace {
+	struct SceneDesc {
+		std::vector<std::string> dependencies;
+	};
+
+	struct SceneResource {
+		std::vector<std::shared_ptr<SceneResource>> dependencies;
+	};
+
+	class NullAssetLoader : public Grafkit::Asset::IAssetLoader {
+	public:
+		[[nodiscard]] Grafkit::Asset::SerializedAssetPtr Load(const std::string& assetName) const override
+		{
+			throw std::runtime_error("No assets: " + assetName);
+		}
+	};
+
+	// Counts builds running at the same time; a build waits a little for others to join in
+	struct BuildTracker {
+		std::mutex mutex;
+		std::vector<std::string> order;
+		std::atomic<int> running = 0;
+		std::atomic<int> maxRunning = 0;
+	};
+
+	class SceneBuilder : public Grafkit::Resource::ResourceBuilder<SceneDesc, SceneResource> {
+	public:
+		SceneBuilder(std::string name, SceneDesc desc, BuildTracker& tracker, bool fails = false)
+			: ResourceBuilder(std::move(desc))
+			, m_name(std::move(name))
+			, m_tracker(tracker)
+			, m_fails(fails)
+		{
+		}
+
+		[[nodiscard]] bool ResolveDependencies(const Grafkit::RefWrapper<ResourceManager>& resources) final
+		{
+			m_dependencies.clear();
+			for (const auto& name : m_descriptor.dependencies) {
+				const auto dependency = resources->Get<SceneResource>(name);
+				if (dependency == nullptr) {
+					return false;
+				}
+				m_dependencies.push_back(dependency);
+			}
+			return true;
+		}
+
+		void Build([[maybe_unused]] const Grafkit::Core::DeviceRef& device) final
+		{
+			const int running = ++m_tracker.running;
+			int maxRunning = m_tracker.maxRunning.load();
+			while (running > maxRunning && !m_tracker.maxRunning.compare_exchange_weak(maxRunning, running)) { }
+
+			std::this_thread::sleep_for(std::chrono::milliseconds(20));
+			--m_tracker.running;
+
+			{
+				std::lock_guard<std::mutex> lock(m_tracker.mutex);
+				m_tracker.order.push_back(m_name);
+			}
+
+			if (m_fails) {
+				throw std::runtime_error("Build failed: " + m_name);
+			}
+			m_resource = std::make_shared<SceneResource>(SceneResource { m_dependencies });
+		}
+
+		[[nodiscard]] std::vector<Grafkit::Resource::ResourceId> GetDependencies() const final
+		{
+			std::vector<Grafkit::Resource::ResourceId> dependencies;
+			for (const auto& name : m_descriptor.dependencies) {
+				dependencies.push_back({ typeid(SceneResource), name });
+			}
+			return dependencies;
+		}
+
+	private:
+		std::string m_name;
+		BuildTracker& m_tracker;
+		bool m_fails;
+		std::vector<std::shared_ptr<SceneResource>> m_dependencies;
+	};
+} // namespace
+
+class TestBuildScheduler : public ::testing::Test {
+protected:
+	void SetUp() override
+	{
+		m_resources = std::make_unique<ResourceManager>(
+			Grafkit::MakeReferenceAs<Grafkit::Asset::IAssetLoader>(m_assetLoader), 1);
+		m_scheduler = std::make_unique<BuildScheduler>(Grafkit::MakeReference(*m_resources), 4);
+	}
+
+	void TearDown() override
+	{
+		m_scheduler.reset();
+		m_resources.reset();
+	}
+
+	void Add(const std::string& name, std::vector<std::string> dependencies, bool fails = false)
+	{
+		m_scheduler->Add(
+			name, std::make_shared<SceneBuilder>(name, SceneDesc { std::move(dependencies) }, m_tracker, fails));
+	}
+
+	[[nodiscard]] size_t OrderOf(const std::string& name)
+	{
+		const auto it = std::find(m_tracker.order.begin(), m_tracker.order.end(), name);
+		return static_cast<size_t>(std::distance(m_tracker.order.begin(), it));
+	}
+
+	NullAssetLoader m_assetLoader;
+	BuildTracker m_tracker;
+	std::unique_ptr<ResourceManager> m_resources;
+	std::unique_ptr<BuildScheduler> m_scheduler;
+};
+
+TEST_F(TestBuildScheduler, BuildsInDependencyOrder)
+{
+	// Added in reverse, like a mesh before its materials before their images
+	Add("mesh", { "material1", "material2" });
+	Add("material1", { "image" });
+	Add("material2", { "image" });
+	Add("image", {});
+
+	ASSERT_TRUE(m_scheduler->Validate().empty());
+	m_scheduler->Build({});
+
+	ASSERT_EQ(m_tracker.order.size(), 4u);
+	ASSERT_EQ(OrderOf("image"), 0u);
+	ASSERT_EQ(OrderOf("mesh"), 3u);
+
+	const auto mesh = m_resources->Get<SceneResource>("mesh");
+	ASSERT_NE(mesh, nullptr);
+	ASSERT_EQ(mesh->dependencies[0], m_resources->Get<SceneResource>("material1"));
+	ASSERT_EQ(mesh->dependencies[0]->dependencies[0], m_resources->Get<SceneResource>("image"));
+	ASSERT_EQ(m_scheduler->GetLoaderCount(), 0u);
+}
+
+TEST_F(TestBuildScheduler, BuildsIndependentLoadersInParallel)
+{
+	Add("mesh", { "image1", "image2", "image3", "image4" });
+	Add("image1", {});
+	Add("image2", {});
+	Add("image3", {});
+	Add("image4", {});
+
+	m_scheduler->Build({});
+
+	ASSERT_GT(m_tracker.maxRunning.load(), 1);
+	ASSERT_EQ(OrderOf("mesh"), 4u);
+	ASSERT_NE(m_resources->Get<SceneResource>("mesh"), nullptr);
+}
+
+TEST_F(TestBuildScheduler, UsesExistingResources)
+{
+	const auto stage = std::make_shared<SceneResource>();
+	m_resources->Add("stage", stage);
+	Add("material", { "stage" });
+
+	m_scheduler->Build({});
+
+	ASSERT_EQ(m_resources->Get<SceneResource>("material")->dependencies[0], stage);
+}
+
+TEST_F(TestBuildScheduler, ReportsProblemsUpFront)
+{
+	Add("mesh", { "material", "missing" });
+	Add("material", { "image" });
+	Add("image", { "material" });
+	Add("independent", {});
+
+	const auto errors = m_scheduler->Validate();
+	ASSERT_EQ(errors.size(), 2u);
+	ASSERT_NE(errors[0].find("Missing dependency 'missing'"), std::string::npos);
+	ASSERT_NE(errors[1].find("Dependency cycle: 'material'"), std::string::npos);
+	ASSERT_NE(errors[1].find("'image'"), std::string::npos);
+
+	ASSERT_THROW(m_scheduler->Build({}), std::runtime_error);
+	ASSERT_TRUE(m_tracker.order.empty());
+	ASSERT_EQ(m_resources->Get<SceneResource>("independent"), nullptr);
+}
+
+TEST_F(TestBuildScheduler, StopsAfterFailedBuild)
+{
+	Add("mesh", { "material" });
+	Add("material", {}, true);
+
+	ASSERT_THROW(m_scheduler->Build({}), std::runtime_error);
+	ASSERT_EQ(m_tracker.order, std::vector<std::string>({ "material" }));
+	ASSERT_EQ(m_resources->Get<SceneResource>("mesh"), nullptr);
+}
+
+TEST_F(TestBuildScheduler, RejectsDuplicates)
+{
+	Add("image", {});
+	ASSERT_THROW(Add("image", {}), std::invalid_argument);
+}
@@ -0,0 +1,122 @@
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <grafkit/utils/concurrent_map.hpp>
+
+using Grafkit::Utils::ConcurrentMap;
+
+namespace {
+	struct TestValue {
+		int key;
+		int version;
+	};
+} // namespace
+
+TEST(TestConcurrentMap, InsertFindErase)
+{
+	ConcurrentMap<std::string, int> map;
+	ASSERT_EQ(map.Find("a"), nullptr);
+
+	ASSERT_EQ(map.InsertOrAssign("a", std::make_shared<int>(1)), nullptr);
+	ASSERT_EQ(*map.InsertOrAssign("a", std::make_shared<int>(2)), 1);
+	map.InsertOrAssign("b", std::make_shared<int>(3));
+
+	ASSERT_EQ(*map.Find("a"), 2);
+	ASSERT_EQ(map.Size(), 2u);
+
+	int sum = 0;
+	map.ForEach([&sum](const std::string&, const std::shared_ptr<int>& value) { sum += *value; });
+	ASSERT_EQ(sum, 5);
+
+	ASSERT_EQ(*map.Erase("a"), 2);
+	ASSERT_EQ(map.Erase("a"), nullptr);
+	ASSERT_EQ(map.Find("a"), nullptr);
+
+	map.Clear();
+	ASSERT_EQ(map.Size(), 0u);
+}
+
+TEST(TestConcurrentMap, ValuesOutliveErase)
+{
+	ConcurrentMap<int, TestValue> map;
+	map.InsertOrAssign(1, std::make_shared<TestValue>(TestValue { 1, 0 }));
+
+	const auto value = map.Find(1);
+	map.Erase(1);
+	ASSERT_EQ(value->key, 1);
+}
+
+TEST(TestConcurrentMap, StressReadersAndWriters)
+{
+	constexpr int KEY_COUNT = 512;
+	constexpr int WRITER_COUNT = 4;
+	constexpr int READER_COUNT = 4;
+	constexpr int VERSION_COUNT = 50;
+
+	ConcurrentMap<int, TestValue> map;
+	std::atomic<int> readersStarted = 0;
+	std::atomic<int> writersDone = 0;
+	std::atomic<int> mismatches = 0;
+	std::atomic<size_t> hits = 0;
+
+	// Each writer owns every WRITER_COUNT-th key, inserting, replacing and erasing them over and over
+	std::vector<std::thread> threads;
+	for (int writer = 0; writer < WRITER_COUNT; ++writer) {
+		threads.emplace_back([&map, &readersStarted, &writersDone, writer]() {
+			// Writers are quick, they would be done before the readers got going
+			while (readersStarted.load() < READER_COUNT) {
+				std::this_thread::yield();
+			}
+			for (int version = 1; version <= VERSION_COUNT; ++version) {
+				for (int key = writer; key < KEY_COUNT; key += WRITER_COUNT) {
+					map.InsertOrAssign(key, std::make_shared<TestValue>(TestValue { key, version }));
+					if (version % 3 == 0) {
+						map.Erase(key);
+					}
+				}
+			}
+			++writersDone;
+		});
+	}
+
+	for (int reader = 0; reader < READER_COUNT; ++reader) {
+		threads.emplace_back([&map, &readersStarted, &writersDone, &mismatches, &hits]() {
+			std::vector<int> lastVersions(KEY_COUNT, 0);
+			++readersStarted;
+			// One more pass once the writers are done
+			bool done = false;
+			while (!done) {
+				done = writersDone.load() == WRITER_COUNT;
+				for (int key = 0; key < KEY_COUNT; ++key) {
+					const auto value = map.Find(key);
+					if (value == nullptr) {
+						continue;
+					}
+					// A value is never seen half written, nor older than one seen before
+					if (value->key != key || value->version < lastVersions[key]) {
+						++mismatches;
+					}
+					lastVersions[key] = value->version;
+					++hits;
+				}
+			}
+		});
+	}
+
+	for (auto& thread : threads) {
+		thread.join();
+	}
+
+	ASSERT_EQ(mismatches.load(), 0);
+	ASSERT_GT(hits.load(), 0u);
+
+	// The last version is not a multiple of three, every key stays
+	ASSERT_EQ(map.Size(), static_cast<size_t>(KEY_COUNT));
+	for (int key = 0; key < KEY_COUNT; ++key) {
+		ASSERT_EQ(map.Find(key)->version, VERSION_COUNT);
+	}
+}
@@ -0,0 +1,208 @@
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <grafkit/interface/asset.h>
+#include <grafkit/interface/resource.h>
+#include <grafkit/resource/cook_cache.h>
+
+using Grafkit::Resource::CookCache;
+using Grafkit::Resource::ResourceManager;
+
+namespace {
+	struct CookedDesc {
+		std::string value;
+	};
+
+	struct CookedResource {
+		std::string value;
+	};
+
+	std::atomic<int> g_deserializeCount = 0;
+	std::atomic<int> g_cookCount = 0;
+
+	// The asset content is the value itself, editable from the tests
+	class CookedSerializedAsset : public Grafkit::Asset::ISerializedAsset {
+	public:
+		explicit CookedSerializedAsset(std::string content)
+			: m_content(std::move(content))
+		{
+		}
+
+		void Deserialize([[maybe_unused]] const std::type_index& assetType, void* object) override
+		{
+			++g_deserializeCount;
+			static_cast<CookedDesc*>(object)->value = m_content;
+		}
+
+		[[nodiscard]] std::span<const uint8_t> GetData() const override
+		{
+			return { reinterpret_cast<const uint8_t*>(m_content.data()), m_content.size() };
+		}
+
+	private:
+		std::string m_content;
+	};
+
+	class CookedAssetLoader : public Grafkit::Asset::IAssetLoader {
+	public:
+		[[nodiscard]] Grafkit::Asset::SerializedAssetPtr Load(
+			[[maybe_unused]] const std::string& assetName) const override
+		{
+			return std::make_shared<CookedSerializedAsset>(m_content);
+		}
+
+		std::string m_content = "source";
+	};
+
+	// Cooking reverses the value, standing in for an expensive conversion
+	class CookedBuilder : public Grafkit::Resource::ResourceBuilder<CookedDesc, CookedResource>,
+						  public Grafkit::Resource::ICookable {
+	public:
+		explicit CookedBuilder(const CookedDesc& desc)
+			: ResourceBuilder(desc)
+		{
+		}
+
+		[[nodiscard]] bool ResolveDependencies(
+			[[maybe_unused]] const Grafkit::RefWrapper<ResourceManager>& resources) final
+		{
+			return true;
+		}
+
+		void Build([[maybe_unused]] const Grafkit::Core::DeviceRef& device) final
+		{
+			std::ignore = Cook();
+			m_resource = std::make_shared<CookedResource>(CookedResource { { m_cooked.begin(), m_cooked.end() } });
+		}
+
+		[[nodiscard]] std::vector<uint8_t> Cook() override
+		{
+			if (m_cooked.empty()) {
+				++g_cookCount;
+				m_cooked.assign(m_descriptor.value.rbegin(), m_descriptor.value.rend());
+			}
+			return m_cooked;
+		}
+
+		void LoadCooked(const std::span<const uint8_t> data) override { m_cooked.assign(data.begin(), data.end()); }
+
+	private:
+		std::vector<uint8_t> m_cooked;
+	};
+} // namespace
+
+class TestCookCache : public ::testing::Test {
+protected:
+	void SetUp() override
+	{
+		m_directory = std::filesystem::temp_directory_path() / "grafkit_test_cook_cache";
+		std::filesystem::remove_all(m_directory);
+		m_cache = std::make_shared<CookCache>(m_directory);
+
+		g_deserializeCount = 0;
+		g_cookCount = 0;
+		Grafkit::Resource::ResourceLoaderRegistry::Instance().RegisterBuilder<CookedBuilder>();
+	}
+
+	void TearDown() override { std::filesystem::remove_all(m_directory); }
+
+	std::shared_ptr<CookedResource> Load(const std::string& name)
+	{
+		ResourceManager resources(Grafkit::MakeReferenceAs<Grafkit::Asset::IAssetLoader>(m_assetLoader), 1);
+		resources.SetCookCache(m_cache);
+
+		auto future = resources.LoadAsync<CookedResource>(name);
+		const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+		while (resources.GetPendingCount() > 0 && std::chrono::steady_clock::now() < deadline) {
+			resources.Update({});
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+		return future.get();
+	}
+
+	std::filesystem::path m_directory;
+	std::shared_ptr<CookCache> m_cache;
+	CookedAssetLoader m_assetLoader;
+};
+
+TEST_F(TestCookCache, StoreAndLoad)
+{
+	const std::vector<uint8_t> data = { 1, 2, 3, 4, 5 };
+	m_cache->Store("asset.json", 42, data);
+
+	const auto loaded = m_cache->Load("asset.json", 42);
+	ASSERT_TRUE(loaded.has_value());
+	ASSERT_EQ(*loaded, data);
+
+	ASSERT_FALSE(m_cache->Load("asset.json", 43).has_value());
+	ASSERT_FALSE(m_cache->Load("other.json", 42).has_value());
+
+	m_cache->Invalidate("asset.json");
+	ASSERT_FALSE(m_cache->Load("asset.json", 42).has_value());
+}
+
+TEST_F(TestCookCache, CorruptEntry)
+{
+	const std::vector<uint8_t> data(100, 7);
+	m_cache->Store("asset.json", 42, data);
+
+	{
+		std::fstream file(m_cache->GetPath("asset.json"), std::ios::binary | std::ios::in | std::ios::out);
+		file.seekp(sizeof(Grafkit::Resource::CookCacheHeader) + 10);
+		file.put(8);
+	}
+	ASSERT_FALSE(m_cache->Load("asset.json", 42).has_value());
+}
+
+TEST_F(TestCookCache, OversizedEntry)
+{
+	const std::vector<uint8_t> data(100, 7);
+	m_cache->Store("asset.json", 42, data);
+
+	{
+		std::fstream file(m_cache->GetPath("asset.json"), std::ios::binary | std::ios::in | std::ios::out);
+		Grafkit::Resource::CookCacheHeader header {};
+		file.read(reinterpret_cast<char*>(&header), sizeof(header));
+		header.dataSize = uint64_t { 1 } << 60;
+		file.seekp(0);
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	}
+	ASSERT_FALSE(m_cache->Load("asset.json", 42).has_value());
+}
+
+TEST_F(TestCookCache, FailedStoreStillLoads)
+{
+	// Entries can not be written once the directory is gone
+	std::filesystem::remove_all(m_directory);
+	const auto resource = Load("asset.json");
+	ASSERT_NE(resource, nullptr);
+	ASSERT_EQ(resource->value, "ecruos");
+	ASSERT_EQ(g_cookCount, 1);
+}
+
+TEST_F(TestCookCache, WarmStartSkipsDeserialization)
+{
+	const auto cold = Load("asset.json");
+	ASSERT_EQ(cold->value, "ecruos");
+	ASSERT_EQ(g_deserializeCount, 1);
+	ASSERT_EQ(g_cookCount, 1);
+
+	const auto warm = Load("asset.json");
+	ASSERT_EQ(warm->value, "ecruos");
+	ASSERT_EQ(g_deserializeCount, 1);
+	ASSERT_EQ(g_cookCount, 1);
+}
+
+TEST_F(TestCookCache, SourceChangeInvalidates)
+{
+	ASSERT_EQ(Load("asset.json")->value, "ecruos");
+
+	m_assetLoader.m_content = "edited";
+	ASSERT_EQ(Load("asset.json")->value, "detide");
+	ASSERT_EQ(g_deserializeCount, 2);
+	ASSERT_EQ(g_cookCount, 2);
+}
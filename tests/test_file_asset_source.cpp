@@ -0,0 +1,62 @@
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+
+#include <grafkit_loader/file_loader.h>
+#include <grafkit_loader/mapped_file.h>
+
+using Grafkit::Asset::FileAssetSource;
+
+class TestFileAssetSource : public ::testing::Test {
+protected:
+	void SetUp() override { m_path = std::filesystem::temp_directory_path() / "grafkit_test_asset.bin"; }
+
+	void TearDown() override { std::filesystem::remove(m_path); }
+
+	std::vector<uint8_t> WriteFile(const size_t size) const
+	{
+		std::vector<uint8_t> content(size);
+		for (size_t i = 0; i < size; ++i) {
+			content[i] = static_cast<uint8_t>(i * 31);
+		}
+		std::ofstream file(m_path, std::ios::binary | std::ios::trunc);
+		file.write(reinterpret_cast<const char*>(content.data()), static_cast<std::streamsize>(content.size()));
+		return content;
+	}
+
+	FileAssetSource m_source;
+	std::filesystem::path m_path;
+};
+
+TEST_F(TestFileAssetSource, ReadData)
+{
+	const auto content = WriteFile(1000);
+
+	std::vector<uint8_t> data;
+	m_source.ReadData(m_path.string(), data);
+	ASSERT_EQ(data, content);
+}
+
+TEST_F(TestFileAssetSource, OpenSmallFile)
+{
+	const auto content = WriteFile(1000);
+
+	const auto data = m_source.OpenData(m_path.string());
+	ASSERT_TRUE(std::ranges::equal(data->GetData(), content));
+}
+
+TEST_F(TestFileAssetSource, OpenMappedFile)
+{
+	const auto content = WriteFile(FileAssetSource::MAPPING_THRESHOLD * 4 + 123);
+
+	const auto data = m_source.OpenData(m_path.string());
+	ASSERT_NE(std::dynamic_pointer_cast<const Grafkit::Asset::MappedFile>(data), nullptr);
+	ASSERT_TRUE(std::ranges::equal(data->GetData(), content));
+}
+
+TEST_F(TestFileAssetSource, MissingFile)
+{
+	std::vector<uint8_t> data;
+	ASSERT_THROW(m_source.ReadData("does_not_exist.bin", data), std::runtime_error);
+	ASSERT_THROW(auto mapped = m_source.OpenData("does_not_exist.bin"), std::runtime_error);
+}
@@ -0,0 +1,92 @@
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <grafkit_loader/file_watcher.h>
+
+using Grafkit::Asset::FileWatcher;
+
+class TestFileWatcher : public ::testing::Test {
+protected:
+	void SetUp() override
+	{
+		m_directory = std::filesystem::temp_directory_path() / "grafkit_test_watcher";
+		std::filesystem::remove_all(m_directory);
+		std::filesystem::create_directories(m_directory / "images");
+	}
+
+	void TearDown() override { std::filesystem::remove_all(m_directory); }
+
+	void Write(const std::filesystem::path& name, const std::string& content) const
+	{
+		std::ofstream file(m_directory / name, std::ios::binary | std::ios::trunc);
+		file << content;
+	}
+
+	// Collects changes until the expected count arrives or it times out
+	static std::vector<std::string> WaitForChanges(FileWatcher& watcher, const size_t count)
+	{
+		std::vector<std::string> changes;
+		const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(3);
+		while (changes.size() < count && std::chrono::steady_clock::now() < deadline) {
+			const auto polled = watcher.Poll();
+			changes.insert(changes.end(), polled.begin(), polled.end());
+			std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		}
+		std::sort(changes.begin(), changes.end());
+		return changes;
+	}
+
+	std::filesystem::path m_directory;
+};
+
+TEST_F(TestFileWatcher, ReportsWrittenFiles)
+{
+	Write("scene.json", "{}");
+
+	FileWatcher watcher;
+	watcher.Watch(m_directory);
+	ASSERT_TRUE(watcher.Poll().empty());
+
+	Write("scene.json", "{\"name\": \"scene\"}");
+	Write("images/rgb.png", "png");
+
+	const auto root = m_directory.lexically_normal().generic_string();
+	ASSERT_EQ(WaitForChanges(watcher, 2), std::vector<std::string>({ root + "/images/rgb.png", root + "/scene.json" }));
+}
+
+TEST_F(TestFileWatcher, WatchesNewDirectories)
+{
+	FileWatcher watcher;
+	watcher.Watch(m_directory);
+
+	std::filesystem::create_directories(m_directory / "meshes");
+	ASSERT_TRUE(watcher.Poll().empty());
+
+	Write("meshes/cube.json", "{}");
+	ASSERT_EQ(WaitForChanges(watcher, 1),
+		std::vector<std::string>({ (m_directory / "meshes/cube.json").lexically_normal().generic_string() }));
+}
+
+TEST_F(TestFileWatcher, SkipsDirectoriesRemovedBeforePoll)
+{
+	FileWatcher watcher;
+	watcher.Watch(m_directory);
+
+	std::filesystem::create_directories(m_directory / "transient");
+	std::filesystem::remove_all(m_directory / "transient");
+	ASSERT_NO_THROW(watcher.Poll());
+
+	Write("scene.json", "{}");
+	ASSERT_EQ(WaitForChanges(watcher, 1),
+		std::vector<std::string>({ (m_directory / "scene.json").lexically_normal().generic_string() }));
+}
+
+TEST_F(TestFileWatcher, RejectsMissingDirectory)
+{
+	FileWatcher watcher;
+	ASSERT_THROW(watcher.Watch(m_directory / "missing"), std::runtime_error);
+}
@@ -0,0 +1,91 @@
+#include <algorithm>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <grafkit/core/geometry_layout.h>
+
+using Grafkit::Core::GEOMETRY_INDEX_ALIGNMENT;
+using Grafkit::Core::GeometryLayout;
+
+TEST(TestGeometryLayout, PadsForStrideAndIndexAlignment)
+{
+	// Worst case padding of both, wherever the allocation lands
+	ASSERT_EQ(Grafkit::Core::GetGeometryAllocationSize(36, 12, 6), 36u + 11u + 6u + 3u);
+	ASSERT_EQ(Grafkit::Core::GetGeometryAllocationSize(0, 1, 12), 12u + 3u);
+
+	// Vertices start on the next multiple of their stride, indices on the next multiple of four after them
+	GeometryLayout layout = Grafkit::Core::GetGeometryLayout(0, 36, 12);
+	EXPECT_EQ(layout.vertexOffset, 0u);
+	EXPECT_EQ(layout.indexOffset, 36u);
+
+	layout = Grafkit::Core::GetGeometryLayout(4, 36, 12);
+	EXPECT_EQ(layout.vertexOffset, 12u);
+	EXPECT_EQ(layout.indexOffset, 48u);
+
+	layout = Grafkit::Core::GetGeometryLayout(8, 18, 6);
+	EXPECT_EQ(layout.vertexOffset, 12u);
+	EXPECT_EQ(layout.indexOffset, 32u);
+
+	layout = Grafkit::Core::GetGeometryLayout(20, 20, 20);
+	EXPECT_EQ(layout.vertexOffset, 20u);
+	EXPECT_EQ(layout.indexOffset, 40u);
+}
+
+TEST(TestGeometryLayout, AllocatesFromVirtualBlock)
+{
+	VmaVirtualBlockCreateInfo blockInfo {};
+	blockInfo.size = 65536;
+	VmaVirtualBlock block = VK_NULL_HANDLE;
+	ASSERT_EQ(vmaCreateVirtualBlock(&blockInfo, &block), VK_SUCCESS);
+
+	struct Placed {
+		VmaVirtualAllocation allocation;
+		VkDeviceSize begin;
+		VkDeviceSize end;
+	};
+
+	// Strides of packed formats along with odd 16 bit index counts
+	const std::vector<VkDeviceSize> strides = { 12, 20, 6, 28, 36, 16 };
+	std::vector<Placed> placed;
+	for (size_t i = 0; i < 24; ++i) {
+		const VkDeviceSize stride = strides[i % strides.size()];
+		const VkDeviceSize vertexSize = stride * (i + 1);
+		const VkDeviceSize indexSize = 2 * (3 * i + 3);
+
+		VmaVirtualAllocation allocation = VK_NULL_HANDLE;
+		const auto layout = Grafkit::Core::AllocateGeometry(block, vertexSize, stride, indexSize, allocation);
+		ASSERT_TRUE(layout.has_value());
+		ASSERT_NE(allocation, VK_NULL_HANDLE);
+
+		EXPECT_EQ(layout->vertexOffset % stride, 0u);
+		EXPECT_EQ(layout->indexOffset % GEOMETRY_INDEX_ALIGNMENT, 0u);
+		EXPECT_GE(layout->indexOffset, layout->vertexOffset + vertexSize);
+
+		// Both of them fit the allocation
+		VmaVirtualAllocationInfo info {};
+		vmaGetVirtualAllocationInfo(block, allocation, &info);
+		EXPECT_GE(layout->vertexOffset, info.offset);
+		EXPECT_LE(layout->indexOffset + indexSize, info.offset + info.size);
+		placed.push_back({ allocation, layout->vertexOffset, layout->indexOffset + indexSize });
+
+		// Freeing every other one leaves holes at odd offsets for the next ones
+		if (i % 2 == 1) {
+			vmaVirtualFree(block, placed[placed.size() - 2].allocation);
+			placed.erase(placed.end() - 2);
+		}
+	}
+
+	std::sort(placed.begin(), placed.end(), [](const Placed& a, const Placed& b) { return a.begin < b.begin; });
+	for (size_t i = 1; i < placed.size(); ++i) {
+		EXPECT_LE(placed[i - 1].end, placed[i].begin);
+	}
+
+	// No room left for something larger than the block
+	VmaVirtualAllocation allocation = VK_NULL_HANDLE;
+	EXPECT_FALSE(Grafkit::Core::AllocateGeometry(block, blockInfo.size, 12, 0, allocation).has_value());
+	EXPECT_EQ(allocation, VK_NULL_HANDLE);
+
+	vmaClearVirtualBlock(block);
+	vmaDestroyVirtualBlock(block);
+}
@@ -0,0 +1,113 @@
+#include <chrono>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <grafkit/descriptors/image_desc.h>
+#include <grafkit/interface/resource.h>
+#include <grafkit_loader/asset_loader_system.h>
+
+using Grafkit::Resource::ImageDesc;
+using Grafkit::Resource::ImageFormat;
+
+namespace {
+	struct TestImage {
+		ImageDesc desc;
+		std::thread::id decodedOn;
+	};
+
+	// Keeps the decoded descriptor, so no device is needed
+	class TestImageBuilder : public Grafkit::Resource::ResourceBuilder<ImageDesc, TestImage> {
+	public:
+		explicit TestImageBuilder(ImageDesc&& desc)
+			: ResourceBuilder(std::move(desc))
+			, m_decodedOn(std::this_thread::get_id())
+		{
+		}
+
+		[[nodiscard]] bool ResolveDependencies(
+			[[maybe_unused]] const Grafkit::RefWrapper<Grafkit::Resource::ResourceManager>& resources) final
+		{
+			return true;
+		}
+
+		void Build([[maybe_unused]] const Grafkit::Core::DeviceRef& device) final
+		{
+			m_resource = std::make_shared<TestImage>(TestImage { std::move(m_descriptor), m_decodedOn });
+		}
+
+	private:
+		std::thread::id m_decodedOn;
+	};
+} // namespace
+
+TEST(TestImageAsset, ExpandsRgbToRgba)
+{
+	Grafkit::Asset::ImageAssetLoader loader;
+	const auto desc = loader.Load("images/rgb.png")->DeserializeAs<ImageDesc>();
+
+	ASSERT_EQ(desc.size, glm::uvec3(2, 2, 1));
+	ASSERT_EQ(desc.format, ImageFormat::RGBA);
+	ASSERT_EQ(desc.channels, 4u);
+	const std::vector<uint8_t> expected = { 255, 0, 0, 255, 0, 255, 0, 255, 0, 0, 255, 255, 255, 255, 255, 255 };
+	ASSERT_EQ(desc.image, expected);
+}
+
+TEST(TestImageAsset, KeepsGrayscale)
+{
+	Grafkit::Asset::ImageAssetLoader loader;
+	ImageDesc desc;
+	desc.useMipmap = true;
+	loader.Load("images/gray.png")->DeserializeInto(desc);
+
+	ASSERT_EQ(desc.format, ImageFormat::Grayscale);
+	ASSERT_EQ(desc.channels, 1u);
+	ASSERT_EQ(desc.image, std::vector<uint8_t>({ 0, 128, 255 }));
+	ASSERT_TRUE(desc.useMipmap);
+}
+
+TEST(TestImageAsset, ReadsHdrAsFloat)
+{
+	Grafkit::Asset::ImageAssetLoader loader;
+	const auto desc = loader.Load("images/gray.hdr")->DeserializeAs<ImageDesc>();
+
+	ASSERT_EQ(desc.format, ImageFormat::RGBAFloat);
+	ASSERT_EQ(desc.size, glm::uvec3(2, 1, 1));
+	ASSERT_EQ(desc.image.size(), 2 * 4 * sizeof(float));
+
+	std::array<float, 8> pixels {};
+	std::memcpy(pixels.data(), desc.image.data(), desc.image.size());
+	ASSERT_FLOAT_EQ(pixels[0], 1.0f);
+	ASSERT_FLOAT_EQ(pixels[4], 0.5f);
+	ASSERT_FLOAT_EQ(pixels[7], 1.0f);
+}
+
+TEST(TestImageAsset, RejectsInvalidData)
+{
+	Grafkit::Asset::ImageAsset asset(std::vector<uint8_t> { 1, 2, 3, 4 });
+	ASSERT_THROW(asset.DeserializeAs<ImageDesc>(), std::runtime_error);
+
+	Grafkit::Asset::ImageAssetLoader loader;
+	ASSERT_THROW(loader.Load("images/rgb.png")->DeserializeAs<Grafkit::Resource::SolidImageDesc>(), std::runtime_error);
+}
+
+TEST(TestImageAsset, DecodesOnWorkers)
+{
+	Grafkit::Resource::ResourceLoaderRegistry::Instance().RegisterBuilder<TestImageBuilder>();
+	Grafkit::Asset::ImageAssetLoader loader;
+	Grafkit::Resource::ResourceManager resources(Grafkit::MakeReferenceAs<Grafkit::Asset::IAssetLoader>(loader), 2);
+
+	auto rgb = resources.LoadAsync<TestImage>("images/rgb.png");
+	auto gray = resources.LoadAsync<TestImage>("images/gray.png");
+
+	const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+	while (resources.GetPendingCount() > 0 && std::chrono::steady_clock::now() < deadline) {
+		resources.Update({});
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+
+	ASSERT_EQ(rgb.get()->desc.format, ImageFormat::RGBA);
+	ASSERT_EQ(gray.get()->desc.format, ImageFormat::Grayscale);
+	ASSERT_NE(rgb.get()->decodedOn, std::this_thread::get_id());
+	ASSERT_NE(gray.get()->decodedOn, std::this_thread::get_id());
+}
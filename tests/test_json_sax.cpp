@@ -0,0 +1,101 @@
+#include <string>
+#include <gtest/gtest.h>
+
+#include <grafkit/descriptors/animation_desc.h>
+#include <grafkit/descriptors/image_desc.h>
+#include <grafkit/descriptors/material_desc.h>
+#include <grafkit/descriptors/mesh_desc.h>
+#include <grafkit_loader/json_adapter.h>
+
+using Grafkit::Asset::JsonAsset;
+
+namespace {
+	JsonAsset MakeAsset(const std::string& text) { return JsonAsset(std::vector<uint8_t>(text.begin(), text.end())); }
+} // namespace
+
+TEST(TestJsonSax, ReadsLargeArray)
+{
+	std::string text = R"({"size": {"x": 64, "y": 32, "z": 1}, "channels": 4, "image": [)";
+	for (uint32_t i = 0; i < 64 * 32 * 4; ++i) {
+		text += (i ? "," : "") + std::to_string(i % 256);
+	}
+	text += "]}";
+
+	const auto desc = MakeAsset(text).DeserializeAs<Grafkit::Resource::ImageDesc>();
+
+	ASSERT_EQ(desc.image.size(), 64u * 32u * 4u);
+	ASSERT_EQ(desc.image.capacity(), desc.image.size());
+	ASSERT_EQ(desc.image[257], 1);
+	ASSERT_EQ(desc.size, glm::uvec3(64, 32, 1));
+	ASSERT_EQ(desc.channels, 4u);
+}
+
+TEST(TestJsonSax, ReadsNestedObjects)
+{
+	const std::string text = R"({
+		"name": "walk, \"loop\" [1]",
+		"duration": 2.5,
+		"isLooping": true,
+		"channels": [
+			{"id": 1, "target": 7, "keys": [
+				{"time": 0.0, "interpolation": 0, "value": {"x": 1, "y": 2, "z": 3, "w": 4}},
+				{"time": 1.5, "value": {"x": 5, "y": 6, "z": 7, "w": 8}}
+			]},
+			{"id": 2, "keys": []}
+		]
+	})";
+
+	const auto desc = MakeAsset(text).DeserializeAs<Grafkit::Resource::AnimationClipDesc>();
+
+	ASSERT_EQ(desc.name, "walk, \"loop\" [1]");
+	ASSERT_FLOAT_EQ(desc.duration, 2.5f);
+	ASSERT_TRUE(desc.isLooping);
+	ASSERT_EQ(desc.channels.size(), 2u);
+	ASSERT_EQ(desc.channels[0].target, 7u);
+	ASSERT_EQ(desc.channels[0].keys.size(), 2u);
+	ASSERT_EQ(desc.channels[0].keys[0].interpolation, Grafkit::Resource::KeyInterpolation::Step);
+	ASSERT_EQ(desc.channels[0].keys[1].interpolation, Grafkit::Resource::KeyInterpolation::Linear);
+	ASSERT_EQ(desc.channels[0].keys[1].value, glm::vec4(5, 6, 7, 8));
+	ASSERT_TRUE(desc.channels[1].keys.empty());
+}
+
+TEST(TestJsonSax, ReadsMaps)
+{
+	const auto material = MakeAsset(R"({"name": "test", "textures": [[1, "diffuse.png"], [3, "normal.png"]]})")
+							  .DeserializeAs<Grafkit::Resource::MaterialDesc>();
+
+	ASSERT_EQ(material.name, "test");
+	ASSERT_EQ(material.textures.size(), 2u);
+	ASSERT_EQ(material.textures.at(static_cast<Grafkit::Resource::TextureType>(3)), "normal.png");
+
+	const auto mesh = MakeAsset(R"({
+		"name": "quad",
+		"primitives": [{"positions": [{"x": 0, "y": 1, "z": 2}], "indices": [0, 1, 2]}],
+		"materials": {"a": 1, "b": 2}
+	})")
+						  .DeserializeAs<Grafkit::Resource::MeshDesc>();
+
+	ASSERT_EQ(mesh.primitives.size(), 1u);
+	ASSERT_EQ(mesh.primitives[0].positions[0], glm::vec3(0, 1, 2));
+	ASSERT_EQ(mesh.primitives[0].indices.size(), 3u);
+	ASSERT_EQ(mesh.materials.at("b"), 2u);
+}
+
+TEST(TestJsonSax, SkipsUnknownFields)
+{
+	Grafkit::Resource::MaterialDesc material;
+	material.stage = "default";
+
+	auto asset = MakeAsset(R"({"extra": {"a": [1, {"b": null}], "c": "d"}, "name": "test", "more": [[]]})");
+	asset.DeserializeInto(material);
+
+	ASSERT_EQ(material.name, "test");
+	ASSERT_EQ(material.stage, "default");
+}
+
+TEST(TestJsonSax, MalformedInputThrows)
+{
+	ASSERT_THROW(MakeAsset(R"({"name": "test")").DeserializeAs<Grafkit::Resource::MaterialDesc>(), std::exception);
+	ASSERT_THROW(MakeAsset(R"({"name": 42})").DeserializeAs<Grafkit::Resource::MaterialDesc>(), std::exception);
+	ASSERT_THROW(MakeAsset(R"([1, 2])").DeserializeAs<Grafkit::Resource::MaterialDesc>(), std::exception);
+}
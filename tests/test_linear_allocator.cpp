@@ -0,0 +1,93 @@
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <grafkit/core/linear_allocator.h>
+
+using Grafkit::Core::LinearAllocator;
+
+TEST(TestLinearAllocator, AlignsOffsets)
+{
+	LinearAllocator allocator(1024, 256);
+
+	EXPECT_EQ(allocator.Allocate(64), 0u);
+	EXPECT_EQ(allocator.Allocate(100), 256u);
+	EXPECT_EQ(allocator.Allocate(256), 512u);
+	EXPECT_EQ(allocator.GetUsedSize(), 768u);
+
+	// No alignment at all is the same as packing them
+	LinearAllocator packed(64, 0);
+	EXPECT_EQ(packed.GetAlignment(), 1u);
+	EXPECT_EQ(packed.Allocate(3), 0u);
+	EXPECT_EQ(packed.Allocate(5), 3u);
+}
+
+TEST(TestLinearAllocator, FailsWhenFullUntilReset)
+{
+	LinearAllocator allocator(512, 256);
+
+	EXPECT_EQ(allocator.Allocate(200), 0u);
+	EXPECT_EQ(allocator.Allocate(256), 256u);
+	EXPECT_EQ(allocator.GetUsedSize(), 512u);
+
+	// Overflowing ones fail, and so do the ones after them even if they would fit
+	EXPECT_FALSE(allocator.Allocate(1).has_value());
+	EXPECT_FALSE(allocator.Allocate(1024).has_value());
+	EXPECT_EQ(allocator.GetUsedSize(), allocator.GetSize());
+
+	allocator.Reset();
+	EXPECT_EQ(allocator.GetUsedSize(), 0u);
+	EXPECT_EQ(allocator.Allocate(512), 0u);
+}
+
+TEST(TestLinearAllocator, FitsTheLastAllocationWithoutItsPadding)
+{
+	// The end of the range needs no padding after it
+	LinearAllocator allocator(300, 256);
+	EXPECT_EQ(allocator.Allocate(16), 0u);
+	EXPECT_EQ(allocator.Allocate(44), 256u);
+	EXPECT_FALSE(allocator.Allocate(45).has_value());
+}
+
+TEST(TestLinearAllocator, RejectsAlignmentNotPowerOfTwo)
+{
+	EXPECT_THROW(LinearAllocator(1024, 48), std::invalid_argument);
+	EXPECT_NO_THROW(LinearAllocator(1024, 64));
+}
+
+TEST(TestLinearAllocator, HandsOutDistinctOffsetsAcrossThreads)
+{
+	constexpr size_t threadCount = 4;
+	constexpr size_t allocationCount = 256;
+	LinearAllocator allocator(threadCount * allocationCount * 64, 64);
+
+	std::vector<std::vector<VkDeviceSize>> offsets(threadCount);
+	std::vector<std::thread> threads;
+	for (size_t i = 0; i < threadCount; ++i) {
+		threads.emplace_back([&allocator, &offsets, i]() {
+			for (size_t j = 0; j < allocationCount; ++j) {
+				const auto offset = allocator.Allocate(1 + j % 64);
+				ASSERT_TRUE(offset.has_value());
+				offsets[i].push_back(*offset);
+			}
+		});
+	}
+	for (auto &thread : threads) {
+		thread.join();
+	}
+
+	std::vector<VkDeviceSize> all;
+	for (const auto &threadOffsets : offsets) {
+		all.insert(all.end(), threadOffsets.begin(), threadOffsets.end());
+	}
+	ASSERT_EQ(all.size(), threadCount * allocationCount);
+
+	std::sort(all.begin(), all.end());
+	for (size_t i = 0; i < all.size(); ++i) {
+		EXPECT_EQ(all[i], i * 64);
+	}
+	EXPECT_EQ(allocator.GetUsedSize(), allocator.GetSize());
+}
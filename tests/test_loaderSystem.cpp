@@ -35,3 +35,18 @@ TEST_F(TestLoaderSystem, ReadDataAndDeserialize)
 
 	ASSERT_EQ(materialDesc.name, "test");
 }
+
+TEST_F(TestLoaderSystem, DeserializeInPlace)
+{
+	const SerializedAssetPtr serializedData = m_assetLoader->Load("test.json");
+	ASSERT_TRUE(serializedData != nullptr);
+	ASSERT_FALSE(serializedData->GetData().empty());
+
+	// Fields missing from the asset keep the value of the target
+	Grafkit::Resource::MaterialDesc materialDesc;
+	materialDesc.stage = "default";
+	serializedData->DeserializeInto(materialDesc);
+
+	ASSERT_EQ(materialDesc.name, "test");
+	ASSERT_EQ(materialDesc.stage, "default");
+}
@@ -0,0 +1,231 @@
+#include <algorithm>
+#include <array>
+#include <random>
+#include <tuple>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <grafkit/descriptors/mesh_desc.h>
+#include <grafkit/resource/mesh_optimizer.h>
+#include <grafkit/resource/mesh_simplifier.h>
+
+using Grafkit::Resource::MeshOptimizeOptions;
+namespace MeshOptimizer = Grafkit::Resource::MeshOptimizer;
+
+namespace {
+	struct TestVertex {
+		glm::vec3 position;
+		uint32_t id;
+	};
+
+	using Triangle = std::array<std::tuple<float, float, float>, 3>;
+
+	// Grid of quads in the XY plane, triangles shuffled to ruin the cache locality of the original order
+	void MakeGrid(const uint32_t size, std::vector<glm::vec3>& positions, std::vector<uint32_t>& indices)
+	{
+		for (uint32_t y = 0; y <= size; ++y) {
+			for (uint32_t x = 0; x <= size; ++x) {
+				positions.emplace_back(static_cast<float>(x), static_cast<float>(y), 0.0f);
+			}
+		}
+
+		std::vector<std::array<uint32_t, 3>> triangles;
+		for (uint32_t y = 0; y < size; ++y) {
+			for (uint32_t x = 0; x < size; ++x) {
+				const uint32_t corner = y * (size + 1) + x;
+				triangles.push_back({ corner, corner + 1, corner + size + 2 });
+				triangles.push_back({ corner, corner + size + 2, corner + size + 1 });
+			}
+		}
+		std::shuffle(triangles.begin(), triangles.end(), std::mt19937(42));
+
+		for (const auto& triangle : triangles) {
+			indices.insert(indices.end(), triangle.begin(), triangle.end());
+		}
+	}
+
+	// Triangles by their corner positions, each rotated to start at its smallest corner so winding is kept
+	std::vector<Triangle> GetTriangles(const std::vector<glm::vec3>& positions, const std::vector<uint32_t>& indices)
+	{
+		std::vector<Triangle> triangles;
+		for (size_t i = 0; i < indices.size(); i += 3) {
+			Triangle triangle;
+			for (size_t corner = 0; corner < 3; ++corner) {
+				const glm::vec3& position = positions[indices[i + corner]];
+				triangle[corner] = { position.x, position.y, position.z };
+			}
+			std::rotate(triangle.begin(), std::min_element(triangle.begin(), triangle.end()), triangle.end());
+			triangles.push_back(triangle);
+		}
+		std::sort(triangles.begin(), triangles.end());
+		return triangles;
+	}
+} // namespace
+
+TEST(TestMeshOptimizer, CalculatesAcmr)
+{
+	ASSERT_FLOAT_EQ(MeshOptimizer::CalculateAcmr(std::vector<uint32_t> { 0, 1, 2 }, 3), 3.0f);
+	ASSERT_FLOAT_EQ(MeshOptimizer::CalculateAcmr(std::vector<uint32_t> { 0, 1, 2, 2, 1, 3 }, 4), 2.0f);
+
+	// Six vertices do not fit a cache of four, every one of them misses again
+	const std::vector<uint32_t> indices = { 0, 1, 2, 3, 4, 5, 0, 1, 2 };
+	ASSERT_FLOAT_EQ(MeshOptimizer::CalculateAcmr(indices, 6, 4), 3.0f);
+	ASSERT_FLOAT_EQ(MeshOptimizer::CalculateAcmr(indices, 6, 8), 2.0f);
+
+	ASSERT_THROW((void)MeshOptimizer::CalculateAcmr(std::vector<uint32_t> { 0, 1 }, 2), std::invalid_argument);
+	ASSERT_THROW((void)MeshOptimizer::CalculateAcmr(std::vector<uint32_t> { 0, 1, 3 }, 3), std::invalid_argument);
+}
+
+TEST(TestMeshOptimizer, OptimizesVertexCache)
+{
+	std::vector<glm::vec3> positions;
+	std::vector<uint32_t> indices;
+	MakeGrid(32, positions, indices);
+	const auto vertexCount = static_cast<uint32_t>(positions.size());
+
+	const auto optimized = MeshOptimizer::OptimizeVertexCache(indices, vertexCount);
+
+	ASSERT_EQ(GetTriangles(positions, optimized), GetTriangles(positions, indices));
+	ASSERT_GT(MeshOptimizer::CalculateAcmr(indices, vertexCount), 2.0f);
+	ASSERT_LT(MeshOptimizer::CalculateAcmr(optimized, vertexCount), 1.0f);
+}
+
+TEST(TestMeshOptimizer, OptimizesOverdraw)
+{
+	// Two parallel triangles facing the same way, the one facing out of the mesh occludes the other, it goes first
+	std::vector<glm::vec3> positions = { { 0, 0, 1 }, { 1, 0, 1 }, { 0, 1, 1 }, { 0, 0, -1 }, { 0, 1, -1 },
+		{ 1, 0, -1 } };
+	const std::vector<uint32_t> indices = { 3, 5, 4, 0, 1, 2 };
+	ASSERT_EQ(MeshOptimizer::OptimizeOverdraw(indices, positions), std::vector<uint32_t>({ 0, 1, 2, 3, 5, 4 }));
+
+	std::vector<glm::vec3> gridPositions;
+	std::vector<uint32_t> gridIndices;
+	MakeGrid(32, gridPositions, gridIndices);
+	const auto vertexCount = static_cast<uint32_t>(gridPositions.size());
+	const auto cacheOptimized = MeshOptimizer::OptimizeVertexCache(gridIndices, vertexCount);
+	const auto overdrawOptimized = MeshOptimizer::OptimizeOverdraw(cacheOptimized, gridPositions, 16, 1.05f);
+
+	// Clusters are kept whole, the cache efficiency is kept within the threshold, give or take a cluster boundary
+	ASSERT_EQ(GetTriangles(gridPositions, overdrawOptimized), GetTriangles(gridPositions, gridIndices));
+	ASSERT_LT(MeshOptimizer::CalculateAcmr(overdrawOptimized, vertexCount),
+		MeshOptimizer::CalculateAcmr(cacheOptimized, vertexCount) * 1.25f);
+}
+
+TEST(TestMeshOptimizer, OptimizesVertexFetch)
+{
+	std::vector<uint32_t> indices = { 4, 2, 0, 0, 2, 3 };
+	const auto remap = MeshOptimizer::OptimizeVertexFetch(indices, 6);
+
+	ASSERT_EQ(indices, std::vector<uint32_t>({ 0, 1, 2, 2, 1, 3 }));
+	// Unreferenced vertices keep their relative order at the end
+	ASSERT_EQ(remap, std::vector<uint32_t>({ 2, 4, 1, 3, 0, 5 }));
+}
+
+TEST(TestMeshOptimizer, OptimizesVertexStructs)
+{
+	std::vector<glm::vec3> positions;
+	std::vector<uint32_t> indices;
+	MakeGrid(16, positions, indices);
+
+	std::vector<TestVertex> vertices;
+	for (uint32_t i = 0; i < positions.size(); ++i) {
+		vertices.push_back({ positions[i], i });
+	}
+	const auto triangles = GetTriangles(positions, indices);
+
+	const auto stats = MeshOptimizer::Optimize(vertices, indices);
+
+	std::vector<glm::vec3> optimizedPositions;
+	for (const auto& vertex : vertices) {
+		ASSERT_EQ(vertex.position, positions[vertex.id]);
+		optimizedPositions.push_back(vertex.position);
+	}
+	ASSERT_EQ(GetTriangles(optimizedPositions, indices), triangles);
+	ASSERT_EQ(stats.triangleCount, indices.size() / 3);
+	ASSERT_LT(stats.acmrAfter, stats.acmrBefore);
+
+	// First use order, every vertex is fetched after the ones before it
+	uint32_t next = 0;
+	for (const uint32_t index : indices) {
+		ASSERT_LE(index, next);
+		next = std::max(next, index + 1);
+	}
+}
+
+TEST(TestMeshOptimizer, OptimizesMeshDescPrimitives)
+{
+	Grafkit::Resource::MeshDescV2 mesh {};
+	std::vector<uint32_t> firstIndices;
+	std::vector<uint32_t> secondIndices;
+	MakeGrid(8, mesh.positions, firstIndices);
+	std::vector<glm::vec3> secondPositions;
+	MakeGrid(4, secondPositions, secondIndices);
+
+	const auto firstVertexCount = static_cast<uint32_t>(mesh.positions.size());
+	mesh.positions.insert(mesh.positions.end(), secondPositions.begin(), secondPositions.end());
+	mesh.indices = firstIndices;
+	mesh.indices.insert(mesh.indices.end(), secondIndices.begin(), secondIndices.end());
+	for (const auto& position : mesh.positions) {
+		mesh.texCoords.emplace_back(position.x, position.y);
+	}
+	mesh.primitives = {
+		{ 0, static_cast<uint32_t>(firstIndices.size()), 0, firstVertexCount, 0 },
+		{ static_cast<uint32_t>(firstIndices.size()), static_cast<uint32_t>(secondIndices.size()), firstVertexCount,
+			static_cast<uint32_t>(secondPositions.size()), 1 },
+	};
+
+	const auto stats = MeshOptimizer::Optimize(mesh);
+
+	ASSERT_EQ(stats.triangleCount, (firstIndices.size() + secondIndices.size()) / 3);
+	ASSERT_LT(stats.acmrAfter, stats.acmrBefore);
+
+	// Streams are remapped together, within the range of their own primitive
+	for (size_t i = 0; i < mesh.positions.size(); ++i) {
+		ASSERT_EQ(mesh.texCoords[i], glm::vec2(mesh.positions[i].x, mesh.positions[i].y));
+	}
+	const std::vector<uint32_t> second(mesh.indices.begin() + static_cast<ptrdiff_t>(firstIndices.size()),
+		mesh.indices.end());
+	const std::vector<glm::vec3> remappedSecond(mesh.positions.begin() + firstVertexCount, mesh.positions.end());
+	ASSERT_EQ(GetTriangles(remappedSecond, second), GetTriangles(secondPositions, secondIndices));
+
+	mesh.primitives[1].vertexCount += 1;
+	ASSERT_THROW(MeshOptimizer::Optimize(mesh), std::out_of_range);
+}
+
+TEST(TestMeshOptimizer, RemapsLevelsOfDetail)
+{
+	Grafkit::Resource::MeshDescV2 mesh {};
+	MakeGrid(16, mesh.positions, mesh.indices);
+	mesh.primitives = {
+		{ 0, static_cast<uint32_t>(mesh.indices.size()), 0, static_cast<uint32_t>(mesh.positions.size()), 0 },
+	};
+	Grafkit::Resource::MeshSimplifier::GenerateLods(mesh);
+	ASSERT_FALSE(mesh.primitives[0].lods.empty());
+
+	const auto getLodTriangles = [&mesh]() {
+		std::vector<std::vector<Triangle>> result;
+		for (const auto& lod : mesh.primitives[0].lods) {
+			const auto begin = mesh.indices.begin() + lod.indexOffset;
+			result.push_back(GetTriangles(mesh.positions, std::vector<uint32_t>(begin, begin + lod.indexCount)));
+		}
+		return result;
+	};
+	const auto lods = mesh.primitives[0].lods;
+	const auto lodTriangles = getLodTriangles();
+	const size_t indexCount = mesh.indices.size();
+
+	(void)MeshOptimizer::Optimize(mesh);
+
+	// Every level still draws the same triangles over the remapped vertices, in place
+	ASSERT_EQ(mesh.indices.size(), indexCount);
+	ASSERT_EQ(mesh.primitives[0].lods.size(), lods.size());
+	for (size_t i = 0; i < lods.size(); ++i) {
+		EXPECT_EQ(mesh.primitives[0].lods[i].indexOffset, lods[i].indexOffset);
+		EXPECT_EQ(mesh.primitives[0].lods[i].indexCount, lods[i].indexCount);
+	}
+	EXPECT_EQ(getLodTriangles(), lodTriangles);
+
+	mesh.primitives[0].lods.back().indexCount += 3;
+	ASSERT_THROW(MeshOptimizer::Optimize(mesh), std::out_of_range);
+}
@@ -0,0 +1,289 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <grafkit/descriptors/mesh_desc.h>
+#include <grafkit/resource/mesh_simplifier.h>
+#include <grafkit/utils/thread_pool.h>
+
+using Grafkit::Resource::MeshDescV2;
+using Grafkit::Resource::MeshLodOptions;
+namespace MeshSimplifier = Grafkit::Resource::MeshSimplifier;
+
+namespace {
+	// Grid of quads in the XY plane facing +Z, counter-clockwise; the seam column has its vertices split in two
+	void MakeGrid(const uint32_t size,
+		std::vector<glm::vec3>& positions,
+		std::vector<uint32_t>& indices,
+		const uint32_t seam = ~0u)
+	{
+		const uint32_t rowSize = size + 1;
+		for (uint32_t y = 0; y <= size; ++y) {
+			for (uint32_t x = 0; x <= size; ++x) {
+				positions.emplace_back(static_cast<float>(x), static_cast<float>(y), 0.0f);
+			}
+		}
+
+		// Twins of the seam column are appended after the grid, the right side of the seam uses them
+		const auto vertex = [&](const uint32_t x, const uint32_t y, const bool isRightSide) {
+			if (x == seam && isRightSide) {
+				return rowSize * rowSize + y;
+			}
+			return y * rowSize + x;
+		};
+		if (seam <= size) {
+			for (uint32_t y = 0; y <= size; ++y) {
+				positions.push_back(positions[y * rowSize + seam]);
+			}
+		}
+
+		for (uint32_t y = 0; y < size; ++y) {
+			for (uint32_t x = 0; x < size; ++x) {
+				const bool isRight = x >= seam;
+				const uint32_t a = vertex(x, y, isRight);
+				const uint32_t b = vertex(x + 1, y, isRight);
+				const uint32_t c = vertex(x + 1, y + 1, isRight);
+				const uint32_t d = vertex(x, y + 1, isRight);
+				indices.insert(indices.end(), { a, b, c, a, c, d });
+			}
+		}
+	}
+
+	float SignedArea(const std::vector<uint32_t>& indices, const std::vector<glm::vec3>& positions)
+	{
+		float area = 0.0f;
+		for (size_t i = 0; i < indices.size(); i += 3) {
+			const glm::vec3& a = positions[indices[i]];
+			area += glm::cross(positions[indices[i + 1]] - a, positions[indices[i + 2]] - a).z * 0.5f;
+		}
+		return area;
+	}
+
+	// After Ericson: Real-Time Collision Detection, 5.1.5
+	glm::vec3 ClosestPointOnTriangle(const glm::vec3& p, const glm::vec3& a, const glm::vec3& b, const glm::vec3& c)
+	{
+		const glm::vec3 ab = b - a;
+		const glm::vec3 ac = c - a;
+		const glm::vec3 ap = p - a;
+		const float d1 = glm::dot(ab, ap);
+		const float d2 = glm::dot(ac, ap);
+		if (d1 <= 0.0f && d2 <= 0.0f) {
+			return a;
+		}
+
+		const glm::vec3 bp = p - b;
+		const float d3 = glm::dot(ab, bp);
+		const float d4 = glm::dot(ac, bp);
+		if (d3 >= 0.0f && d4 <= d3) {
+			return b;
+		}
+
+		const float vc = d1 * d4 - d3 * d2;
+		if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) {
+			return a + ab * (d1 / (d1 - d3));
+		}
+
+		const glm::vec3 cp = p - c;
+		const float d5 = glm::dot(ab, cp);
+		const float d6 = glm::dot(ac, cp);
+		if (d6 >= 0.0f && d5 <= d6) {
+			return c;
+		}
+
+		const float vb = d5 * d2 - d1 * d6;
+		if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) {
+			return a + ac * (d2 / (d2 - d6));
+		}
+
+		const float va = d3 * d6 - d5 * d4;
+		if (va <= 0.0f && d4 - d3 >= 0.0f && d5 - d6 >= 0.0f) {
+			return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+		}
+
+		const float denominator = 1.0f / (va + vb + vc);
+		return a + ab * (vb * denominator) + ac * (vc * denominator);
+	}
+
+	// Farthest any of the original vertices got from the simplified surface
+	float MaxDistanceFromSurface(const std::vector<uint32_t>& original,
+		const std::vector<uint32_t>& simplified,
+		const std::vector<glm::vec3>& positions)
+	{
+		float maxDistance = 0.0f;
+		for (const uint32_t vertex : original) {
+			const glm::vec3& p = positions[vertex];
+			float distance = std::numeric_limits<float>::max();
+			for (size_t i = 0; i < simplified.size(); i += 3) {
+				const glm::vec3 closest = ClosestPointOnTriangle(
+					p, positions[simplified[i]], positions[simplified[i + 1]], positions[simplified[i + 2]]);
+				distance = std::min(distance, glm::length(p - closest));
+			}
+			maxDistance = std::max(maxDistance, distance);
+		}
+		return maxDistance;
+	}
+} // namespace
+
+TEST(TestMeshSimplifier, FlatGridKeepsItsShape)
+{
+	std::vector<glm::vec3> positions;
+	std::vector<uint32_t> indices;
+	MakeGrid(16, positions, indices);
+
+	float error = 1.0f;
+	const std::vector<uint32_t> result
+		= MeshSimplifier::Simplify(indices, positions, indices.size() / 4, 0.01f, &error);
+
+	EXPECT_LE(result.size(), indices.size() / 4);
+	EXPECT_EQ(result.size() % 3, 0u);
+	EXPECT_NEAR(error, 0.0f, 1e-4f);
+	// Borders stay in place, nothing folds over
+	EXPECT_NEAR(SignedArea(result, positions), 256.0f, 1e-2f);
+}
+
+TEST(TestMeshSimplifier, KeepsSeams)
+{
+	std::vector<glm::vec3> positions;
+	std::vector<uint32_t> indices;
+	MakeGrid(16, positions, indices, 8);
+	const uint32_t firstTwin = 17 * 17;
+
+	const std::vector<uint32_t> result = MeshSimplifier::Simplify(indices, positions, indices.size() / 4, 0.01f);
+	EXPECT_LT(result.size(), indices.size() / 2);
+	EXPECT_NEAR(SignedArea(result, positions), 256.0f, 1e-2f);
+
+	// Triangles stay on their side of the seam
+	for (size_t i = 0; i < result.size(); i += 3) {
+		const glm::vec3 center
+			= (positions[result[i]] + positions[result[i + 1]] + positions[result[i + 2]]) * (1.0f / 3.0f);
+		for (size_t corner = 0; corner < 3; ++corner) {
+			const uint32_t index = result[i + corner];
+			if (center.x < 8.0f) {
+				EXPECT_LT(index, firstTwin);
+				EXPECT_LE(positions[index].x, 8.0f);
+			} else {
+				EXPECT_GE(positions[index].x, 8.0f);
+				EXPECT_TRUE(positions[index].x > 8.0f || index >= firstTwin);
+			}
+		}
+	}
+}
+
+TEST(TestMeshSimplifier, StaysWithinError)
+{
+	// A bump in the middle of the grid
+	std::vector<glm::vec3> positions;
+	std::vector<uint32_t> indices;
+	MakeGrid(24, positions, indices);
+	for (glm::vec3& position : positions) {
+		const float dx = position.x - 12.0f;
+		const float dy = position.y - 12.0f;
+		position.z = 4.0f * std::exp(-(dx * dx + dy * dy) / 32.0f);
+	}
+
+	// Errors are relative to the extent of the grid
+	const float extent = 24.0f;
+	float error = 0.0f;
+	const std::vector<uint32_t> result = MeshSimplifier::Simplify(indices, positions, 0, 0.02f, &error);
+	EXPECT_LT(result.size(), indices.size() / 2);
+	EXPECT_GT(result.size(), 0u);
+	EXPECT_LE(error, 0.02f);
+	EXPECT_LE(MaxDistanceFromSurface(indices, result, positions), 0.02f * extent);
+
+	// Hardly anything collapses without error on a curved surface
+	float strictError = 1.0f;
+	const std::vector<uint32_t> strict = MeshSimplifier::Simplify(indices, positions, 0, 0.0f, &strictError);
+	EXPECT_LE(strict.size(), indices.size());
+	EXPECT_LE(strictError, 1e-4f);
+
+	indices.push_back(0);
+	EXPECT_THROW((void)MeshSimplifier::Simplify(indices, positions, 0, 0.01f), std::invalid_argument);
+}
+
+TEST(TestMeshSimplifier, GeneratesLodsInParallel)
+{
+	std::vector<MeshDescV2> meshes(4);
+	for (size_t i = 0; i < meshes.size(); ++i) {
+		MeshDescV2& mesh = meshes[i];
+		mesh.name = "mesh" + std::to_string(i);
+		MakeGrid(static_cast<uint32_t>(8 + i * 4), mesh.positions, mesh.indices);
+		mesh.primitives.push_back({
+			.indexOffset = 0,
+			.indexCount = static_cast<uint32_t>(mesh.indices.size()),
+			.vertexOffset = 0,
+			.vertexCount = static_cast<uint32_t>(mesh.positions.size()),
+			.materialIndex = 0,
+		});
+	}
+
+	std::vector<MeshDescV2> expected = meshes;
+	for (MeshDescV2& mesh : expected) {
+		MeshSimplifier::GenerateLods(mesh);
+	}
+
+	Grafkit::Utils::ThreadPool pool(2);
+	MeshSimplifier::GenerateLods(meshes, MeshLodOptions {}, pool);
+
+	for (size_t i = 0; i < meshes.size(); ++i) {
+		const auto& lods = meshes[i].primitives[0].lods;
+		ASSERT_EQ(lods.size(), 3u);
+		EXPECT_EQ(meshes[i].indices, expected[i].indices);
+
+		uint32_t previousCount = meshes[i].primitives[0].indexCount;
+		for (const auto& lod : lods) {
+			EXPECT_LE(lod.indexCount, previousCount);
+			EXPECT_LE(lod.indexOffset + lod.indexCount, meshes[i].indices.size());
+			EXPECT_LE(lod.error, 0.01f);
+			previousCount = lod.indexCount;
+		}
+	}
+
+	// Errors of a mesh come back after every mesh is done
+	meshes[1].primitives[0].indexCount = static_cast<uint32_t>(meshes[1].indices.size() + 3);
+	EXPECT_THROW(MeshSimplifier::GenerateLods(meshes, MeshLodOptions {}, pool), std::out_of_range);
+}
+
+TEST(TestMeshSimplifier, ReplacesPreviousLods)
+{
+	MeshDescV2 mesh {};
+	mesh.name = "grid";
+	std::vector<uint32_t> second;
+	MakeGrid(8, mesh.positions, mesh.indices);
+	const auto firstCount = static_cast<uint32_t>(mesh.indices.size());
+	const auto firstVertexCount = static_cast<uint32_t>(mesh.positions.size());
+	std::vector<glm::vec3> secondPositions;
+	MakeGrid(12, secondPositions, second);
+	mesh.positions.insert(mesh.positions.end(), secondPositions.begin(), secondPositions.end());
+	mesh.indices.insert(mesh.indices.end(), second.begin(), second.end());
+	mesh.primitives = {
+		{ 0, firstCount, 0, firstVertexCount, 0 },
+		{ firstCount, static_cast<uint32_t>(second.size()), firstVertexCount,
+			static_cast<uint32_t>(secondPositions.size()), 1 },
+	};
+
+	MeshSimplifier::GenerateLods(mesh);
+	const MeshDescV2 expected = mesh;
+	ASSERT_FALSE(expected.primitives[1].lods.empty());
+
+	// The second run leaves no indices of the first one behind
+	MeshSimplifier::GenerateLods(mesh);
+	EXPECT_EQ(mesh.indices, expected.indices);
+	for (size_t i = 0; i < mesh.primitives.size(); ++i) {
+		EXPECT_EQ(mesh.primitives[i].indexOffset, expected.primitives[i].indexOffset);
+		ASSERT_EQ(mesh.primitives[i].lods.size(), expected.primitives[i].lods.size());
+		for (size_t level = 0; level < mesh.primitives[i].lods.size(); ++level) {
+			EXPECT_EQ(mesh.primitives[i].lods[level].indexOffset, expected.primitives[i].lods[level].indexOffset);
+			EXPECT_EQ(mesh.primitives[i].lods[level].indexCount, expected.primitives[i].lods[level].indexCount);
+		}
+	}
+
+	// Fewer levels, the rest goes away too
+	MeshSimplifier::GenerateLods(mesh, MeshLodOptions { .ratios = { 0.5f } });
+	ASSERT_EQ(mesh.primitives[0].lods.size(), 1u);
+	ASSERT_EQ(mesh.primitives[1].lods.size(), 1u);
+	EXPECT_EQ(mesh.indices.size(),
+		firstCount + second.size() + mesh.primitives[0].lods[0].indexCount + mesh.primitives[1].lods[0].indexCount);
+}
@@ -0,0 +1,214 @@
+#include <algorithm>
+#include <array>
+#include <set>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <grafkit/render/mesh.h>
+#include <grafkit/render/meshlet.h>
+#include <grafkit/resource/meshlet_builder.h>
+
+using Grafkit::Meshlet;
+using Grafkit::MeshletCuller;
+using Grafkit::Resource::MeshletData;
+namespace MeshletBuilder = Grafkit::Resource::MeshletBuilder;
+
+namespace {
+	// Grid of quads in the XY plane facing +Z, counter-clockwise
+	void MakeGrid(const uint32_t size, std::vector<glm::vec3>& positions, std::vector<uint32_t>& indices)
+	{
+		for (uint32_t y = 0; y <= size; ++y) {
+			for (uint32_t x = 0; x <= size; ++x) {
+				positions.emplace_back(static_cast<float>(x), static_cast<float>(y), 0.0f);
+			}
+		}
+		for (uint32_t y = 0; y < size; ++y) {
+			for (uint32_t x = 0; x < size; ++x) {
+				const uint32_t corner = y * (size + 1) + x;
+				indices.insert(indices.end(), { corner, corner + 1, corner + size + 2 });
+				indices.insert(indices.end(), { corner, corner + size + 2, corner + size + 1 });
+			}
+		}
+	}
+
+	std::set<std::array<uint32_t, 3>> SortedTriangles(const std::vector<uint32_t>& indices)
+	{
+		std::set<std::array<uint32_t, 3>> triangles;
+		for (size_t i = 0; i < indices.size(); i += 3) {
+			std::array<uint32_t, 3> triangle = { indices[i], indices[i + 1], indices[i + 2] };
+			// Rotate so the smallest comes first, keeps the winding
+			std::rotate(triangle.begin(), std::min_element(triangle.begin(), triangle.end()), triangle.end());
+			triangles.insert(triangle);
+		}
+		return triangles;
+	}
+
+	// Perspective projection looking down -Z from the camera, or +Z when looking back, [-1, 1] depth like glm's
+	// Near plane at 0.1, far plane at 1000
+	glm::mat4 MakeViewProjection(const glm::vec3& camera, const bool isLookingBack = false)
+	{
+		glm::mat4 projection(0.0f);
+		projection[0][0] = 1.0f;
+		projection[1][1] = 1.0f;
+		projection[2][2] = -1000.1f / 999.9f;
+		projection[2][3] = -1.0f;
+		projection[3][2] = -200.0f / 999.9f;
+
+		// Looking back turns around the Y axis
+		const float turn = isLookingBack ? -1.0f : 1.0f;
+		glm::mat4 view(1.0f);
+		view[0][0] = turn;
+		view[2][2] = turn;
+		view[3] = glm::vec4(-camera.x * turn, -camera.y, -camera.z * turn, 1.0f);
+
+		glm::mat4 result(0.0f);
+		for (int column = 0; column < 4; ++column) {
+			result[column] = projection * view[column];
+		}
+		return result;
+	}
+} // namespace
+
+TEST(TestMeshletBuilder, BuildsMeshletsWithinLimits)
+{
+	std::vector<glm::vec3> positions;
+	std::vector<uint32_t> indices;
+	MakeGrid(32, positions, indices);
+
+	const MeshletData data = MeshletBuilder::Build(indices, positions);
+	ASSERT_FALSE(data.meshlets.empty());
+
+	uint32_t triangleOffset = 0;
+	for (const Meshlet& meshlet : data.meshlets) {
+		EXPECT_LE(meshlet.vertexCount, Meshlet::MAX_VERTICES);
+		EXPECT_LE(meshlet.triangleCount, Meshlet::MAX_TRIANGLES);
+		EXPECT_EQ(meshlet.triangleOffset, triangleOffset);
+		triangleOffset += meshlet.triangleCount;
+
+		// Every vertex is within the bounding sphere
+		for (uint32_t i = 0; i < meshlet.vertexCount; ++i) {
+			const glm::vec3& position = positions[data.vertices[meshlet.vertexOffset + i]];
+			EXPECT_LE(glm::length(position - meshlet.center), meshlet.radius * 1.0001f);
+		}
+
+		// A flat grid has a single normal
+		EXPECT_NEAR(meshlet.coneAxis.z, 1.0f, 1e-5f);
+		EXPECT_NEAR(meshlet.coneCutoff, 0.0f, 1e-3f);
+	}
+
+	// Same triangles, same winding; 2048 triangles need at least 17 meshlets
+	const std::vector<uint32_t> meshletIndices = MeshletBuilder::BuildIndices(data);
+	EXPECT_EQ(SortedTriangles(meshletIndices), SortedTriangles(indices));
+	EXPECT_GE(data.meshlets.size(), 17u);
+	EXPECT_LE(data.meshlets.size(), 30u);
+}
+
+TEST(TestMeshletBuilder, SmallLimits)
+{
+	std::vector<glm::vec3> positions;
+	std::vector<uint32_t> indices;
+	MakeGrid(8, positions, indices);
+
+	const MeshletData data = MeshletBuilder::Build(indices, positions, { .maxVertices = 4, .maxTriangles = 2 });
+	for (const Meshlet& meshlet : data.meshlets) {
+		EXPECT_LE(meshlet.vertexCount, 4u);
+		EXPECT_LE(meshlet.triangleCount, 2u);
+	}
+	EXPECT_EQ(SortedTriangles(MeshletBuilder::BuildIndices(data)), SortedTriangles(indices));
+
+	EXPECT_THROW((void)MeshletBuilder::Build(indices, positions, { .maxVertices = 300 }), std::invalid_argument);
+	indices.push_back(0);
+	EXPECT_THROW((void)MeshletBuilder::Build(indices, positions), std::invalid_argument);
+}
+
+TEST(TestMeshletBuilder, CullsFrustumAndBackfaces)
+{
+	std::vector<glm::vec3> positions;
+	std::vector<uint32_t> indices;
+	MakeGrid(32, positions, indices);
+	const MeshletData data = MeshletBuilder::Build(indices, positions);
+
+	const Grafkit::Primitive primitive {
+		.firstIndex = 12,
+		.indexCount = static_cast<uint32_t>(indices.size()),
+		.meshletCount = static_cast<uint32_t>(data.meshlets.size()),
+	};
+
+	// Facing the camera, everything is visible and merges into a single range
+	MeshletCuller culler;
+	const glm::vec3 front(16.0f, 16.0f, 40.0f);
+	culler.SetView(MakeViewProjection(front), front);
+	std::vector<Grafkit::DrawRange> ranges;
+	culler.Cull(primitive, data.meshlets, ranges);
+	ASSERT_EQ(ranges.size(), 1u);
+	EXPECT_EQ(ranges[0].firstIndex, 12u);
+	EXPECT_EQ(ranges[0].indexCount, indices.size());
+
+	// From behind, every meshlet is in view but faces away
+	const glm::vec3 back(16.0f, 16.0f, -40.0f);
+	culler.SetView(MakeViewProjection(back, true), back);
+	ranges.clear();
+	culler.ResetStats();
+	culler.Cull(primitive, data.meshlets, ranges);
+	EXPECT_TRUE(ranges.empty());
+	EXPECT_EQ(culler.GetStats().meshletCount, data.meshlets.size());
+	EXPECT_EQ(culler.GetStats().frustumCulled, 0u);
+	EXPECT_EQ(culler.GetStats().backfaceCulled, data.meshlets.size());
+
+	// Unless backface culling is off
+	culler.SetBackfaceCulling(false);
+	ranges.clear();
+	culler.Cull(primitive, data.meshlets, ranges);
+	ASSERT_EQ(ranges.size(), 1u);
+	EXPECT_EQ(ranges[0].indexCount, indices.size());
+
+	// Looking away, the frustum drops everything
+	culler.SetView(MakeViewProjection(front, true), front);
+	ranges.clear();
+	culler.ResetStats();
+	culler.Cull(primitive, data.meshlets, ranges);
+	EXPECT_TRUE(ranges.empty());
+	EXPECT_EQ(culler.GetStats().frustumCulled, data.meshlets.size());
+
+	// Close to a corner, most of the grid is outside of the 90 degree field of view
+	const glm::vec3 corner(2.0f, 2.0f, 2.0f);
+	culler.SetBackfaceCulling(true);
+	culler.SetView(MakeViewProjection(corner), corner);
+	ranges.clear();
+	culler.ResetStats();
+	culler.Cull(primitive, data.meshlets, ranges);
+	EXPECT_FALSE(ranges.empty());
+	EXPECT_GT(culler.GetStats().frustumCulled, data.meshlets.size() / 2);
+	for (const Grafkit::DrawRange& range : ranges) {
+		EXPECT_GE(range.firstIndex, 12u);
+		EXPECT_LE(range.firstIndex + range.indexCount, 12u + indices.size());
+	}
+}
+
+TEST(TestMeshletBuilder, KeepsMeshletsJustPastTheNearPlane)
+{
+	MeshletCuller culler;
+	const glm::vec3 camera(0.0f);
+	culler.SetView(MakeViewProjection(camera), camera);
+
+	// Between the near plane and where the depth reaches zero in clip space, at about 0.2
+	Meshlet nearMeshlet;
+	nearMeshlet.triangleCount = 1;
+	nearMeshlet.center = glm::vec3(0.0f, 0.0f, -0.15f);
+	nearMeshlet.radius = 0.01f;
+
+	// Fully behind the near plane
+	Meshlet behindMeshlet = nearMeshlet;
+	behindMeshlet.triangleOffset = 1;
+	behindMeshlet.center = glm::vec3(0.0f, 0.0f, -0.05f);
+
+	const Grafkit::Primitive primitive { .indexCount = 6, .meshletCount = 2 };
+	const std::array<Meshlet, 2> meshlets = { nearMeshlet, behindMeshlet };
+	std::vector<Grafkit::DrawRange> ranges;
+	culler.Cull(primitive, meshlets, ranges);
+	ASSERT_EQ(ranges.size(), 1u);
+	EXPECT_EQ(ranges[0].firstIndex, 0u);
+	EXPECT_EQ(ranges[0].indexCount, 3u);
+	EXPECT_EQ(culler.GetStats().frustumCulled, 1u);
+}
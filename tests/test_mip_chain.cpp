@@ -0,0 +1,88 @@
+#include <cstring>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <grafkit/core/mip_chain.h>
+
+using namespace Grafkit::Core;
+
+TEST(TestMipChain, LevelCount)
+{
+	EXPECT_EQ(GetMipLevelCount({ 1, 1, 1 }), 1u);
+	EXPECT_EQ(GetMipLevelCount({ 256, 256, 1 }), 9u);
+	EXPECT_EQ(GetMipLevelCount({ 300, 17, 1 }), 9u);
+	EXPECT_EQ(GetMipLevelCount({ 4, 4, 32 }), 6u);
+}
+
+TEST(TestMipChain, LayoutAlignsLevels)
+{
+	const auto levels = GetMipChainLayout({ 5, 3, 1 }, 3, 1);
+	ASSERT_EQ(levels.size(), 3u);
+
+	EXPECT_EQ(levels[0].extent.width, 5u);
+	EXPECT_EQ(levels[0].extent.height, 3u);
+	EXPECT_EQ(levels[0].offset, 0u);
+	EXPECT_EQ(levels[0].size, 15u);
+
+	EXPECT_EQ(levels[1].extent.width, 2u);
+	EXPECT_EQ(levels[1].extent.height, 1u);
+	EXPECT_EQ(levels[1].offset, 16u);
+	EXPECT_EQ(levels[1].size, 2u);
+
+	EXPECT_EQ(levels[2].extent.width, 1u);
+	EXPECT_EQ(levels[2].extent.height, 1u);
+	EXPECT_EQ(levels[2].offset, 32u);
+
+	EXPECT_EQ(GetMipChainSize({ 5, 3, 1 }, 3, 1), 33u);
+	for (const MipLevel& level : levels) {
+		EXPECT_EQ(level.offset % MIP_LEVEL_ALIGNMENT, 0u);
+	}
+}
+
+TEST(TestMipChain, BoxFiltersUnorm)
+{
+	const auto levels = GetMipChainLayout({ 4, 2, 1 }, 3, 2);
+	std::vector<uint8_t> data(GetMipChainSize({ 4, 2, 1 }, 3, 2), 0xcd);
+
+	// Two channels: a gradient and a constant
+	const uint8_t first[] = {
+		0, 100, 10, 100, 20, 100, 30, 100, //
+		40, 100, 50, 100, 60, 100, 71, 100, //
+	};
+	std::memcpy(data.data(), first, sizeof(first));
+
+	GenerateMipChain(data, levels, 2, MipChannelType::Unorm8);
+
+	const uint8_t* second = data.data() + levels[1].offset;
+	EXPECT_EQ(second[0], 25); // (0 + 10 + 40 + 50) / 4
+	EXPECT_EQ(second[1], 100);
+	EXPECT_EQ(second[2], 45); // (20 + 30 + 60 + 71) / 4, rounded
+	EXPECT_EQ(second[3], 100);
+
+	const uint8_t* third = data.data() + levels[2].offset;
+	EXPECT_EQ(third[0], 35);
+	EXPECT_EQ(third[1], 100);
+}
+
+TEST(TestMipChain, OddEdgeFoldsIntoLastTexel)
+{
+	const auto levels = GetMipChainLayout({ 3, 1, 1 }, 2, sizeof(float));
+	std::vector<uint8_t> data(GetMipChainSize({ 3, 1, 1 }, 2, sizeof(float)));
+
+	const float first[] = { 1.0f, 2.0f, 6.0f };
+	std::memcpy(data.data(), first, sizeof(first));
+
+	GenerateMipChain(data, levels, 1, MipChannelType::Float32);
+
+	float second = 0.0f;
+	std::memcpy(&second, data.data() + levels[1].offset, sizeof(float));
+	EXPECT_FLOAT_EQ(second, 3.0f);
+}
+
+TEST(TestMipChain, ThrowsWhenDataIsShort)
+{
+	const auto levels = GetMipChainLayout({ 4, 4, 1 }, 3, 4);
+	std::vector<uint8_t> data(64);
+	EXPECT_THROW(GenerateMipChain(data, levels, 4, MipChannelType::Unorm8), std::invalid_argument);
+}
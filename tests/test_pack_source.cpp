@@ -0,0 +1,196 @@
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+
+#include <grafkit_loader/asset_loader_system.h>
+#include <grafkit_loader/file_loader.h>
+#include <grafkit_loader/pack_source.h>
+
+using Grafkit::Asset::PackAssetSource;
+using Grafkit::Asset::PackFile;
+
+// test.gkpak is built from data/pack by the packer at build time
+class TestPackSource : public ::testing::Test {
+protected:
+	void SetUp() override { m_source.Mount("test.gkpak"); }
+
+	static std::vector<uint8_t> ReadOriginal(const std::string& name)
+	{
+		std::vector<uint8_t> data;
+		Grafkit::Asset::FileAssetSource::ReadFile(std::filesystem::path("pack") / name, data);
+		return data;
+	}
+
+	PackAssetSource m_source;
+};
+
+TEST_F(TestPackSource, EntriesAreSortedByHash)
+{
+	const PackFile pack("test.gkpak");
+	const auto entries = pack.GetEntries();
+	ASSERT_FALSE(entries.empty());
+	ASSERT_TRUE(std::ranges::is_sorted(entries, {}, &Grafkit::Asset::PackEntry::nameHash));
+
+	for (const auto& entry : entries) {
+		ASSERT_EQ(entry.nameHash, Grafkit::Asset::HashAssetName(pack.GetName(entry)));
+		ASSERT_EQ(entry.dataOffset % 16, 0);
+	}
+}
+
+TEST_F(TestPackSource, ReadData)
+{
+	std::vector<uint8_t> data;
+	m_source.ReadData("test.json", data);
+	ASSERT_EQ(data, ReadOriginal("test.json"));
+}
+
+TEST_F(TestPackSource, ReadCompressedData)
+{
+	const PackFile pack("test.gkpak");
+	const auto* entry = pack.Find("text/lorem.txt");
+	ASSERT_NE(entry, nullptr);
+	ASSERT_NE(entry->flags & Grafkit::Asset::PACK_ENTRY_COMPRESSED, 0);
+	ASSERT_LT(entry->storedSize, entry->size);
+
+	const auto data = m_source.OpenData("text/lorem.txt");
+	ASSERT_TRUE(std::ranges::equal(data->GetData(), ReadOriginal("text/lorem.txt")));
+}
+
+TEST_F(TestPackSource, NormalizedNames)
+{
+	std::vector<uint8_t> data;
+	m_source.ReadData("./text\\lorem.txt", data);
+	ASSERT_EQ(data, ReadOriginal("text/lorem.txt"));
+}
+
+TEST_F(TestPackSource, MissingAsset)
+{
+	std::vector<uint8_t> data;
+	ASSERT_THROW(m_source.ReadData("does_not_exist.json", data), std::runtime_error);
+}
+
+TEST_F(TestPackSource, InvalidPack)
+{
+	const auto path = std::filesystem::temp_directory_path() / "grafkit_test_invalid.gkpak";
+	{
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		const std::string content(256, 'x');
+		file.write(content.data(), static_cast<std::streamsize>(content.size()));
+	}
+	ASSERT_THROW(PackFile{path}, std::runtime_error);
+	std::filesystem::remove(path);
+}
+
+TEST_F(TestPackSource, HashCollision)
+{
+	// Two entries sharing the hash of the second one's name, as a collision would leave them
+	const auto path = std::filesystem::temp_directory_path() / "grafkit_test_collision.gkpak";
+	const uint64_t hash = Grafkit::Asset::HashAssetName("wanted.txt");
+	const std::string names = "other.txtwanted.txt";
+
+	Grafkit::Asset::PackHeader header {};
+	header.magic = Grafkit::Asset::PACK_MAGIC;
+	header.version = Grafkit::Asset::PACK_VERSION;
+	header.entryCount = 2;
+	header.blockSize = 4096;
+	header.entryTableOffset = sizeof(header);
+	header.blockTableOffset = header.entryTableOffset + 2 * sizeof(Grafkit::Asset::PackEntry);
+	header.stringTableOffset = header.blockTableOffset;
+	header.stringTableSize = names.size();
+
+	const uint64_t dataOffset = 176;
+	const Grafkit::Asset::PackEntry entries[2] = {
+		{ hash, dataOffset, 5, 5, 0, 9, 0, 0 },
+		{ hash, dataOffset + 16, 6, 6, 9, 10, 0, 0 },
+	};
+
+	std::vector<char> content(dataOffset + 32, 0);
+	std::memcpy(content.data(), &header, sizeof(header));
+	std::memcpy(content.data() + header.entryTableOffset, entries, sizeof(entries));
+	std::memcpy(content.data() + header.stringTableOffset, names.data(), names.size());
+	std::memcpy(content.data() + dataOffset, "OTHER", 5);
+	std::memcpy(content.data() + dataOffset + 16, "WANTED", 6);
+	{
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		file.write(content.data(), static_cast<std::streamsize>(content.size()));
+	}
+
+	{
+		const PackFile pack(path);
+		const auto* entry = pack.Find("wanted.txt");
+		ASSERT_NE(entry, nullptr);
+		ASSERT_EQ(pack.GetName(*entry), "wanted.txt");
+		ASSERT_EQ(pack.Find(".\\wanted.txt"), entry);
+
+		std::vector<uint8_t> data(entry->size);
+		pack.ReadEntry(*entry, data);
+		ASSERT_EQ(std::string(data.begin(), data.end()), "WANTED");
+	}
+	std::filesystem::remove(path);
+}
+
+TEST_F(TestPackSource, CorruptPack)
+{
+	// A valid pack of a single uncompressed entry, corrupted one field at a time
+	const auto path = std::filesystem::temp_directory_path() / "grafkit_test_corrupt.gkpak";
+	const std::string name = "entry.txt";
+	const uint64_t dataOffset = 144;
+
+	Grafkit::Asset::PackHeader header {};
+	header.magic = Grafkit::Asset::PACK_MAGIC;
+	header.version = Grafkit::Asset::PACK_VERSION;
+	header.entryCount = 1;
+	header.blockSize = 4096;
+	header.entryTableOffset = sizeof(header);
+	header.blockTableOffset = header.entryTableOffset + sizeof(Grafkit::Asset::PackEntry);
+	header.stringTableOffset = header.blockTableOffset;
+	header.stringTableSize = name.size();
+
+	const Grafkit::Asset::PackEntry entry
+		= { Grafkit::Asset::HashAssetName(name), dataOffset, 5, 5, 0, static_cast<uint32_t>(name.size()), 0, 0 };
+
+	const auto write = [&](const Grafkit::Asset::PackHeader& packHeader, const Grafkit::Asset::PackEntry& packEntry) {
+		std::vector<char> content(dataOffset + 64, 0);
+		std::memcpy(content.data(), &packHeader, sizeof(packHeader));
+		std::memcpy(content.data() + header.entryTableOffset, &packEntry, sizeof(packEntry));
+		std::memcpy(content.data() + header.stringTableOffset, name.data(), name.size());
+		std::memcpy(content.data() + dataOffset, "ENTRY", 5);
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		file.write(content.data(), static_cast<std::streamsize>(content.size()));
+	};
+
+	write(header, entry);
+	{
+		const PackFile pack(path);
+		std::vector<uint8_t> data(entry.size);
+		pack.ReadEntry(*pack.Find(name), data);
+		ASSERT_EQ(std::string(data.begin(), data.end()), "ENTRY");
+	}
+
+	// Stored size of an uncompressed entry past its size would be copied over the end of the target
+	auto corruptEntry = entry;
+	corruptEntry.storedSize = 64;
+	write(header, corruptEntry);
+	ASSERT_THROW(PackFile{path}, std::runtime_error);
+
+	auto corruptHeader = header;
+	corruptHeader.blockSize = 0;
+	write(corruptHeader, entry);
+	ASSERT_THROW(PackFile{path}, std::runtime_error);
+
+	corruptHeader = header;
+	corruptHeader.blockTableOffset -= 2;
+	write(corruptHeader, entry);
+	ASSERT_THROW(PackFile{path}, std::runtime_error);
+
+	std::filesystem::remove(path);
+}
+
+TEST(PackJsonAssetLoader, LoadFromPack)
+{
+	Grafkit::Asset::PackJsonAssetLoader loader("test.gkpak");
+	const auto asset = loader.Load("test.json");
+	ASSERT_NE(asset, nullptr);
+	ASSERT_FALSE(asset->GetData().empty());
+}
@@ -0,0 +1,383 @@
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <grafkit/interface/asset.h>
+#include <grafkit/interface/resource.h>
+#include <grafkit/utils/thread_pool.h>
+
+using Grafkit::Resource::ResourceManager;
+
+namespace {
+	struct TestDesc {
+		std::string value;
+		std::string dependency;
+	};
+
+	struct TestResource {
+		std::string value;
+		std::thread::id builtOn;
+	};
+
+	struct TestDependentResource {
+		std::shared_ptr<TestResource> dependency;
+	};
+
+	// Each asset name deserializes into a descriptor holding the name itself, followed by the version
+	class TestSerializedAsset : public Grafkit::Asset::ISerializedAsset {
+	public:
+		explicit TestSerializedAsset(std::string name, std::string version = {})
+			: m_name(std::move(name))
+			, m_version(std::move(version))
+		{
+		}
+
+		void Deserialize([[maybe_unused]] const std::type_index& assetType, void* object) override
+		{
+			const auto separator = m_name.find(':');
+			*static_cast<TestDesc*>(object) = TestDesc { m_name.substr(0, separator) + m_version,
+				separator == std::string::npos ? std::string() : m_name.substr(separator + 1) };
+		}
+
+		[[nodiscard]] std::span<const uint8_t> GetData() const override
+		{
+			return { reinterpret_cast<const uint8_t*>(m_name.data()), m_name.size() };
+		}
+
+	private:
+		std::string m_name;
+		std::string m_version;
+	};
+
+	class TestAssetLoader : public Grafkit::Asset::IAssetLoader {
+	public:
+		[[nodiscard]] Grafkit::Asset::SerializedAssetPtr Load(const std::string& assetName) const override
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (assetName == "missing" || m_version == "broken") {
+				throw std::runtime_error("File not found: " + assetName);
+			}
+			return std::make_shared<TestSerializedAsset>(assetName, m_version);
+		}
+
+		void SetVersion(std::string version)
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_version = std::move(version);
+		}
+
+	private:
+		mutable std::mutex m_mutex;
+		std::string m_version;
+	};
+
+	class TestBuilder : public Grafkit::Resource::ResourceBuilder<TestDesc, TestResource> {
+	public:
+		explicit TestBuilder(const TestDesc& desc)
+			: ResourceBuilder(desc)
+		{
+		}
+
+		[[nodiscard]] bool ResolveDependencies(
+			[[maybe_unused]] const Grafkit::RefWrapper<ResourceManager>& resources) final
+		{
+			return true;
+		}
+
+		void Build([[maybe_unused]] const Grafkit::Core::DeviceRef& device) final
+		{
+			if (m_descriptor.value.ends_with("thrown")) {
+				throw 42;
+			}
+			m_resource =
+				std::make_shared<TestResource>(TestResource { m_descriptor.value, std::this_thread::get_id() });
+		}
+
+		[[nodiscard]] Grafkit::Resource::ResourceUsage GetUsage() const final
+		{
+			return { m_descriptor.value.size(), 100 };
+		}
+	};
+
+	class TestDependentBuilder : public Grafkit::Resource::ResourceBuilder<TestDesc, TestDependentResource> {
+	public:
+		explicit TestDependentBuilder(const TestDesc& desc)
+			: ResourceBuilder(desc)
+		{
+		}
+
+		[[nodiscard]] bool ResolveDependencies(const Grafkit::RefWrapper<ResourceManager>& resources) final
+		{
+			m_dependency = resources->Get<TestResource>(m_descriptor.dependency);
+			return m_dependency != nullptr;
+		}
+
+		[[nodiscard]] std::vector<Grafkit::Resource::ResourceId> GetDependencies() const final
+		{
+			return { { typeid(TestResource), m_descriptor.dependency } };
+		}
+
+		void Build([[maybe_unused]] const Grafkit::Core::DeviceRef& device) final
+		{
+			m_resource = std::make_shared<TestDependentResource>(TestDependentResource { m_dependency });
+		}
+
+	private:
+		std::shared_ptr<TestResource> m_dependency;
+	};
+} // namespace
+
+class TestResourceManager : public ::testing::Test {
+protected:
+	void SetUp() override
+	{
+		Grafkit::Resource::ResourceLoaderRegistry::Instance().RegisterBuilder<TestBuilder>();
+		Grafkit::Resource::ResourceLoaderRegistry::Instance().RegisterBuilder<TestDependentBuilder>();
+		m_resources = std::make_unique<ResourceManager>(
+			Grafkit::MakeReferenceAs<Grafkit::Asset::IAssetLoader>(m_assetLoader), 2);
+	}
+
+	void TearDown() override { m_resources.reset(); }
+
+	// Stand-in for the frame loop
+	void RunUntilIdle()
+	{
+		const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+		while (m_resources->GetPendingCount() > 0 && std::chrono::steady_clock::now() < deadline) {
+			m_resources->Update({});
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+	}
+
+	TestAssetLoader m_assetLoader;
+	std::unique_ptr<ResourceManager> m_resources;
+};
+
+TEST_F(TestResourceManager, LoadAsync)
+{
+	std::thread::id callbackThread;
+	auto future = m_resources->LoadAsync<TestResource>("first",
+		[&callbackThread](const std::shared_ptr<TestResource>&) { callbackThread = std::this_thread::get_id(); });
+
+	RunUntilIdle();
+
+	const auto resource = future.get();
+	ASSERT_NE(resource, nullptr);
+	ASSERT_EQ(resource->value, "first");
+	ASSERT_EQ(m_resources->Get<TestResource>("first"), resource);
+
+	// Build and callbacks happen on the thread calling Update
+	ASSERT_EQ(resource->builtOn, std::this_thread::get_id());
+	ASSERT_EQ(callbackThread, std::this_thread::get_id());
+}
+
+TEST_F(TestResourceManager, LoadAsyncWaitsForDependencies)
+{
+	auto dependent = m_resources->LoadAsync<TestDependentResource>("dependent:base");
+	auto base = m_resources->LoadAsync<TestResource>("base");
+
+	RunUntilIdle();
+
+	ASSERT_NE(dependent.get(), nullptr);
+	ASSERT_EQ(dependent.get()->dependency, base.get());
+}
+
+TEST_F(TestResourceManager, LoadAsyncFailures)
+{
+	bool callbackFired = false;
+	auto missing = m_resources->LoadAsync<TestResource>(
+		"missing", [&callbackFired](const std::shared_ptr<TestResource>& resource) {
+			callbackFired = true;
+			ASSERT_EQ(resource, nullptr);
+		});
+	auto unresolved = m_resources->LoadAsync<TestDependentResource>("dependent:nothing");
+
+	RunUntilIdle();
+
+	ASSERT_TRUE(callbackFired);
+	ASSERT_THROW(missing.get(), std::runtime_error);
+	ASSERT_THROW(unresolved.get(), std::runtime_error);
+}
+
+TEST_F(TestResourceManager, EvictsLeastRecentlyUsed)
+{
+	m_resources->SetMemoryBudget({ .gpuBytes = 250 });
+	m_resources->LoadAsync<TestResource>("a");
+	m_resources->LoadAsync<TestResource>("b");
+	RunUntilIdle();
+	ASSERT_EQ(m_resources->GetMemoryUsage().gpuBytes, 200u);
+
+	ASSERT_NE(m_resources->Get<TestResource>("a"), nullptr);
+	m_resources->LoadAsync<TestResource>("c");
+	RunUntilIdle();
+
+	ASSERT_EQ(m_resources->GetMemoryUsage().gpuBytes, 200u);
+	ASSERT_EQ(m_resources->GetMemoryUsage().cpuBytes, 2u);
+	ASSERT_TRUE(m_resources->Contains({ typeid(TestResource), "a" }));
+	ASSERT_FALSE(m_resources->Contains({ typeid(TestResource), "b" }));
+
+	// Asking for it again brings it back, evicting the next one in line
+	ASSERT_EQ(m_resources->Get<TestResource>("b"), nullptr);
+	RunUntilIdle();
+
+	ASSERT_NE(m_resources->Get<TestResource>("b"), nullptr);
+	ASSERT_FALSE(m_resources->Contains({ typeid(TestResource), "a" }));
+	ASSERT_EQ(m_resources->GetMemoryUsage<TestResource>().gpuBytes, 200u);
+}
+
+TEST_F(TestResourceManager, KeepsReferencedResources)
+{
+	m_resources->SetMemoryBudget<TestResource>({ .cpuBytes = 4 });
+	auto first = m_resources->LoadAsync<TestResource>("first");
+	m_resources->LoadAsync<TestResource>("second");
+	RunUntilIdle();
+
+	// Only the unreferenced one can go, the budget stays exceeded as long as the other is in use
+	const auto resource = first.get();
+	first = {};
+	m_resources->EnforceBudgets();
+
+	ASSERT_EQ(m_resources->Get<TestResource>("first"), resource);
+	ASSERT_FALSE(m_resources->Contains({ typeid(TestResource), "second" }));
+	ASSERT_EQ(m_resources->GetMemoryUsage<TestResource>().cpuBytes, 5u);
+}
+
+TEST_F(TestResourceManager, ReloadsEvictedDependencies)
+{
+	m_resources->LoadAsync<TestResource>("base");
+	RunUntilIdle();
+
+	m_resources->SetMemoryBudget({ .gpuBytes = 0 });
+	m_resources->EnforceBudgets();
+	ASSERT_FALSE(m_resources->Contains({ typeid(TestResource), "base" }));
+
+	auto dependent = m_resources->LoadAsync<TestDependentResource>("dependent:base");
+	RunUntilIdle();
+
+	ASSERT_NE(dependent.get(), nullptr);
+	ASSERT_EQ(dependent.get()->dependency->value, "base");
+}
+
+TEST_F(TestResourceManager, ReloadsDependents)
+{
+	m_resources->LoadAsync<TestDependentResource>("dependent:base");
+	m_resources->LoadAsync<TestResource>("base");
+	m_resources->LoadAsync<TestResource>("other");
+	RunUntilIdle();
+
+	std::vector<std::string> reloaded;
+	m_resources->AddReloadCallback(
+		[&reloaded](const Grafkit::Resource::ResourceId& id, const std::shared_ptr<void>& resource) {
+			ASSERT_NE(resource, nullptr);
+			reloaded.push_back(id.name);
+		});
+
+	const std::weak_ptr<TestResource> oldBase = m_resources->Get<TestResource>("base");
+	const auto other = m_resources->Get<TestResource>("other");
+
+	m_assetLoader.SetVersion("2");
+	m_resources->Reload("base");
+	RunUntilIdle();
+
+	// Both swapped in by the same update, unrelated resources are left alone
+	ASSERT_EQ(reloaded, std::vector<std::string>({ "base", "dependent:base" }));
+	ASSERT_EQ(m_resources->Get<TestResource>("base")->value, "base2");
+	ASSERT_EQ(m_resources->Get<TestDependentResource>("dependent:base")->dependency->value, "base2");
+	ASSERT_EQ(m_resources->Get<TestResource>("other"), other);
+
+	// The replaced one is still alive for the frames in flight
+	ASSERT_FALSE(oldBase.expired());
+	m_resources->Update({});
+	m_resources->Update({});
+	ASSERT_TRUE(oldBase.expired());
+}
+
+TEST_F(TestResourceManager, KeepsOldResourcesWhenReloadFails)
+{
+	m_resources->LoadAsync<TestDependentResource>("dependent:base");
+	m_resources->LoadAsync<TestResource>("base");
+	RunUntilIdle();
+	const auto base = m_resources->Get<TestResource>("base");
+	const auto dependent = m_resources->Get<TestDependentResource>("dependent:base");
+
+	m_resources->Reload("unknown");
+	ASSERT_EQ(m_resources->GetPendingCount(), 0u);
+
+	m_assetLoader.SetVersion("broken");
+	m_resources->Reload("base");
+	RunUntilIdle();
+
+	ASSERT_EQ(m_resources->Get<TestResource>("base"), base);
+	ASSERT_EQ(m_resources->Get<TestDependentResource>("dependent:base"), dependent);
+}
+
+TEST_F(TestResourceManager, KeepsOldResourcesWhenReloadThrowsAnything)
+{
+	m_resources->LoadAsync<TestResource>("base");
+	RunUntilIdle();
+	const auto base = m_resources->Get<TestResource>("base");
+
+	m_assetLoader.SetVersion("thrown");
+	m_resources->Reload("base");
+	RunUntilIdle();
+
+	ASSERT_EQ(m_resources->Get<TestResource>("base"), base);
+}
+
+TEST(TestThreadPool, SurvivesTasksThrowingAnything)
+{
+	Grafkit::Utils::ThreadPool pool(1);
+	pool.Enqueue([]() { throw 42; });
+
+	std::future<int> failed = pool.Submit([]() -> int { throw 42; });
+	ASSERT_THROW(failed.get(), int);
+
+	// The worker is still there to run the next one
+	std::future<int> result = pool.Submit([]() { return 7; });
+	ASSERT_EQ(result.get(), 7);
+	pool.WaitIdle();
+}
+
+TEST_F(TestResourceManager, GetsFromWorkerThreads)
+{
+	constexpr int RESOURCE_COUNT = 200;
+
+	std::atomic<bool> isDone = false;
+	std::atomic<int> found = 0;
+	std::vector<std::thread> readers;
+	for (int i = 0; i < 4; ++i) {
+		readers.emplace_back([this, &isDone, &found]() {
+			// One more round once the writes are done, every resource is there by then
+			bool isLastRound = false;
+			while (!isLastRound) {
+				isLastRound = isDone.load();
+				for (int j = 0; j < RESOURCE_COUNT; ++j) {
+					const auto resource = m_resources->Get<TestResource>("resource" + std::to_string(j));
+					if (resource != nullptr) {
+						ASSERT_EQ(resource->value, "resource" + std::to_string(j));
+						++found;
+					}
+				}
+			}
+		});
+	}
+
+	// Stored and replaced on this thread while the others keep looking them up
+	for (int round = 0; round < 2; ++round) {
+		for (int i = 0; i < RESOURCE_COUNT; ++i) {
+			const std::string name = "resource" + std::to_string(i);
+			m_resources->Add(name, std::make_shared<TestResource>(TestResource { name, std::this_thread::get_id() }));
+		}
+	}
+
+	isDone = true;
+	for (auto& reader : readers) {
+		reader.join();
+	}
+
+	ASSERT_GE(found.load(), 4 * RESOURCE_COUNT);
+	ASSERT_TRUE(m_resources->Contains({ typeid(TestResource), "resource0" }));
+}
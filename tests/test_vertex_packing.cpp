@@ -0,0 +1,133 @@
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <grafkit/render/vertex_packing.h>
+
+using namespace Grafkit;
+namespace VertexPacking = Grafkit::VertexPacking;
+
+namespace {
+	std::vector<Vertex> MakeVertices()
+	{
+		return {
+			{ .position = { -2.0f, 0.0f, 1.0f }, .color = { 1.0f, 0.0f, 0.5f }, .uv = { 0.0f, 1.0f },
+				.normal = { 0.0f, 0.0f, 1.0f } },
+			{ .position = { 6.0f, 4.0f, 1.0f }, .color = { 0.0f, 1.0f, 0.0f }, .uv = { 1.5f, -0.5f },
+				.normal = { 0.0f, -1.0f, 0.0f } },
+			{ .position = { 2.0f, -4.0f, 3.0f }, .color = { 0.2f, 0.2f, 0.2f }, .uv = { 0.25f, 0.75f },
+				.normal = glm::normalize(glm::vec3(-1.0f, 1.0f, -1.0f)) },
+		};
+	}
+} // namespace
+
+TEST(TestVertexPacking, HalfRoundTrip)
+{
+	for (const float value : { 0.0f, 1.0f, -2.5f, 0.333f, 1000.0f, 65504.0f, 6.1e-5f, 3.0e-6f }) {
+		const float unpacked = VertexPacking::UnpackHalf(VertexPacking::PackHalf(value));
+		EXPECT_NEAR(unpacked, value, std::abs(value) * 1e-3f + 1e-7f) << value;
+	}
+
+	EXPECT_EQ(VertexPacking::PackHalf(1.0f), 0x3c00);
+	EXPECT_EQ(VertexPacking::PackHalf(-2.0f), 0xc000);
+	EXPECT_TRUE(std::isinf(VertexPacking::UnpackHalf(VertexPacking::PackHalf(1.0e6f))));
+	EXPECT_TRUE(std::isnan(VertexPacking::UnpackHalf(VertexPacking::PackHalf(NAN))));
+}
+
+TEST(TestVertexPacking, OctahedralRoundTrip)
+{
+	for (int i = 0; i < 200; ++i) {
+		// Spiral over the whole sphere, both hemispheres and the poles
+		const float z = 1.0f - 2.0f * static_cast<float>(i) / 199.0f;
+		const float radius = std::sqrt(std::max(0.0f, 1.0f - z * z));
+		const float angle = static_cast<float>(i) * 2.39996f;
+		const glm::vec3 direction(radius * std::cos(angle), radius * std::sin(angle), z);
+
+		const glm::vec3 unpacked = VertexPacking::UnpackOctahedral(VertexPacking::PackOctahedral(direction));
+		EXPECT_GT(glm::dot(unpacked, direction), 0.99999f) << i;
+	}
+}
+
+TEST(TestVertexPacking, CalculatesBoundsAndTransform)
+{
+	const std::vector<Vertex> vertices = MakeVertices();
+	const PositionBounds bounds = CalculateBounds(vertices);
+	EXPECT_FLOAT_EQ(bounds.center.x, 2.0f);
+	EXPECT_FLOAT_EQ(bounds.center.y, 0.0f);
+	EXPECT_FLOAT_EQ(bounds.center.z, 2.0f);
+	EXPECT_FLOAT_EQ(bounds.extent.x, 4.0f);
+	EXPECT_FLOAT_EQ(bounds.extent.y, 4.0f);
+	EXPECT_FLOAT_EQ(bounds.extent.z, 1.0f);
+
+	const glm::mat4 transform = GetPositionTransform(VertexFormat::Snorm16, bounds);
+	const glm::vec4 corner = transform * glm::vec4(1.0f, -1.0f, 1.0f, 1.0f);
+	EXPECT_FLOAT_EQ(corner.x, 6.0f);
+	EXPECT_FLOAT_EQ(corner.y, -4.0f);
+	EXPECT_FLOAT_EQ(corner.z, 3.0f);
+}
+
+TEST(TestVertexPacking, PacksCompactVertices)
+{
+	const std::vector<Vertex> vertices = MakeVertices();
+	const PositionBounds bounds = CalculateBounds(vertices);
+
+	for (const VertexFormat format : { VertexFormat::Snorm16, VertexFormat::Half }) {
+		const std::vector<uint8_t> data = PackVertices(vertices, format, bounds);
+		ASSERT_EQ(data.size(), vertices.size() * GetVertexStride(format));
+
+		const glm::mat4 transform = GetPositionTransform(format, bounds);
+		for (size_t i = 0; i < vertices.size(); ++i) {
+			CompactVertex packed {};
+			std::memcpy(&packed, data.data() + i * sizeof(packed), sizeof(packed));
+
+			// Decodes the position as the vertex input would
+			glm::vec4 position(0.0f, 0.0f, 0.0f, 1.0f);
+			for (int axis = 0; axis < 3; ++axis) {
+				position[axis] = format == VertexFormat::Snorm16
+					? static_cast<float>(packed.position[axis]) / 32767.0f
+					: VertexPacking::UnpackHalf(static_cast<uint16_t>(packed.position[axis]));
+			}
+			position = transform * position;
+			EXPECT_NEAR(position.x, vertices[i].position.x, 1e-2f);
+			EXPECT_NEAR(position.y, vertices[i].position.y, 1e-2f);
+			EXPECT_NEAR(position.z, vertices[i].position.z, 1e-2f);
+
+			const glm::vec3 normal = VertexPacking::UnpackOctahedral(packed.normal);
+			const glm::vec3 tangent = VertexPacking::UnpackOctahedral(packed.tangent);
+			EXPECT_GT(glm::dot(normal, vertices[i].normal), 0.9999f);
+			EXPECT_NEAR(glm::dot(normal, tangent), 0.0f, 1e-3f);
+		}
+	}
+
+	// UVs are clamped into the range of unorm16
+	const std::vector<uint8_t> data = PackVertices(vertices, VertexFormat::Snorm16, bounds);
+	CompactVertex packed {};
+	std::memcpy(&packed, data.data() + sizeof(packed), sizeof(packed));
+	EXPECT_EQ(packed.uv[0], 65535);
+	EXPECT_EQ(packed.uv[1], 0);
+	EXPECT_EQ(packed.color[1], 255);
+}
+
+TEST(TestVertexPacking, DescribesVertexFormats)
+{
+	EXPECT_EQ(GetVertexStride(VertexFormat::Float), sizeof(Vertex));
+	EXPECT_EQ(GetVertexStride(VertexFormat::Snorm16), 24u);
+	EXPECT_EQ(GetVertexStride(VertexFormat::Half), 24u);
+	EXPECT_EQ(GetIndexSize(VK_INDEX_TYPE_UINT16), 2u);
+	EXPECT_EQ(GetIndexSize(VK_INDEX_TYPE_UINT32), 4u);
+
+	const Core::VertexDescription compact = GetVertexDescription(VertexFormat::Snorm16, 1, 2);
+	ASSERT_EQ(compact.bindings.size(), 1u);
+	EXPECT_EQ(compact.bindings[0].binding, 1u);
+	EXPECT_EQ(compact.bindings[0].stride, 24u);
+	ASSERT_EQ(compact.attributes.size(), 5u);
+	EXPECT_EQ(compact.attributes[0].format, VK_FORMAT_R16G16B16A16_SNORM);
+	EXPECT_EQ(compact.attributes[3].location, 3u);
+	EXPECT_EQ(compact.attributes[3].binding, 2u);
+	EXPECT_EQ(compact.attributes[3].offset, offsetof(CompactVertex, normal));
+
+	const Core::VertexDescription half = GetVertexDescription(VertexFormat::Half);
+	EXPECT_EQ(half.attributes[0].format, VK_FORMAT_R16G16B16A16_SFLOAT);
+}
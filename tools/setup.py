@@ -44,6 +44,7 @@ setup(
         "console_scripts": [
             "hexdump=grafkit_tools.hexdump:main",
             "codegen=grafkit_tools.codegen:main",
+            "packer=grafkit_tools.packer:main",
         ],
     },
     extras_require={"test": test_requires},
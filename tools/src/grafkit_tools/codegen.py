@@ -63,6 +63,9 @@ class Field:
     type: str
     name: str
     default: Optional[Union[str, int, float, bool]] = None
+    comment: Optional[str] = ""
+    # VkFormat of the field as a vertex attribute, types having it get a generated GetVertexDescription
+    format: Optional[str] = None
 
 
 @dataclass
@@ -83,6 +86,10 @@ class Type:
     name: str
     fields: List[Field]
     comment: Optional[str] = ""
+    # "binary" marks a fixed, memory-mappable layout that is read in place instead of being serialized
+    layout: Optional[str] = None
+    align: Optional[int] = None
+    size: Optional[int] = None
 
 
 @dataclass
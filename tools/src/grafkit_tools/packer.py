@@ -0,0 +1,197 @@
+import argparse
+import logging
+import os
+import struct
+import sys
+from dataclasses import dataclass, field
+
+from grafkit_tools.utils import lz4
+
+logger = logging.getLogger(__name__)
+
+# Has to match with pack_desc.gen.yaml and pack_source.h
+PACK_MAGIC = 0x4B504B47  # 'GKPK'
+PACK_VERSION = 1
+PACK_ENTRY_COMPRESSED = 1 << 0
+
+HEADER_FORMAT = "<IIIIQQQQ"
+ENTRY_FORMAT = "<QQQQIIII"
+HEADER_SIZE = struct.calcsize(HEADER_FORMAT)
+ENTRY_SIZE = struct.calcsize(ENTRY_FORMAT)
+
+DEFAULT_BLOCK_SIZE = 64 * 1024
+DEFAULT_ALIGNMENT = 64
+# Entries are only stored compressed when it saves at least this much
+COMPRESSION_RATIO_LIMIT = 0.9
+
+FNV_OFFSET_BASIS = 0xCBF29CE484222325
+FNV_PRIME = 0x100000001B3
+
+
+def hash_asset_name(name: str) -> int:
+    value = FNV_OFFSET_BASIS
+    for byte in name.encode("utf-8"):
+        value ^= byte
+        value = (value * FNV_PRIME) & 0xFFFFFFFFFFFFFFFF
+    return value
+
+
+def align_up(value: int, alignment: int) -> int:
+    return (value + alignment - 1) & ~(alignment - 1)
+
+
+@dataclass
+class PackItem:
+    name: str
+    data: bytes
+    stored: bytes = b""
+    blocks: list[int] = field(default_factory=list)
+    flags: int = 0
+
+
+def compress_item(item: PackItem, block_size: int):
+    blocks = []
+    stored = bytearray()
+    for offset in range(0, len(item.data), block_size):
+        block = item.data[offset : offset + block_size]
+        compressed = lz4.compress_block(block)
+        # Incompressible blocks are kept raw, the reader tells them apart by size
+        if len(compressed) >= len(block):
+            compressed = block
+        blocks.append(len(compressed))
+        stored += compressed
+
+    if item.data and len(stored) < len(item.data) * COMPRESSION_RATIO_LIMIT:
+        item.stored = bytes(stored)
+        item.blocks = blocks
+        item.flags |= PACK_ENTRY_COMPRESSED
+    else:
+        item.stored = item.data
+
+
+def collect_files(input_dir: str) -> list[PackItem]:
+    items = []
+    for root, _, files in os.walk(input_dir):
+        for file_name in sorted(files):
+            path = os.path.join(root, file_name)
+            name = os.path.relpath(path, input_dir).replace(os.sep, "/")
+            with open(path, "rb") as file:
+                items.append(PackItem(name=name, data=file.read()))
+    return items
+
+
+def write_pack(items: list[PackItem], output_file: str, block_size: int, alignment: int):
+    items = sorted(items, key=lambda item: hash_asset_name(item.name))
+
+    hashes = [hash_asset_name(item.name) for item in items]
+    for index in range(1, len(items)):
+        if hashes[index - 1] == hashes[index]:
+            raise ValueError(f"Asset name hash collision: {items[index - 1].name} and {items[index].name}")
+
+    string_table = bytearray()
+    name_offsets = []
+    for item in items:
+        name_offsets.append(len(string_table))
+        string_table += item.name.encode("utf-8")
+
+    block_table = []
+    first_blocks = []
+    for item in items:
+        first_blocks.append(len(block_table))
+        block_table += item.blocks
+
+    entry_table_offset = HEADER_SIZE
+    block_table_offset = entry_table_offset + len(items) * ENTRY_SIZE
+    string_table_offset = block_table_offset + len(block_table) * 4
+    data_offset = align_up(string_table_offset + len(string_table), alignment)
+
+    data_offsets = []
+    for item in items:
+        data_offsets.append(data_offset)
+        data_offset = align_up(data_offset + len(item.stored), alignment)
+
+    with open(output_file, "wb") as file:
+        file.write(
+            struct.pack(
+                HEADER_FORMAT,
+                PACK_MAGIC,
+                PACK_VERSION,
+                len(items),
+                block_size,
+                entry_table_offset,
+                block_table_offset,
+                string_table_offset,
+                len(string_table),
+            )
+        )
+        for index, item in enumerate(items):
+            file.write(
+                struct.pack(
+                    ENTRY_FORMAT,
+                    hashes[index],
+                    data_offsets[index],
+                    len(item.data),
+                    len(item.stored),
+                    name_offsets[index],
+                    len(item.name.encode("utf-8")),
+                    first_blocks[index],
+                    item.flags,
+                )
+            )
+        file.write(struct.pack(f"<{len(block_table)}I", *block_table))
+        file.write(string_table)
+
+        for index, item in enumerate(items):
+            file.write(b"\0" * (data_offsets[index] - file.tell()))
+            file.write(item.stored)
+        file.write(b"\0" * (align_up(file.tell(), alignment) - file.tell()))
+
+
+def pack_directory(
+    input_dir: str, output_file: str, block_size=DEFAULT_BLOCK_SIZE, alignment=DEFAULT_ALIGNMENT, compress=True
+):
+    items = collect_files(input_dir)
+    for item in items:
+        if compress:
+            compress_item(item, block_size)
+        else:
+            item.stored = item.data
+
+    write_pack(items, output_file, block_size, alignment)
+
+    total_size = sum(len(item.data) for item in items)
+    stored_size = sum(len(item.stored) for item in items)
+    logger.info(f"Packed {len(items)} files into {output_file}: {total_size} -> {stored_size} bytes")
+
+
+def build_parser():
+    parser = argparse.ArgumentParser(description="Pack a directory of assets into a single pack file.")
+    parser.add_argument("--input-dir", "-i", help="Directory to pack", required=True)
+    parser.add_argument("--output", "-o", help="Pack file to write", required=True)
+    parser.add_argument("--block-size", "-b", help="Compression block size", type=int, default=DEFAULT_BLOCK_SIZE)
+    parser.add_argument("--alignment", "-a", help="Alignment of entries", type=int, default=DEFAULT_ALIGNMENT)
+    parser.add_argument("--no-compression", help="Store every entry uncompressed", action="store_true")
+    return parser
+
+
+def main():
+    logging.basicConfig(level=logging.INFO)
+
+    parser = build_parser()
+    args = parser.parse_args()
+
+    if args.alignment <= 0 or args.alignment & (args.alignment - 1):
+        logger.error("Alignment has to be a power of two")
+        return 1
+
+    try:
+        pack_directory(args.input_dir, args.output, args.block_size, args.alignment, not args.no_compression)
+    except Exception as e:
+        logger.error(e, exc_info=True)
+        return 1
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -23,9 +23,34 @@ def snake_to_camel_case(name):
     return "".join(word.title() for word in name.split("_"))
 
 
+def fnv1a_64(text):
+    value = 0xCBF29CE484222325
+    for byte in text.encode("utf-8"):
+        value = ((value ^ byte) * 0x100000001B3) & 0xFFFFFFFFFFFFFFFF
+    return value
+
+
+def schema_hash(type, sources):
+    """Hash of the fields of a type and of the types it contains; changes whenever the binary form does"""
+    types = {t["name"]: t for source in sources for t in (source["types"] or [])}
+
+    def describe(t, visited):
+        visited = visited | {t["name"]}
+        text = t["name"] + "{"
+        for field in t["fields"]:
+            text += field["type"] + " " + field["name"] + ";"
+            for name in re.findall(r"[A-Za-z_]\w*", field["type"]):
+                if name in types and name not in visited:
+                    text += describe(types[name], visited)
+        return text + "}"
+
+    return f"0x{fnv1a_64(describe(type, set())):016x}"
+
+
 def setup_env(env):
     env.filters["hex_byte"] = hex_byte
     env.filters["generate_chunks"] = generate_chunks
     env.filters["sanitize_for_cpp"] = sanitize_string_for_cpp
     env.filters["snake_to_camel_case"] = snake_to_camel_case
+    env.filters["schema_hash"] = schema_hash
     return env
@@ -0,0 +1,106 @@
+"""
+Minimal LZ4 block format compressor.
+The output is a plain LZ4 block (no frame header), decoded by the engine when loading packed assets.
+"""
+
+MIN_MATCH = 4
+LAST_LITERALS = 5  # The last 5 bytes of a block are always literals
+MATCH_FIND_LIMIT = 12  # The last match has to start at least 12 bytes before the end
+MAX_OFFSET = 0xFFFF
+
+
+def _write_length(out: bytearray, length: int):
+    while length >= 255:
+        out.append(255)
+        length -= 255
+    out.append(length)
+
+
+def _write_sequence(out: bytearray, literals: bytes, offset: int, match_length: int):
+    literal_length = len(literals)
+    token = min(literal_length, 15) << 4
+    if match_length:
+        token |= min(match_length - MIN_MATCH, 15)
+    out.append(token)
+
+    if literal_length >= 15:
+        _write_length(out, literal_length - 15)
+    out += literals
+
+    if match_length:
+        out += offset.to_bytes(2, "little")
+        if match_length - MIN_MATCH >= 15:
+            _write_length(out, match_length - MIN_MATCH - 15)
+
+
+def compress_block(data: bytes) -> bytes:
+    """Greedy hash chain-less compressor, good enough for offline packing."""
+    size = len(data)
+    out = bytearray()
+    table = {}
+
+    anchor = 0
+    pos = 0
+    limit = size - MATCH_FIND_LIMIT
+    while pos < limit:
+        key = data[pos : pos + MIN_MATCH]
+        candidate = table.get(key)
+        table[key] = pos
+
+        if candidate is None or pos - candidate > MAX_OFFSET:
+            pos += 1
+            continue
+
+        match_length = MIN_MATCH
+        max_length = size - LAST_LITERALS - pos
+        while match_length < max_length and data[candidate + match_length] == data[pos + match_length]:
+            match_length += 1
+
+        _write_sequence(out, data[anchor:pos], pos - candidate, match_length)
+        pos += match_length
+        anchor = pos
+
+    _write_sequence(out, data[anchor:], 0, 0)
+    return bytes(out)
+
+
+def decompress_block(data: bytes, size: int) -> bytes:
+    """Reference decoder, used to verify packs."""
+    out = bytearray()
+    pos = 0
+    while pos < len(data):
+        token = data[pos]
+        pos += 1
+
+        literal_length = token >> 4
+        if literal_length == 15:
+            while True:
+                value = data[pos]
+                pos += 1
+                literal_length += value
+                if value != 255:
+                    break
+        out += data[pos : pos + literal_length]
+        pos += literal_length
+
+        if pos >= len(data):
+            break
+
+        offset = int.from_bytes(data[pos : pos + 2], "little")
+        pos += 2
+        match_length = (token & 0x0F) + MIN_MATCH
+        if (token & 0x0F) == 15:
+            while True:
+                value = data[pos]
+                pos += 1
+                match_length += value
+                if value != 255:
+                    break
+
+        start = len(out) - offset
+        for i in range(match_length):
+            out.append(out[start + i])
+
+    if len(out) != size:
+        raise ValueError(f"Decompressed size mismatch: {len(out)} != {size}")
+    return bytes(out)